@@ -0,0 +1,1029 @@
+/**
+ * @file book_bench.cpp
+ * @brief Performance benchmarks for the OrderBook matching engine, its
+ *        order ID index, the packed vs. compact order layouts, pointer vs.
+ *        index-linked queues and the market-by-order event path.
+ *
+ * METHODOLOGY:
+ * 1. Build a resting book of N price levels before timing.
+ * 2. Time only the operation under test (manual timing per batch).
+ * 3. Report per-operation latency via an inverted rate counter.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <book/compact_order_book.hpp>
+#include <book/indexed_intrusive_list.hpp>
+#include <book/intrusive_list.hpp>
+#include <book/ladder_order_book.hpp>
+#include <book/market_by_order.hpp>
+#include <book/order_book.hpp>
+#include <book/order_index.hpp>
+#include <book/pool_allocation.hpp>
+#include <book/segmented_pool.hpp>
+#include <itch/parser.hpp>
+
+#include "test_files.hpp"
+
+namespace {
+
+using itch::test::put_be;
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+/// Pool capacity for book benchmarks (covers 10,000 levels x 8 orders)
+constexpr std::size_t BENCH_POOL_CAPACITY = 1 << 17;
+
+/// Resting orders per price level
+constexpr uint64_t ORDERS_PER_LEVEL = 8;
+
+/// Maximum cancels timed per benchmark iteration
+constexpr std::size_t CANCEL_BATCH = 1024;
+
+using BenchPool = book::MemPool<book::Order, BENCH_POOL_CAPACITY>;
+using BenchBook = book::OrderBook<BENCH_POOL_CAPACITY>;
+
+/// Order ID for slot `slot` at level `level`
+constexpr uint64_t order_id(uint64_t level, uint64_t slot) {
+  return level * ORDERS_PER_LEVEL + slot + 1;
+}
+
+/// Bid price for level `level` (1 cent apart, descending)
+constexpr uint64_t level_price(uint64_t level) {
+  return 1'000'000 - level * 100;
+}
+
+// ============================================================================
+// Benchmark: Cancel latency vs. book depth
+// ============================================================================
+
+/**
+ * @brief Cancel resting orders from a book with state.range(0) bid levels.
+ *
+ * Slot 0 of every level is never cancelled, so levels never empty and the
+ * measurement isolates order lookup + level resolution + list unlink.
+ * Cancelled orders are re-added (untimed) after each batch.
+ */
+static void BM_CancelOrder_DeepBook(benchmark::State &state) {
+  const auto num_levels = static_cast<uint64_t>(state.range(0));
+
+  auto pool = std::make_unique<BenchPool>();
+  auto book = std::make_unique<BenchBook>(*pool);
+
+  for (uint64_t level = 0; level < num_levels; ++level) {
+    for (uint64_t slot = 0; slot < ORDERS_PER_LEVEL; ++slot) {
+      book->add_order(order_id(level, slot), level_price(level), 100,
+                      book::Side::Buy);
+    }
+  }
+
+  // Cancellable orders, in random ladder positions
+  std::vector<uint64_t> candidates;
+  candidates.reserve(num_levels * (ORDERS_PER_LEVEL - 1));
+  for (uint64_t level = 0; level < num_levels; ++level) {
+    for (uint64_t slot = 1; slot < ORDERS_PER_LEVEL; ++slot) {
+      candidates.push_back(order_id(level, slot));
+    }
+  }
+  std::mt19937_64 rng(42);
+  std::shuffle(candidates.begin(), candidates.end(), rng);
+
+  const std::size_t batch = std::min(CANCEL_BATCH, candidates.size());
+  std::size_t cursor = 0;
+
+  for (auto _ : state) {
+    if (cursor + batch > candidates.size()) {
+      cursor = 0;
+    }
+    const uint64_t *ids = candidates.data() + cursor;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < batch; ++i) {
+      benchmark::DoNotOptimize(book->cancel_order(ids[i]));
+    }
+    auto end = std::chrono::steady_clock::now();
+    state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+
+    // Restore the book (untimed)
+    for (std::size_t i = 0; i < batch; ++i) {
+      const uint64_t level = (ids[i] - 1) / ORDERS_PER_LEVEL;
+      book->add_order(ids[i], level_price(level), 100, book::Side::Buy);
+    }
+    cursor += batch;
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batch));
+  state.counters["per_cancel"] = benchmark::Counter(
+      static_cast<double>(batch),
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_CancelOrder_DeepBook)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1'000)
+    ->Arg(10'000)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// Benchmark: Cancel latency vs. pool storage policy
+// ============================================================================
+
+/// Pool for the storage policy benchmark (~150 MB of orders, so random
+/// cancels span far more pages than a 4 KB-page TLB covers)
+constexpr std::size_t POLICY_POOL_CAPACITY = 1 << 22;
+
+/// Live orders and levels in the storage policy benchmark
+constexpr uint64_t POLICY_LIVE_ORDERS = 3'000'000;
+constexpr uint64_t POLICY_LEVELS = 1'000;
+
+/**
+ * @brief Book of POLICY_LIVE_ORDERS bids whose pool uses `Allocation`.
+ *
+ * Built once per policy (a few seconds) and shared by every run.
+ */
+template <typename Allocation> struct PolicyFixture {
+  using Book = book::OrderBook<POLICY_POOL_CAPACITY, Allocation>;
+
+  PolicyFixture()
+      : pool(std::make_unique<typename Book::PoolType>()),
+        book(std::make_unique<Book>(*pool)), ids(POLICY_LIVE_ORDERS) {
+    for (uint64_t i = 0; i < POLICY_LIVE_ORDERS; ++i) {
+      book->add_order(i + 1, price_of(i + 1), 100, book::Side::Buy);
+      ids[i] = i + 1;
+    }
+    std::mt19937_64 rng(42);
+    std::shuffle(ids.begin(), ids.end(), rng);
+  }
+
+  static uint64_t price_of(uint64_t id) {
+    return level_price(id % POLICY_LEVELS);
+  }
+
+  static PolicyFixture &get() {
+    static PolicyFixture fixture;
+    return fixture;
+  }
+
+  std::unique_ptr<typename Book::PoolType> pool;
+  std::unique_ptr<Book> book;
+  std::vector<uint64_t> ids; ///< Live IDs in random order
+  std::size_t cursor = 0;
+};
+
+/**
+ * @brief Cancel random resting orders across the whole pool; each is
+ *        re-added (untimed). The label names the page backing obtained.
+ */
+template <typename Allocation>
+static void BM_CancelOrder_PoolPolicy(benchmark::State &state) {
+  auto &fx = PolicyFixture<Allocation>::get();
+
+  for (auto _ : state) {
+    if (fx.cursor + CANCEL_BATCH > fx.ids.size()) {
+      fx.cursor = 0;
+    }
+    const uint64_t *ids = fx.ids.data() + fx.cursor;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < CANCEL_BATCH; ++i) {
+      benchmark::DoNotOptimize(fx.book->cancel_order(ids[i]));
+    }
+    auto end = std::chrono::steady_clock::now();
+    state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+
+    for (std::size_t i = 0; i < CANCEL_BATCH; ++i) {
+      fx.book->add_order(ids[i], fx.price_of(ids[i]), 100, book::Side::Buy);
+    }
+    fx.cursor += CANCEL_BATCH;
+  }
+
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations() * CANCEL_BATCH));
+  state.counters["per_cancel"] = benchmark::Counter(
+      static_cast<double>(CANCEL_BATCH),
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+  state.SetLabel(book::page_backing_name(fx.pool->page_backing()));
+}
+
+BENCHMARK_TEMPLATE(BM_CancelOrder_PoolPolicy, book::HeapAllocation)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_CancelOrder_PoolPolicy, book::HugePageAllocation)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// Benchmark: Fixed MemPool vs. growable SegmentedPool
+// ============================================================================
+
+/// Segment size for the growable pool (the resting book fills 5 segments)
+constexpr std::size_t BENCH_SEGMENT_SLOTS = BENCH_POOL_CAPACITY / 8;
+
+using FixedPoolBook = book::OrderBook<BENCH_POOL_CAPACITY>;
+using SegmentedPoolBook = book::BasicOrderBook<
+    book::SegmentedPool<book::Order, BENCH_SEGMENT_SLOTS>>;
+
+/// Pool for `Book`, sized as each pool type is meant to be used
+template <typename Book> std::unique_ptr<typename Book::PoolType> make_pool() {
+  if constexpr (std::is_same_v<Book, SegmentedPoolBook>) {
+    return std::make_unique<typename Book::PoolType>(BENCH_SEGMENT_SLOTS);
+  } else {
+    return std::make_unique<typename Book::PoolType>();
+  }
+}
+
+/**
+ * @brief Add then cancel a batch of orders on a book of 10,000 levels.
+ *
+ * The segmented pool starts at one segment and grows while the resting
+ * book is built (untimed); timed batches measure the steady-state
+ * allocate/deallocate path through the book.
+ */
+template <typename Book>
+static void BM_AddCancel_PoolType(benchmark::State &state) {
+  constexpr uint64_t kLevels = 10'000;
+  auto pool = make_pool<Book>();
+  Book book(*pool, BENCH_POOL_CAPACITY);
+  for (uint64_t level = 0; level < kLevels; ++level) {
+    for (uint64_t slot = 0; slot < ORDERS_PER_LEVEL; ++slot) {
+      book.add_order(order_id(level, slot), level_price(level), 100,
+                     book::Side::Buy);
+    }
+  }
+  const uint64_t first_id = order_id(kLevels, 0);
+
+  for (auto _ : state) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < CANCEL_BATCH; ++i) {
+      benchmark::DoNotOptimize(book.add_order(
+          first_id + i, level_price(i % kLevels), 100, book::Side::Buy));
+    }
+    for (uint64_t i = 0; i < CANCEL_BATCH; ++i) {
+      benchmark::DoNotOptimize(book.cancel_order(first_id + i));
+    }
+    auto end = std::chrono::steady_clock::now();
+    state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+  }
+
+  state.counters["per_add_cancel"] = benchmark::Counter(
+      static_cast<double>(CANCEL_BATCH),
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+}
+
+BENCHMARK_TEMPLATE(BM_AddCancel_PoolType, FixedPoolBook)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_AddCancel_PoolType, SegmentedPoolBook)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// Benchmark: Sweep matching - function pointer vs. template execution sink
+// ============================================================================
+
+/// Most makers one sweep fills (sizes the execution buffer)
+constexpr std::size_t SWEEP_MAX_MAKERS = 1024;
+
+/// Next free slot for the function-pointer sink, which cannot carry state
+book::Execution *g_sweep_cursor = nullptr;
+
+void record_sweep_fill(const book::Execution &exec) {
+  *g_sweep_cursor++ = exec;
+}
+
+/// The former interface: an opaque void(*)(const Execution &) per fill
+struct FunctionPointerSink {
+  static std::size_t sweep(BenchBook &book, std::span<book::Execution> fills,
+                           uint64_t id, uint64_t price, uint32_t qty) {
+    BenchBook::ExecutionCallback callback = record_sweep_fill;
+    benchmark::DoNotOptimize(&callback); // Unknown target: indirect call
+    g_sweep_cursor = fills.data();
+    book.add_order(id, price, qty, book::Side::Buy, callback);
+    return static_cast<std::size_t>(g_sweep_cursor - fills.data());
+  }
+};
+
+/// Template sink: ExecutionBuffer is inlined into the matching loop
+struct BufferSink {
+  static std::size_t sweep(BenchBook &book, std::span<book::Execution> fills,
+                           uint64_t id, uint64_t price, uint32_t qty) {
+    book::ExecutionBuffer sink(fills);
+    book.add_order(id, price, qty, book::Side::Buy, sink);
+    return sink.size();
+  }
+};
+
+/**
+ * @brief One aggressive buy that fills state.range(0) resting asks
+ *        (8 per level) and reports every fill to the sink under test.
+ *
+ * The makers are re-added (untimed) after each sweep.
+ */
+template <typename Sink> static void BM_Sweep_Sink(benchmark::State &state) {
+  const auto makers = static_cast<uint64_t>(state.range(0));
+  const uint64_t levels = makers / ORDERS_PER_LEVEL;
+  auto ask_price = [](uint64_t level) { return 1'000'000 + level * 100; };
+
+  auto pool = std::make_unique<BenchPool>();
+  BenchBook book(*pool);
+  std::vector<book::Execution> fills(SWEEP_MAX_MAKERS);
+  auto rest_makers = [&] {
+    for (uint64_t level = 0; level < levels; ++level) {
+      for (uint64_t slot = 0; slot < ORDERS_PER_LEVEL; ++slot) {
+        book.add_order(order_id(level, slot), ask_price(level), 100,
+                       book::Side::Sell);
+      }
+    }
+  };
+  rest_makers();
+
+  const uint64_t taker_id = order_id(levels, 0);
+  const auto sweep_qty = static_cast<uint32_t>(makers * 100);
+  for (auto _ : state) {
+    auto start = std::chrono::steady_clock::now();
+    const std::size_t filled = Sink::sweep(book, fills, taker_id,
+                                           ask_price(levels - 1), sweep_qty);
+    auto end = std::chrono::steady_clock::now();
+    state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+
+    if (filled != makers || !book.empty()) {
+      state.SkipWithError("sweep did not fill every maker");
+      break;
+    }
+    rest_makers();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * makers));
+  state.counters["per_fill"] = benchmark::Counter(
+      static_cast<double>(makers),
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+}
+
+BENCHMARK_TEMPLATE(BM_Sweep_Sink, FunctionPointerSink)
+    ->Arg(128)
+    ->Arg(1024)
+    ->UseManualTime();
+BENCHMARK_TEMPLATE(BM_Sweep_Sink, BufferSink)
+    ->Arg(128)
+    ->Arg(1024)
+    ->UseManualTime();
+
+// ============================================================================
+// Benchmark: Order ID index (FlatOrderIndex vs. std::unordered_map)
+// ============================================================================
+
+/// Operations timed per benchmark iteration for index benchmarks
+constexpr std::size_t INDEX_BATCH = 4096;
+
+/// std::unordered_map as OrderBook used it (node per insert, no reserve)
+struct StdOrderIndex {
+  explicit StdOrderIndex(std::size_t /*max_entries*/) {}
+
+  bool insert(uint64_t id, const book::OrderHandle &handle) {
+    return map.emplace(id, handle).second;
+  }
+  const book::OrderHandle *find(uint64_t id) const {
+    auto it = map.find(id);
+    return it == map.end() ? nullptr : &it->second;
+  }
+  bool erase(uint64_t id) { return map.erase(id) != 0; }
+
+  std::unordered_map<uint64_t, book::OrderHandle> map;
+};
+
+using FlatIndex = book::FlatOrderIndex<book::OrderHandle>;
+
+/// Index pre-filled with `live` IDs (1..live) plus those IDs, shuffled
+template <typename Index> struct IndexFixture {
+  explicit IndexFixture(std::size_t live)
+      : index(std::make_unique<Index>(live + INDEX_BATCH)), ids(live) {
+    for (std::size_t i = 0; i < live; ++i) {
+      ids[i] = i + 1;
+      index->insert(ids[i], book::OrderHandle{nullptr, 0});
+    }
+    std::mt19937_64 rng(42);
+    std::shuffle(ids.begin(), ids.end(), rng);
+  }
+
+  std::unique_ptr<Index> index;
+  std::vector<uint64_t> ids;
+};
+
+/// Set manual iteration time from a steady_clock interval
+inline void set_time(benchmark::State &state,
+                     std::chrono::steady_clock::time_point start,
+                     std::chrono::steady_clock::time_point end) {
+  state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+}
+
+/// Per-operation latency counter shared by the index benchmarks
+inline void set_per_op(benchmark::State &state) {
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations() * INDEX_BATCH));
+  state.counters["per_op"] = benchmark::Counter(
+      static_cast<double>(INDEX_BATCH),
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+}
+
+/**
+ * @brief Look up random live IDs in an index holding state.range(0) orders.
+ */
+template <typename Index> static void BM_Index_Lookup(benchmark::State &state) {
+  IndexFixture<Index> fx(static_cast<std::size_t>(state.range(0)));
+  std::size_t cursor = 0;
+
+  for (auto _ : state) {
+    if (cursor + INDEX_BATCH > fx.ids.size()) {
+      cursor = 0;
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < INDEX_BATCH; ++i) {
+      benchmark::DoNotOptimize(fx.index->find(fx.ids[cursor + i]));
+    }
+    auto end = std::chrono::steady_clock::now();
+    set_time(state, start, end);
+    cursor += INDEX_BATCH;
+  }
+  set_per_op(state);
+}
+
+/**
+ * @brief Insert fresh IDs on top of state.range(0) live orders.
+ *
+ * New IDs continue the increasing ITCH order reference sequence; each batch
+ * is erased again (untimed) so the live count stays constant.
+ */
+template <typename Index> static void BM_Index_Insert(benchmark::State &state) {
+  const auto live = static_cast<std::size_t>(state.range(0));
+  IndexFixture<Index> fx(live);
+  uint64_t next_id = live + 1;
+
+  for (auto _ : state) {
+    const uint64_t first = next_id;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < INDEX_BATCH; ++i) {
+      benchmark::DoNotOptimize(
+          fx.index->insert(first + i, book::OrderHandle{nullptr, 0}));
+    }
+    auto end = std::chrono::steady_clock::now();
+    set_time(state, start, end);
+
+    for (std::size_t i = 0; i < INDEX_BATCH; ++i) {
+      fx.index->erase(first + i);
+    }
+    next_id += INDEX_BATCH;
+  }
+  set_per_op(state);
+}
+
+/**
+ * @brief Erase random live IDs from an index holding state.range(0) orders.
+ *
+ * Erased IDs are re-inserted (untimed) after each batch.
+ */
+template <typename Index> static void BM_Index_Erase(benchmark::State &state) {
+  IndexFixture<Index> fx(static_cast<std::size_t>(state.range(0)));
+  std::size_t cursor = 0;
+
+  for (auto _ : state) {
+    if (cursor + INDEX_BATCH > fx.ids.size()) {
+      cursor = 0;
+    }
+    const uint64_t *ids = fx.ids.data() + cursor;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < INDEX_BATCH; ++i) {
+      benchmark::DoNotOptimize(fx.index->erase(ids[i]));
+    }
+    auto end = std::chrono::steady_clock::now();
+    set_time(state, start, end);
+
+    for (std::size_t i = 0; i < INDEX_BATCH; ++i) {
+      fx.index->insert(ids[i], book::OrderHandle{nullptr, 0});
+    }
+    cursor += INDEX_BATCH;
+  }
+  set_per_op(state);
+}
+
+#define INDEX_BENCHMARK(func, index)                                           \
+  BENCHMARK_TEMPLATE(func, index)                                              \
+      ->Arg(1'000'000)                                                         \
+      ->Arg(10'000'000)                                                        \
+      ->UseManualTime()                                                        \
+      ->Unit(benchmark::kMicrosecond)
+
+INDEX_BENCHMARK(BM_Index_Lookup, FlatIndex);
+INDEX_BENCHMARK(BM_Index_Lookup, StdOrderIndex);
+INDEX_BENCHMARK(BM_Index_Insert, FlatIndex);
+INDEX_BENCHMARK(BM_Index_Insert, StdOrderIndex);
+INDEX_BENCHMARK(BM_Index_Erase, FlatIndex);
+INDEX_BENCHMARK(BM_Index_Erase, StdOrderIndex);
+
+// ============================================================================
+// Benchmark: Packed Order vs. CompactOrder layout (match and cancel)
+// ============================================================================
+
+/// Levels and orders per level in the layout benchmarks (64K live orders)
+constexpr uint64_t LAYOUT_LEVELS = 256;
+constexpr uint64_t LAYOUT_DEPTH = 256;
+
+/// Operations timed per layout benchmark iteration (< LAYOUT_DEPTH, so the
+/// best level never empties and only order records are measured)
+constexpr std::size_t LAYOUT_BATCH = 128;
+
+using PackedBook = book::OrderBook<BENCH_POOL_CAPACITY>;
+using CompactBook = book::CompactOrderBook<BENCH_POOL_CAPACITY>;
+
+/**
+ * @brief Bid book of LAYOUT_LEVELS x LAYOUT_DEPTH orders, added round-robin
+ *        across levels so queue neighbours are far apart in the pool.
+ */
+template <typename Book> struct LayoutFixture {
+  LayoutFixture()
+      : pool(std::make_unique<typename Book::PoolType>()),
+        book(std::make_unique<Book>(*pool)) {
+    for (uint64_t slot = 0; slot < LAYOUT_DEPTH; ++slot) {
+      for (uint64_t level = 0; level < LAYOUT_LEVELS; ++level) {
+        book->add_order(id(level, slot), level_price(level), 100,
+                        book::Side::Buy);
+      }
+    }
+  }
+
+  static constexpr uint64_t id(uint64_t level, uint64_t slot) {
+    return level * LAYOUT_DEPTH + slot + 1;
+  }
+
+  std::unique_ptr<typename Book::PoolType> pool;
+  std::unique_ptr<Book> book;
+};
+
+/**
+ * @brief Sell takers that each fill exactly the oldest order at the best
+ *        bid; filled orders are re-added at the back (untimed).
+ */
+template <typename Book> static void BM_Layout_Match(benchmark::State &state) {
+  LayoutFixture<Book> fx;
+  const uint64_t best = level_price(0);
+  uint64_t next_taker = LAYOUT_LEVELS * LAYOUT_DEPTH + 1;
+  std::vector<uint64_t> filled;
+  filled.reserve(LAYOUT_BATCH);
+  uint64_t front_slot = 0; // Queue position of the best level's oldest order
+
+  for (auto _ : state) {
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < LAYOUT_BATCH; ++i) {
+      benchmark::DoNotOptimize(
+          fx.book->add_order(next_taker++, best, 100, book::Side::Sell));
+    }
+    auto end = std::chrono::steady_clock::now();
+    state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+
+    // Restore depth: the filled makers rejoin at the back (untimed)
+    for (std::size_t i = 0; i < LAYOUT_BATCH; ++i) {
+      const uint64_t slot = (front_slot + i) % LAYOUT_DEPTH;
+      fx.book->add_order(LayoutFixture<Book>::id(0, slot), best, 100,
+                         book::Side::Buy);
+    }
+    front_slot = (front_slot + LAYOUT_BATCH) % LAYOUT_DEPTH;
+  }
+
+  if (fx.book->order_count() != LAYOUT_LEVELS * LAYOUT_DEPTH) {
+    state.SkipWithError("book depth drifted");
+  }
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations() * LAYOUT_BATCH));
+  state.counters["per_match"] = benchmark::Counter(
+      static_cast<double>(LAYOUT_BATCH),
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+}
+
+/**
+ * @brief Cancel random resting orders; each is re-added (untimed).
+ */
+template <typename Book> static void BM_Layout_Cancel(benchmark::State &state) {
+  LayoutFixture<Book> fx;
+  std::vector<uint64_t> ids(LAYOUT_LEVELS * LAYOUT_DEPTH);
+  for (uint64_t i = 0; i < ids.size(); ++i) {
+    ids[i] = i + 1;
+  }
+  std::mt19937_64 rng(42);
+  std::shuffle(ids.begin(), ids.end(), rng);
+  std::size_t cursor = 0;
+
+  for (auto _ : state) {
+    if (cursor + LAYOUT_BATCH > ids.size()) {
+      cursor = 0;
+    }
+    const uint64_t *batch = ids.data() + cursor;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < LAYOUT_BATCH; ++i) {
+      benchmark::DoNotOptimize(fx.book->cancel_order(batch[i]));
+    }
+    auto end = std::chrono::steady_clock::now();
+    state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+
+    for (std::size_t i = 0; i < LAYOUT_BATCH; ++i) {
+      const uint64_t level = (batch[i] - 1) / LAYOUT_DEPTH;
+      fx.book->add_order(batch[i], level_price(level), 100, book::Side::Buy);
+    }
+    cursor += LAYOUT_BATCH;
+  }
+
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations() * LAYOUT_BATCH));
+  state.counters["per_cancel"] = benchmark::Counter(
+      static_cast<double>(LAYOUT_BATCH),
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+}
+
+BENCHMARK_TEMPLATE(BM_Layout_Match, PackedBook)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_Layout_Match, CompactBook)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_Layout_Cancel, PackedBook)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_Layout_Cancel, CompactBook)->UseManualTime();
+
+// ============================================================================
+// Benchmark: IntrusiveList vs. IndexedIntrusiveList
+// ============================================================================
+
+/// Queues and elements per queue in the list benchmarks (64K elements)
+constexpr uint32_t LIST_QUEUES = 256;
+constexpr uint32_t LIST_DEPTH = 256;
+constexpr std::size_t LIST_ELEMENTS = std::size_t{LIST_QUEUES} * LIST_DEPTH;
+
+/// Remove/re-append pairs timed per list benchmark iteration
+constexpr std::size_t LIST_BATCH = 1024;
+
+/// Levels in the level store shift benchmark (orders per level as above)
+constexpr uint64_t SHIFT_LEVELS = 256;
+
+/// Pointer-linked queue element (16 bytes of links)
+struct PointerElement : book::IntrusiveNode {
+  uint64_t id = 0;
+  uint32_t qty = 0;
+  uint32_t queue = 0;
+};
+
+/// Index-linked queue element (8 bytes of links)
+struct IndexElement : book::IndexedNode {
+  uint64_t id = 0;
+  uint32_t qty = 0;
+  uint32_t queue = 0;
+};
+
+struct PointerLinks {
+  using Element = PointerElement;
+  using Pool = book::MemPool<Element, LIST_ELEMENTS>;
+  using List = book::IntrusiveList<Element>;
+};
+
+struct IndexLinks {
+  using Element = IndexElement;
+  using Pool = book::MemPool<Element, LIST_ELEMENTS>;
+  using List = book::IndexedIntrusiveList<Element, Pool>;
+};
+
+/// Construct an empty list of either kind over `pool`
+template <typename List, typename Pool> List make_list(Pool &pool) {
+  if constexpr (std::is_constructible_v<List, Pool &>) {
+    return List(pool);
+  } else {
+    (void)pool;
+    return List();
+  }
+}
+
+/**
+ * @brief LIST_QUEUES queues of LIST_DEPTH pool elements, filled round-robin
+ *        so neighbours in a queue are LIST_QUEUES slots apart.
+ */
+template <typename Links> struct ListFixture {
+  using Element = typename Links::Element;
+  using List = typename Links::List;
+
+  ListFixture() : pool(std::make_unique<typename Links::Pool>()) {
+    queues.reserve(LIST_QUEUES);
+    for (uint32_t q = 0; q < LIST_QUEUES; ++q) {
+      queues.push_back(make_list<List>(*pool));
+    }
+    for (uint32_t slot = 0; slot < LIST_DEPTH; ++slot) {
+      for (uint32_t q = 0; q < LIST_QUEUES; ++q) {
+        Element *elem = pool->allocate();
+        elem->id = elements.size() + 1;
+        elem->qty = 100;
+        elem->queue = q;
+        queues[q].push_back(elem);
+        elements.push_back(elem);
+      }
+    }
+  }
+
+  ~ListFixture() {
+    for (List &queue : queues) {
+      queue.clear();
+    }
+  }
+
+  std::unique_ptr<typename Links::Pool> pool;
+  std::vector<List> queues;
+  std::vector<Element *> elements;
+};
+
+/**
+ * @brief Remove a random element and re-append it to its queue (the
+ *        cancel / re-add pattern of a busy level).
+ */
+template <typename Links> static void BM_List_Churn(benchmark::State &state) {
+  ListFixture<Links> fx;
+  std::vector<typename Links::Element *> order = fx.elements;
+  std::mt19937_64 rng(42);
+  std::shuffle(order.begin(), order.end(), rng);
+  std::size_t cursor = 0;
+
+  for (auto _ : state) {
+    if (cursor + LIST_BATCH > order.size()) {
+      cursor = 0;
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < LIST_BATCH; ++i) {
+      auto *elem = order[cursor + i];
+      auto &queue = fx.queues[elem->queue];
+      queue.remove(elem);
+      queue.push_back(elem);
+    }
+    auto end = std::chrono::steady_clock::now();
+    set_time(state, start, end);
+    cursor += LIST_BATCH;
+  }
+
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations() * LIST_BATCH));
+  state.counters["per_op"] = benchmark::Counter(
+      static_cast<double>(LIST_BATCH),
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+}
+
+/**
+ * @brief Walk every queue front to back, summing quantities.
+ */
+template <typename Links> static void BM_List_Walk(benchmark::State &state) {
+  ListFixture<Links> fx;
+
+  for (auto _ : state) {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t total = 0;
+    for (const auto &queue : fx.queues) {
+      for (const auto &elem : queue) {
+        total += elem.qty;
+      }
+    }
+    benchmark::DoNotOptimize(total);
+    auto end = std::chrono::steady_clock::now();
+    set_time(state, start, end);
+  }
+
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations() * LIST_ELEMENTS));
+  state.counters["per_elem"] = benchmark::Counter(
+      static_cast<double>(LIST_ELEMENTS),
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+}
+
+BENCHMARK_TEMPLATE(BM_List_Churn, PointerLinks)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_List_Churn, IndexLinks)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_List_Walk, PointerLinks)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_List_Walk, IndexLinks)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+/// PriceLevel: pointer-linked queue, moves re-link the sentinel
+struct PointerLevels {
+  using Pool = BenchPool;
+  using Level = book::PriceLevel;
+  static Level make(Pool &, uint64_t price) { return Level(price); }
+};
+
+/// CompactOrderBook level: index-linked queue, trivially copyable
+struct IndexLevels {
+  using Pool = CompactBook::PoolType;
+  using Level = CompactBook::LevelType;
+  static Level make(Pool &pool, uint64_t price) {
+    return Level(pool, price, book::Side::Buy);
+  }
+};
+
+/**
+ * @brief Insert a new best level at the front of a sorted level vector
+ *        and erase it again - every resting level shifts twice.
+ *
+ * This is the overflow-vector insert of LadderOrderBook; index-linked
+ * levels shift with memmove, pointer-linked ones element by element.
+ */
+template <typename Levels>
+static void BM_LevelStore_Shift(benchmark::State &state) {
+  auto pool = std::make_unique<typename Levels::Pool>();
+  std::vector<typename Levels::Level> levels;
+  levels.reserve(SHIFT_LEVELS + 1);
+  for (uint64_t level = 0; level < SHIFT_LEVELS; ++level) {
+    levels.push_back(Levels::make(*pool, level_price(level)));
+    for (uint64_t slot = 0; slot < ORDERS_PER_LEVEL; ++slot) {
+      auto *order = pool->allocate();
+      order->qty = 100;
+      levels.back().orders.push_back(order);
+    }
+  }
+
+  for (auto _ : state) {
+    auto start = std::chrono::steady_clock::now();
+    levels.insert(levels.begin(), Levels::make(*pool, level_price(0) + 100));
+    levels.erase(levels.begin());
+    benchmark::ClobberMemory();
+    auto end = std::chrono::steady_clock::now();
+    set_time(state, start, end);
+  }
+
+  if (levels.front().orders.size() != ORDERS_PER_LEVEL) {
+    state.SkipWithError("level queue lost on shift");
+  }
+  for (auto &level : levels) {
+    level.orders.clear();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK_TEMPLATE(BM_LevelStore_Shift, PointerLevels)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_LevelStore_Shift, IndexLevels)->UseManualTime();
+
+// ============================================================================
+// Benchmark: Market-by-order event application
+// ============================================================================
+
+/// Symbols the synthetic feed is spread across
+constexpr uint16_t MBO_SYMBOLS = 64;
+
+/// Orders per synthetic feed pass (each yields A, E, X, U, D)
+constexpr uint64_t MBO_ORDERS = 16'384;
+
+/// Orders live at once: adds run this far ahead of their later events
+constexpr uint64_t MBO_LIVE_WINDOW = 4'096;
+
+/**
+ * @brief Pre-encoded ITCH order events (length-delimited, zero-copy parse).
+ */
+struct MboFeed {
+  std::vector<char> bytes;
+  std::vector<uint32_t> offsets; ///< Start of each message; last = end
+
+  std::size_t message_count() const { return offsets.size() - 1; }
+
+  char *begin_message(char type, uint16_t locate) {
+    const std::size_t at = bytes.size();
+    offsets.back() = static_cast<uint32_t>(at);
+    bytes.resize(at + itch::get_message_size(type), 0);
+    offsets.push_back(static_cast<uint32_t>(bytes.size()));
+    char *msg = bytes.data() + at;
+    msg[0] = type;
+    put_be(msg + 1, locate, 2);
+    return msg;
+  }
+};
+
+/**
+ * @brief Build a self-cancelling feed: every order is added, executed,
+ *        partially cancelled, replaced and finally deleted, so the books
+ *        are empty again after each pass.
+ */
+MboFeed build_mbo_feed() {
+  MboFeed feed;
+  feed.offsets.push_back(0);
+
+  auto locate_of = [](uint64_t i) {
+    return static_cast<uint16_t>(1 + i % MBO_SYMBOLS);
+  };
+  auto price_of = [](uint64_t i, bool buy) {
+    const uint64_t offset = (i * 7 % 50) * 100;
+    return static_cast<uint32_t>(buy ? 1'000'000 - 100 - offset
+                                     : 1'000'000 + 100 + offset);
+  };
+
+  auto lifecycle = [&](uint64_t i) {
+    const uint16_t locate = locate_of(i);
+    const uint64_t ref = i + 1;
+    const uint64_t new_ref = ref + MBO_ORDERS;
+    const bool buy = (i & 1) == 0;
+
+    char *e = feed.begin_message('E', locate);
+    put_be(e + 11, ref, 8);
+    put_be(e + 19, 30, 4);
+
+    char *x = feed.begin_message('X', locate);
+    put_be(x + 11, ref, 8);
+    put_be(x + 19, 20, 4);
+
+    char *u = feed.begin_message('U', locate);
+    put_be(u + 11, ref, 8);
+    put_be(u + 19, new_ref, 8);
+    put_be(u + 27, 100, 4);
+    put_be(u + 31, price_of(i + 3, buy), 4);
+
+    char *d = feed.begin_message('D', locate);
+    put_be(d + 11, new_ref, 8);
+  };
+
+  for (uint64_t i = 0; i < MBO_ORDERS; ++i) {
+    const bool buy = (i & 1) == 0;
+    char *a = feed.begin_message('A', locate_of(i));
+    put_be(a + 11, i + 1, 8);
+    a[19] = buy ? 'B' : 'S';
+    put_be(a + 20, 100, 4);
+    put_be(a + 32, price_of(i, buy), 4);
+
+    if (i >= MBO_LIVE_WINDOW) {
+      lifecycle(i - MBO_LIVE_WINDOW);
+    }
+  }
+  for (uint64_t i = MBO_ORDERS - MBO_LIVE_WINDOW; i < MBO_ORDERS; ++i) {
+    lifecycle(i);
+  }
+  return feed;
+}
+
+/**
+ * @brief Parse and apply a market-by-order feed pass; reports ns/message.
+ *
+ * Books are created before timing (first pass, untimed), so iterations
+ * measure steady-state event application without allocation.
+ */
+template <typename Book>
+static void BM_MarketByOrder_Apply(benchmark::State &state) {
+  static const MboFeed feed = build_mbo_feed();
+  const std::size_t messages = feed.message_count();
+
+  auto pool = std::make_unique<typename Book::PoolType>();
+  book::BookManager<Book> books(*pool);
+  book::MarketByOrderVisitor<Book> visitor(books);
+  itch::Parser parser;
+
+  auto apply_pass = [&] {
+    for (std::size_t i = 0; i < messages; ++i) {
+      const uint32_t at = feed.offsets[i];
+      (void)parser.parse(feed.bytes.data() + at, feed.offsets[i + 1] - at,
+                         visitor);
+    }
+  };
+  apply_pass(); // Warm-up: creates books and grows their indexes
+
+  for (auto _ : state) {
+    auto start = std::chrono::steady_clock::now();
+    apply_pass();
+    auto end = std::chrono::steady_clock::now();
+    state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+  }
+
+  if (visitor.stats().unknown != 0 || books.order_count() != 0) {
+    state.SkipWithError("feed did not apply cleanly");
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages));
+  state.counters["per_msg"] = benchmark::Counter(
+      static_cast<double>(messages),
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+}
+
+using MboVectorBook = book::OrderBook<BENCH_POOL_CAPACITY>;
+using MboLadderBook = book::LadderOrderBook<BENCH_POOL_CAPACITY, 1024>;
+
+BENCHMARK_TEMPLATE(BM_MarketByOrder_Apply, MboVectorBook)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_MarketByOrder_Apply, MboLadderBook)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+} // anonymous namespace
@@ -0,0 +1,229 @@
+/**
+ * @file column_bench.cpp
+ * @brief Columnar extraction (the core of the Python module's
+ *        parse_file()): reserved vs. growing columns, and the cost of
+ *        exporting the columns by copy instead of handing them over.
+ *
+ * METHODOLOGY:
+ * 1. Input is $CHRONOS_BENCH_PCAP when set (e.g. the stress capture),
+ *    otherwise a generated 256 MB capture of AddOrder and OrderExecuted
+ *    messages in /tmp.
+ * 2. The capture stays in the page cache, so a pass measures parsing and
+ *    column writes, not storage.
+ * 3. One whole-file parse into fresh columns per iteration.
+ * 4. peak_rss_mb is VmHWM above the pre-pass RSS, with the high-water mark
+ *    reset (/proc/self/clear_refs) before each pass. It includes the
+ *    mapped capture pages, which every variant touches alike.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include <itch/column_accumulator.hpp>
+
+#include "test_files.hpp"
+
+namespace {
+
+/// Generated capture used when $CHRONOS_BENCH_PCAP is not set
+constexpr const char *GENERATED_PCAP = "/tmp/chronos_column_bench.pcap";
+constexpr std::size_t GENERATED_BYTES = std::size_t{256} << 20;
+
+/// Messages per generated packet (12 AddOrder, 8 OrderExecuted)
+constexpr std::size_t GENERATED_ADDS = 12;
+constexpr std::size_t GENERATED_EXECS = 8;
+
+/**
+ * @brief Write the generated capture once (reused by later runs).
+ */
+bool write_generated_pcap() {
+  struct stat st;
+  if (::stat(GENERATED_PCAP, &st) == 0 &&
+      static_cast<std::size_t>(st.st_size) >= GENERATED_BYTES) {
+    return true;
+  }
+  std::FILE *out = std::fopen(GENERATED_PCAP, "wb");
+  if (out == nullptr) {
+    return false;
+  }
+
+  using itch::test::put_be;
+  itch::test::PcapBuilder pcap;
+  std::vector<std::vector<unsigned char>> messages(GENERATED_ADDS +
+                                                   GENERATED_EXECS);
+  uint64_t sequence = 1;
+  uint64_t ref = 1;
+  uint64_t ts = 34'200'000'000'000;
+  bool ok = true;
+  while (ok && pcap.total_bytes() < GENERATED_BYTES) {
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+      const bool add = i < GENERATED_ADDS;
+      std::vector<unsigned char> &msg = messages[i];
+      msg.assign(add ? sizeof(itch::AddOrder) : sizeof(itch::OrderExecuted),
+                 0);
+      msg[0] = add ? itch::msg_type::AddOrder : itch::msg_type::OrderExecuted;
+      put_be(&msg[1], 1 + ref % 8000, 2);
+      put_be(&msg[5], ts += 50, 6);
+      put_be(&msg[11], add ? ref++ : ref - 1 - i, 8);
+      if (add) {
+        msg[19] = (ref & 1) != 0 ? 'B' : 'S';
+        put_be(&msg[20], 100, 4);
+        std::memcpy(&msg[24], "BENCH   ", 8);
+        put_be(&msg[32], 1'000'000 + ref % 1000, 4);
+      } else {
+        put_be(&msg[19], 10, 4);
+        put_be(&msg[23], ref, 8);
+      }
+    }
+    pcap.packet(itch::test::mold_udp_frame("BENCH00001", sequence, messages));
+    sequence += messages.size();
+    if (pcap.bytes().size() >= (std::size_t{1} << 20)) {
+      ok = pcap.flush(out);
+    }
+  }
+  ok = ok && pcap.flush(out);
+  return std::fclose(out) == 0 && ok;
+}
+
+/**
+ * @brief Capture to parse: $CHRONOS_BENCH_PCAP or the generated file.
+ */
+const char *bench_pcap() {
+  static const char *path = [] {
+    const char *env = std::getenv("CHRONOS_BENCH_PCAP");
+    if (env != nullptr && env[0] != '\0') {
+      return env;
+    }
+    return write_generated_pcap() ? GENERATED_PCAP : "";
+  }();
+  return path;
+}
+
+/**
+ * @brief A /proc/self/status field in bytes (0 if unavailable).
+ */
+std::size_t status_bytes(const char *field) {
+  std::FILE *status = std::fopen("/proc/self/status", "r");
+  if (status == nullptr) {
+    return 0;
+  }
+  char line[256];
+  std::size_t kb = 0;
+  const std::size_t field_len = std::strlen(field);
+  while (std::fgets(line, sizeof(line), status) != nullptr) {
+    if (std::strncmp(line, field, field_len) == 0) {
+      kb = std::strtoull(line + field_len, nullptr, 10);
+      break;
+    }
+  }
+  std::fclose(status);
+  return kb << 10;
+}
+
+/**
+ * @brief Reset the peak RSS (VmHWM) to the current RSS.
+ */
+void reset_peak_rss() {
+  std::FILE *clear_refs = std::fopen("/proc/self/clear_refs", "w");
+  if (clear_refs != nullptr) {
+    std::fputs("5", clear_refs);
+    std::fclose(clear_refs);
+  }
+}
+
+/// How a pass treats its columns
+enum class Export : int64_t {
+  Grow = 0,    ///< No reservation: columns reallocate as they fill
+  Reserve = 1, ///< reserve_for() the file, then hand the columns over
+  Copy = 2,    ///< Reserve, then copy every column out (export by copy)
+};
+
+// ============================================================================
+// Benchmark: Whole-file parse into columns
+// ============================================================================
+
+/**
+ * @brief Parse the capture into fresh columns once per iteration.
+ *
+ * state.range(0) is the Export mode.
+ */
+static void BM_ColumnParse(benchmark::State &state) {
+  const auto mode = static_cast<Export>(state.range(0));
+  const itch::PcapReader reader(bench_pcap());
+  if (!reader.is_open()) {
+    state.SkipWithError("cannot open capture");
+    return;
+  }
+  // Fault the capture in once so every pass starts warm
+  (void)reader.for_each_packet([](const char *, std::size_t) {});
+
+  std::size_t rows = 0;
+  std::size_t column_bytes = 0;
+  std::size_t peak_rss = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    reset_peak_rss();
+    const std::size_t baseline = status_bytes("VmRSS:");
+    state.ResumeTiming();
+
+    itch::ColumnAccumulator acc;
+    if (mode != Export::Grow) {
+      acc.reserve_for(reader.file_size());
+    }
+    (void)itch::parse_packets(reader, 0, reader.file_size(), acc);
+
+    rows = acc.add_order_refs.size() + acc.exec_order_refs.size();
+    column_bytes = 0;
+    const auto measure = [&](const char *, const auto &column) {
+      column_bytes += column.size() * sizeof(column[0]);
+    };
+    acc.visit_add_columns(measure);
+    acc.visit_exec_columns(measure);
+
+    // Held until the pass ends, as the NumPy copies would be
+    std::vector<std::vector<char>> copies;
+    if (mode == Export::Copy) {
+      const auto copy_out = [&](const char *, const auto &column) {
+        std::vector<char> &copy = copies.emplace_back(column.size() *
+                                                      sizeof(column[0]));
+        std::memcpy(copy.data(), column.data(), copy.size());
+        benchmark::DoNotOptimize(copy.data());
+      };
+      acc.visit_add_columns(copy_out);
+      acc.visit_exec_columns(copy_out);
+    }
+    benchmark::DoNotOptimize(acc.add_order_refs.data());
+
+    state.PauseTiming();
+    peak_rss = std::max(peak_rss, status_bytes("VmHWM:") - baseline);
+    state.ResumeTiming();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(reader.file_size()));
+  state.counters["rows"] = static_cast<double>(rows);
+  state.counters["column_mb"] =
+      static_cast<double>(column_bytes) / (1024.0 * 1024.0);
+  state.counters["peak_rss_mb"] =
+      static_cast<double>(peak_rss) / (1024.0 * 1024.0);
+  static const char *const kLabels[] = {"grow", "reserve", "copy out"};
+  state.SetLabel(kLabels[state.range(0)]);
+}
+
+BENCHMARK(BM_ColumnParse)
+    ->Arg(static_cast<int64_t>(Export::Grow))
+    ->Arg(static_cast<int64_t>(Export::Reserve))
+    ->Arg(static_cast<int64_t>(Export::Copy))
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include <itch/compat.hpp>
+#include <itch/line_arbitrator.hpp>
 #include <itch/messages.hpp>
 #include <itch/parser.hpp>
 
@@ -39,7 +40,7 @@ std::vector<char> create_add_order_message() {
 
   // Stock locate = 1234 (big-endian) at offset 1
   buffer[1] = 0x04;
-  buffer[2] = 0xD2;
+  buffer[2] = static_cast<char>(0xD2);
 
   // Tracking number = 5678 (big-endian) at offset 3
   buffer[3] = 0x16;
@@ -351,4 +352,103 @@ static void BM_RawPointerAccess(benchmark::State &state) {
 }
 BENCHMARK(BM_RawPointerAccess)->Unit(benchmark::kNanosecond);
 
+// ============================================================================
+// Benchmark 5: A/B Line Arbitration
+// ============================================================================
+
+/// Messages per synthetic MoldUDP64 packet in the arbitration benchmarks
+constexpr uint64_t kArbPacketSize = 8;
+constexpr uint64_t kArbPackets = 4096;
+
+/// Parses every delivered message; counts gaps
+struct ArbParseHandler {
+  const itch::Parser &parser;
+  uint64_t shares = 0;
+  uint64_t gaps = 0;
+
+  struct Visitor : itch::DefaultVisitor {
+    uint64_t *shares;
+    void on_add_order(const itch::AddOrder &msg) { *shares += msg.shares; }
+  };
+
+  void on_message(const char *msg, size_t len, uint64_t /*sequence*/) {
+    Visitor visitor;
+    visitor.shares = &shares;
+    (void)parser.parse(msg, len, visitor);
+  }
+  void on_gap(uint64_t /*first*/, uint64_t /*count*/) { ++gaps; }
+};
+
+/**
+ * @brief Baseline: one line, every message parsed as it arrives.
+ */
+static void BM_LineSingle(benchmark::State &state) {
+  const char *msg = g_add_order_msg.data();
+  const size_t len = g_add_order_msg.size();
+  itch::Parser parser;
+
+  for (auto _ : state) {
+    ArbParseHandler handler{parser};
+    for (uint64_t seq = 1; seq <= kArbPackets * kArbPacketSize; ++seq) {
+      handler.on_message(msg, len, seq);
+    }
+    benchmark::DoNotOptimize(handler.shares);
+  }
+
+  state.SetItemsProcessed(state.iterations() * kArbPackets * kArbPacketSize);
+}
+BENCHMARK(BM_LineSingle)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Two redundant lines through LineArbitrator.
+ *
+ * Line B trails A by one packet; A loses one packet in every `range(0)`
+ * (0 = lossless), which B then fills. Items are unique messages delivered,
+ * so the rate is directly comparable with BM_LineSingle.
+ */
+static void BM_LineArbitrated(benchmark::State &state) {
+  const char *msg = g_add_order_msg.data();
+  const size_t len = g_add_order_msg.size();
+  const auto loss_interval = static_cast<uint64_t>(state.range(0));
+  itch::Parser parser;
+
+  auto offer_packet = [&](auto &arb, itch::Line line, uint64_t packet,
+                          ArbParseHandler &handler) {
+    const uint64_t first = 1 + packet * kArbPacketSize;
+    for (uint64_t i = 0; i < kArbPacketSize; ++i) {
+      arb.offer(line, first + i, msg, len, handler);
+    }
+    arb.observe(line, first + kArbPacketSize);
+    arb.resolve(handler);
+  };
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    itch::LineArbitrator<4096> arb;
+    ArbParseHandler handler{parser};
+    state.ResumeTiming();
+
+    for (uint64_t p = 0; p < kArbPackets; ++p) {
+      if (loss_interval == 0 || p % loss_interval != 0) {
+        offer_packet(arb, itch::Line::A, p, handler);
+      }
+      if (p > 0) {
+        offer_packet(arb, itch::Line::B, p - 1, handler);
+      }
+    }
+    offer_packet(arb, itch::Line::B, kArbPackets - 1, handler);
+    arb.flush(handler);
+
+    benchmark::DoNotOptimize(handler.shares);
+    benchmark::DoNotOptimize(arb.stats().delivered);
+  }
+
+  state.SetItemsProcessed(state.iterations() * kArbPackets * kArbPacketSize);
+}
+BENCHMARK(BM_LineArbitrated)
+    ->Arg(0)    // Lossless: B is pure duplicates
+    ->Arg(100)  // A drops 1% of packets
+    ->Arg(10)   // A drops 10% of packets
+    ->Unit(benchmark::kMicrosecond);
+
 } // anonymous namespace
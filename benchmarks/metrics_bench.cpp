@@ -0,0 +1,77 @@
+/**
+ * @file metrics_bench.cpp
+ * @brief Cost of the latency instrumentation used by chronos_replay.
+ *
+ * METHODOLOGY:
+ * 1. Timestamp pair: the two clock reads that bracket one measured
+ *    operation, for high_resolution_clock and for the TSC.
+ * 2. Record: one LatencyRecorder start/stop (two TSC reads plus the
+ *    histogram update), over a spread of values so buckets vary.
+ * 3. Disabled: the same calls on LatencyRecorder<false> (should be ~0).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+
+#include <metrics/latency_histogram.hpp>
+#include <metrics/tsc_clock.hpp>
+
+namespace {
+
+/**
+ * @brief Two high_resolution_clock reads (the replay's old timing).
+ */
+static void BM_TimestampPair_Chrono(benchmark::State &state) {
+  for (auto _ : state) {
+    auto start = std::chrono::high_resolution_clock::now();
+    auto end = std::chrono::high_resolution_clock::now();
+    benchmark::DoNotOptimize(end - start);
+  }
+}
+BENCHMARK(BM_TimestampPair_Chrono);
+
+/**
+ * @brief Two fenced TSC reads.
+ */
+static void BM_TimestampPair_Tsc(benchmark::State &state) {
+  for (auto _ : state) {
+    const uint64_t start = metrics::TscClock::now();
+    const uint64_t end = metrics::TscClock::now();
+    benchmark::DoNotOptimize(end - start);
+  }
+}
+BENCHMARK(BM_TimestampPair_Tsc);
+
+/**
+ * @brief Histogram update alone, values spread over 64..64K ticks.
+ */
+static void BM_Histogram_Record(benchmark::State &state) {
+  metrics::LatencyHistogram<> histogram;
+  uint64_t value = 64;
+  for (auto _ : state) {
+    histogram.record(value);
+    value = value < 65536 ? value * 3 / 2 : 64;
+  }
+  benchmark::DoNotOptimize(histogram.count());
+}
+BENCHMARK(BM_Histogram_Record);
+
+/**
+ * @brief Full per-message cost: start, stop and record under one type.
+ */
+template <bool Enabled>
+static void BM_LatencyRecorder_StartStop(benchmark::State &state) {
+  metrics::LatencyRecorder<Enabled> recorder;
+  for (auto _ : state) {
+    const uint64_t start = recorder.start();
+    recorder.stop('A', start);
+  }
+  benchmark::DoNotOptimize(&recorder);
+  state.SetLabel(Enabled ? "enabled" : "compiled out");
+}
+BENCHMARK_TEMPLATE(BM_LatencyRecorder_StartStop, true);
+BENCHMARK_TEMPLATE(BM_LatencyRecorder_StartStop, false);
+
+} // namespace
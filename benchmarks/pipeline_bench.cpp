@@ -0,0 +1,254 @@
+/**
+ * @file pipeline_bench.cpp
+ * @brief Two-thread benchmarks for the SPSC ring used by the sharded replay.
+ *
+ * METHODOLOGY:
+ * 1. The benchmark thread and one peer thread are pinned to CPUs 0 and 1
+ *    when the machine has two (label reports "unpinned" otherwise; on a
+ *    single core the numbers measure scheduler handoff, not the ring).
+ * 2. Round trip: ping on one ring, echo on a second, time until the echo
+ *    returns - one cache-line transfer each way.
+ * 3. Throughput: the peer produces a fixed stream, the benchmark thread
+ *    consumes it; batch size sets how many elements share one publish
+ *    and one release.
+ * 4. Payloads: MessageView (pointer into the mapped capture, 16 bytes) and
+ *    a compact decoded order event (32 bytes).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include <pipeline/sharded_pipeline.hpp>
+#include <pipeline/spsc_ring.hpp>
+
+namespace {
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+/// Slots per ring (as in the sharded replay)
+constexpr std::size_t BENCH_RING_CAPACITY = 65536;
+
+/// Elements moved per throughput iteration
+constexpr uint64_t STREAM_LENGTH = 1 << 20;
+
+/// Largest batch the benchmarks stage on either side
+constexpr std::size_t MAX_BATCH = 256;
+
+/**
+ * @brief Decoded order event: the alternative payload to a raw view.
+ *
+ * Everything the market-by-order book needs from A/F/E/C/X/D/U, so a
+ * worker would never touch the capture bytes.
+ */
+struct alignas(32) OrderEvent {
+  uint64_t order_ref = 0;
+  uint64_t new_order_ref = 0; ///< U only
+  uint32_t shares = 0;
+  uint32_t price = 0;
+  uint16_t stock_locate = 0;
+  char type = 0;
+  char side = 0;
+};
+static_assert(sizeof(OrderEvent) == 32);
+
+/// Fill `value` so the i-th element is distinguishable
+void make_payload(pipeline::MessageView &value, uint64_t i) {
+  value.data = reinterpret_cast<const char *>(i + 1);
+  value.len = 36;
+}
+
+void make_payload(OrderEvent &value, uint64_t i) {
+  value.order_ref = i + 1;
+  value.shares = 100;
+  value.type = 'A';
+}
+
+/// Read a field the consumer would need, so the load is not elided
+uint64_t touch(const pipeline::MessageView &value) {
+  return static_cast<uint64_t>(value.len);
+}
+
+uint64_t touch(const OrderEvent &value) { return value.order_ref; }
+
+/// Pin the calling thread when the machine has enough CPUs
+bool pin_if_possible(unsigned cpu) {
+  return std::thread::hardware_concurrency() > 1 &&
+         pipeline::pin_current_thread(cpu);
+}
+
+void wait(uint32_t &spins) {
+  if (++spins < 64) {
+    pipeline::cpu_relax();
+  } else {
+    std::this_thread::yield();
+  }
+}
+
+// ============================================================================
+// Benchmark: Round-trip latency (ping / echo)
+// ============================================================================
+
+/**
+ * @brief One element to the echo thread and back per iteration.
+ */
+void BM_SpscRing_RoundTrip(benchmark::State &state) {
+  using Ring = pipeline::SpscRing<uint64_t, 1024>;
+  auto ping = std::make_unique<Ring>();
+  auto pong = std::make_unique<Ring>();
+  std::atomic<bool> running{true};
+
+  std::thread echo([&] {
+    (void)pin_if_possible(1);
+    uint64_t value = 0;
+    uint32_t spins = 0;
+    while (running.load(std::memory_order_relaxed)) {
+      if (!ping->try_pop(value)) {
+        wait(spins);
+        continue;
+      }
+      spins = 0;
+      while (!pong->try_push(value)) {
+        wait(spins);
+      }
+    }
+  });
+  const bool pinned = pin_if_possible(0);
+
+  uint64_t sequence = 0;
+  for (auto _ : state) {
+    uint32_t spins = 0;
+    while (!ping->try_push(sequence)) {
+      wait(spins);
+    }
+    uint64_t reply = 0;
+    while (!pong->try_pop(reply)) {
+      wait(spins);
+    }
+    benchmark::DoNotOptimize(reply);
+    ++sequence;
+  }
+
+  running.store(false, std::memory_order_relaxed);
+  echo.join();
+  state.SetLabel(pinned ? "pinned" : "unpinned");
+}
+BENCHMARK(BM_SpscRing_RoundTrip)->Unit(benchmark::kNanosecond);
+
+// ============================================================================
+// Benchmark: Throughput vs. batch size
+// ============================================================================
+
+/**
+ * @brief Stream STREAM_LENGTH elements from a producer thread.
+ *
+ * Arg: batch size (1 = try_push / try_pop per element, otherwise
+ * try_push_n / consume of up to that many).
+ */
+template <typename Payload>
+void BM_SpscRing_Throughput(benchmark::State &state) {
+  using Ring = pipeline::SpscRing<Payload, BENCH_RING_CAPACITY>;
+  const std::size_t batch = static_cast<std::size_t>(state.range(0));
+  const bool pinned = pin_if_possible(0);
+
+  for (auto _ : state) {
+    auto ring = std::make_unique<Ring>();
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    std::thread producer([&] {
+      (void)pin_if_possible(1);
+      std::array<Payload, MAX_BATCH> staged{};
+      uint32_t spins = 0;
+      for (uint64_t i = 0; i < STREAM_LENGTH;) {
+        if (batch == 1) {
+          Payload value{};
+          make_payload(value, i);
+          while (!ring->try_push(value)) {
+            wait(spins);
+          }
+          ++i;
+          continue;
+        }
+        const std::size_t n =
+            std::min<uint64_t>(batch, STREAM_LENGTH - i);
+        for (std::size_t k = 0; k < n; ++k) {
+          make_payload(staged[k], i + k);
+        }
+        std::size_t sent = 0;
+        while (sent < n) {
+          const std::size_t pushed =
+              ring->try_push_n(staged.data() + sent, n - sent);
+          if (pushed == 0) {
+            wait(spins);
+          }
+          sent += pushed;
+        }
+        i += n;
+      }
+    });
+
+    uint64_t received = 0;
+    uint64_t checksum = 0;
+    uint32_t spins = 0;
+    while (received < STREAM_LENGTH) {
+      std::size_t n = 0;
+      if (batch == 1) {
+        Payload value;
+        if (ring->try_pop(value)) {
+          checksum += touch(value);
+          n = 1;
+        }
+      } else {
+        n = ring->consume(
+            [&](const Payload &value) { checksum += touch(value); }, batch);
+      }
+      if (n == 0) {
+        wait(spins);
+      }
+      received += n;
+    }
+    producer.join();
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    benchmark::DoNotOptimize(checksum);
+    state.SetIterationTime(
+        std::chrono::duration<double>(end - start).count());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(STREAM_LENGTH));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(STREAM_LENGTH) *
+                          static_cast<int64_t>(sizeof(Payload)));
+  state.counters["per_msg"] = benchmark::Counter(
+      static_cast<double>(STREAM_LENGTH),
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+  state.SetLabel(pinned ? "pinned" : "unpinned");
+}
+
+using ViewPayload = pipeline::MessageView;
+BENCHMARK_TEMPLATE(BM_SpscRing_Throughput, ViewPayload)
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(256)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SpscRing_Throughput, OrderEvent)
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(256)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
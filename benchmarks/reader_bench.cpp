@@ -0,0 +1,231 @@
+/**
+ * @file reader_bench.cpp
+ * @brief PCAP read throughput and memory footprint: whole-file mmap,
+ *        sliding windows and io_uring block reads.
+ *
+ * METHODOLOGY:
+ * 1. Input is $CHRONOS_BENCH_PCAP when set (e.g. a 20 GB capture),
+ *    otherwise a generated 256 MB capture of 1400-byte packets in /tmp.
+ * 2. The file is evicted from the page cache before every pass (untimed),
+ *    so each pass reads from storage, as a capture larger than RAM must.
+ * 3. One pass per iteration; the first and last byte of every payload are
+ *    read.
+ * 4. peak_rss_mb is the highest RSS above the pre-pass baseline, sampled
+ *    from /proc/self/statm every 4096 packets.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include <itch/pcap_reader.hpp>
+#include <itch/uring_reader.hpp>
+
+#include "test_files.hpp"
+
+namespace {
+
+/// Generated capture used when $CHRONOS_BENCH_PCAP is not set
+constexpr const char *GENERATED_PCAP = "/tmp/chronos_reader_bench.pcap";
+constexpr std::size_t GENERATED_BYTES = std::size_t{256} << 20;
+constexpr uint32_t GENERATED_PACKET_BYTES = 1400;
+
+/// Packets between RSS samples
+constexpr std::size_t RSS_SAMPLE_INTERVAL = 4096;
+
+/**
+ * @brief Write the generated capture once (reused by later runs).
+ */
+bool write_generated_pcap() {
+  struct stat st;
+  if (::stat(GENERATED_PCAP, &st) == 0 &&
+      static_cast<std::size_t>(st.st_size) >= GENERATED_BYTES) {
+    return true;
+  }
+  std::FILE *out = std::fopen(GENERATED_PCAP, "wb");
+  if (out == nullptr) {
+    return false;
+  }
+  itch::test::PcapBuilder pcap;
+  bool ok = true;
+  while (ok && pcap.total_bytes() < GENERATED_BYTES) {
+    pcap.fill_packet(GENERATED_PACKET_BYTES, 'A');
+    if (pcap.bytes().size() >= (std::size_t{1} << 20)) {
+      ok = pcap.flush(out);
+    }
+  }
+  ok = ok && pcap.flush(out);
+  return std::fclose(out) == 0 && ok;
+}
+
+/**
+ * @brief Capture to read: $CHRONOS_BENCH_PCAP or the generated file.
+ */
+const char *bench_pcap() {
+  static const char *path = [] {
+    const char *env = std::getenv("CHRONOS_BENCH_PCAP");
+    if (env != nullptr && env[0] != '\0') {
+      return env;
+    }
+    return write_generated_pcap() ? GENERATED_PCAP : "";
+  }();
+  return path;
+}
+
+/**
+ * @brief Evict the file's pages from the page cache.
+ */
+void drop_page_cache(const char *path) {
+  const int fd = ::open(path, O_RDONLY);
+  if (fd >= 0) {
+    (void)::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+  }
+}
+
+/**
+ * @brief Resident set size in bytes (0 if unavailable).
+ */
+std::size_t resident_bytes() {
+  std::FILE *statm = std::fopen("/proc/self/statm", "r");
+  if (statm == nullptr) {
+    return 0;
+  }
+  unsigned long size = 0;
+  unsigned long resident = 0;
+  const int fields = std::fscanf(statm, "%lu %lu", &size, &resident);
+  std::fclose(statm);
+  return fields == 2 ? resident * static_cast<std::size_t>(
+                                      ::sysconf(_SC_PAGESIZE))
+                     : 0;
+}
+
+/**
+ * @brief Time one cold pass per iteration over the reader make_reader()
+ *        returns, tracking throughput and peak RSS.
+ */
+template <typename MakeReader>
+void run_cold_passes(benchmark::State &state, const char *path,
+                     MakeReader &&make_reader) {
+  std::size_t file_bytes = 0;
+  std::size_t peak_rss = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    drop_page_cache(path);
+    const std::size_t baseline = resident_bytes();
+    state.ResumeTiming();
+
+    auto start = std::chrono::steady_clock::now();
+    auto reader = make_reader();
+    if (!reader.is_open()) {
+      state.SkipWithError("cannot open capture");
+      break;
+    }
+    file_bytes = reader.file_size();
+    std::size_t packets = 0;
+    uint64_t checksum = 0;
+    reader.for_each_packet([&](const char *data, std::size_t len) {
+      checksum += static_cast<unsigned char>(data[0]) +
+                  static_cast<unsigned char>(data[len - 1]);
+      if (++packets % RSS_SAMPLE_INTERVAL == 0) [[unlikely]] {
+        const std::size_t rss = resident_bytes();
+        peak_rss = std::max(peak_rss, rss > baseline ? rss - baseline : 0);
+      }
+    });
+    benchmark::DoNotOptimize(checksum);
+    auto end = std::chrono::steady_clock::now();
+    state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(file_bytes));
+  state.counters["peak_rss_mb"] =
+      static_cast<double>(peak_rss) / (1024.0 * 1024.0);
+}
+
+// ============================================================================
+// Benchmark: One pass over a capture, whole-file vs. windowed mapping
+// ============================================================================
+
+/**
+ * @brief Read every packet of the capture once per iteration.
+ *
+ * state.range(0) is the window size in MB; 0 maps the whole file.
+ */
+static void BM_PcapRead(benchmark::State &state) {
+  const char *path = bench_pcap();
+  const auto window_mb = static_cast<std::size_t>(state.range(0));
+  const itch::PcapMapping mapping = window_mb == 0
+                                        ? itch::PcapMapping::Whole
+                                        : itch::PcapMapping::Window;
+  run_cold_passes(state, path, [&] {
+    return itch::PcapReader(path, mapping, window_mb << 20);
+  });
+  state.SetLabel(window_mb == 0 ? "whole file" : "window");
+}
+
+BENCHMARK(BM_PcapRead)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(64)
+    ->Iterations(3)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Benchmark: One pass over a capture, io_uring blocks vs. mmap
+// ============================================================================
+
+/**
+ * @brief The same cold pass through UringPcapReader.
+ *
+ * state.range(0) is the block size in KB, state.range(1) the queue depth.
+ * Depth 0 forces the pread() fallback (depth 1, no io_uring).
+ */
+static void BM_PcapRead_Uring(benchmark::State &state) {
+  const char *path = bench_pcap();
+  const auto depth = static_cast<unsigned>(state.range(1));
+  const itch::UringReadConfig config{
+      .block_bytes = static_cast<std::size_t>(state.range(0)) << 10,
+      .queue_depth = std::max(depth, 1U),
+      .use_uring = depth > 0};
+
+  // Report what this machine actually granted
+  {
+    const itch::UringPcapReader probe(path, config);
+    const itch::BlockFileReader &blocks = probe.blocks();
+    std::string label = blocks.backend() == itch::ReadBackend::IoUring
+                            ? "io_uring"
+                            : "pread";
+    label += blocks.direct_io() ? " direct" : " cached";
+    if (blocks.registered_buffers()) {
+      label += " fixed";
+    }
+    state.SetLabel(label);
+  }
+
+  run_cold_passes(state, path,
+                  [&] { return itch::UringPcapReader(path, config); });
+}
+
+BENCHMARK(BM_PcapRead_Uring)
+    ->Args({1024, 0})
+    ->Args({1024, 4})
+    ->Args({1024, 16})
+    ->Args({256, 16})
+    ->Iterations(3)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,174 @@
+#pragma once
+
+/**
+ * @file book_manager.hpp
+ * @brief One order book per security, addressed directly by stock_locate.
+ *
+ * DESIGN PRINCIPLES:
+ * 1. Dense routing table - ITCH locate codes are 16-bit, so a flat array of
+ *    65536 book pointers replaces any symbol hashing.
+ * 2. One shared pool - every book draws orders from the same MemPool or
+ *    SegmentedPool, so capacity follows the market rather than being
+ *    split per symbol.
+ * 3. Lazy creation - a book is built on the first message for its locate;
+ *    untouched locates cost one null pointer.
+ * 4. Small books - each book's order index starts small and grows only for
+ *    busy symbols, so ~8,000 books fit alongside a full-day pool.
+ *
+ * USAGE:
+ *   MemPool<Order, 10'000'000> pool;
+ *   BookManager<OrderBook<10'000'000>> books(pool);
+ *   books.book(msg.stock_locate).add_order(id, price, qty, side);
+ *   if (auto *b = books.find(locate)) { b->cancel_order(id); }
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace book {
+
+// ============================================================================
+// BookManager - Per-Symbol Books Indexed by Locate Code
+// ============================================================================
+
+/**
+ * @brief Owns one Book per ITCH stock_locate.
+ *
+ * @tparam Book Book engine (OrderBook or LadderOrderBook); must be
+ *         constructible as Book(PoolType &, std::size_t expected_orders).
+ *
+ * Key properties:
+ * - book()/find() are a single array index (no hashing, no branching on
+ *   symbol strings)
+ * - Books are heap-allocated once and never move, so references returned
+ *   by book() stay valid for the manager's lifetime
+ * - locates() lists active locates in creation order for reporting
+ */
+template <typename Book> class BookManager {
+public:
+  // ========================================================================
+  // Types
+  // ========================================================================
+
+  using BookType = Book;
+  using PoolType = typename Book::PoolType;
+  using Locate = uint16_t;
+
+  /// Number of addressable locate codes (ITCH stock_locate is 16-bit)
+  static constexpr std::size_t kMaxLocates = 65536;
+
+  /// Default initial index size per book (grows on demand); keeps an
+  /// idle OrderBook near 20 KB so thousands of symbols stay cheap
+  static constexpr std::size_t kDefaultOrdersPerBook = 256;
+
+  // ========================================================================
+  // Construction
+  // ========================================================================
+
+  /**
+   * @brief Construct an empty manager over a shared pool.
+   *
+   * @param pool Pool shared by every book
+   * @param orders_per_book Initial order index size of each new book
+   *
+   * @note Allocates the 65536-entry routing table (512 KB) up front.
+   */
+  explicit BookManager(PoolType &pool,
+                       std::size_t orders_per_book = kDefaultOrdersPerBook)
+      : pool_(pool), orders_per_book_(orders_per_book), books_(kMaxLocates) {}
+
+  // Non-copyable, non-movable (books hold references to the pool)
+  BookManager(const BookManager &) = delete;
+  BookManager &operator=(const BookManager &) = delete;
+  BookManager(BookManager &&) = delete;
+  BookManager &operator=(BookManager &&) = delete;
+
+  ~BookManager() = default;
+
+  // ========================================================================
+  // Routing
+  // ========================================================================
+
+  /**
+   * @brief Book for `locate`, creating it on first use.
+   *
+   * Complexity: O(1); allocates only the first time a locate is seen.
+   */
+  [[nodiscard]] Book &book(Locate locate) {
+    std::unique_ptr<Book> &slot = books_[locate];
+    if (slot == nullptr) [[unlikely]] {
+      slot = std::make_unique<Book>(pool_, orders_per_book_);
+      locates_.push_back(locate);
+    }
+    return *slot;
+  }
+
+  /**
+   * @brief Book for `locate`, or nullptr if none has been created.
+   *
+   * Use for messages that reference existing orders (E/C/X/D/U): an
+   * unknown locate cannot hold the order, so no book is created.
+   */
+  [[nodiscard]] Book *find(Locate locate) noexcept {
+    return books_[locate].get();
+  }
+
+  [[nodiscard]] const Book *find(Locate locate) const noexcept {
+    return books_[locate].get();
+  }
+
+  // ========================================================================
+  // Aggregates
+  // ========================================================================
+
+  /**
+   * @brief Number of books created so far.
+   */
+  [[nodiscard]] std::size_t book_count() const noexcept {
+    return locates_.size();
+  }
+
+  /**
+   * @brief Active locates in the order their books were created.
+   */
+  [[nodiscard]] const std::vector<Locate> &locates() const noexcept {
+    return locates_;
+  }
+
+  /**
+   * @brief Resting orders across all books.
+   *
+   * Complexity: O(book_count())
+   */
+  [[nodiscard]] std::size_t order_count() const noexcept {
+    std::size_t total = 0;
+    for (const Locate locate : locates_) {
+      total += books_[locate]->order_count();
+    }
+    return total;
+  }
+
+  /**
+   * @brief Visit every book as callback(locate, const Book &).
+   */
+  template <typename Callback> void for_each_book(Callback &&callback) const {
+    for (const Locate locate : locates_) {
+      callback(locate, static_cast<const Book &>(*books_[locate]));
+    }
+  }
+
+  /**
+   * @brief Get the shared pool.
+   */
+  [[nodiscard]] PoolType &pool() noexcept { return pool_; }
+
+private:
+  PoolType &pool_;                           ///< Shared order storage
+  std::size_t orders_per_book_;              ///< Initial index size per book
+  std::vector<std::unique_ptr<Book>> books_; ///< Dense, indexed by locate
+  std::vector<Locate> locates_;              ///< Active locates
+};
+
+} // namespace book
@@ -0,0 +1,237 @@
+#pragma once
+
+/**
+ * @file book_sampler.hpp
+ * @brief Per-symbol book replay that records L1/L2 depth snapshots into
+ *        columns (the core of the Python module's replay_book()).
+ *
+ * DESIGN PRINCIPLES:
+ * 1. Apply events with MarketByOrderVisitor; only read the books here.
+ * 2. Snapshot rows are columns (Column / ColumnAllocator), reserved from
+ *    the file size as address space only, ready to hand over without a
+ *    copy.
+ * 3. Every row holds the book after the events it covers, so a consumer
+ *    can forward-fill rows onto any time grid.
+ */
+
+#include "book_manager.hpp"
+#include "market_by_order.hpp"
+#include "price_level.hpp"
+#include "types.hpp"
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <itch/column_accumulator.hpp>
+#include <itch/messages.hpp>
+#include <itch/parser.hpp>
+#include <vector>
+
+namespace book {
+
+// ============================================================================
+// BookSampler - Parser Visitor Sampling Per-Symbol Books
+// ============================================================================
+
+/**
+ * @brief Parser visitor that applies order events to per-symbol books
+ *        (MarketByOrderVisitor) and records depth snapshots.
+ *
+ * Sampling:
+ * - interval_ns == 0: one row after every event applied to a selected
+ *   book, stamped with the event time.
+ * - interval_ns > 0: one row per book for each interval [k*interval_ns,
+ *   (k+1)*interval_ns) in which it changed, stamped with the interval
+ *   end and holding the book after the interval's last event. Rows are
+ *   written when the feed reaches a later interval, and by finish() for
+ *   the last one. Quiet intervals are omitted: the previous row still
+ *   holds, so forward-fill reconstructs them.
+ *
+ * Only selected instruments are replayed (ParseFilter stock_locates /
+ * symbols); the time window limits the rows kept (by their stamp), not
+ * the replay.
+ *
+ * @tparam Book Book engine for MarketByOrderVisitor
+ *
+ * @example
+ *   BookSampler<Book> sampler(books, filter, depth, interval_ns);
+ *   reader.for_each_packet(... parse_frame(parser, data, len, sampler));
+ *   sampler.finish();
+ */
+template <typename Book> class BookSampler : public itch::DefaultVisitor {
+public:
+  using Manager = BookManager<Book>;
+
+  // Snapshot rows (level columns are row-major, `depth` per row)
+  itch::Column<uint64_t> timestamps;
+  itch::Column<uint16_t> stock_locates;
+  itch::Column<uint32_t> bid_prices;
+  itch::Column<uint64_t> bid_sizes;
+  itch::Column<uint32_t> ask_prices;
+  itch::Column<uint64_t> ask_sizes;
+
+  /**
+   * @param filter Instruments to replay and window to keep; must outlive
+   *        the sampler
+   * @param depth Price levels per side in each row (> 0)
+   */
+  BookSampler(Manager &books, const itch::ParseFilter &filter,
+              std::size_t depth, uint64_t interval_ns)
+      : mbo_(books), books_(books), filter_(filter), depth_(depth),
+        interval_ns_(interval_ns) {
+    if (filter_.by_symbol()) {
+      matches_.assign(filter_.locates.size(), itch::LocateMatch::Unknown);
+    }
+  }
+
+  /**
+   * @brief Reserve rows for the most order events `file_bytes` could hold
+   *        (address space only, see ColumnAllocator).
+   */
+  void reserve_for(std::size_t file_bytes) {
+    const std::size_t rows =
+        file_bytes / (sizeof(itch::OrderDelete) + sizeof(uint16_t));
+    itch::reserve_columns(rows, timestamps, stock_locates);
+    itch::reserve_columns(rows * depth_, bid_prices, bid_sizes, ask_prices,
+                          ask_sizes);
+  }
+
+  /**
+   * @brief Write the rows of the last interval (call once the feed ends).
+   */
+  void finish() { flush_interval(); }
+
+  [[nodiscard]] const MarketByOrderStats &stats() const noexcept {
+    return mbo_.stats();
+  }
+
+  void on_stock_directory(const itch::StockDirectory &msg) {
+    resolve(msg.stock_locate, msg.stock);
+  }
+
+  void on_add_order(const itch::AddOrder &msg) {
+    resolve(msg.stock_locate, msg.stock);
+    apply(msg, [&] { mbo_.on_add_order(msg); });
+  }
+
+  void on_add_order_mpid(const itch::AddOrderMPID &msg) {
+    resolve(msg.stock_locate, msg.stock);
+    apply(msg, [&] { mbo_.on_add_order_mpid(msg); });
+  }
+
+  void on_order_executed(const itch::OrderExecuted &msg) {
+    apply(msg, [&] { mbo_.on_order_executed(msg); });
+  }
+
+  void on_order_executed_with_price(const itch::OrderExecutedWithPrice &msg) {
+    apply(msg, [&] { mbo_.on_order_executed_with_price(msg); });
+  }
+
+  void on_order_cancel(const itch::OrderCancel &msg) {
+    apply(msg, [&] { mbo_.on_order_cancel(msg); });
+  }
+
+  void on_order_delete(const itch::OrderDelete &msg) {
+    apply(msg, [&] { mbo_.on_order_delete(msg); });
+  }
+
+  void on_order_replace(const itch::OrderReplace &msg) {
+    apply(msg, [&] { mbo_.on_order_replace(msg); });
+  }
+
+private:
+  void resolve(uint16_t locate, const itch::StockSymbol &stock) noexcept {
+    if (filter_.by_symbol() &&
+        matches_[locate] == itch::LocateMatch::Unknown) {
+      matches_[locate] = filter_.wants(stock) ? itch::LocateMatch::Keep
+                                              : itch::LocateMatch::Drop;
+    }
+  }
+
+  [[nodiscard]] bool selected(uint16_t locate) const noexcept {
+    return !filter_.by_instrument() || filter_.locates.test(locate) ||
+           (filter_.by_symbol() &&
+            matches_[locate] == itch::LocateMatch::Keep);
+  }
+
+  /**
+   * @brief Apply one event to its book if selected, sampling around it.
+   */
+  template <typename Msg, typename Apply>
+  void apply(const Msg &msg, Apply &&apply_event) {
+    const auto locate = static_cast<uint16_t>(msg.stock_locate);
+    if (!selected(locate)) {
+      return;
+    }
+    const uint64_t ts = msg.timestamp.nanoseconds();
+    if (interval_ns_ == 0) {
+      apply_event();
+      sample(locate, ts);
+      return;
+    }
+
+    if (ts >= interval_end_) {
+      flush_interval();
+      interval_end_ = ts / interval_ns_ * interval_ns_ + interval_ns_;
+    }
+    apply_event();
+    if (!dirty_.test(locate)) {
+      dirty_.set(locate);
+      dirty_locates_.push_back(locate);
+    }
+  }
+
+  /**
+   * @brief One row per book changed in the current interval, stamped with
+   *        its end, in order of first change.
+   */
+  void flush_interval() {
+    for (const uint16_t locate : dirty_locates_) {
+      sample(locate, interval_end_);
+      dirty_.reset(locate);
+    }
+    dirty_locates_.clear();
+  }
+
+  /**
+   * @brief Append one snapshot row of `locate`'s book, if it has one and
+   *        `ts` is inside the filter's time window.
+   */
+  void sample(uint16_t locate, uint64_t ts) {
+    const Book *book = books_.find(locate);
+    if (book == nullptr || !filter_.in_window(ts)) {
+      return;
+    }
+    timestamps.push_back(ts);
+    stock_locates.push_back(locate);
+    append_side(*book, Side::Buy, bid_prices, bid_sizes);
+    append_side(*book, Side::Sell, ask_prices, ask_sizes);
+  }
+
+  /// Top `depth_` levels of one side, padded with zeros
+  void append_side(const Book &book, Side side,
+                   itch::Column<uint32_t> &prices,
+                   itch::Column<uint64_t> &sizes) {
+    std::size_t row = prices.size();
+    prices.resize(row + depth_);
+    sizes.resize(row + depth_);
+    book.for_each_level(side, depth_, [&](const PriceLevel &level) {
+      prices[row] = static_cast<uint32_t>(level.price);
+      sizes[row] = level.total_volume;
+      ++row;
+    });
+  }
+
+  MarketByOrderVisitor<Book> mbo_;
+  Manager &books_;
+  const itch::ParseFilter &filter_;
+  std::size_t depth_;
+  uint64_t interval_ns_;
+  std::vector<itch::LocateMatch> matches_;
+
+  // Interval mode: books changed since interval_end_ - interval_ns_
+  uint64_t interval_end_ = 0;
+  std::bitset<65536> dirty_;
+  std::vector<uint16_t> dirty_locates_;
+};
+
+} // namespace book
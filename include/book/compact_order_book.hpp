@@ -0,0 +1,567 @@
+#pragma once
+
+/**
+ * @file compact_order_book.hpp
+ * @brief Order book variant with a 32-byte aligned order record linked by
+ *        32-bit pool indices.
+ *
+ * DESIGN PRINCIPLES:
+ * 1. Hot/cold split - an order keeps only what matching and cancel touch
+ *    (id, qty, links, level); price and side are per-level facts and live
+ *    on the level, once.
+ * 2. Aligned records - 32-byte orders in an aligned MemPool never straddle
+ *    a cache line (two per line) and every field load is aligned.
+ * 3. Index links - each level queues its orders in an IndexedIntrusiveList
+ *    (32-bit MemPool slots, no embedded sentinel), so levels are trivially
+ *    copyable.
+ * 4. Same API - CompactOrderBook is a drop-in engine for BookManager and
+ *    MarketByOrderVisitor.
+ *
+ * LAYOUT (vs. packed book::Order):
+ *   Order (packed)         CompactOrder (alignas 32)
+ *   prev*, next*  16 B     prev, next    8 B (pool indices)
+ *   id             8 B     id            8 B
+ *   price          8 B     qty           4 B
+ *   qty            4 B     level         4 B (level store index)
+ *   side           1 B     (reserved)    8 B
+ *   --------------------   ----------------------
+ *   37 B, unaligned        32 B, one half-line
+ */
+
+#include "indexed_intrusive_list.hpp"
+#include "memory_pool.hpp"
+#include "order_book.hpp"
+#include "order_index.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace book {
+
+// ============================================================================
+// Compact Order and Level Records
+// ============================================================================
+
+/**
+ * @brief Hot order record: everything touched per fill or cancel.
+ *
+ * Price and side are recovered from the level (levels_[level]).
+ */
+struct alignas(32) CompactOrder : IndexedNode {
+  uint64_t id = 0;       ///< Unique order identifier
+  uint32_t qty = 0;      ///< Remaining quantity (shares)
+  LevelIndex level = 0;  ///< Level the order rests at
+
+  /**
+   * @brief Reduce quantity (partial fill); clamps at zero.
+   */
+  uint32_t reduce_qty(uint32_t fill_qty) noexcept {
+    qty = fill_qty >= qty ? 0 : qty - fill_qty;
+    return qty;
+  }
+
+  [[nodiscard]] constexpr bool is_filled() const noexcept { return qty == 0; }
+};
+
+static_assert(sizeof(CompactOrder) == 32, "CompactOrder must be 32 bytes");
+static_assert(alignof(CompactOrder) == 32, "CompactOrder must be 32-aligned");
+static_assert(std::is_trivially_copyable_v<CompactOrder>);
+
+/**
+ * @brief Price level holding its FIFO queue as pool indices.
+ *
+ * Trivially copyable: growing or reordering the level store is a memcpy.
+ *
+ * @tparam Pool MemPool of CompactOrder records the queue links into
+ */
+template <typename Pool> struct CompactPriceLevel {
+  using Queue = IndexedIntrusiveList<CompactOrder, Pool>;
+
+  uint64_t price = 0;        ///< Price in ticks (shared by all orders)
+  uint64_t total_volume = 0; ///< Cached aggregate quantity
+  Queue orders;              ///< FIFO queue (front matched first)
+  Side side = Side::Buy;     ///< Side of every order at this level
+
+  CompactPriceLevel(Pool &pool, uint64_t level_price, Side level_side) noexcept
+      : price(level_price), orders(pool), side(level_side) {}
+
+  [[nodiscard]] bool empty() const noexcept { return orders.empty(); }
+
+  /**
+   * @brief Subtract from the cached volume; clamps at zero.
+   */
+  void reduce_volume(uint64_t qty) noexcept {
+    total_volume = qty <= total_volume ? total_volume - qty : 0;
+  }
+};
+
+static_assert(
+    std::is_trivially_copyable_v<CompactPriceLevel<MemPool<CompactOrder, 1>>>);
+
+// ============================================================================
+// CompactOrderBook - OrderBook over CompactOrder Records
+// ============================================================================
+
+/**
+ * @brief Vector-ladder limit order book storing CompactOrder records.
+ *
+ * Same matching rules and API as OrderBook; only the storage layout
+ * differs. The order index maps id -> pool slot (4 bytes, vs. a 16-byte
+ * OrderHandle), and the slot's record names its level.
+ *
+ * @tparam Capacity Maximum number of orders the pool can hold
+ *         (below 2^32 - 2 so every slot fits a PoolIndex)
+ * @tparam Allocation MemPool storage policy (see pool_allocation.hpp)
+ *
+ * @example
+ *   MemPool<CompactOrder, 1000000> pool;
+ *   CompactOrderBook<1000000> book(pool);
+ *   book.add_order(1, 10000, 100, Side::Buy);
+ */
+template <std::size_t Capacity, typename Allocation = HeapAllocation>
+class CompactOrderBook {
+  static_assert(Capacity < kUnlinkedPoolIndex,
+                "CompactOrderBook capacity must fit a 32-bit index");
+
+public:
+  // ========================================================================
+  // Types
+  // ========================================================================
+
+  using PoolType = MemPool<CompactOrder, Capacity, Allocation>;
+  using LevelType = CompactPriceLevel<PoolType>;
+
+  /// Function-pointer sink (any ExecutionSink is accepted)
+  using ExecutionCallback = void (*)(const Execution &);
+
+  // ========================================================================
+  // Construction
+  // ========================================================================
+
+  /**
+   * @brief Construct order book with reference to memory pool.
+   *
+   * @param pool Pre-allocated pool of CompactOrder records
+   * @param expected_orders Live orders the index is sized for up front
+   *        (doubles on demand, as in OrderBook)
+   */
+  explicit CompactOrderBook(PoolType &pool,
+                            std::size_t expected_orders = Capacity)
+      : order_map_(expected_orders), pool_(pool) {
+    const std::size_t levels =
+        std::min(kInitialLevelCapacity, expected_orders);
+    levels_.reserve(levels);
+    free_levels_.reserve(levels);
+  }
+
+  // Non-copyable, non-movable (contains references)
+  CompactOrderBook(const CompactOrderBook &) = delete;
+  CompactOrderBook &operator=(const CompactOrderBook &) = delete;
+  CompactOrderBook(CompactOrderBook &&) = delete;
+  CompactOrderBook &operator=(CompactOrderBook &&) = delete;
+
+  ~CompactOrderBook() = default;
+
+  // ========================================================================
+  // Order Entry
+  // ========================================================================
+
+  /**
+   * @brief Add a limit order, matching first if it crosses the spread.
+   *
+   * @return true if order was added/matched, false if duplicate or pool full
+   */
+  template <typename Sink = NullExecutionSink>
+    requires ExecutionSink<Sink>
+  bool add_order(uint64_t id, uint64_t price, uint32_t qty, Side side,
+                 Sink &&on_execution = {}) noexcept {
+    if (id == kInvalidOrderId || order_map_.contains(id)) {
+      return false;
+    }
+
+    const uint32_t remaining =
+        side == Side::Buy ? match_buy(id, price, qty, on_execution)
+                          : match_sell(id, price, qty, on_execution);
+    if (remaining == 0) {
+      return true;
+    }
+    return rest_new_order(id, price, remaining, side);
+  }
+
+  /**
+   * @brief Rest an order without matching (market-by-order feed mode).
+   */
+  bool insert_order(uint64_t id, uint64_t price, uint32_t qty,
+                    Side side) noexcept {
+    if (id == kInvalidOrderId || order_map_.contains(id)) {
+      return false;
+    }
+    return rest_new_order(id, price, qty, side);
+  }
+
+  // ========================================================================
+  // Order Cancellation
+  // ========================================================================
+
+  /**
+   * @brief Cancel an existing order.
+   *
+   * Complexity: O(1) unless its level empties (then O(log n) erase)
+   */
+  bool cancel_order(uint64_t id) noexcept {
+    const PoolIndex *found = order_map_.find(id);
+    if (found == nullptr) {
+      return false;
+    }
+    const PoolIndex slot = *found;
+    order_map_.erase(id);
+    remove_from_level(slot);
+    pool_.deallocate(&pool_.at(slot));
+    return true;
+  }
+
+  /**
+   * @brief Reduce a resting order's quantity (ITCH E/C/X semantics).
+   */
+  bool reduce_order(uint64_t id, uint32_t qty) noexcept {
+    const PoolIndex *found = order_map_.find(id);
+    if (found == nullptr) {
+      return false;
+    }
+    const PoolIndex slot = *found;
+    CompactOrder &order = pool_.at(slot);
+    if (qty < order.qty) {
+      levels_[order.level].reduce_volume(qty);
+      order.reduce_qty(qty);
+      return true;
+    }
+
+    order_map_.erase(id);
+    remove_from_level(slot);
+    pool_.deallocate(&order);
+    return true;
+  }
+
+  /**
+   * @brief Replace an order (ITCH U); the replacement may match.
+   */
+  bool replace_order(uint64_t old_id, uint64_t new_id, uint64_t price,
+                     uint32_t qty) noexcept {
+    Side side{};
+    if (replaceable(old_id, new_id, side) != ReplaceResult::Applied) {
+      return false;
+    }
+    cancel_order(old_id);
+    return add_order(new_id, price, qty, side);
+  }
+
+  /**
+   * @brief Replace an order without matching (market-by-order mode).
+   */
+  ReplaceResult replace_passive(uint64_t old_id, uint64_t new_id,
+                                uint64_t price, uint32_t qty) noexcept {
+    Side side{};
+    const ReplaceResult check = replaceable(old_id, new_id, side);
+    if (check != ReplaceResult::Applied) {
+      return check;
+    }
+    cancel_order(old_id);
+    return rest_new_order(new_id, price, qty, side) ? ReplaceResult::Applied
+                                                    : ReplaceResult::Rejected;
+  }
+
+  // ========================================================================
+  // Market Data Accessors
+  // ========================================================================
+
+  [[nodiscard]] std::optional<uint64_t> best_bid() const noexcept {
+    if (bids_.empty()) {
+      return std::nullopt;
+    }
+    return bids_.front().price;
+  }
+
+  [[nodiscard]] std::optional<uint64_t> best_ask() const noexcept {
+    if (asks_.empty()) {
+      return std::nullopt;
+    }
+    return asks_.front().price;
+  }
+
+  [[nodiscard]] std::optional<uint64_t> spread() const noexcept {
+    auto bid = best_bid();
+    auto ask = best_ask();
+    if (!bid || !ask) {
+      return std::nullopt;
+    }
+    return *ask - *bid;
+  }
+
+  [[nodiscard]] uint64_t best_bid_volume() const noexcept {
+    return bids_.empty() ? 0 : levels_[bids_.front().index].total_volume;
+  }
+
+  [[nodiscard]] uint64_t best_ask_volume() const noexcept {
+    return asks_.empty() ? 0 : levels_[asks_.front().index].total_volume;
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return bids_.empty() && asks_.empty();
+  }
+
+  [[nodiscard]] std::size_t order_count() const noexcept {
+    return order_map_.size();
+  }
+
+  [[nodiscard]] std::size_t bid_level_count() const noexcept {
+    return bids_.size();
+  }
+
+  [[nodiscard]] std::size_t ask_level_count() const noexcept {
+    return asks_.size();
+  }
+
+  // ========================================================================
+  // Direct access for testing
+  // ========================================================================
+
+  [[nodiscard]] const std::vector<LevelRef> &bids() const noexcept {
+    return bids_;
+  }
+
+  [[nodiscard]] const std::vector<LevelRef> &asks() const noexcept {
+    return asks_;
+  }
+
+  [[nodiscard]] const LevelType &
+  level(const LevelRef &ref) const noexcept {
+    return levels_[ref.index];
+  }
+
+  /**
+   * @brief Order IDs queued at a level, oldest first (O(n), for tests).
+   */
+  [[nodiscard]] std::vector<uint64_t>
+  queue(const LevelRef &ref) const {
+    std::vector<uint64_t> ids;
+    for (const CompactOrder &order : levels_[ref.index].orders) {
+      ids.push_back(order.id);
+    }
+    return ids;
+  }
+
+private:
+  // ========================================================================
+  // Data Members
+  // ========================================================================
+
+  /// Levels reserved up front; the store only grows past this on deep books
+  static constexpr std::size_t kInitialLevelCapacity = 1024;
+
+  std::vector<LevelRef> bids_; ///< Sorted descending (best bid first)
+  std::vector<LevelRef> asks_; ///< Sorted ascending (best ask first)
+  std::vector<LevelType> levels_;        ///< Level store (stable indices)
+  std::vector<LevelIndex> free_levels_; ///< Recycled level slots
+  FlatOrderIndex<PoolIndex> order_map_; ///< ID -> pool slot
+  PoolType &pool_;                      ///< Reference to memory pool
+
+  // ========================================================================
+  // Matching Logic
+  // ========================================================================
+
+  template <typename Sink>
+  uint32_t match_buy(uint64_t taker_id, uint64_t price, uint32_t qty,
+                     Sink &on_execution) noexcept {
+    uint32_t remaining = qty;
+    while (remaining > 0 && !asks_.empty()) {
+      const LevelRef best = asks_.front();
+      if (price < best.price) {
+        break;
+      }
+      remaining = match_at_level(best.index, taker_id, remaining,
+                                 on_execution);
+      if (levels_[best.index].empty()) {
+        asks_.erase(asks_.begin());
+        free_levels_.push_back(best.index);
+      }
+    }
+    return remaining;
+  }
+
+  template <typename Sink>
+  uint32_t match_sell(uint64_t taker_id, uint64_t price, uint32_t qty,
+                      Sink &on_execution) noexcept {
+    uint32_t remaining = qty;
+    while (remaining > 0 && !bids_.empty()) {
+      const LevelRef best = bids_.front();
+      if (price > best.price) {
+        break;
+      }
+      remaining = match_at_level(best.index, taker_id, remaining,
+                                 on_execution);
+      if (levels_[best.index].empty()) {
+        bids_.erase(bids_.begin());
+        free_levels_.push_back(best.index);
+      }
+    }
+    return remaining;
+  }
+
+  /**
+   * @brief Fill against one level's queue, oldest first.
+   */
+  template <typename Sink>
+  uint32_t match_at_level(LevelIndex index, uint64_t taker_id, uint32_t qty,
+                          Sink &on_execution) noexcept {
+    LevelType &level = levels_[index];
+    uint32_t remaining = qty;
+
+    while (remaining > 0 && !level.empty()) {
+      CompactOrder &maker = level.orders.front();
+      const uint32_t fill_qty = std::min(remaining, maker.qty);
+
+      emit_execution(on_execution, Execution{.maker_id = maker.id,
+                                             .taker_id = taker_id,
+                                             .price = level.price,
+                                             .qty = fill_qty,
+                                             .maker_side = level.side});
+
+      remaining -= fill_qty;
+      level.reduce_volume(fill_qty);
+      maker.reduce_qty(fill_qty);
+
+      if (maker.is_filled()) {
+        level.orders.pop_front();
+        order_map_.erase(maker.id);
+        pool_.deallocate(&maker);
+      }
+    }
+    return remaining;
+  }
+
+  // ========================================================================
+  // Price Level Management
+  // ========================================================================
+
+  /// Applied (with old_id's side in `side`) if new_id may replace old_id
+  ReplaceResult replaceable(uint64_t old_id, uint64_t new_id,
+                            Side &side) const noexcept {
+    const PoolIndex *found = order_map_.find(old_id);
+    if (found == nullptr) {
+      return ReplaceResult::UnknownOrder;
+    }
+    if (new_id == kInvalidOrderId ||
+        (new_id != old_id && order_map_.contains(new_id))) {
+      return ReplaceResult::Rejected;
+    }
+    side = levels_[pool_.at(*found).level].side;
+    return ReplaceResult::Applied;
+  }
+
+  bool rest_new_order(uint64_t id, uint64_t price, uint32_t qty,
+                      Side side) noexcept {
+    // Grow before allocating (see BasicOrderBook::rest_new_order)
+    if (order_map_.size() == order_map_.max_entries()) [[unlikely]] {
+      const std::size_t grown =
+          std::max<std::size_t>(order_map_.max_entries(), 8) * 2;
+      if (!try_allocate([&] { order_map_.reserve(grown); })) {
+        return false;
+      }
+    }
+
+    CompactOrder *order = pool_.allocate();
+    if (order == nullptr) {
+      return false; // Pool exhausted
+    }
+    const auto slot = static_cast<PoolIndex>(pool_.index_of(order));
+
+    order->id = id;
+    order->qty = qty;
+    order->level =
+        side == Side::Buy ? find_or_add_bid(price) : find_or_add_ask(price);
+    LevelType &level = levels_[order->level];
+    level.orders.push_back(order);
+    level.total_volume += qty;
+
+    if (!order_map_.insert(id, slot)) [[unlikely]] {
+      remove_from_level(slot); // Unindexed orders could never be cancelled
+      pool_.deallocate(order);
+      return false;
+    }
+    return true;
+  }
+
+  LevelIndex find_or_add_bid(uint64_t price) noexcept {
+    auto it = std::lower_bound(bids_.begin(), bids_.end(), price,
+                               [](const LevelRef &ref, uint64_t p) {
+                                 return ref.price > p; // Descending
+                               });
+    if (it != bids_.end() && it->price == price) {
+      return it->index;
+    }
+    const LevelIndex index = acquire_level(price, Side::Buy);
+    bids_.insert(it, LevelRef{price, index});
+    return index;
+  }
+
+  LevelIndex find_or_add_ask(uint64_t price) noexcept {
+    auto it = std::lower_bound(asks_.begin(), asks_.end(), price,
+                               [](const LevelRef &ref, uint64_t p) {
+                                 return ref.price < p; // Ascending
+                               });
+    if (it != asks_.end() && it->price == price) {
+      return it->index;
+    }
+    const LevelIndex index = acquire_level(price, Side::Sell);
+    asks_.insert(it, LevelRef{price, index});
+    return index;
+  }
+
+  /**
+   * @brief Unlink an order, dropping its level from the ladder once empty.
+   */
+  void remove_from_level(PoolIndex slot) noexcept {
+    CompactOrder &order = pool_.at(slot);
+    const LevelIndex index = order.level;
+    LevelType &level = levels_[index];
+
+    level.reduce_volume(order.qty);
+    level.orders.remove(&order);
+    if (!level.empty()) {
+      return;
+    }
+
+    if (level.side == Side::Buy) {
+      auto it = std::lower_bound(bids_.begin(), bids_.end(), level.price,
+                                 [](const LevelRef &ref, uint64_t price) {
+                                   return ref.price > price;
+                                 });
+      bids_.erase(it);
+    } else {
+      auto it = std::lower_bound(asks_.begin(), asks_.end(), level.price,
+                                 [](const LevelRef &ref, uint64_t price) {
+                                   return ref.price < price;
+                                 });
+      asks_.erase(it);
+    }
+    free_levels_.push_back(index);
+  }
+
+  LevelIndex acquire_level(uint64_t price, Side side) noexcept {
+    const LevelType fresh(pool_, price, side);
+    if (!free_levels_.empty()) {
+      const LevelIndex index = free_levels_.back();
+      free_levels_.pop_back();
+      levels_[index] = fresh;
+      return index;
+    }
+    // Trivially copyable levels: growth is a plain memcpy, no re-linking
+    levels_.push_back(fresh);
+    return static_cast<LevelIndex>(levels_.size() - 1);
+  }
+};
+
+} // namespace book
@@ -0,0 +1,375 @@
+#pragma once
+
+/**
+ * @file indexed_intrusive_list.hpp
+ * @brief Intrusive doubly-linked list that links pool slots by 32-bit index.
+ *
+ * DESIGN PRINCIPLES:
+ * 1. Same contract as IntrusiveList - objects are the nodes, O(1) push,
+ *    pop and remove, O(n) size, bidirectional iteration.
+ * 2. Index links - prev/next are 32-bit MemPool slots, 8 bytes per node
+ *    instead of 16.
+ * 3. No sentinel - the list is (pool, head, tail); nothing points back
+ *    into it, so it is trivially copyable and a container of lists (a
+ *    level store) can grow or shift with memmove.
+ *
+ * USAGE:
+ *   struct Order : IndexedNode { ... };
+ *   MemPool<Order, N> pool;
+ *   IndexedIntrusiveList<Order, MemPool<Order, N>> orders(pool);
+ *   orders.push_back(pool.allocate());
+ *   orders.remove(&order);  // O(1) removal, no pointer fix-up on relocate
+ *
+ * Elements must live in the pool the list was built with. A relocated
+ * list (copied bytes) takes over the elements; the source must not be
+ * used again. Destroying a list leaves its elements marked linked - call
+ * clear() first if they outlive it.
+ */
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace book {
+
+// ============================================================================
+// IndexedNode - Base class for index-linked elements
+// ============================================================================
+
+/**
+ * @brief Slot index into a MemPool, used as a 32-bit link.
+ */
+using PoolIndex = uint32_t;
+
+/// Link value meaning "no element" (either end of a list)
+inline constexpr PoolIndex kNullPoolIndex =
+    std::numeric_limits<PoolIndex>::max();
+
+/// Link value meaning "not in any list"; pools must stay below it
+inline constexpr PoolIndex kUnlinkedPoolIndex = kNullPoolIndex - 1;
+
+/**
+ * @brief Base node for IndexedIntrusiveList elements.
+ *
+ * Two end markers are needed because a lone element has no neighbours:
+ * kNullPoolIndex terminates a list, kUnlinkedPoolIndex marks a node that
+ * is in none.
+ */
+struct IndexedNode {
+  PoolIndex prev = kUnlinkedPoolIndex; ///< Previous slot (toward head)
+  PoolIndex next = kUnlinkedPoolIndex; ///< Next slot (toward tail)
+
+  /**
+   * @brief Check if this node is currently linked in a list.
+   */
+  [[nodiscard]] constexpr bool is_linked() const noexcept {
+    return next != kUnlinkedPoolIndex;
+  }
+
+  /**
+   * @brief Mark as unlinked (called after removal from a list).
+   */
+  constexpr void unlink() noexcept {
+    prev = kUnlinkedPoolIndex;
+    next = kUnlinkedPoolIndex;
+  }
+};
+
+static_assert(sizeof(IndexedNode) == 8, "Index links must be 8 bytes");
+
+// ============================================================================
+// C++20 Concepts
+// ============================================================================
+
+/**
+ * @brief Concept requiring type T to derive from IndexedNode.
+ */
+template <typename T>
+concept IndexedListElement =
+    std::is_base_of_v<IndexedNode, T> && std::is_class_v<T>;
+
+/**
+ * @brief Slot storage the list resolves indices through (MemPool shape).
+ */
+template <typename Pool, typename T>
+concept IndexedListPool = requires(Pool &pool, const T *ptr, std::size_t i) {
+  { pool.at(i) } -> std::convertible_to<T &>;
+  { pool.index_of(ptr) } -> std::convertible_to<std::size_t>;
+};
+
+// ============================================================================
+// IndexedIntrusiveList - O(1) list over pool slots
+// ============================================================================
+
+/**
+ * @brief Intrusive doubly-linked list whose links are pool indices.
+ *
+ * @tparam T Element type (derives from IndexedNode)
+ * @tparam Pool Storage owning the elements (MemPool<T, N> or compatible)
+ *
+ * Layout: pool pointer plus head and tail slots, 16 bytes, trivially
+ * copyable - unlike IntrusiveList, whose embedded sentinel is pointed to
+ * by the first and last element and must be re-linked on every move.
+ *
+ * @example
+ *   struct Order : IndexedNode { uint64_t id; };
+ *   MemPool<Order, 1024> pool;
+ *   IndexedIntrusiveList<Order, MemPool<Order, 1024>> orders(pool);
+ *   orders.push_back(pool.allocate());
+ *   for (auto &order : orders) {
+ *     process(order);
+ *   }
+ */
+template <IndexedListElement T, IndexedListPool<T> Pool>
+class IndexedIntrusiveList {
+public:
+  using PoolType = Pool;
+
+  // ========================================================================
+  // Iterator
+  // ========================================================================
+
+  /**
+   * @brief Bidirectional iterator; end() is the null index.
+   */
+  template <bool IsConst> class Iterator {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::conditional_t<IsConst, const T, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    Iterator() noexcept = default;
+
+    Iterator(const IndexedIntrusiveList *list, PoolIndex index) noexcept
+        : list_(list), index_(index) {}
+
+    // Allow conversion from non-const to const iterator
+    template <bool Other>
+      requires(IsConst && !Other)
+    Iterator(const Iterator<Other> &other) noexcept
+        : list_(other.list_), index_(other.index_) {}
+
+    [[nodiscard]] reference operator*() const noexcept {
+      return list_->element(index_);
+    }
+
+    [[nodiscard]] pointer operator->() const noexcept {
+      return &list_->element(index_);
+    }
+
+    Iterator &operator++() noexcept {
+      index_ = list_->element(index_).next;
+      return *this;
+    }
+
+    Iterator operator++(int) noexcept {
+      Iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    Iterator &operator--() noexcept {
+      index_ = index_ == kNullPoolIndex ? list_->tail_
+                                        : list_->element(index_).prev;
+      return *this;
+    }
+
+    Iterator operator--(int) noexcept {
+      Iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    [[nodiscard]] bool operator==(const Iterator &other) const noexcept {
+      return index_ == other.index_;
+    }
+
+    [[nodiscard]] bool operator!=(const Iterator &other) const noexcept {
+      return index_ != other.index_;
+    }
+
+    /// Pool slot of the current element (kNullPoolIndex at end)
+    [[nodiscard]] PoolIndex index() const noexcept { return index_; }
+
+  private:
+    template <bool> friend class Iterator;
+    const IndexedIntrusiveList *list_ = nullptr;
+    PoolIndex index_ = kNullPoolIndex;
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  // ========================================================================
+  // Construction
+  // ========================================================================
+
+  /**
+   * @brief Construct an empty list over `pool`'s slots.
+   */
+  explicit IndexedIntrusiveList(Pool &pool) noexcept : pool_(&pool) {}
+
+  // Trivially copyable by design: a copy is a relocation (see file header)
+
+  // ========================================================================
+  // Capacity
+  // ========================================================================
+
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return head_ == kNullPoolIndex;
+  }
+
+  /**
+   * @brief Count elements in list (O(n), as IntrusiveList).
+   */
+  [[nodiscard]] std::size_t size() const noexcept {
+    std::size_t count = 0;
+    for (PoolIndex i = head_; i != kNullPoolIndex; i = element(i).next) {
+      ++count;
+    }
+    return count;
+  }
+
+  // ========================================================================
+  // Element Access
+  // ========================================================================
+
+  /// @pre !empty()
+  [[nodiscard]] T &front() noexcept { return element(head_); }
+  [[nodiscard]] const T &front() const noexcept { return element(head_); }
+
+  /// @pre !empty()
+  [[nodiscard]] T &back() noexcept { return element(tail_); }
+  [[nodiscard]] const T &back() const noexcept { return element(tail_); }
+
+  /// Pool slots of the first and last element (kNullPoolIndex if empty)
+  [[nodiscard]] PoolIndex head_index() const noexcept { return head_; }
+  [[nodiscard]] PoolIndex tail_index() const noexcept { return tail_; }
+
+  // ========================================================================
+  // Iterators
+  // ========================================================================
+
+  [[nodiscard]] iterator begin() noexcept { return iterator(this, head_); }
+
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return const_iterator(this, head_);
+  }
+
+  [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+
+  [[nodiscard]] iterator end() noexcept {
+    return iterator(this, kNullPoolIndex);
+  }
+
+  [[nodiscard]] const_iterator end() const noexcept {
+    return const_iterator(this, kNullPoolIndex);
+  }
+
+  [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+
+  // ========================================================================
+  // Modifiers
+  // ========================================================================
+
+  /**
+   * @brief Add element to front of list.
+   *
+   * @param elem Pool element (must not be nullptr, must not be linked)
+   */
+  void push_front(T *elem) noexcept { link_before(head_, slot_of(elem)); }
+
+  /**
+   * @brief Add element to back of list.
+   *
+   * @param elem Pool element (must not be nullptr, must not be linked)
+   */
+  void push_back(T *elem) noexcept {
+    link_before(kNullPoolIndex, slot_of(elem));
+  }
+
+  /// @pre !empty()
+  void pop_front() noexcept { unlink_slot(head_); }
+
+  /// @pre !empty()
+  void pop_back() noexcept { unlink_slot(tail_); }
+
+  /**
+   * @brief Remove specific element from list.
+   *
+   * Complexity: O(1) - neighbours are found through the element's links.
+   */
+  void remove(T *elem) noexcept { unlink_slot(slot_of(elem)); }
+
+  /**
+   * @brief Remove all elements from list (O(n)).
+   */
+  void clear() noexcept {
+    while (!empty()) {
+      pop_front();
+    }
+  }
+
+  /**
+   * @brief Insert element before position.
+   *
+   * @return Iterator to inserted element
+   */
+  iterator insert(iterator pos, T *elem) noexcept {
+    const PoolIndex slot = slot_of(elem);
+    link_before(pos.index(), slot);
+    return iterator(this, slot);
+  }
+
+  /**
+   * @brief Erase element at position.
+   *
+   * @return Iterator to element following erased element
+   */
+  iterator erase(iterator pos) noexcept {
+    const PoolIndex next = element(pos.index()).next;
+    unlink_slot(pos.index());
+    return iterator(this, next);
+  }
+
+private:
+  Pool *pool_;
+  PoolIndex head_ = kNullPoolIndex; ///< Oldest element
+  PoolIndex tail_ = kNullPoolIndex; ///< Newest element
+
+  [[nodiscard]] T &element(PoolIndex slot) const noexcept {
+    return pool_->at(slot);
+  }
+
+  [[nodiscard]] PoolIndex slot_of(const T *elem) const noexcept {
+    return static_cast<PoolIndex>(pool_->index_of(elem));
+  }
+
+  /**
+   * @brief Link `slot` before `pos` (kNullPoolIndex = append).
+   */
+  void link_before(PoolIndex pos, PoolIndex slot) noexcept {
+    T &node = element(slot);
+    const PoolIndex prev = pos == kNullPoolIndex ? tail_ : element(pos).prev;
+    node.prev = prev;
+    node.next = pos;
+    (prev == kNullPoolIndex ? head_ : element(prev).next) = slot;
+    (pos == kNullPoolIndex ? tail_ : element(pos).prev) = slot;
+  }
+
+  void unlink_slot(PoolIndex slot) noexcept {
+    T &node = element(slot);
+    (node.prev == kNullPoolIndex ? head_ : element(node.prev).next) =
+        node.next;
+    (node.next == kNullPoolIndex ? tail_ : element(node.next).prev) =
+        node.prev;
+    node.unlink();
+  }
+};
+
+} // namespace book
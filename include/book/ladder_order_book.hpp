@@ -0,0 +1,777 @@
+#pragma once
+
+/**
+ * @file ladder_order_book.hpp
+ * @brief Array-indexed price ladder variant of the limit order book.
+ *
+ * DESIGN PRINCIPLES:
+ * 1. Dense tick-indexed ring of PriceLevels per side around the touch.
+ * 2. Two-level bitmap of non-empty levels for O(1) best-price lookup.
+ * 3. Levels never move while in the ring - no vector insert/erase shifts.
+ * 4. Far-from-touch (or off-tick) prices spill into small sorted overflows.
+ *
+ * LAYOUT:
+ *   tick = price / tick_size
+ *   window = [base_tick, base_tick + LadderTicks)
+ *   slot = tick & (LadderTicks - 1)   // ring: rebasing never moves a slot
+ *
+ * The window is re-centred when a new best price lands outside it. Levels
+ * that fall out of the window move to the overflow and overflow levels that
+ * fall inside move into the ring (an O(1) IntrusiveList splice each).
+ *
+ * LadderOrderBook exposes the same order entry and market data API as
+ * OrderBook, so drivers can select the engine with a template parameter.
+ */
+
+#include "memory_pool.hpp"
+#include "order_book.hpp"
+#include "order_index.hpp"
+#include "price_level.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace book {
+
+// ============================================================================
+// LevelBitmap - Two-level occupancy bitmap
+// ============================================================================
+
+/**
+ * @brief Occupancy bitmap with a summary word for O(1) first/last search.
+ *
+ * Bit i of words_[w] marks slot w * 64 + i; bit w of summary_ marks a
+ * non-empty word. Any search touches at most two words plus the summary.
+ *
+ * @tparam Bits Number of slots (power of two, 64..4096)
+ */
+template <std::size_t Bits> class LevelBitmap {
+  static_assert(std::has_single_bit(Bits), "Bits must be a power of two");
+  static_assert(Bits >= 64 && Bits <= 64 * 64,
+                "Two-level bitmap supports 64..4096 slots");
+
+public:
+  static constexpr std::size_t npos = Bits;
+
+  void set(std::size_t i) noexcept {
+    words_[i >> 6] |= uint64_t{1} << (i & 63);
+    summary_ |= uint64_t{1} << (i >> 6);
+  }
+
+  void clear(std::size_t i) noexcept {
+    words_[i >> 6] &= ~(uint64_t{1} << (i & 63));
+    if (words_[i >> 6] == 0) {
+      summary_ &= ~(uint64_t{1} << (i >> 6));
+    }
+  }
+
+  [[nodiscard]] bool test(std::size_t i) const noexcept {
+    return (words_[i >> 6] >> (i & 63)) & 1;
+  }
+
+  [[nodiscard]] bool none() const noexcept { return summary_ == 0; }
+
+  /**
+   * @brief Lowest set slot >= from, or npos.
+   */
+  [[nodiscard]] std::size_t find_first_from(std::size_t from) const noexcept {
+    if (from >= Bits) {
+      return npos;
+    }
+    const std::size_t w = from >> 6;
+    const uint64_t m = words_[w] & (~uint64_t{0} << (from & 63));
+    if (m != 0) {
+      return (w << 6) + static_cast<std::size_t>(std::countr_zero(m));
+    }
+    const uint64_t above =
+        (w == 63) ? 0 : summary_ & (~uint64_t{0} << (w + 1));
+    if (above == 0) {
+      return npos;
+    }
+    const auto w2 = static_cast<std::size_t>(std::countr_zero(above));
+    return (w2 << 6) + static_cast<std::size_t>(std::countr_zero(words_[w2]));
+  }
+
+  /**
+   * @brief Highest set slot < limit, or npos.
+   */
+  [[nodiscard]] std::size_t find_last_below(std::size_t limit) const noexcept {
+    if (limit == 0) {
+      return npos;
+    }
+    const std::size_t last = limit - 1;
+    const std::size_t w = last >> 6;
+    const uint64_t keep =
+        ((last & 63) == 63) ? ~uint64_t{0}
+                            : (uint64_t{1} << ((last & 63) + 1)) - 1;
+    const uint64_t m = words_[w] & keep;
+    if (m != 0) {
+      return (w << 6) + 63 - static_cast<std::size_t>(std::countl_zero(m));
+    }
+    const uint64_t below = summary_ & ((uint64_t{1} << w) - 1);
+    if (below == 0) {
+      return npos;
+    }
+    const std::size_t w2 =
+        63 - static_cast<std::size_t>(std::countl_zero(below));
+    return (w2 << 6) + 63 -
+           static_cast<std::size_t>(std::countl_zero(words_[w2]));
+  }
+
+private:
+  std::array<uint64_t, Bits / 64> words_{};
+  uint64_t summary_ = 0;
+};
+
+// ============================================================================
+// BasicLadderOrderBook - Tick-indexed Limit Order Book
+// ============================================================================
+
+/**
+ * @brief Limit order book storing levels in a dense tick-indexed ring.
+ *
+ * @tparam Pool Order storage (see OrderPool); LadderOrderBook<Capacity>
+ *         names the MemPool-backed book
+ * @tparam LadderTicks Ring size in ticks per side (power of two, <= 4096)
+ *
+ * Key properties:
+ * - O(1) add/cancel for prices inside the window (slot = tick & mask)
+ * - O(1) best bid/ask via bitmap search
+ * - Price-Time Priority matching identical to OrderBook
+ * - Hot region (levels around the touch) is one contiguous array
+ *
+ * @example
+ *   MemPool<Order, 1000000> pool;
+ *   LadderOrderBook<1000000> book(pool);      // 1 cent ticks
+ *   book.add_order(1, 1000000, 100, Side::Buy);
+ */
+template <OrderPool Pool, std::size_t LadderTicks = 4096>
+class BasicLadderOrderBook {
+  static_assert(std::has_single_bit(LadderTicks),
+                "LadderTicks must be a power of two");
+
+public:
+  // ========================================================================
+  // Types
+  // ========================================================================
+
+  using PoolType = Pool;
+
+  /// Function-pointer sink (any ExecutionSink is accepted)
+  using ExecutionCallback = void (*)(const Execution &);
+
+  /// Default tick: one cent in ITCH fixed-point (price * 10000)
+  static constexpr uint64_t kDefaultTickSize = 100;
+
+  // ========================================================================
+  // Construction
+  // ========================================================================
+
+  /**
+   * @brief Construct ladder book sized for the pool's current capacity.
+   *
+   * @param pool Reference to the memory pool for orders
+   */
+  explicit BasicLadderOrderBook(PoolType &pool)
+      : BasicLadderOrderBook(pool, pool.capacity()) {}
+
+  /**
+   * @brief Construct ladder book with reference to memory pool.
+   *
+   * @param pool Reference to the memory pool for orders
+   * @param expected_orders Initial index size (see BasicOrderBook)
+   * @param tick_size Price increment (in price units) of one ladder slot
+   */
+  BasicLadderOrderBook(PoolType &pool, std::size_t expected_orders,
+                       uint64_t tick_size = kDefaultTickSize)
+      : bid_ring_(LadderTicks), ask_ring_(LadderTicks),
+        order_map_(expected_orders), pool_(pool),
+        tick_size_(tick_size == 0 ? 1 : tick_size) {}
+
+  // Non-copyable
+  BasicLadderOrderBook(const BasicLadderOrderBook &) = delete;
+  BasicLadderOrderBook &operator=(const BasicLadderOrderBook &) = delete;
+
+  // Non-movable (contains references)
+  BasicLadderOrderBook(BasicLadderOrderBook &&) = delete;
+  BasicLadderOrderBook &operator=(BasicLadderOrderBook &&) = delete;
+
+  ~BasicLadderOrderBook() = default;
+
+  // ========================================================================
+  // Order Entry
+  // ========================================================================
+
+  /**
+   * @brief Add a new limit order to the book (see OrderBook::add_order).
+   *
+   * @return true if order was added/matched, false if duplicate or pool full
+   */
+  template <typename Sink = NullExecutionSink>
+    requires ExecutionSink<Sink>
+  bool add_order(uint64_t id, uint64_t price, uint32_t qty, Side side,
+                 Sink &&on_execution = {}) noexcept {
+    if (id == kInvalidOrderId || order_map_.contains(id)) {
+      return false;
+    }
+
+    const uint32_t remaining_qty =
+        (side == Side::Buy) ? match_buy(id, price, qty, on_execution)
+                            : match_sell(id, price, qty, on_execution);
+
+    if (remaining_qty == 0) {
+      return true;
+    }
+
+    return rest_new_order(id, price, remaining_qty, side);
+  }
+
+  /**
+   * @brief Rest an order without matching (see OrderBook::insert_order).
+   */
+  bool insert_order(uint64_t id, uint64_t price, uint32_t qty,
+                    Side side) noexcept {
+    if (id == kInvalidOrderId || order_map_.contains(id)) {
+      return false;
+    }
+    return rest_new_order(id, price, qty, side);
+  }
+
+  // ========================================================================
+  // Order Cancellation / Modification
+  // ========================================================================
+
+  /**
+   * @brief Cancel an existing order.
+   *
+   * Complexity: O(1) for in-window prices (slot computed from price)
+   */
+  bool cancel_order(uint64_t id) noexcept {
+    Order *const *found = order_map_.find(id);
+    if (found == nullptr) {
+      return false;
+    }
+
+    Order *order = *found;
+    order_map_.erase(id);
+    remove_from_level(order);
+    pool_.deallocate(order);
+    return true;
+  }
+
+  /**
+   * @brief Reduce a resting order's quantity (see OrderBook::reduce_order).
+   */
+  bool reduce_order(uint64_t id, uint32_t qty) noexcept {
+    Order *const *found = order_map_.find(id);
+    if (found == nullptr) {
+      return false;
+    }
+
+    Order *order = *found;
+    if (qty < order->qty) {
+      level_of(order).reduce_volume(qty);
+      order->reduce_qty(qty);
+      return true;
+    }
+
+    order_map_.erase(id);
+    remove_from_level(order);
+    pool_.deallocate(order);
+    return true;
+  }
+
+  /**
+   * @brief Replace a resting order (see OrderBook::replace_order).
+   */
+  bool replace_order(uint64_t old_id, uint64_t new_id, uint64_t price,
+                     uint32_t qty) noexcept {
+    Order *const *found = order_map_.find(old_id);
+    if (found == nullptr) {
+      return false;
+    }
+    if (new_id == kInvalidOrderId ||
+        (new_id != old_id && order_map_.contains(new_id))) {
+      return false;
+    }
+
+    const Side side = (*found)->get_side();
+    cancel_order(old_id);
+    return add_order(new_id, price, qty, side);
+  }
+
+  /**
+   * @brief Replace without matching (see OrderBook::replace_passive).
+   */
+  ReplaceResult replace_passive(uint64_t old_id, uint64_t new_id,
+                                uint64_t price, uint32_t qty) noexcept {
+    Order *const *found = order_map_.find(old_id);
+    if (found == nullptr) {
+      return ReplaceResult::UnknownOrder;
+    }
+    if (new_id == kInvalidOrderId ||
+        (new_id != old_id && order_map_.contains(new_id))) {
+      return ReplaceResult::Rejected;
+    }
+
+    const Side side = (*found)->get_side();
+    cancel_order(old_id);
+    return rest_new_order(new_id, price, qty, side) ? ReplaceResult::Applied
+                                                    : ReplaceResult::Rejected;
+  }
+
+  // ========================================================================
+  // Market Data Accessors
+  // ========================================================================
+
+  [[nodiscard]] std::optional<uint64_t> best_bid() const noexcept {
+    const PriceLevel *level = best_level(Side::Buy);
+    if (level == nullptr) {
+      return std::nullopt;
+    }
+    return level->price;
+  }
+
+  [[nodiscard]] std::optional<uint64_t> best_ask() const noexcept {
+    const PriceLevel *level = best_level(Side::Sell);
+    if (level == nullptr) {
+      return std::nullopt;
+    }
+    return level->price;
+  }
+
+  [[nodiscard]] std::optional<uint64_t> spread() const noexcept {
+    auto bid = best_bid();
+    auto ask = best_ask();
+    if (!bid || !ask) {
+      return std::nullopt;
+    }
+    return *ask - *bid;
+  }
+
+  [[nodiscard]] uint64_t best_bid_volume() const noexcept {
+    const PriceLevel *level = best_level(Side::Buy);
+    return level == nullptr ? 0 : level->total_volume;
+  }
+
+  [[nodiscard]] uint64_t best_ask_volume() const noexcept {
+    const PriceLevel *level = best_level(Side::Sell);
+    return level == nullptr ? 0 : level->total_volume;
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return order_map_.empty(); }
+
+  [[nodiscard]] std::size_t order_count() const noexcept {
+    return order_map_.size();
+  }
+
+  [[nodiscard]] std::size_t bid_level_count() const noexcept {
+    return bid_ring_levels_ + bid_overflow_.size();
+  }
+
+  [[nodiscard]] std::size_t ask_level_count() const noexcept {
+    return ask_ring_levels_ + ask_overflow_.size();
+  }
+
+  // ========================================================================
+  // Ladder Introspection
+  // ========================================================================
+
+  [[nodiscard]] uint64_t tick_size() const noexcept { return tick_size_; }
+
+  /**
+   * @brief Lowest price covered by the ring window.
+   */
+  [[nodiscard]] uint64_t window_low() const noexcept {
+    return base_tick_ * tick_size_;
+  }
+
+  /**
+   * @brief Highest price covered by the ring window.
+   */
+  [[nodiscard]] uint64_t window_high() const noexcept {
+    return (base_tick_ + LadderTicks - 1) * tick_size_;
+  }
+
+  /**
+   * @brief Number of levels currently held outside the ring.
+   */
+  [[nodiscard]] std::size_t overflow_level_count() const noexcept {
+    return bid_overflow_.size() + ask_overflow_.size();
+  }
+
+private:
+  static constexpr std::size_t kMask = LadderTicks - 1;
+
+  // ========================================================================
+  // Data Members
+  // ========================================================================
+
+  std::vector<PriceLevel> bid_ring_; ///< Bid levels, slot = tick & kMask
+  std::vector<PriceLevel> ask_ring_; ///< Ask levels, slot = tick & kMask
+  LevelBitmap<LadderTicks> bid_bits_; ///< Non-empty bid slots
+  LevelBitmap<LadderTicks> ask_bits_; ///< Non-empty ask slots
+  std::size_t bid_ring_levels_ = 0;
+  std::size_t ask_ring_levels_ = 0;
+
+  std::vector<PriceLevel> bid_overflow_; ///< Sorted descending (best first)
+  std::vector<PriceLevel> ask_overflow_; ///< Sorted ascending (best first)
+
+  FlatOrderIndex<Order *> order_map_; ///< ID -> Order* (preallocated)
+  PoolType &pool_; ///< Reference to memory pool
+
+  uint64_t tick_size_;
+  uint64_t base_tick_ = 0; ///< First tick of the ring window
+  bool anchored_ = false;  ///< Window placed around the first resting price
+
+  // ========================================================================
+  // Price <-> Slot Mapping
+  // ========================================================================
+
+  [[nodiscard]] bool in_window(uint64_t price) const noexcept {
+    if (!anchored_ || price % tick_size_ != 0) {
+      return false;
+    }
+    const uint64_t tick = price / tick_size_;
+    return tick >= base_tick_ && tick - base_tick_ < LadderTicks;
+  }
+
+  [[nodiscard]] static std::size_t slot_of_tick(uint64_t tick) noexcept {
+    return static_cast<std::size_t>(tick & kMask);
+  }
+
+  [[nodiscard]] uint64_t tick_of_slot(std::size_t slot) const noexcept {
+    return base_tick_ + ((slot - slot_of_tick(base_tick_)) & kMask);
+  }
+
+  /**
+   * @brief Best non-empty ring slot on a side (logical window order).
+   *
+   * The window starts at physical slot b = base & mask, so logical order
+   * is [b, N) followed by [0, b).
+   */
+  [[nodiscard]] std::size_t best_ring_slot(Side side) const noexcept {
+    const std::size_t b = slot_of_tick(base_tick_);
+    if (side == Side::Buy) {
+      std::size_t slot = bid_bits_.find_last_below(b);
+      if (slot == bid_bits_.npos) {
+        slot = bid_bits_.find_last_below(LadderTicks);
+      }
+      return slot;
+    }
+    std::size_t slot = ask_bits_.find_first_from(b);
+    if (slot == ask_bits_.npos) {
+      slot = ask_bits_.find_first_from(0);
+    }
+    return slot;
+  }
+
+  /**
+   * @brief Best level on a side across ring and overflow, or nullptr.
+   */
+  [[nodiscard]] PriceLevel *best_level(Side side) noexcept {
+    const bool buy = side == Side::Buy;
+    std::vector<PriceLevel> &ring = buy ? bid_ring_ : ask_ring_;
+    std::vector<PriceLevel> &overflow = buy ? bid_overflow_ : ask_overflow_;
+
+    const std::size_t slot = best_ring_slot(side);
+    PriceLevel *ring_best =
+        (slot == LevelBitmap<LadderTicks>::npos) ? nullptr : &ring[slot];
+    if (overflow.empty()) {
+      return ring_best;
+    }
+    PriceLevel *overflow_best = &overflow.front();
+    if (ring_best == nullptr) {
+      return overflow_best;
+    }
+    const bool overflow_better = buy ? overflow_best->price > ring_best->price
+                                     : overflow_best->price < ring_best->price;
+    return overflow_better ? overflow_best : ring_best;
+  }
+
+  [[nodiscard]] const PriceLevel *best_level(Side side) const noexcept {
+    return const_cast<BasicLadderOrderBook *>(this)->best_level(side);
+  }
+
+  // ========================================================================
+  // Level Management
+  // ========================================================================
+
+  /**
+   * @brief Find the level holding a resting order.
+   */
+  [[nodiscard]] PriceLevel &level_of(const Order *order) noexcept {
+    const bool buy = order->is_buy();
+    if (in_window(order->price)) {
+      std::vector<PriceLevel> &ring = buy ? bid_ring_ : ask_ring_;
+      return ring[slot_of_tick(order->price / tick_size_)];
+    }
+    std::vector<PriceLevel> &overflow = buy ? bid_overflow_ : ask_overflow_;
+    return *overflow_find(overflow, order->price, buy);
+  }
+
+  [[nodiscard]] static std::vector<PriceLevel>::iterator
+  overflow_find(std::vector<PriceLevel> &overflow, uint64_t price,
+                bool descending) noexcept {
+    if (descending) {
+      return std::lower_bound(overflow.begin(), overflow.end(), price,
+                              [](const PriceLevel &level, uint64_t p) {
+                                return level.price > p;
+                              });
+    }
+    return std::lower_bound(
+        overflow.begin(), overflow.end(), price,
+        [](const PriceLevel &level, uint64_t p) { return level.price < p; });
+  }
+
+  /**
+   * @brief Allocate an order, rest it and index it (no matching).
+   */
+  bool rest_new_order(uint64_t id, uint64_t price, uint32_t qty,
+                      Side side) noexcept {
+    // Grow before allocating (see BasicOrderBook::rest_new_order)
+    if (order_map_.size() == order_map_.max_entries()) [[unlikely]] {
+      const std::size_t grown =
+          std::max<std::size_t>(order_map_.max_entries(), 8) * 2;
+      if (!try_allocate([&] { order_map_.reserve(grown); })) {
+        return false;
+      }
+    }
+
+    Order *order = pool_.allocate();
+    if (order == nullptr) {
+      return false; // Pool exhausted
+    }
+
+    order->id = id;
+    order->price = price;
+    order->qty = qty;
+    order->side = static_cast<char>(side);
+
+    rest_order(order);
+    if (!order_map_.insert(id, order)) [[unlikely]] {
+      remove_from_level(order); // Unindexed orders could never be cancelled
+      pool_.deallocate(order);
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Place a resting order, re-centring the window on a new touch.
+   */
+  void rest_order(Order *order) noexcept {
+    const bool buy = order->is_buy();
+    const uint64_t price = order->price;
+
+    if (price % tick_size_ == 0 && !in_window(price)) {
+      const Side side = order->get_side();
+      const PriceLevel *best = best_level(side);
+      const bool new_touch =
+          best == nullptr || (buy ? price > best->price : price < best->price);
+      if (!anchored_ || new_touch) {
+        rebase(price / tick_size_);
+      }
+    }
+
+    if (in_window(price)) {
+      const std::size_t slot = slot_of_tick(price / tick_size_);
+      PriceLevel &level = buy ? bid_ring_[slot] : ask_ring_[slot];
+      LevelBitmap<LadderTicks> &bits = buy ? bid_bits_ : ask_bits_;
+      if (!bits.test(slot)) {
+        level.price = price;
+        level.total_volume = 0;
+        bits.set(slot);
+        ++(buy ? bid_ring_levels_ : ask_ring_levels_);
+      }
+      level.add_order(order);
+      return;
+    }
+
+    std::vector<PriceLevel> &overflow = buy ? bid_overflow_ : ask_overflow_;
+    auto it = overflow_find(overflow, price, buy);
+    if (it == overflow.end() || it->price != price) {
+      it = overflow.insert(it, PriceLevel(price));
+    }
+    it->add_order(order);
+  }
+
+  /**
+   * @brief Remove an order from its level, releasing the level if empty.
+   */
+  void remove_from_level(Order *order) noexcept {
+    PriceLevel &level = level_of(order);
+    level.remove_order(order);
+    if (level.empty()) {
+      release_level(order->get_side(), &level);
+    }
+  }
+
+  /**
+   * @brief Release an empty level (clear ring bit or erase overflow entry).
+   */
+  void release_level(Side side, PriceLevel *level) noexcept {
+    const bool buy = side == Side::Buy;
+    // Ring levels are exactly those whose price maps into the window
+    if (in_window(level->price)) {
+      (buy ? bid_bits_ : ask_bits_)
+          .clear(slot_of_tick(level->price / tick_size_));
+      --(buy ? bid_ring_levels_ : ask_ring_levels_);
+      return;
+    }
+    std::vector<PriceLevel> &overflow = buy ? bid_overflow_ : ask_overflow_;
+    overflow.erase(overflow.begin() + (level - overflow.data()));
+  }
+
+  /**
+   * @brief Re-centre the ring window on a tick.
+   *
+   * Levels leaving the window move to the overflow; overflow levels now
+   * inside the window move into the ring. Slots staying in the window are
+   * untouched (slot = tick & mask is independent of the base).
+   */
+  void rebase(uint64_t center_tick) noexcept {
+    const uint64_t half = LadderTicks / 2;
+    const uint64_t new_base = center_tick > half ? center_tick - half : 0;
+
+    if (anchored_) {
+      evict_outside(Side::Buy, new_base);
+      evict_outside(Side::Sell, new_base);
+    }
+    base_tick_ = new_base;
+    anchored_ = true;
+    admit_inside(Side::Buy);
+    admit_inside(Side::Sell);
+  }
+
+  void evict_outside(Side side, uint64_t new_base) noexcept {
+    const bool buy = side == Side::Buy;
+    std::vector<PriceLevel> &ring = buy ? bid_ring_ : ask_ring_;
+    LevelBitmap<LadderTicks> &bits = buy ? bid_bits_ : ask_bits_;
+    std::vector<PriceLevel> &overflow = buy ? bid_overflow_ : ask_overflow_;
+
+    for (std::size_t slot = bits.find_first_from(0); slot != bits.npos;
+         slot = bits.find_first_from(slot + 1)) {
+      const uint64_t tick = tick_of_slot(slot);
+      if (tick >= new_base && tick - new_base < LadderTicks) {
+        continue;
+      }
+      auto it = overflow_find(overflow, ring[slot].price, buy);
+      overflow.insert(it, std::move(ring[slot]));
+      bits.clear(slot);
+      --(buy ? bid_ring_levels_ : ask_ring_levels_);
+    }
+  }
+
+  void admit_inside(Side side) noexcept {
+    const bool buy = side == Side::Buy;
+    std::vector<PriceLevel> &ring = buy ? bid_ring_ : ask_ring_;
+    LevelBitmap<LadderTicks> &bits = buy ? bid_bits_ : ask_bits_;
+    std::vector<PriceLevel> &overflow = buy ? bid_overflow_ : ask_overflow_;
+
+    auto keep = overflow.begin();
+    for (auto it = overflow.begin(); it != overflow.end(); ++it) {
+      if (in_window(it->price)) {
+        const std::size_t slot = slot_of_tick(it->price / tick_size_);
+        ring[slot] = std::move(*it);
+        bits.set(slot);
+        ++(buy ? bid_ring_levels_ : ask_ring_levels_);
+      } else {
+        if (keep != it) {
+          *keep = std::move(*it);
+        }
+        ++keep;
+      }
+    }
+    overflow.erase(keep, overflow.end());
+  }
+
+  // ========================================================================
+  // Matching Logic
+  // ========================================================================
+
+  template <typename Sink>
+  uint32_t match_buy(uint64_t taker_id, uint64_t price, uint32_t qty,
+                     Sink &on_execution) noexcept {
+    uint32_t remaining = qty;
+    while (remaining > 0) {
+      PriceLevel *level = best_level(Side::Sell);
+      if (level == nullptr || price < level->price) {
+        break;
+      }
+      remaining =
+          match_at_level(*level, taker_id, remaining, Side::Sell, on_execution);
+      if (level->empty()) {
+        release_level(Side::Sell, level);
+      }
+    }
+    return remaining;
+  }
+
+  template <typename Sink>
+  uint32_t match_sell(uint64_t taker_id, uint64_t price, uint32_t qty,
+                      Sink &on_execution) noexcept {
+    uint32_t remaining = qty;
+    while (remaining > 0) {
+      PriceLevel *level = best_level(Side::Buy);
+      if (level == nullptr || price > level->price) {
+        break;
+      }
+      remaining =
+          match_at_level(*level, taker_id, remaining, Side::Buy, on_execution);
+      if (level->empty()) {
+        release_level(Side::Buy, level);
+      }
+    }
+    return remaining;
+  }
+
+  template <typename Sink>
+  uint32_t match_at_level(PriceLevel &level, uint64_t taker_id, uint32_t qty,
+                          Side maker_side, Sink &on_execution) noexcept {
+    uint32_t remaining = qty;
+
+    while (remaining > 0 && !level.empty()) {
+      Order &maker = level.orders.front();
+      uint32_t fill_qty = std::min(remaining, maker.qty);
+
+      emit_execution(on_execution, Execution{.maker_id = maker.id,
+                                             .taker_id = taker_id,
+                                             .price = level.price,
+                                             .qty = fill_qty,
+                                             .maker_side = maker_side});
+
+      remaining -= fill_qty;
+      level.reduce_volume(fill_qty);
+      maker.reduce_qty(fill_qty);
+
+      if (maker.is_filled()) {
+        Order *filled_order = &maker;
+        level.orders.pop_front();
+        order_map_.erase(filled_order->id);
+        pool_.deallocate(filled_order);
+      }
+    }
+
+    return remaining;
+  }
+};
+
+/**
+ * @brief Ladder book over a fixed-capacity MemPool (the original interface).
+ *
+ * @tparam Capacity Maximum number of orders the pool can hold
+ * @tparam LadderTicks Ring size in ticks per side (power of two, <= 4096)
+ * @tparam Allocation MemPool storage policy (see pool_allocation.hpp)
+ */
+template <std::size_t Capacity, std::size_t LadderTicks = 4096,
+          typename Allocation = HeapAllocation>
+using LadderOrderBook =
+    BasicLadderOrderBook<MemPool<Order, Capacity, Allocation>, LadderTicks>;
+
+} // namespace book
@@ -0,0 +1,162 @@
+#pragma once
+
+/**
+ * @file market_by_order.hpp
+ * @brief Passive market-by-order book builder driven by ITCH order events.
+ *
+ * DESIGN PRINCIPLES:
+ * 1. The exchange has already matched - apply events, never run matching.
+ * 2. Key every order by the exchange order_ref (unique across the feed).
+ * 3. Route by stock_locate through BookManager (one book per symbol).
+ * 4. Count events the book could not apply instead of failing silently.
+ *
+ * EVENT MAPPING:
+ *   A / F  Add order            -> insert_order(ref, price, shares, side)
+ *   E / C  Executed (w/o price) -> reduce_order(ref, executed_shares)
+ *   X      Partial cancel       -> reduce_order(ref, cancelled_shares)
+ *   D      Delete               -> cancel_order(ref)
+ *   U      Replace              -> replace_passive(orig, new, price, shares)
+ */
+
+#include "book_manager.hpp"
+#include "types.hpp"
+#include <cstdint>
+#include <itch/messages.hpp>
+#include <itch/parser.hpp>
+
+namespace book {
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+/**
+ * @brief Per-event counters for a market-by-order replay.
+ */
+struct MarketByOrderStats {
+  uint64_t adds = 0;       ///< A and F applied
+  uint64_t executions = 0; ///< E and C applied
+  uint64_t cancels = 0;    ///< X applied
+  uint64_t deletes = 0;    ///< D applied
+  uint64_t replaces = 0;   ///< U applied
+  uint64_t rejected = 0;   ///< Adds/replaces refused (live ref, pool full)
+  uint64_t unknown = 0;    ///< Events for an order that is not in the book
+
+  /// Order events seen (applied or not)
+  [[nodiscard]] uint64_t messages() const noexcept {
+    return adds + executions + cancels + deletes + replaces + rejected +
+           unknown;
+  }
+};
+
+// ============================================================================
+// MarketByOrderVisitor - Parser Visitor Maintaining Per-Symbol Books
+// ============================================================================
+
+/**
+ * @brief Parser visitor that mirrors the exchange book order by order.
+ *
+ * Unlike the matching replay, an add that would cross is queued as
+ * published, and executions reduce the referenced order rather than
+ * removing it outright.
+ *
+ * @tparam Book Book engine providing insert_order / reduce_order /
+ *         cancel_order / replace_passive (OrderBook or LadderOrderBook)
+ *
+ * @example
+ *   BookManager<OrderBook<N>> books(pool);
+ *   MarketByOrderVisitor<OrderBook<N>> visitor(books);
+ *   parser.parse(msg, len, visitor);
+ */
+template <typename Book>
+class MarketByOrderVisitor : public itch::DefaultVisitor {
+public:
+  using BookType = Book;
+  using Manager = BookManager<Book>;
+
+  explicit MarketByOrderVisitor(Manager &books) noexcept : books_(books) {}
+
+  // ========================================================================
+  // Order Events
+  // ========================================================================
+
+  void on_add_order(const itch::AddOrder &msg) { add(msg); }
+
+  void on_add_order_mpid(const itch::AddOrderMPID &msg) { add(msg); }
+
+  void on_order_executed(const itch::OrderExecuted &msg) {
+    count(reduce(msg.stock_locate, msg.order_ref, msg.executed_shares),
+          stats_.executions);
+  }
+
+  void on_order_executed_with_price(const itch::OrderExecutedWithPrice &msg) {
+    count(reduce(msg.stock_locate, msg.order_ref, msg.executed_shares),
+          stats_.executions);
+  }
+
+  void on_order_cancel(const itch::OrderCancel &msg) {
+    count(reduce(msg.stock_locate, msg.order_ref, msg.cancelled_shares),
+          stats_.cancels);
+  }
+
+  void on_order_delete(const itch::OrderDelete &msg) {
+    Book *book = books_.find(msg.stock_locate);
+    count(book != nullptr && book->cancel_order(msg.order_ref),
+          stats_.deletes);
+  }
+
+  void on_order_replace(const itch::OrderReplace &msg) {
+    Book *book = books_.find(msg.stock_locate);
+    if (book == nullptr) {
+      ++stats_.unknown;
+      return;
+    }
+    switch (book->replace_passive(msg.original_order_ref, msg.new_order_ref,
+                                  msg.price, msg.shares)) {
+    case ReplaceResult::Applied:
+      ++stats_.replaces;
+      break;
+    case ReplaceResult::UnknownOrder:
+      ++stats_.unknown;
+      break;
+    case ReplaceResult::Rejected:
+      ++stats_.rejected;
+      break;
+    }
+  }
+
+  // ========================================================================
+  // Accessors
+  // ========================================================================
+
+  [[nodiscard]] const MarketByOrderStats &stats() const noexcept {
+    return stats_;
+  }
+
+  [[nodiscard]] Manager &books() noexcept { return books_; }
+
+private:
+  template <typename AddMsg> void add(const AddMsg &msg) {
+    const Side side = msg.is_buy() ? Side::Buy : Side::Sell;
+    if (books_.book(msg.stock_locate)
+            .insert_order(msg.order_ref, msg.price, msg.shares, side)) {
+      ++stats_.adds;
+    } else {
+      ++stats_.rejected;
+    }
+  }
+
+  bool reduce(uint16_t locate, uint64_t order_ref, uint32_t shares) noexcept {
+    Book *book = books_.find(locate);
+    return book != nullptr && book->reduce_order(order_ref, shares);
+  }
+
+  void count(bool applied, uint64_t &counter) noexcept {
+    ++(applied ? counter : stats_.unknown);
+  }
+
+  Manager &books_;
+  MarketByOrderStats stats_;
+};
+
+} // namespace book
@@ -9,19 +9,37 @@
  * 2. O(1) allocation/deallocation via index-based free list.
  * 3. Cache-friendly - objects stored contiguously in memory.
  * 4. No OS calls during trading - pure integer arithmetic.
+ * 5. Pluggable storage - an Allocation policy (pool_allocation.hpp) picks
+ *    heap or huge-page memory and NUMA placement.
+ * 6. Optional lazy start - never-used slots come from a bump pointer and
+ *    the free list only holds recycled ones, so a lazy pool constructs in
+ *    O(1) and pages fault in as the book grows.
  *
  * USAGE:
  *   MemPool<Order, 1'000'000> pool;  // Pre-allocate 1M orders
  *   Order* order = pool.allocate();  // O(1) - pop from free stack
  *   pool.deallocate(order);          // O(1) - push to free stack
+ *
+ *   MemPool<Order, 1'000'000, HugePageAllocation> big({.numa_node = 1});
+ *   MemPool<Order, 1'000'000> lazy({}, PoolInit::Lazy);  // O(1) startup
  */
 
+#include "pool_allocation.hpp"
 #include <cstddef>
+#include <cstdint>
+#include <new>
 #include <type_traits>
-#include <vector>
 
 namespace book {
 
+/**
+ * @brief When a pool constructs its slots and faults in its pages.
+ */
+enum class PoolInit : uint8_t {
+  Eager, ///< Construct every slot (and pre-fault) in the constructor
+  Lazy,  ///< Construct each slot on first allocation; no pre-fault
+};
+
 // ============================================================================
 // MemPool - Pre-allocated Object Pool
 // ============================================================================
@@ -31,16 +49,20 @@ namespace book {
  *
  * This pool allocates a contiguous block of memory at construction time
  * and manages object recycling through an index-based free list (stack).
+ * Slots never handed out yet are taken from a bump pointer (in index
+ * order), so the free stack only ever holds recycled slots.
  *
  * Key properties:
  * - Single allocation at startup (no malloc during trading)
- * - O(1) allocate: pop index from free stack
+ * - O(1) allocate: pop index from free stack, else bump the next unused
  * - O(1) deallocate: push index to free stack
  * - Cache-friendly: objects are stored contiguously
  * - No fragmentation: fixed-size objects in fixed locations
  *
  * @tparam T Object type (must be default constructible)
  * @tparam Capacity Maximum number of objects the pool can hold
+ * @tparam Allocation Storage policy for the object and free-list arrays
+ *         (HeapAllocation or HugePageAllocation)
  *
  * @note Objects are NOT constructed on allocate() or destroyed on deallocate().
  *       The caller is responsible for placement new and explicit destructor
@@ -57,7 +79,8 @@ namespace book {
  *   // Deallocate (no destruction - just marks slot as free)
  *   pool.deallocate(order);
  */
-template <typename T, std::size_t Capacity>
+template <typename T, std::size_t Capacity,
+          typename Allocation = HeapAllocation>
   requires std::is_default_constructible_v<T>
 class MemPool {
 public:
@@ -69,6 +92,7 @@ public:
   using size_type = std::size_t;
   using pointer = T *;
   using const_pointer = const T *;
+  using AllocationType = Allocation;
 
   // ========================================================================
   // Construction
@@ -80,15 +104,31 @@ public:
    * Allocates `Capacity` objects and initializes free list with all indices.
    * This is the ONLY allocation that happens - nothing during trading.
    *
+   * @param placement NUMA node and pre-fault request (used by mapping
+   *        policies; HeapAllocation ignores it)
+   * @param init Eager: value-initialize every slot now. Lazy: reserve
+   *        address space only; each slot is value-initialized when first
+   *        allocated and pre-faulting is skipped.
+   *
    * @note This may throw std::bad_alloc if allocation fails.
    */
-  MemPool() : buffer_(Capacity), free_list_(Capacity) {
-    // Initialize free list: [Capacity-1, Capacity-2, ..., 1, 0]
-    // Stack order means index 0 will be allocated first (LIFO)
+  explicit MemPool(const PoolPlacement &placement = {},
+                   PoolInit init = PoolInit::Eager)
+      : objects_(Allocation::allocate(Capacity * sizeof(T), alignof(T),
+                                      effective(placement, init))),
+        indices_(Allocation::allocate(Capacity * sizeof(size_type),
+                                      alignof(size_type),
+                                      effective(placement, init))),
+        buffer_(static_cast<T *>(objects_.data)),
+        free_list_(static_cast<size_type *>(indices_.data)),
+        lazy_(init == PoolInit::Lazy) {
+    if (lazy_) {
+      return;
+    }
+    // Value-initialize every slot, as std::vector<T>(Capacity) did
     for (size_type i = 0; i < Capacity; ++i) {
-      free_list_[i] = Capacity - 1 - i;
+      ::new (static_cast<void *>(buffer_ + i)) T();
     }
-    free_count_ = Capacity;
   }
 
   // Non-copyable (owns unique memory)
@@ -99,7 +139,16 @@ public:
   MemPool(MemPool &&) = delete;
   MemPool &operator=(MemPool &&) = delete;
 
-  ~MemPool() = default;
+  ~MemPool() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      const size_type constructed = lazy_ ? next_unused_ : Capacity;
+      for (size_type i = 0; i < constructed; ++i) {
+        buffer_[i].~T();
+      }
+    }
+    Allocation::release(indices_);
+    Allocation::release(objects_);
+  }
 
   // ========================================================================
   // Capacity
@@ -116,23 +165,38 @@ public:
    * @brief Number of currently allocated objects.
    */
   [[nodiscard]] size_type allocated() const noexcept {
-    return Capacity - free_count_;
+    return next_unused_ - free_count_;
   }
 
   /**
    * @brief Number of free slots available.
    */
-  [[nodiscard]] size_type available() const noexcept { return free_count_; }
+  [[nodiscard]] size_type available() const noexcept {
+    return Capacity - allocated();
+  }
 
   /**
    * @brief Check if pool is empty (all slots free).
    */
-  [[nodiscard]] bool empty() const noexcept { return free_count_ == Capacity; }
+  [[nodiscard]] bool empty() const noexcept { return allocated() == 0; }
 
   /**
    * @brief Check if pool is full (no slots free).
    */
-  [[nodiscard]] bool full() const noexcept { return free_count_ == 0; }
+  [[nodiscard]] bool full() const noexcept { return allocated() == Capacity; }
+
+  /**
+   * @brief Slots ever handed out (the bump pointer). In a lazy pool only
+   *        these have been constructed and faulted in.
+   */
+  [[nodiscard]] size_type high_water_mark() const noexcept {
+    return next_unused_;
+  }
+
+  /**
+   * @brief True if slots are constructed on first allocation.
+   */
+  [[nodiscard]] bool lazy() const noexcept { return lazy_; }
 
   // ========================================================================
   // Allocation
@@ -143,7 +207,8 @@ public:
    *
    * @return Pointer to uninitialized object, or nullptr if pool is full.
    *
-   * Complexity: O(1) - just pops an index from the free stack.
+   * Complexity: O(1) - pops a recycled index from the free stack, or
+   * takes the next never-used slot.
    *
    * @note The returned memory is NOT constructed. For non-POD types,
    *       use placement new: `new (ptr) T(args...)`.
@@ -157,15 +222,21 @@ public:
    * @endcode
    */
   [[nodiscard]] pointer allocate() noexcept {
-    if (free_count_ == 0) [[unlikely]] {
+    if (free_count_ > 0) {
+      // Pop a recycled index from the free stack
+      --free_count_;
+      return &buffer_[free_list_[free_count_]];
+    }
+    if (next_unused_ == Capacity) [[unlikely]] {
       return nullptr;
     }
 
-    // Pop index from free stack
-    --free_count_;
-    const size_type index = free_list_[free_count_];
-
-    return &buffer_[index];
+    // First use of this slot (index order, as the eager stack was filled)
+    pointer slot = buffer_ + next_unused_++;
+    if (lazy_) {
+      ::new (static_cast<void *>(slot)) T();
+    }
+    return slot;
   }
 
   /**
@@ -184,7 +255,7 @@ public:
    */
   void deallocate(pointer ptr) noexcept {
     // Calculate index from pointer
-    const size_type index = static_cast<size_type>(ptr - buffer_.data());
+    const size_type index = static_cast<size_type>(ptr - buffer_);
 
     // Push index to free stack
     free_list_[free_count_] = index;
@@ -201,7 +272,31 @@ public:
    * Useful for debug assertions.
    */
   [[nodiscard]] bool owns(const_pointer ptr) const noexcept {
-    return ptr >= buffer_.data() && ptr < buffer_.data() + Capacity;
+    return ptr >= buffer_ && ptr < buffer_ + Capacity;
+  }
+
+  /**
+   * @brief Slot index of a pool object (inverse of at()).
+   *
+   * Lets containers link pool objects through 32-bit indices instead of
+   * 64-bit pointers.
+   *
+   * @pre owns(ptr)
+   */
+  [[nodiscard]] size_type index_of(const_pointer ptr) const noexcept {
+    return static_cast<size_type>(ptr - buffer_);
+  }
+
+  /**
+   * @brief Object at a slot index (allocated or not).
+   *
+   * @pre index < Capacity (and index < high_water_mark() in a lazy pool,
+   *      whose never-used slots are raw storage)
+   */
+  [[nodiscard]] T &at(size_type index) noexcept { return buffer_[index]; }
+
+  [[nodiscard]] const T &at(size_type index) const noexcept {
+    return buffer_[index];
   }
 
   /**
@@ -209,20 +304,64 @@ public:
    *
    * Useful for cache analysis and debugging.
    */
-  [[nodiscard]] pointer data() noexcept { return buffer_.data(); }
+  [[nodiscard]] pointer data() noexcept { return buffer_; }
+
+  [[nodiscard]] const_pointer data() const noexcept { return buffer_; }
+
+  // ========================================================================
+  // Placement
+  // ========================================================================
+
+  /**
+   * @brief Page size backing the object array (what the policy obtained).
+   */
+  [[nodiscard]] PageBacking page_backing() const noexcept {
+    return objects_.backing;
+  }
+
+  /**
+   * @brief True if both arrays were bound to the requested NUMA node.
+   */
+  [[nodiscard]] bool numa_bound() const noexcept {
+    return objects_.numa_bound && indices_.numa_bound;
+  }
 
-  [[nodiscard]] const_pointer data() const noexcept { return buffer_.data(); }
+  /**
+   * @brief Bytes reserved for objects and free list (after rounding).
+   */
+  [[nodiscard]] size_type reserved_bytes() const noexcept {
+    return objects_.bytes + indices_.bytes;
+  }
 
 private:
+  // Regions owned by the pool (released through the policy)
+  PoolRegion objects_;
+  PoolRegion indices_;
+
   // Contiguous storage for all objects
-  std::vector<T> buffer_;
+  T *buffer_;
 
-  // Free list as stack of indices
+  // Free list as stack of recycled indices
   // free_list_[0..free_count_-1] contain available indices
-  std::vector<size_type> free_list_;
+  size_type *free_list_;
 
-  // Number of free slots (also serves as stack top index)
+  // Number of recycled slots (also serves as stack top index)
   size_type free_count_ = 0;
+
+  // Slots [next_unused_, Capacity) have never been handed out
+  size_type next_unused_ = 0;
+
+  // Construct slots on first allocation instead of up front
+  bool lazy_ = false;
+
+  /// Lazy pools must not pre-fault: that would touch every page now
+  static PoolPlacement effective(PoolPlacement placement,
+                                 PoolInit init) noexcept {
+    if (init == PoolInit::Lazy) {
+      placement.prefault = false;
+    }
+    return placement;
+  }
 };
 
 // ============================================================================
@@ -6,9 +6,12 @@
  *
  * DESIGN PRINCIPLES:
  * 1. Vector-based price levels for cache-friendly linear iteration.
- * 2. Hash map for O(1) order cancellation by ID.
+ * 2. Flat open-addressing index for O(1) order cancellation by ID.
  * 3. Price-Time Priority: best price first, FIFO within price level.
- * 4. Zero allocation during trading (uses external MemPool).
+ * 4. Zero allocation during trading (uses an external MemPool, or a
+ *    SegmentedPool that only allocates when it grows).
+ * 5. Levels live at stable indices; each order's map entry carries its
+ *    level index so cancel/reduce/replace never search the ladder.
  *
  * MATCHING RULES:
  * - Buy orders match against asks if buy_price >= best_ask
@@ -18,12 +21,16 @@
  */
 
 #include "memory_pool.hpp"
+#include "order_index.hpp"
 #include "price_level.hpp"
 #include "types.hpp"
 #include <algorithm>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
-#include <unordered_map>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 namespace book {
@@ -46,16 +53,149 @@ struct Execution {
 };
 
 // ============================================================================
-// OrderBook - Limit Order Book with Matching Engine
+// Execution Sinks
+// ============================================================================
+
+/**
+ * @brief Anything add_order() can report executions to.
+ *
+ * The sink is a template parameter, so a lambda or functor is called
+ * directly (and inlined) inside the matching loop and may carry state.
+ * Plain function pointers (ExecutionCallback) still work; a null one is
+ * skipped. Sinks run inside noexcept book calls and must not throw.
+ */
+template <typename Sink>
+concept ExecutionSink = std::invocable<Sink &, const Execution &>;
+
+/**
+ * @brief Default sink: executions are not reported (compiles to nothing).
+ */
+struct NullExecutionSink {
+  constexpr void operator()(const Execution & /*exec*/) const noexcept {}
+};
+
+/**
+ * @brief Sink that appends executions to a caller-provided buffer.
+ *
+ * Executions beyond the buffer are counted in dropped(), never written,
+ * so size the buffer for the deepest sweep expected.
+ *
+ * @example
+ *   std::array<Execution, 256> fills;
+ *   ExecutionBuffer sink(fills);
+ *   book.add_order(id, price, qty, Side::Buy, sink);
+ *   for (const Execution &fill : sink.executions()) { publish(fill); }
+ */
+class ExecutionBuffer {
+public:
+  explicit ExecutionBuffer(std::span<Execution> storage) noexcept
+      : storage_(storage) {}
+
+  void operator()(const Execution &exec) noexcept {
+    if (size_ < storage_.size()) [[likely]] {
+      storage_[size_++] = exec;
+    } else {
+      ++dropped_;
+    }
+  }
+
+  /// Executions stored since the last clear(), in match order
+  [[nodiscard]] std::span<const Execution> executions() const noexcept {
+    return storage_.first(size_);
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+  /// Executions that did not fit in the buffer
+  [[nodiscard]] std::size_t dropped() const noexcept { return dropped_; }
+
+  void clear() noexcept {
+    size_ = 0;
+    dropped_ = 0;
+  }
+
+private:
+  std::span<Execution> storage_;
+  std::size_t size_ = 0;
+  std::size_t dropped_ = 0;
+};
+
+/**
+ * @brief Deliver one execution to `sink`, skipping a null function pointer.
+ */
+template <typename Sink>
+constexpr void emit_execution(Sink &sink, const Execution &exec) {
+  if constexpr (std::is_pointer_v<Sink>) {
+    if (sink == nullptr) {
+      return;
+    }
+  }
+  sink(exec);
+}
+
+// ============================================================================
+// Order Storage
+// ============================================================================
+
+/**
+ * @brief Storage a book draws its orders from.
+ *
+ * MemPool (fixed capacity in the type) and SegmentedPool (runtime size,
+ * grows in segments) both qualify. allocate() returns nullptr when the
+ * pool can supply no more orders; the book then rejects the add.
+ */
+template <typename Pool>
+concept OrderPool = requires(Pool &pool, Order *order) {
+  { pool.allocate() } -> std::same_as<Order *>;
+  pool.deallocate(order);
+  { pool.capacity() } -> std::convertible_to<std::size_t>;
+};
+
+// ============================================================================
+// Level Handles
+// ============================================================================
+
+/**
+ * @brief Index of a PriceLevel in the book's level store.
+ *
+ * Indices stay valid when the store grows (unlike pointers), so they can be
+ * cached in the order map and resolved in O(1).
+ */
+using LevelIndex = uint32_t;
+
+/**
+ * @brief Sorted ladder entry: price plus the index of its PriceLevel.
+ *
+ * The sorted side vectors hold these small records instead of the levels
+ * themselves, so inserting a new best price shifts 16-byte entries rather
+ * than moving every IntrusiveList sentinel.
+ */
+struct LevelRef {
+  uint64_t price;   ///< Level price in ticks (duplicated for binary search)
+  LevelIndex index; ///< Slot in the level store
+};
+
+/**
+ * @brief Order map entry: resting order plus a direct handle to its level.
+ */
+struct OrderHandle {
+  Order *order;     ///< Resting order (owned by MemPool)
+  LevelIndex level; ///< Level the order rests at
+};
+
+// ============================================================================
+// BasicOrderBook - Limit Order Book with Matching Engine
 // ============================================================================
 
 /**
  * @brief High-performance limit order book with matching engine.
  *
- * Maintains bid and ask sides as sorted vectors of price levels.
- * Provides O(1) order cancellation via hash map lookup.
+ * Maintains bid and ask sides as sorted vectors of level references.
+ * Provides O(1) order cancellation via order index lookup; the map entry also
+ * names the order's PriceLevel, so no price search is needed on cancel.
  *
- * @tparam Capacity Maximum number of orders the pool can hold
+ * @tparam Pool Order storage (see OrderPool); OrderBook<Capacity> names
+ *         the MemPool-backed book
  *
  * Key properties:
  * - Price-Time Priority matching (FIFO at each price level)
@@ -71,36 +211,59 @@ struct Execution {
  *   book.add_order(2, 10100, 50, Side::Sell);   // Sell 50 @ 1.0100
  *
  *   auto spread = book.spread();  // 100 ticks = 0.0100
+ *
+ *   SegmentedPool<Order> grown(50'000);     // runtime size, grows on demand
+ *   BasicOrderBook<SegmentedPool<Order>> small_book(grown);
  */
-template <std::size_t Capacity> class OrderBook {
+template <OrderPool Pool> class BasicOrderBook {
 public:
   // ========================================================================
   // Types
   // ========================================================================
 
-  using PoolType = MemPool<Order, Capacity>;
+  using PoolType = Pool;
+
+  /// Function-pointer sink (any ExecutionSink is accepted)
   using ExecutionCallback = void (*)(const Execution &);
 
   // ========================================================================
   // Construction
   // ========================================================================
 
+  /**
+   * @brief Construct order book sized for the pool's current capacity.
+   *
+   * @param pool Reference to the memory pool for orders
+   */
+  explicit BasicOrderBook(PoolType &pool)
+      : BasicOrderBook(pool, pool.capacity()) {}
+
   /**
    * @brief Construct order book with reference to memory pool.
    *
-   * @param pool Reference to pre-allocated memory pool for orders
+   * @param pool Reference to the memory pool for orders
+   * @param expected_orders Live orders the index is sized for up front.
+   *        Sized to a MemPool's capacity, the index never grows; smaller
+   *        values suit one book per symbol, and the index doubles if a
+   *        symbol exceeds it.
    */
-  explicit OrderBook(PoolType &pool) noexcept : pool_(pool) {}
+  BasicOrderBook(PoolType &pool, std::size_t expected_orders)
+      : order_map_(expected_orders), pool_(pool) {
+    const std::size_t levels =
+        std::min(kInitialLevelCapacity, expected_orders);
+    levels_.reserve(levels);
+    free_levels_.reserve(levels);
+  }
 
   // Non-copyable
-  OrderBook(const OrderBook &) = delete;
-  OrderBook &operator=(const OrderBook &) = delete;
+  BasicOrderBook(const BasicOrderBook &) = delete;
+  BasicOrderBook &operator=(const BasicOrderBook &) = delete;
 
   // Non-movable (contains references)
-  OrderBook(OrderBook &&) = delete;
-  OrderBook &operator=(OrderBook &&) = delete;
+  BasicOrderBook(BasicOrderBook &&) = delete;
+  BasicOrderBook &operator=(BasicOrderBook &&) = delete;
 
-  ~OrderBook() = default;
+  ~BasicOrderBook() = default;
 
   // ========================================================================
   // Order Entry
@@ -112,19 +275,23 @@ public:
    * If the order crosses the spread, it will be matched against resting
    * orders using Price-Time Priority. Any remaining quantity rests in book.
    *
-   * @param id Unique order identifier
+   * @param id Unique order identifier (not kInvalidOrderId)
    * @param price Price in ticks (fixed-point)
    * @param qty Quantity (shares)
    * @param side Order side (Buy or Sell)
-   * @param on_execution Optional callback for trade notifications
+   * @param on_execution Sink called once per fill, in match order (see
+   *        ExecutionSink; e.g. a lambda or an ExecutionBuffer)
    * @return true if order was added/matched, false if pool is full
+   *         (a SegmentedPool only fills at its max_capacity())
    *
    * Complexity: O(k) where k is number of price levels crossed
    */
+  template <typename Sink = NullExecutionSink>
+    requires ExecutionSink<Sink>
   bool add_order(uint64_t id, uint64_t price, uint32_t qty, Side side,
-                 ExecutionCallback on_execution = nullptr) noexcept {
-    // Check for duplicate order ID
-    if (order_map_.find(id) != order_map_.end()) {
+                 Sink &&on_execution = {}) noexcept {
+    // Reject the reserved ID and duplicates before matching anything
+    if (id == kInvalidOrderId || order_map_.contains(id)) {
       return false;
     }
 
@@ -142,29 +309,26 @@ public:
       return true;
     }
 
-    // Allocate order from pool
-    Order *order = pool_.allocate();
-    if (order == nullptr) {
-      return false; // Pool exhausted
-    }
-
-    // Initialize order
-    order->id = id;
-    order->price = price;
-    order->qty = remaining_qty;
-    order->side = static_cast<char>(side);
+    return rest_new_order(id, price, remaining_qty, side);
+  }
 
-    // Add to book
-    if (side == Side::Buy) {
-      add_to_bids(order);
-    } else {
-      add_to_asks(order);
+  /**
+   * @brief Rest an order without matching (market-by-order feed mode).
+   *
+   * Mirrors ITCH 'A'/'F': the exchange has already matched, so the order
+   * is queued at its price as published even if it would cross.
+   *
+   * @return true if the order was added, false if the ID is reserved or
+   *         live, or the pool is full
+   *
+   * Complexity: O(1) at an existing level, O(log n) for a new level
+   */
+  bool insert_order(uint64_t id, uint64_t price, uint32_t qty,
+                    Side side) noexcept {
+    if (id == kInvalidOrderId || order_map_.contains(id)) {
+      return false;
     }
-
-    // Register in order map for O(1) cancel
-    order_map_[id] = order;
-
-    return true;
+    return rest_new_order(id, price, qty, side);
   }
 
   // ========================================================================
@@ -177,31 +341,113 @@ public:
    * @param id Order ID to cancel
    * @return true if order was found and cancelled, false otherwise
    *
-   * Complexity: O(1) for lookup + O(1) for removal from list
-   *             Price level cleanup is O(n) in worst case
+   * Complexity: O(1) for lookup + O(1) for removal from list.
+   *             Only when the level empties is it located (O(log n)) and
+   *             erased from the sorted side vector.
    */
   bool cancel_order(uint64_t id) noexcept {
-    auto it = order_map_.find(id);
-    if (it == order_map_.end()) {
+    const OrderHandle *found = order_map_.find(id);
+    if (found == nullptr) {
       return false;
     }
 
-    Order *order = it->second;
-    order_map_.erase(it);
+    const OrderHandle handle = *found;
+    order_map_.erase(id);
 
-    // Remove from price level
-    if (order->is_buy()) {
-      remove_from_bids(order);
-    } else {
-      remove_from_asks(order);
-    }
+    // Remove from price level (direct handle - no ladder scan)
+    remove_from_level(handle.order, handle.level);
 
     // Return to pool
-    pool_.deallocate(order);
+    pool_.deallocate(handle.order);
 
     return true;
   }
 
+  /**
+   * @brief Reduce a resting order's quantity (execution or partial cancel).
+   *
+   * Mirrors ITCH 'E'/'C' (executed) and 'X' (cancel) semantics: the order
+   * keeps its time priority, and is removed once its quantity reaches zero.
+   *
+   * @param id Order ID to reduce
+   * @param qty Quantity to remove (clamped to the remaining quantity)
+   * @return true if order was found, false otherwise
+   *
+   * Complexity: O(1) unless the order's level empties (see cancel_order)
+   */
+  bool reduce_order(uint64_t id, uint32_t qty) noexcept {
+    const OrderHandle *found = order_map_.find(id);
+    if (found == nullptr) {
+      return false;
+    }
+
+    const OrderHandle handle = *found;
+    if (qty < handle.order->qty) {
+      levels_[handle.level].reduce_volume(qty);
+      handle.order->reduce_qty(qty);
+      return true;
+    }
+
+    order_map_.erase(id);
+    remove_from_level(handle.order, handle.level);
+    pool_.deallocate(handle.order);
+    return true;
+  }
+
+  /**
+   * @brief Replace a resting order with a new ID, price and quantity.
+   *
+   * Mirrors ITCH 'U' semantics: the original order is removed and the
+   * replacement enters on the same side with fresh time priority (and may
+   * match if it crosses the spread).
+   *
+   * @param old_id Order ID to replace
+   * @param new_id ID of the replacement order
+   * @param price New price in ticks
+   * @param qty New quantity
+   * @return true if the replacement was applied, false if old_id is unknown,
+   *         new_id is reserved or already live, or the pool is exhausted
+   */
+  bool replace_order(uint64_t old_id, uint64_t new_id, uint64_t price,
+                     uint32_t qty) noexcept {
+    const OrderHandle *found = order_map_.find(old_id);
+    if (found == nullptr) {
+      return false;
+    }
+    if (new_id == kInvalidOrderId ||
+        (new_id != old_id && order_map_.contains(new_id))) {
+      return false;
+    }
+
+    const Side side = found->order->get_side();
+    cancel_order(old_id);
+    return add_order(new_id, price, qty, side);
+  }
+
+  /**
+   * @brief Replace a resting order without matching (market-by-order mode).
+   *
+   * Same as replace_order(), but the replacement is queued via
+   * insert_order() exactly as the feed publishes it. The result tells an
+   * unknown original apart from a replacement the book refused.
+   */
+  ReplaceResult replace_passive(uint64_t old_id, uint64_t new_id,
+                                uint64_t price, uint32_t qty) noexcept {
+    const OrderHandle *found = order_map_.find(old_id);
+    if (found == nullptr) {
+      return ReplaceResult::UnknownOrder;
+    }
+    if (new_id == kInvalidOrderId ||
+        (new_id != old_id && order_map_.contains(new_id))) {
+      return ReplaceResult::Rejected;
+    }
+
+    const Side side = found->order->get_side();
+    cancel_order(old_id);
+    return rest_new_order(new_id, price, qty, side) ? ReplaceResult::Applied
+                                                    : ReplaceResult::Rejected;
+  }
+
   // ========================================================================
   // Market Data Accessors
   // ========================================================================
@@ -212,7 +458,7 @@ public:
    * @return Best bid price, or nullopt if no bids
    */
   [[nodiscard]] std::optional<uint64_t> best_bid() const noexcept {
-    if (bids_.empty() || bids_.front().empty()) {
+    if (bids_.empty()) {
       return std::nullopt;
     }
     return bids_.front().price;
@@ -224,7 +470,7 @@ public:
    * @return Best ask price, or nullopt if no asks
    */
   [[nodiscard]] std::optional<uint64_t> best_ask() const noexcept {
-    if (asks_.empty() || asks_.front().empty()) {
+    if (asks_.empty()) {
       return std::nullopt;
     }
     return asks_.front().price;
@@ -251,7 +497,7 @@ public:
     if (bids_.empty()) {
       return 0;
     }
-    return bids_.front().total_volume;
+    return levels_[bids_.front().index].total_volume;
   }
 
   /**
@@ -261,7 +507,7 @@ public:
     if (asks_.empty()) {
       return 0;
     }
-    return asks_.front().total_volume;
+    return levels_[asks_.front().index].total_volume;
   }
 
   /**
@@ -292,26 +538,57 @@ public:
     return asks_.size();
   }
 
+  /**
+   * @brief Visit up to `max_levels` levels of one side, best price first,
+   *        as callback(const PriceLevel &).
+   *
+   * @return Number of levels visited
+   *
+   * Complexity: O(max_levels); used for L2 depth snapshots.
+   */
+  template <typename Callback>
+  std::size_t for_each_level(Side side, std::size_t max_levels,
+                             Callback &&callback) const {
+    const std::vector<LevelRef> &ladder = side == Side::Buy ? bids_ : asks_;
+    const std::size_t count = std::min(max_levels, ladder.size());
+    for (std::size_t i = 0; i < count; ++i) {
+      callback(static_cast<const PriceLevel &>(levels_[ladder[i].index]));
+    }
+    return count;
+  }
+
   // ========================================================================
   // Direct access for testing
   // ========================================================================
 
-  [[nodiscard]] const std::vector<PriceLevel> &bids() const noexcept {
+  [[nodiscard]] const std::vector<LevelRef> &bids() const noexcept {
     return bids_;
   }
 
-  [[nodiscard]] const std::vector<PriceLevel> &asks() const noexcept {
+  [[nodiscard]] const std::vector<LevelRef> &asks() const noexcept {
     return asks_;
   }
 
+  /**
+   * @brief Resolve a ladder entry to its PriceLevel.
+   */
+  [[nodiscard]] const PriceLevel &level(const LevelRef &ref) const noexcept {
+    return levels_[ref.index];
+  }
+
 private:
   // ========================================================================
   // Data Members
   // ========================================================================
 
-  std::vector<PriceLevel> bids_; ///< Sorted descending (best bid first)
-  std::vector<PriceLevel> asks_; ///< Sorted ascending (best ask first)
-  std::unordered_map<uint64_t, Order *> order_map_; ///< ID -> Order*
+  /// Levels reserved up front; the store only grows past this on deep books
+  static constexpr std::size_t kInitialLevelCapacity = 1024;
+
+  std::vector<LevelRef> bids_; ///< Sorted descending (best bid first)
+  std::vector<LevelRef> asks_; ///< Sorted ascending (best ask first)
+  std::vector<PriceLevel> levels_;      ///< Level store (stable indices)
+  std::vector<LevelIndex> free_levels_; ///< Recycled level slots
+  FlatOrderIndex<OrderHandle> order_map_; ///< ID -> handle (preallocated)
   PoolType &pool_; ///< Reference to memory pool
 
   // ========================================================================
@@ -323,26 +600,29 @@ private:
    *
    * @return Remaining quantity after matching
    */
+  template <typename Sink>
   uint32_t match_buy(uint64_t taker_id, uint64_t price, uint32_t qty,
-                     ExecutionCallback on_execution) noexcept {
+                     Sink &on_execution) noexcept {
     uint32_t remaining = qty;
 
     // Iterate through ask levels (lowest price first)
     while (remaining > 0 && !asks_.empty()) {
-      PriceLevel &level = asks_.front();
+      const LevelRef best = asks_.front();
 
       // Check if we can match (buy price >= ask price)
-      if (price < level.price) {
+      if (price < best.price) {
         break; // No more matches possible
       }
 
       // Match against orders at this level
+      PriceLevel &level = levels_[best.index];
       remaining =
           match_at_level(level, taker_id, remaining, Side::Sell, on_execution);
 
       // Remove empty level
       if (level.empty()) {
         asks_.erase(asks_.begin());
+        free_levels_.push_back(best.index);
       }
     }
 
@@ -354,26 +634,29 @@ private:
    *
    * @return Remaining quantity after matching
    */
+  template <typename Sink>
   uint32_t match_sell(uint64_t taker_id, uint64_t price, uint32_t qty,
-                      ExecutionCallback on_execution) noexcept {
+                      Sink &on_execution) noexcept {
     uint32_t remaining = qty;
 
     // Iterate through bid levels (highest price first)
     while (remaining > 0 && !bids_.empty()) {
-      PriceLevel &level = bids_.front();
+      const LevelRef best = bids_.front();
 
       // Check if we can match (sell price <= bid price)
-      if (price > level.price) {
+      if (price > best.price) {
         break; // No more matches possible
       }
 
       // Match against orders at this level
+      PriceLevel &level = levels_[best.index];
       remaining =
           match_at_level(level, taker_id, remaining, Side::Buy, on_execution);
 
       // Remove empty level
       if (level.empty()) {
         bids_.erase(bids_.begin());
+        free_levels_.push_back(best.index);
       }
     }
 
@@ -387,12 +670,13 @@ private:
    * @param taker_id Incoming order ID
    * @param qty Quantity to fill
    * @param maker_side Side of resting orders
-   * @param on_execution Callback for executions
+   * @param on_execution Sink for executions (inlined; no indirect call
+   *        unless it is a function pointer)
    * @return Remaining quantity
    */
+  template <typename Sink>
   uint32_t match_at_level(PriceLevel &level, uint64_t taker_id, uint32_t qty,
-                          Side maker_side,
-                          ExecutionCallback on_execution) noexcept {
+                          Side maker_side, Sink &on_execution) noexcept {
     uint32_t remaining = qty;
 
     // Match FIFO (front of list is oldest)
@@ -402,15 +686,12 @@ private:
       // Calculate fill quantity
       uint32_t fill_qty = std::min(remaining, maker.qty);
 
-      // Generate execution report
-      if (on_execution) {
-        Execution exec{.maker_id = maker.id,
-                       .taker_id = taker_id,
-                       .price = level.price,
-                       .qty = fill_qty,
-                       .maker_side = maker_side};
-        on_execution(exec);
-      }
+      // Generate execution report (no-op for NullExecutionSink)
+      emit_execution(on_execution, Execution{.maker_id = maker.id,
+                                             .taker_id = taker_id,
+                                             .price = level.price,
+                                             .qty = fill_qty,
+                                             .maker_side = maker_side});
 
       // Update quantities
       remaining -= fill_qty;
@@ -433,79 +714,151 @@ private:
   // Price Level Management
   // ========================================================================
 
+  /**
+   * @brief Allocate an order and queue it at its level (no matching).
+   */
+  bool rest_new_order(uint64_t id, uint64_t price, uint32_t qty,
+                      Side side) noexcept {
+    // Busy symbols grow the index first, so running out of memory rejects
+    // the order before it is allocated or linked. Doubling starts from at
+    // least 8, so an index sized for 0 orders grows too.
+    if (order_map_.size() == order_map_.max_entries()) [[unlikely]] {
+      const std::size_t grown =
+          std::max<std::size_t>(order_map_.max_entries(), 8) * 2;
+      if (!try_allocate([&] { order_map_.reserve(grown); })) {
+        return false;
+      }
+    }
+
+    Order *order = pool_.allocate();
+    if (order == nullptr) {
+      return false; // Pool exhausted
+    }
+
+    order->id = id;
+    order->price = price;
+    order->qty = qty;
+    order->side = static_cast<char>(side);
+
+    const LevelIndex level =
+        (side == Side::Buy) ? add_to_bids(order) : add_to_asks(order);
+
+    // Register in order map for O(1) cancel
+    if (!order_map_.insert(id, OrderHandle{order, level})) [[unlikely]] {
+      // Unindexed orders could never be cancelled: undo the rest
+      remove_from_level(order, level);
+      pool_.deallocate(order);
+      return false;
+    }
+
+    return true;
+  }
+
   /**
    * @brief Add order to bid side (sorted descending).
+   *
+   * @return Index of the level the order now rests at
    */
-  void add_to_bids(Order *order) noexcept {
+  LevelIndex add_to_bids(Order *order) noexcept {
     // Find insertion point (descending order)
     auto it = std::lower_bound(bids_.begin(), bids_.end(), order->price,
-                               [](const PriceLevel &level, uint64_t price) {
-                                 return level.price > price; // Descending
+                               [](const LevelRef &ref, uint64_t price) {
+                                 return ref.price > price; // Descending
                                });
 
     // Check if level exists at this price
     if (it != bids_.end() && it->price == order->price) {
-      it->add_order(order);
-    } else {
-      // Insert new level
-      PriceLevel new_level(order->price);
-      new_level.add_order(order);
-      bids_.insert(it, std::move(new_level));
+      levels_[it->index].add_order(order);
+      return it->index;
     }
+
+    // Insert new level
+    const LevelIndex index = acquire_level(order->price);
+    levels_[index].add_order(order);
+    bids_.insert(it, LevelRef{order->price, index});
+    return index;
   }
 
   /**
    * @brief Add order to ask side (sorted ascending).
+   *
+   * @return Index of the level the order now rests at
    */
-  void add_to_asks(Order *order) noexcept {
+  LevelIndex add_to_asks(Order *order) noexcept {
     // Find insertion point (ascending order)
     auto it = std::lower_bound(asks_.begin(), asks_.end(), order->price,
-                               [](const PriceLevel &level, uint64_t price) {
-                                 return level.price < price; // Ascending
+                               [](const LevelRef &ref, uint64_t price) {
+                                 return ref.price < price; // Ascending
                                });
 
     // Check if level exists at this price
     if (it != asks_.end() && it->price == order->price) {
-      it->add_order(order);
-    } else {
-      // Insert new level
-      PriceLevel new_level(order->price);
-      new_level.add_order(order);
-      asks_.insert(it, std::move(new_level));
+      levels_[it->index].add_order(order);
+      return it->index;
     }
+
+    // Insert new level
+    const LevelIndex index = acquire_level(order->price);
+    levels_[index].add_order(order);
+    asks_.insert(it, LevelRef{order->price, index});
+    return index;
   }
 
   /**
-   * @brief Remove order from bid side.
+   * @brief Remove order from its level, dropping the level once empty.
+   *
+   * The level is resolved directly from the handle; the sorted side vector
+   * is only searched (binary search) when the level must be erased.
    */
-  void remove_from_bids(Order *order) noexcept {
-    // Find price level
-    for (auto it = bids_.begin(); it != bids_.end(); ++it) {
-      if (it->price == order->price) {
-        it->remove_order(order);
-        if (it->empty()) {
-          bids_.erase(it);
-        }
-        return;
-      }
+  void remove_from_level(Order *order, LevelIndex index) noexcept {
+    PriceLevel &level = levels_[index];
+    level.remove_order(order);
+    if (!level.empty()) {
+      return;
     }
+
+    if (order->is_buy()) {
+      auto it = std::lower_bound(bids_.begin(), bids_.end(), level.price,
+                                 [](const LevelRef &ref, uint64_t price) {
+                                   return ref.price > price;
+                                 });
+      bids_.erase(it);
+    } else {
+      auto it = std::lower_bound(asks_.begin(), asks_.end(), level.price,
+                                 [](const LevelRef &ref, uint64_t price) {
+                                   return ref.price < price;
+                                 });
+      asks_.erase(it);
+    }
+    free_levels_.push_back(index);
   }
 
   /**
-   * @brief Remove order from ask side.
+   * @brief Take a level slot from the free list (or grow the store).
    */
-  void remove_from_asks(Order *order) noexcept {
-    // Find price level
-    for (auto it = asks_.begin(); it != asks_.end(); ++it) {
-      if (it->price == order->price) {
-        it->remove_order(order);
-        if (it->empty()) {
-          asks_.erase(it);
-        }
-        return;
-      }
+  LevelIndex acquire_level(uint64_t price) noexcept {
+    if (!free_levels_.empty()) {
+      const LevelIndex index = free_levels_.back();
+      free_levels_.pop_back();
+      levels_[index].price = price;
+      levels_[index].total_volume = 0;
+      return index;
     }
+
+    // Growth moves existing levels; their IntrusiveList move re-links
+    // the sentinels, and indices held by orders remain valid.
+    levels_.emplace_back(price);
+    return static_cast<LevelIndex>(levels_.size() - 1);
   }
 };
 
+/**
+ * @brief Order book over a fixed-capacity MemPool (the original interface).
+ *
+ * @tparam Capacity Maximum number of orders the pool can hold
+ * @tparam Allocation MemPool storage policy (see pool_allocation.hpp)
+ */
+template <std::size_t Capacity, typename Allocation = HeapAllocation>
+using OrderBook = BasicOrderBook<MemPool<Order, Capacity, Allocation>>;
+
 } // namespace book
@@ -0,0 +1,287 @@
+#pragma once
+
+/**
+ * @file order_index.hpp
+ * @brief Pre-allocated open-addressing order ID index.
+ *
+ * DESIGN PRINCIPLES:
+ * 1. Zero runtime malloc - the slot table is sized once at construction.
+ * 2. Linear probing over a flat array - one cache line per typical lookup.
+ * 3. Backward-shift deletion - no tombstones, so probe chains never degrade.
+ * 4. Fibonacci hashing - sequential ITCH order references spread evenly.
+ *
+ * USAGE:
+ *   FlatOrderIndex<Order *> index(1'000'000); // Room for 1M live orders
+ *   index.insert(12345, order);               // O(1) expected
+ *   Order **slot = index.find(12345);         // nullptr if absent
+ *   index.erase(12345);                       // O(1) expected
+ *   index.reserve(2'000'000);                 // Explicit (allocating) growth
+ */
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace book {
+
+/// Order ID no book accepts: FlatOrderIndex marks empty slots with it
+inline constexpr uint64_t kInvalidOrderId =
+    std::numeric_limits<uint64_t>::max();
+
+// ============================================================================
+// FlatOrderIndex - Open-Addressing Hash Map (uint64_t -> Value)
+// ============================================================================
+
+/**
+ * @brief Fixed-capacity open-addressing map keyed by order ID.
+ *
+ * Replaces std::unordered_map on the order hot path: every slot lives in
+ * one contiguous array allocated at construction, so insert/erase never
+ * touch the allocator.
+ *
+ * Key properties:
+ * - Table size is the next power of two >= 1.25 x max_entries
+ *   (load factor <= 0.8 when the owning pool is full)
+ * - Linear probing with backward-shift deletion (no tombstones)
+ * - Empty slots are marked by kEmptyKey (UINT64_MAX), which is therefore
+ *   not a valid order ID
+ *
+ * @tparam Value Trivially copyable mapped type (e.g. Order* or a handle)
+ */
+template <typename Value>
+  requires std::is_trivially_copyable_v<Value>
+class FlatOrderIndex {
+public:
+  // ========================================================================
+  // Types
+  // ========================================================================
+
+  using key_type = uint64_t;
+  using mapped_type = Value;
+  using size_type = std::size_t;
+
+  /// Reserved key marking an empty slot
+  static constexpr key_type kEmptyKey = kInvalidOrderId;
+
+  // ========================================================================
+  // Construction
+  // ========================================================================
+
+  /**
+   * @brief Pre-allocate a table able to hold `max_entries` live keys.
+   *
+   * @note This may throw std::bad_alloc if allocation fails.
+   */
+  explicit FlatOrderIndex(size_type max_entries)
+      : max_entries_(max_entries), slots_(table_size_for(max_entries)),
+        mask_(slots_.size() - 1),
+        shift_(64 - static_cast<unsigned>(std::countr_zero(slots_.size()))) {}
+
+  // Non-copyable (large table, owned by a single book)
+  FlatOrderIndex(const FlatOrderIndex &) = delete;
+  FlatOrderIndex &operator=(const FlatOrderIndex &) = delete;
+
+  FlatOrderIndex(FlatOrderIndex &&) noexcept = default;
+  FlatOrderIndex &operator=(FlatOrderIndex &&) noexcept = default;
+
+  ~FlatOrderIndex() = default;
+
+  // ========================================================================
+  // Capacity
+  // ========================================================================
+
+  /**
+   * @brief Number of live keys.
+   */
+  [[nodiscard]] size_type size() const noexcept { return size_; }
+
+  /**
+   * @brief Check if the index holds no keys.
+   */
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  /**
+   * @brief Maximum number of live keys accepted by insert().
+   */
+  [[nodiscard]] size_type max_entries() const noexcept { return max_entries_; }
+
+  /**
+   * @brief Number of slots in the table (power of two).
+   */
+  [[nodiscard]] size_type slot_count() const noexcept { return slots_.size(); }
+
+  // ========================================================================
+  // Lookup
+  // ========================================================================
+
+  /**
+   * @brief Find the value stored for `key`.
+   *
+   * @return Pointer to the stored value, or nullptr if absent (always for
+   *         kEmptyKey, which insert() refuses). The pointer is invalidated
+   *         by the next insert() or erase().
+   *
+   * Complexity: O(1) expected.
+   */
+  [[nodiscard]] Value *find(key_type key) noexcept {
+    if (key == kEmptyKey) [[unlikely]] {
+      return nullptr; // Would match the first empty slot
+    }
+    size_type i = home_of(key);
+    while (true) {
+      Slot &slot = slots_[i];
+      if (slot.key == key) {
+        return &slot.value;
+      }
+      if (slot.key == kEmptyKey) {
+        return nullptr;
+      }
+      i = (i + 1) & mask_;
+    }
+  }
+
+  [[nodiscard]] const Value *find(key_type key) const noexcept {
+    return const_cast<FlatOrderIndex *>(this)->find(key);
+  }
+
+  /**
+   * @brief Check if `key` is present.
+   */
+  [[nodiscard]] bool contains(key_type key) const noexcept {
+    return find(key) != nullptr;
+  }
+
+  // ========================================================================
+  // Modification
+  // ========================================================================
+
+  /**
+   * @brief Insert `key` -> `value`.
+   *
+   * @return false if the key already exists, is kEmptyKey, or the index
+   *         already holds max_entries() keys.
+   *
+   * Complexity: O(1) expected.
+   */
+  bool insert(key_type key, const Value &value) noexcept {
+    if (key == kEmptyKey || size_ >= max_entries_) [[unlikely]] {
+      return false;
+    }
+
+    size_type i = home_of(key);
+    while (slots_[i].key != kEmptyKey) {
+      if (slots_[i].key == key) {
+        return false;
+      }
+      i = (i + 1) & mask_;
+    }
+
+    slots_[i].key = key;
+    slots_[i].value = value;
+    ++size_;
+    return true;
+  }
+
+  /**
+   * @brief Remove `key` from the index.
+   *
+   * Shifts the rest of the probe chain back into the freed slot so later
+   * lookups still terminate at the first empty slot.
+   *
+   * @return true if the key was present.
+   *
+   * Complexity: O(1) expected.
+   */
+  bool erase(key_type key) noexcept {
+    if (key == kEmptyKey) [[unlikely]] {
+      return false; // Never stored; would match the first empty slot
+    }
+    size_type hole = home_of(key);
+    while (slots_[hole].key != key) {
+      if (slots_[hole].key == kEmptyKey) {
+        return false;
+      }
+      hole = (hole + 1) & mask_;
+    }
+
+    // Backward-shift: pull forward any entry whose home is at or before hole
+    size_type next = (hole + 1) & mask_;
+    while (slots_[next].key != kEmptyKey) {
+      const size_type home = home_of(slots_[next].key);
+      // Distance from home to next vs. from home to hole (cyclic)
+      if (((next - home) & mask_) >= ((next - hole) & mask_)) {
+        slots_[hole] = slots_[next];
+        hole = next;
+      }
+      next = (next + 1) & mask_;
+    }
+
+    slots_[hole].key = kEmptyKey;
+    --size_;
+    return true;
+  }
+
+  /**
+   * @brief Grow the table to hold at least `max_entries` live keys.
+   *
+   * Rehashes every key into a freshly allocated table. Intended for books
+   * that start small (one per symbol) and grow only when a symbol turns
+   * out to be busy; never called implicitly by insert().
+   *
+   * @note This may throw std::bad_alloc if allocation fails.
+   *
+   * Complexity: O(slot_count()) when growing, O(1) otherwise.
+   */
+  void reserve(size_type max_entries) {
+    if (max_entries <= max_entries_) {
+      return;
+    }
+
+    FlatOrderIndex grown(max_entries);
+    for (const Slot &slot : slots_) {
+      if (slot.key != kEmptyKey) {
+        grown.insert(slot.key, slot.value);
+      }
+    }
+    *this = std::move(grown);
+  }
+
+  /**
+   * @brief Remove all keys (table memory is retained).
+   */
+  void clear() noexcept {
+    for (Slot &slot : slots_) {
+      slot.key = kEmptyKey;
+    }
+    size_ = 0;
+  }
+
+private:
+  struct Slot {
+    key_type key = kEmptyKey;
+    Value value{};
+  };
+
+  /// Next power of two >= 1.25 x max_entries (at least 16 slots)
+  static size_type table_size_for(size_type max_entries) noexcept {
+    const size_type wanted = max_entries + max_entries / 4 + 1;
+    return std::bit_ceil(wanted < 16 ? size_type{16} : wanted);
+  }
+
+  /// Fibonacci hash: top bits of key * 2^64/phi
+  [[nodiscard]] size_type home_of(key_type key) const noexcept {
+    return static_cast<size_type>((key * 0x9E3779B97F4A7C15ULL) >> shift_);
+  }
+
+  size_type max_entries_ = 0;
+  std::vector<Slot> slots_;
+  size_type mask_ = 0;
+  unsigned shift_ = 0;
+  size_type size_ = 0;
+};
+
+} // namespace book
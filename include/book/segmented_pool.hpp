@@ -0,0 +1,336 @@
+#pragma once
+
+/**
+ * @file segmented_pool.hpp
+ * @brief Object pool that grows in fixed-size segments at runtime.
+ *
+ * DESIGN PRINCIPLES:
+ * 1. Runtime size - the initial capacity is a constructor argument, not a
+ *    template parameter, so a small run reserves little and one type
+ *    serves every run.
+ * 2. Stable addresses - the pool grows by adding a segment and never
+ *    moves existing objects, so Order* held by books stay valid.
+ * 3. Same hot path as MemPool - pop a recycled slot, else bump the next
+ *    unused slot of the current segment; a new segment is mapped only
+ *    when every reserved slot is in use.
+ * 4. Bounded growth - an optional maximum turns runaway growth into the
+ *    usual nullptr from allocate().
+ *
+ * USAGE:
+ *   SegmentedPool<Order> pool(100'000);      // 2 segments of 65536
+ *   Order *order = pool.allocate();          // O(1), grows when exhausted
+ *   pool.deallocate(order);                  // O(1)
+ *   BasicOrderBook<SegmentedPool<Order>> book(pool);
+ */
+
+#include "memory_pool.hpp"
+#include "pool_allocation.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace book {
+
+// ============================================================================
+// SegmentedPool - Growable Object Pool
+// ============================================================================
+
+/**
+ * @brief Pool of T in SegmentSlots-sized segments, grown on demand.
+ *
+ * Slot indices are global (segment * SegmentSlots + offset), so at() is
+ * a shift and a mask. index_of() scans the segment table and is O(number
+ * of segments); prefer pointers on hot paths.
+ *
+ * @tparam T Object type (must be default constructible)
+ * @tparam SegmentSlots Objects per segment (power of two)
+ * @tparam Allocation Storage policy for each segment (see
+ *         pool_allocation.hpp)
+ *
+ * @note As with MemPool, objects are value-initialized when their slot is
+ *       first handed out (lazy) or when their segment is added (eager),
+ *       and are not reset on deallocate().
+ */
+template <typename T, std::size_t SegmentSlots = 65536,
+          typename Allocation = HeapAllocation>
+  requires std::is_default_constructible_v<T>
+class SegmentedPool {
+  static_assert(std::has_single_bit(SegmentSlots),
+                "SegmentSlots must be a power of two");
+
+public:
+  // ========================================================================
+  // Types
+  // ========================================================================
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using AllocationType = Allocation;
+
+  static constexpr size_type kSegmentSlots = SegmentSlots;
+
+  /// No limit on growth
+  static constexpr size_type kUnbounded = std::numeric_limits<size_type>::max();
+
+  // ========================================================================
+  // Construction
+  // ========================================================================
+
+  /**
+   * @brief Reserve segments for `initial_capacity` objects.
+   *
+   * @param initial_capacity Slots reserved now (rounded up to whole
+   *        segments; at least one segment)
+   * @param max_capacity Growth limit in slots (rounded down to whole
+   *        segments, never below the initial reservation)
+   * @param placement NUMA node and pre-fault request for every segment
+   * @param init Eager: value-initialize each segment when it is added.
+   *        Lazy: construct slots on first use and skip pre-faulting.
+   */
+  explicit SegmentedPool(size_type initial_capacity,
+                         size_type max_capacity = kUnbounded,
+                         const PoolPlacement &placement = {},
+                         PoolInit init = PoolInit::Lazy)
+      : placement_(placement), lazy_(init == PoolInit::Lazy) {
+    if (lazy_) {
+      placement_.prefault = false;
+    }
+    const size_type initial_segments =
+        initial_capacity == 0 ? 1
+                              : (initial_capacity + SegmentSlots - 1) /
+                                    SegmentSlots;
+    max_segments_ = std::max(max_capacity / SegmentSlots, initial_segments);
+    segments_.reserve(initial_segments);
+    regions_.reserve(initial_segments);
+    for (size_type i = 0; i < initial_segments; ++i) {
+      map_segment(); // Throws like the policy: no pool rather than a short one
+    }
+  }
+
+  // Non-copyable, non-movable (addresses must remain stable)
+  SegmentedPool(const SegmentedPool &) = delete;
+  SegmentedPool &operator=(const SegmentedPool &) = delete;
+  SegmentedPool(SegmentedPool &&) = delete;
+  SegmentedPool &operator=(SegmentedPool &&) = delete;
+
+  ~SegmentedPool() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      const size_type constructed = lazy_ ? next_unused_ : capacity();
+      for (size_type i = 0; i < constructed; ++i) {
+        at(i).~T();
+      }
+    }
+    for (const PoolRegion &region : regions_) {
+      Allocation::release(region);
+    }
+  }
+
+  // ========================================================================
+  // Capacity
+  // ========================================================================
+
+  /**
+   * @brief Slots currently reserved (grows by SegmentSlots at a time).
+   */
+  [[nodiscard]] size_type capacity() const noexcept {
+    return segments_.size() * SegmentSlots;
+  }
+
+  /**
+   * @brief Most slots the pool may ever reserve.
+   */
+  [[nodiscard]] size_type max_capacity() const noexcept {
+    return max_segments_ * SegmentSlots;
+  }
+
+  [[nodiscard]] size_type segment_count() const noexcept {
+    return segments_.size();
+  }
+
+  [[nodiscard]] size_type allocated() const noexcept {
+    return next_unused_ - free_list_.size();
+  }
+
+  /**
+   * @brief Slots free without growing.
+   */
+  [[nodiscard]] size_type available() const noexcept {
+    return capacity() - allocated();
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return allocated() == 0; }
+
+  /**
+   * @brief True only when the growth limit is reached and every slot is
+   *        in use.
+   */
+  [[nodiscard]] bool full() const noexcept {
+    return allocated() == max_capacity();
+  }
+
+  /**
+   * @brief Slots ever handed out (the bump pointer).
+   */
+  [[nodiscard]] size_type high_water_mark() const noexcept {
+    return next_unused_;
+  }
+
+  [[nodiscard]] bool lazy() const noexcept { return lazy_; }
+
+  // ========================================================================
+  // Allocation
+  // ========================================================================
+
+  /**
+   * @brief Allocate an object, adding a segment if every slot is in use.
+   *
+   * @return nullptr at max_capacity(), or if memory for a new segment is
+   *         refused (never throws, so noexcept order entry may call it)
+   *
+   * Complexity: O(1); a growth step costs one segment allocation.
+   */
+  [[nodiscard]] pointer allocate() noexcept {
+    if (!free_list_.empty()) {
+      pointer slot = free_list_.back();
+      free_list_.pop_back();
+      return slot;
+    }
+    if (next_unused_ == capacity()) [[unlikely]] {
+      if (segments_.size() == max_segments_ || !add_segment()) {
+        return nullptr;
+      }
+    }
+    pointer slot = &at(next_unused_++);
+    if (lazy_) {
+      ::new (static_cast<void *>(slot)) T();
+    }
+    return slot;
+  }
+
+  /**
+   * @brief Return an object to the pool (not destroyed).
+   *
+   * @warning Double-deallocation or a foreign pointer is undefined behavior.
+   */
+  void deallocate(pointer ptr) noexcept { free_list_.push_back(ptr); }
+
+  // ========================================================================
+  // Slot Access
+  // ========================================================================
+
+  /**
+   * @brief Object at a global slot index.
+   *
+   * @pre index < high_water_mark() in a lazy pool, < capacity() otherwise
+   */
+  [[nodiscard]] T &at(size_type index) noexcept {
+    return segments_[index / SegmentSlots][index % SegmentSlots];
+  }
+
+  [[nodiscard]] const T &at(size_type index) const noexcept {
+    return segments_[index / SegmentSlots][index % SegmentSlots];
+  }
+
+  /**
+   * @brief Global slot index of a pool object (O(segments)).
+   *
+   * @pre owns(ptr)
+   */
+  [[nodiscard]] size_type index_of(const_pointer ptr) const noexcept {
+    for (size_type s = 0; s < segments_.size(); ++s) {
+      if (in_segment(s, ptr)) {
+        return s * SegmentSlots +
+               static_cast<size_type>(ptr - segments_[s]);
+      }
+    }
+    return capacity();
+  }
+
+  /**
+   * @brief Check if pointer belongs to this pool (O(segments)).
+   */
+  [[nodiscard]] bool owns(const_pointer ptr) const noexcept {
+    return index_of(ptr) != capacity();
+  }
+
+  /**
+   * @brief Page size backing the first segment.
+   */
+  [[nodiscard]] PageBacking page_backing() const noexcept {
+    return regions_.front().backing;
+  }
+
+  /**
+   * @brief True if every segment was bound to the requested NUMA node.
+   */
+  [[nodiscard]] bool numa_bound() const noexcept {
+    for (const PoolRegion &region : regions_) {
+      if (!region.numa_bound) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  std::vector<pointer> segments_;    ///< Segment base addresses, in order
+  std::vector<PoolRegion> regions_;  ///< Storage behind each segment
+  std::vector<pointer> free_list_;   ///< Recycled slots (LIFO)
+  size_type next_unused_ = 0;        ///< Slots [next_unused_, capacity())
+                                     ///< have never been handed out
+  size_type max_segments_ = 0;
+  PoolPlacement placement_;
+  bool lazy_ = true;
+
+  [[nodiscard]] bool in_segment(size_type s,
+                                const_pointer ptr) const noexcept {
+    return ptr >= segments_[s] && ptr < segments_[s] + SegmentSlots;
+  }
+
+  /**
+   * @brief Map one more segment and size the free list to cover it.
+   *
+   * The bookkeeping vectors grow before the region is mapped, so once the
+   * segment exists nothing can fail and leak it.
+   *
+   * @return false if a non-throwing policy returned no memory
+   * @throws std::bad_alloc from the policy or the bookkeeping vectors
+   */
+  bool map_segment() {
+    segments_.reserve(segments_.size() + 1);
+    regions_.reserve(regions_.size() + 1);
+    // Deallocate never reallocates: every reserved slot fits the free list
+    free_list_.reserve(capacity() + SegmentSlots);
+
+    const PoolRegion region =
+        Allocation::allocate(SegmentSlots * sizeof(T), alignof(T), placement_);
+    if (region.data == nullptr) {
+      return false;
+    }
+    auto *base = static_cast<pointer>(region.data);
+    if (!lazy_) {
+      for (size_type i = 0; i < SegmentSlots; ++i) {
+        ::new (static_cast<void *>(base + i)) T();
+      }
+    }
+    regions_.push_back(region);
+    segments_.push_back(base);
+    return true;
+  }
+
+  /**
+   * @brief map_segment() for allocate(): std::bad_alloc becomes false.
+   */
+  bool add_segment() noexcept {
+    bool added = false;
+    return try_allocate([&] { added = map_segment(); }) && added;
+  }
+};
+
+} // namespace book
@@ -25,6 +25,20 @@ namespace book {
  */
 enum class Side : char { Buy = 'B', Sell = 'S' };
 
+// ============================================================================
+// ReplaceResult Enum
+// ============================================================================
+
+/**
+ * @brief Outcome of a passive replace (ITCH 'U' in market-by-order mode).
+ */
+enum class ReplaceResult : uint8_t {
+  Applied,      ///< Original removed, replacement resting under the new ID
+  UnknownOrder, ///< Original ID not in the book; nothing changed
+  Rejected,     ///< New ID reserved or live (nothing changed), or the
+                ///< original was removed but the replacement could not rest
+};
+
 // ============================================================================
 // Order - Core order structure
 // ============================================================================
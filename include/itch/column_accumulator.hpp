@@ -0,0 +1,665 @@
+#pragma once
+
+/**
+ * @file column_accumulator.hpp
+ * @brief Columnar extraction of AddOrder and OrderExecuted messages.
+ *
+ * DESIGN PRINCIPLES:
+ * 1. One vector per field (struct of arrays), ready to hand to NumPy or
+ *    any other columnar consumer without a copy.
+ * 2. Columns are reserved up front from the file size as address space
+ *    only (MAP_NORESERVE), so they never reallocate while growing and an
+ *    over-estimate commits no memory.
+ * 3. Filters (stock_locate, symbol, message type, time window) are
+ *    evaluated before a row is appended, so only kept rows cost memory.
+ * 4. A capture can be cut into packet ranges, parsed into one accumulator
+ *    each on its own thread, and merged back in file order.
+ * 5. A capture can be walked in fixed-size batches (ColumnStream) that
+ *    reuse one set of columns.
+ *
+ * The Python module (src/python_bindings.cpp) is a thin wrapper over
+ * this header.
+ */
+
+#include "messages.hpp"
+#include "moldudp64.hpp"
+#include "parser.hpp"
+#include "pcap_reader.hpp"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <new>
+#include <string>
+#include <sys/mman.h>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace itch {
+
+// ============================================================================
+// Column Storage
+// ============================================================================
+
+/**
+ * @brief Allocator for column vectors: anonymous mmap with MAP_NORESERVE.
+ *
+ * Reserving for the largest row count a file could hold claims address
+ * space only; pages are committed as rows are written, so an over-estimate
+ * costs no memory.
+ */
+template <typename T> struct ColumnAllocator {
+  using value_type = T;
+
+  ColumnAllocator() = default;
+  template <typename U>
+  ColumnAllocator(const ColumnAllocator<U> & /*other*/) noexcept {}
+
+  T *allocate(std::size_t n) {
+    void *p = mmap(nullptr, n * sizeof(T), PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(p);
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept { munmap(p, n * sizeof(T)); }
+
+  friend bool operator==(const ColumnAllocator &,
+                         const ColumnAllocator &) noexcept {
+    return true;
+  }
+};
+
+template <typename T> using Column = std::vector<T, ColumnAllocator<T>>;
+
+/**
+ * @brief Reserve `rows` in each column; keep growing normally if the
+ *        address space is refused.
+ */
+template <typename... Columns>
+void reserve_columns(std::size_t rows, Columns &...columns) {
+  try {
+    (columns.reserve(rows), ...);
+  } catch (const std::bad_alloc &) {
+    // Not fatal: the columns reallocate as they grow
+  }
+}
+
+// ============================================================================
+// Filters - Evaluated Before Any Column Append
+// ============================================================================
+
+/**
+ * @brief Row predicates pushed down into the parse.
+ *
+ * A row is kept when it passes every active predicate. stock_locates and
+ * symbols both select instruments, so a row passes if it matches either.
+ */
+struct ParseFilter {
+  using Symbol = std::array<char, sizeof(StockSymbol)>;
+
+  bool keep_adds = true;
+  bool keep_executions = true;
+  uint64_t start_ns = 0;                                 ///< Inclusive
+  uint64_t end_ns = std::numeric_limits<uint64_t>::max(); ///< Exclusive
+  bool by_locate = false;         ///< stock_locates was given
+  std::bitset<65536> locates;     ///< Selected stock_locates
+  std::vector<Symbol> symbols;    ///< Selected symbols, space-padded
+
+  [[nodiscard]] bool by_symbol() const noexcept { return !symbols.empty(); }
+
+  [[nodiscard]] bool by_instrument() const noexcept {
+    return by_locate || by_symbol();
+  }
+
+  [[nodiscard]] bool active() const noexcept {
+    return by_instrument() || !keep_adds || !keep_executions ||
+           start_ns != 0 || end_ns != std::numeric_limits<uint64_t>::max();
+  }
+
+  [[nodiscard]] bool in_window(uint64_t timestamp_ns) const noexcept {
+    return timestamp_ns >= start_ns && timestamp_ns < end_ns;
+  }
+
+  [[nodiscard]] bool wants(const StockSymbol &stock) const noexcept {
+    return std::any_of(symbols.begin(), symbols.end(),
+                       [&](const Symbol &symbol) {
+                         return std::memcmp(symbol.data(), stock.data,
+                                            symbol.size()) == 0;
+                       });
+  }
+};
+
+/// What a stock_locate is known to map to under a symbol filter
+enum class LocateMatch : uint8_t { Unknown, Keep, Drop };
+
+// ============================================================================
+// ColumnAccumulator - Parser Visitor Appending Rows to Columns
+// ============================================================================
+
+/**
+ * @brief Accumulates AddOrder and OrderExecuted messages into columns.
+ *
+ * @example
+ *   ColumnAccumulator acc;
+ *   acc.reserve_for(reader.file_size());
+ *   parse_packets(reader, 0, reader.file_size(), acc);
+ *   // acc.add_order_refs[i], acc.add_prices[i], ...
+ */
+class ColumnAccumulator : public DefaultVisitor {
+public:
+  /// Bytes each message occupies in a capture at minimum (message plus
+  /// its 2-byte MoldUDP64 length prefix)
+  static constexpr std::size_t kMinAddBytes =
+      sizeof(AddOrder) + sizeof(uint16_t);
+  static constexpr std::size_t kMinExecBytes =
+      sizeof(OrderExecuted) + sizeof(uint16_t);
+
+  // AddOrder data
+  Column<uint64_t> add_order_refs;
+  Column<uint64_t> add_timestamps;
+  Column<uint16_t> add_stock_locates;
+  Column<uint32_t> add_shares;
+  Column<uint32_t> add_prices;
+  Column<char> add_sides;
+
+  // OrderExecuted data
+  Column<uint64_t> exec_order_refs;
+  Column<uint64_t> exec_timestamps;
+  Column<uint16_t> exec_stock_locates;
+  Column<uint32_t> exec_shares;
+  Column<uint64_t> exec_match_numbers;
+
+  /**
+   * @brief Reserve every column for the most rows a file of this size
+   *        could contain, so no column ever reallocates.
+   */
+  void reserve_for(std::size_t file_bytes) {
+    reserve_columns(file_bytes / kMinAddBytes, add_order_refs,
+                    add_timestamps, add_stock_locates, add_shares,
+                    add_prices, add_sides);
+    reserve_columns(file_bytes / kMinExecBytes, exec_order_refs,
+                    exec_timestamps, exec_stock_locates, exec_shares,
+                    exec_match_numbers);
+  }
+
+  // MoldUDP64 transport
+  std::string session;
+  uint64_t next_sequence = 0;
+
+  // Symbol filter state: locates resolved from Stock Directory and
+  // AddOrder messages, and execution rows seen before their locate was
+  // resolved (settled by drop_unmatched_pending())
+  std::vector<LocateMatch> locate_matches;
+  std::vector<std::size_t> pending_exec_rows;
+
+  /**
+   * @brief Evaluate `filter` on every message before appending it
+   *        (`filter` must outlive the parse).
+   */
+  void set_filter(const ParseFilter &filter) {
+    filter_ = filter.active() ? &filter : nullptr;
+    if (filter.by_symbol()) {
+      locate_matches.assign(filter.locates.size(), LocateMatch::Unknown);
+    }
+  }
+
+  void on_packet(const MoldPacket &pkt) {
+    if (session.empty()) {
+      session.assign(pkt.session, MoldPacket::kSessionSize);
+    }
+    next_sequence = pkt.next_sequence();
+  }
+
+  void on_stock_directory(const StockDirectory &msg) {
+    if (filter_ != nullptr && filter_->by_symbol()) {
+      resolve(static_cast<uint16_t>(msg.stock_locate), msg.stock);
+    }
+  }
+
+  void on_add_order(const AddOrder &msg) {
+    if (filter_ != nullptr) [[unlikely]] {
+      const auto locate = static_cast<uint16_t>(msg.stock_locate);
+      if (filter_->by_symbol()) {
+        resolve(locate, msg.stock);
+      }
+      if (!filter_->keep_adds ||
+          !filter_->in_window(msg.timestamp.nanoseconds()) ||
+          (filter_->by_instrument() && !filter_->locates.test(locate) &&
+           (!filter_->by_symbol() ||
+            locate_matches[locate] != LocateMatch::Keep))) {
+        return;
+      }
+    }
+    add_order_refs.push_back(static_cast<uint64_t>(msg.order_ref));
+    add_timestamps.push_back(msg.timestamp.nanoseconds());
+    add_stock_locates.push_back(static_cast<uint16_t>(msg.stock_locate));
+    add_shares.push_back(static_cast<uint32_t>(msg.shares));
+    add_prices.push_back(static_cast<uint32_t>(msg.price));
+    add_sides.push_back(msg.side);
+  }
+
+  void on_order_executed(const OrderExecuted &msg) {
+    if (filter_ != nullptr) [[unlikely]] {
+      const auto locate = static_cast<uint16_t>(msg.stock_locate);
+      if (!filter_->keep_executions ||
+          !filter_->in_window(msg.timestamp.nanoseconds())) {
+        return;
+      }
+      if (filter_->by_instrument() && !filter_->locates.test(locate)) {
+        if (!filter_->by_symbol() ||
+            locate_matches[locate] == LocateMatch::Drop) {
+          return;
+        }
+        if (locate_matches[locate] == LocateMatch::Unknown) {
+          pending_exec_rows.push_back(exec_order_refs.size());
+        }
+      }
+    }
+    exec_order_refs.push_back(static_cast<uint64_t>(msg.order_ref));
+    exec_timestamps.push_back(msg.timestamp.nanoseconds());
+    exec_stock_locates.push_back(static_cast<uint16_t>(msg.stock_locate));
+    exec_shares.push_back(static_cast<uint32_t>(msg.executed_shares));
+    exec_match_numbers.push_back(static_cast<uint64_t>(msg.match_number));
+  }
+
+  /**
+   * @brief Call fn(name, column) for each AddOrder column.
+   */
+  template <typename Fn> void visit_add_columns(Fn &&fn) {
+    fn("order_ref", add_order_refs);
+    fn("timestamp", add_timestamps);
+    fn("stock_locate", add_stock_locates);
+    fn("shares", add_shares);
+    fn("price", add_prices);
+    fn("side", add_sides);
+  }
+
+  /**
+   * @brief Call fn(name, column) for each OrderExecuted column.
+   */
+  template <typename Fn> void visit_exec_columns(Fn &&fn) {
+    fn("order_ref", exec_order_refs);
+    fn("timestamp", exec_timestamps);
+    fn("stock_locate", exec_stock_locates);
+    fn("executed_shares", exec_shares);
+    fn("match_number", exec_match_numbers);
+  }
+
+  /**
+   * @brief Fill in locates this accumulator never resolved from
+   *        `other` (a locate maps to one symbol, so the two agree).
+   */
+  void merge_locate_matches(const ColumnAccumulator &other) {
+    for (std::size_t i = 0; i < other.locate_matches.size(); ++i) {
+      if (locate_matches[i] == LocateMatch::Unknown) {
+        locate_matches[i] = other.locate_matches[i];
+      }
+    }
+  }
+
+  /**
+   * @brief Remove pending execution rows whose locate `matches` does not
+   *        resolve to a selected symbol, compacting the columns in place.
+   */
+  void drop_unmatched_pending(const std::vector<LocateMatch> &matches) {
+    if (pending_exec_rows.empty()) {
+      return;
+    }
+    const std::size_t rows = exec_order_refs.size();
+    std::size_t next_pending = 0;
+    std::size_t kept = 0;
+    for (std::size_t row = 0; row < rows; ++row) {
+      if (next_pending < pending_exec_rows.size() &&
+          pending_exec_rows[next_pending] == row) {
+        ++next_pending;
+        if (matches[exec_stock_locates[row]] != LocateMatch::Keep) {
+          continue;
+        }
+      }
+      if (kept != row) {
+        visit_exec_columns([&](const char *, auto &column) {
+          column[kept] = column[row];
+        });
+      }
+      ++kept;
+    }
+    visit_exec_columns(
+        [&](const char *, auto &column) { column.resize(kept); });
+    pending_exec_rows.clear();
+  }
+
+  /**
+   * @brief Append another accumulator's rows after this one's, freeing
+   *        its columns as they are copied.
+   *
+   * `later` must cover packets after this accumulator's, so session is
+   * kept from the earliest packet and next_sequence from the latest.
+   */
+  void append(ColumnAccumulator &later) {
+    const auto move_rows = [](auto &dst, auto &src) {
+      dst.insert(dst.end(), src.begin(), src.end());
+      std::remove_reference_t<decltype(src)>().swap(src);
+    };
+    move_rows(add_order_refs, later.add_order_refs);
+    move_rows(add_timestamps, later.add_timestamps);
+    move_rows(add_stock_locates, later.add_stock_locates);
+    move_rows(add_shares, later.add_shares);
+    move_rows(add_prices, later.add_prices);
+    move_rows(add_sides, later.add_sides);
+    move_rows(exec_order_refs, later.exec_order_refs);
+    move_rows(exec_timestamps, later.exec_timestamps);
+    move_rows(exec_stock_locates, later.exec_stock_locates);
+    move_rows(exec_shares, later.exec_shares);
+    move_rows(exec_match_numbers, later.exec_match_numbers);
+
+    if (session.empty()) {
+      session = later.session;
+    }
+    if (!later.session.empty()) {
+      next_sequence = later.next_sequence;
+    }
+  }
+
+private:
+  /**
+   * @brief Record whether `locate` is a selected symbol, the first time
+   *        its symbol is seen.
+   */
+  void resolve(uint16_t locate, const StockSymbol &stock) noexcept {
+    if (locate_matches[locate] == LocateMatch::Unknown) {
+      locate_matches[locate] =
+          filter_->wants(stock) ? LocateMatch::Keep : LocateMatch::Drop;
+    }
+  }
+
+  const ParseFilter *filter_ = nullptr;
+};
+
+// ============================================================================
+// Packet Ranges
+// ============================================================================
+
+/**
+ * @brief Parse the packets starting in [begin, end) into `accumulator`.
+ *
+ * Frames are decoded by the reader's link type (check it with
+ * is_supported_link_type() first).
+ *
+ * @return Number of packets parsed.
+ */
+inline std::size_t parse_packets(const PcapReader &reader, std::size_t begin,
+                                 std::size_t end,
+                                 ColumnAccumulator &accumulator) {
+  const Parser parser;
+  const auto link = static_cast<LinkType>(reader.link_type());
+  PcapPacket packet;
+  std::size_t cursor = begin;
+  std::size_t packets = 0;
+  while (cursor < end && reader.next_packet(cursor, packet)) {
+    (void)parse_frame(parser, packet.data, packet.len, accumulator, link);
+    ++packets;
+  }
+  return packets;
+}
+
+/**
+ * @brief Cut the file into at most `parts` ranges of roughly equal bytes,
+ *        each starting on a packet header.
+ *
+ * Walks the packet headers once (PCAP has no resync marker to split on).
+ *
+ * @return Range boundaries as cursors; range i is [bounds[i], bounds[i+1]).
+ */
+inline std::vector<std::size_t> split_packet_ranges(const PcapReader &reader,
+                                                    std::size_t parts) {
+  std::vector<std::size_t> bounds{sizeof(PcapGlobalHeader)};
+  const std::size_t stride = reader.file_size() / parts;
+  std::size_t cursor = bounds.front();
+  PcapPacket packet;
+  while (reader.next_packet(cursor, packet)) {
+    if (bounds.size() < parts && cursor >= bounds.size() * stride) {
+      bounds.push_back(cursor);
+    }
+  }
+  bounds.push_back(cursor);
+  return bounds;
+}
+
+/**
+ * @brief Run task(i) for each i in [0, tasks): task 0 on the calling
+ *        thread, the others on a thread each.
+ *
+ * Every thread is joined before this returns, so a throwing task cannot
+ * leave a joinable std::thread behind (std::terminate). The exception of
+ * the lowest failing task is then rethrown; one raised while starting a
+ * thread takes precedence, and task 0 is not run in that case.
+ */
+template <typename Task> void run_workers(std::size_t tasks, Task task) {
+  std::vector<std::exception_ptr> errors(tasks);
+  const auto run = [&](std::size_t i) noexcept {
+    try {
+      task(i);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  std::exception_ptr start_error;
+  try {
+    workers.reserve(tasks > 0 ? tasks - 1 : 0);
+    for (std::size_t i = 1; i < tasks; ++i) {
+      workers.emplace_back(run, i);
+    }
+  } catch (...) {
+    start_error = std::current_exception();
+  }
+  if (!start_error && tasks > 0) {
+    run(0);
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  if (start_error) {
+    std::rethrow_exception(start_error);
+  }
+  for (const std::exception_ptr &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+/**
+ * @brief Parse the whole file on up to `threads` threads into
+ *        `accumulator`, in file order.
+ *
+ * The file is cut into packet ranges (split_packet_ranges()); the first
+ * is parsed into `accumulator` itself, which reserves for the whole file,
+ * and each other into a shard of its own that is appended afterwards. A
+ * later range may resolve the symbol of an earlier range's pending
+ * executions, so those are settled against every shard's resolutions.
+ *
+ * @param filter Applied to every range; must outlive the call
+ * @throws Whatever a range's parse throws (std::bad_alloc), after every
+ *         thread has finished
+ * @return Number of packets parsed.
+ */
+inline std::size_t parse_file_columns(const PcapReader &reader,
+                                      std::size_t threads,
+                                      const ParseFilter &filter,
+                                      ColumnAccumulator &accumulator) {
+  const std::vector<std::size_t> bounds =
+      threads > 1 ? split_packet_ranges(reader, threads)
+                  : std::vector<std::size_t>{0, reader.file_size()};
+  const std::size_t ranges = bounds.size() - 1;
+  std::vector<ColumnAccumulator> shards(ranges - 1);
+  std::vector<std::size_t> packets(ranges, 0);
+
+  accumulator.set_filter(filter);
+  accumulator.reserve_for(reader.file_size());
+  for (std::size_t i = 1; i < ranges; ++i) {
+    shards[i - 1].set_filter(filter);
+    shards[i - 1].reserve_for(bounds[i + 1] - bounds[i]);
+  }
+  run_workers(ranges, [&](std::size_t i) {
+    packets[i] = parse_packets(reader, bounds[i], bounds[i + 1],
+                               i == 0 ? accumulator : shards[i - 1]);
+  });
+
+  if (filter.by_symbol()) {
+    for (const ColumnAccumulator &shard : shards) {
+      accumulator.merge_locate_matches(shard);
+    }
+    accumulator.drop_unmatched_pending(accumulator.locate_matches);
+    for (ColumnAccumulator &shard : shards) {
+      shard.drop_unmatched_pending(accumulator.locate_matches);
+    }
+  }
+
+  std::size_t packet_count = packets.front();
+  for (std::size_t i = 1; i < ranges; ++i) {
+    packet_count += packets[i];
+    accumulator.append(shards[i - 1]);
+  }
+  return packet_count;
+}
+
+// ============================================================================
+// Streaming - Fixed-Size Batches in Bounded Memory
+// ============================================================================
+
+/**
+ * @brief Walks a capture in batches of at most `chunk_messages` rows per
+ *        message type, reusing one set of columns.
+ *
+ * fill() parses whole packets until either message type holds a full
+ * batch or the file ends. take_add_batch() / take_exec_batch() hand the
+ * batch's rows out; rows the last packet added past the limit stay and
+ * lead the next batch. Mapped pages behind the cursor are released as it
+ * advances, so memory stays at about one batch whatever the file size.
+ *
+ * Not thread-safe: one caller at a time (the Python wrapper locks).
+ */
+class ColumnStream {
+public:
+  /// Rows one packet can add beyond the batch limit (a jumbo frame of
+  /// minimum-size messages), reserved so the overflow never reallocates
+  static constexpr std::size_t kPacketSlack =
+      9000 / ColumnAccumulator::kMinExecBytes;
+
+  /**
+   * @param reader Open capture with a supported link type; must outlive
+   *        the stream
+   * @param chunk_messages Most rows per message type in a batch (> 0)
+   */
+  ColumnStream(const PcapReader &reader, std::size_t chunk_messages)
+      : reader_(reader), link_(static_cast<LinkType>(reader.link_type())),
+        chunk_messages_(chunk_messages) {
+    auto &acc = accumulator_;
+    reserve_columns(chunk_messages_ + kPacketSlack, acc.add_order_refs,
+                    acc.add_timestamps, acc.add_stock_locates,
+                    acc.add_shares, acc.add_prices, acc.add_sides,
+                    acc.exec_order_refs, acc.exec_timestamps,
+                    acc.exec_stock_locates, acc.exec_shares,
+                    acc.exec_match_numbers);
+  }
+
+  /**
+   * @brief Parse up to the next batch.
+   * @return false once the file is exhausted and no rows remain.
+   */
+  bool fill() {
+    auto &acc = accumulator_;
+    PcapPacket packet;
+    while (!done_ && acc.add_order_refs.size() < chunk_messages_ &&
+           acc.exec_order_refs.size() < chunk_messages_) {
+      if (!reader_.next_packet(cursor_, packet)) {
+        done_ = true;
+        break;
+      }
+      (void)parse_frame(parser_, packet.data, packet.len, acc, link_);
+      ++packet_count_;
+    }
+    release_parsed_pages();
+    return !acc.add_order_refs.empty() || !acc.exec_order_refs.empty();
+  }
+
+  /**
+   * @brief Call fn(name, column, rows) for each AddOrder column, where
+   *        the first `rows` are the batch, then drop those rows.
+   */
+  template <typename Fn> void take_add_batch(Fn &&fn) {
+    cut_batch(accumulator_.add_order_refs.size(), [&](auto &&visit) {
+      accumulator_.visit_add_columns(visit);
+    }, fn);
+  }
+
+  /**
+   * @brief Same as take_add_batch() for the OrderExecuted columns.
+   */
+  template <typename Fn> void take_exec_batch(Fn &&fn) {
+    cut_batch(accumulator_.exec_order_refs.size(), [&](auto &&visit) {
+      accumulator_.visit_exec_columns(visit);
+    }, fn);
+  }
+
+  [[nodiscard]] std::size_t chunk_messages() const noexcept {
+    return chunk_messages_;
+  }
+  [[nodiscard]] std::size_t packet_count() const noexcept {
+    return packet_count_;
+  }
+  /// Session and next_sequence as of the last packet parsed
+  [[nodiscard]] const ColumnAccumulator &accumulator() const noexcept {
+    return accumulator_;
+  }
+
+private:
+  template <typename Visit, typename Fn>
+  void cut_batch(std::size_t rows, Visit visit, Fn &fn) {
+    const std::size_t take = std::min(rows, chunk_messages_);
+    visit([&](const char *name, auto &column) {
+      fn(name, std::as_const(column), take);
+      column.erase(column.begin(),
+                   column.begin() + static_cast<std::ptrdiff_t>(take));
+    });
+  }
+
+  /**
+   * @brief Drop mapped pages behind the cursor from this process, so
+   *        resident memory does not grow with the file.
+   */
+  void release_parsed_pages() noexcept {
+    const std::size_t page = PcapWindow::page_size();
+    const std::size_t end = cursor_ / page * page;
+    if (end > released_ && reader_.data() != nullptr) {
+      // The mapping is page-aligned, so the offsets are too
+      void *start = const_cast<char *>(reader_.data() + released_);
+      (void)::madvise(start, end - released_, MADV_DONTNEED);
+      released_ = end;
+    }
+  }
+
+  const PcapReader &reader_;
+  LinkType link_;
+  Parser parser_;
+  ColumnAccumulator accumulator_;
+  std::size_t chunk_messages_;
+  std::size_t cursor_ = 0;
+  std::size_t released_ = 0;
+  std::size_t packet_count_ = 0;
+  bool done_ = false;
+};
+
+} // namespace itch
@@ -0,0 +1,384 @@
+#pragma once
+
+/**
+ * @file line_arbitrator.hpp
+ * @brief A/B feed arbitration on MoldUDP64 sequence numbers.
+ *
+ * DESIGN PRINCIPLES:
+ * 1. First copy of each sequence number wins; later copies are dropped.
+ * 2. Out-of-order messages wait in a fixed-size ring indexed by sequence,
+ *    so a gap on one line is filled from the other with no allocation.
+ * 3. Zero-copy: the ring stores pointers into the mmap'd captures.
+ * 4. A gap is declared unrecoverable as soon as every live line has moved
+ *    past it, or a line jumps further ahead than the window; it is then
+ *    reported to the handler.
+ *
+ * HANDLER INTERFACE:
+ *   struct Handler {
+ *       void on_message(const char* msg, size_t len, uint64_t sequence);
+ *       void on_gap(uint64_t first_sequence, uint64_t count);
+ *   };
+ */
+
+#include "moldudp64.hpp"
+#include "pcap_reader.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace itch {
+
+// ============================================================================
+// Line Identifiers and Statistics
+// ============================================================================
+
+/**
+ * @brief Redundant feed line.
+ */
+enum class Line : uint8_t { A = 0, B = 1 };
+
+inline constexpr std::size_t kLineCount = 2;
+
+/**
+ * @brief Arbitration counters.
+ */
+struct ArbitrationStats {
+  uint64_t delivered = 0;                ///< Messages passed to the handler
+  uint64_t delivered_from[kLineCount]{}; ///< ...by the line that won
+  uint64_t duplicates = 0;               ///< Copies dropped (already seen)
+  uint64_t gaps = 0;                     ///< Unrecoverable gap ranges
+  uint64_t gap_messages = 0;             ///< Sequence numbers never seen
+  uint64_t max_buffered = 0;             ///< Peak ring occupancy
+};
+
+// ============================================================================
+// LineArbitrator - Sequence-Ordered Merge of Redundant Lines
+// ============================================================================
+
+/**
+ * @brief Merges messages from two redundant lines into one gap-free stream.
+ *
+ * Messages are delivered strictly in sequence order. A message ahead of
+ * the next expected sequence is parked in the ring until the missing
+ * sequence numbers arrive from either line.
+ *
+ * @tparam WindowSize Ring capacity in messages (power of two). Bounds how
+ *         far one line may run ahead of a hole before the hole is abandoned.
+ *
+ * @example
+ *   LineArbitrator<4096> arb;
+ *   arb.offer(Line::A, seq, msg, len, handler);  // for each message
+ *   arb.observe(Line::A, packet.next_sequence());
+ *   arb.resolve(handler);                        // after each packet
+ *   arb.flush(handler);                          // at end of input
+ */
+template <std::size_t WindowSize = 4096> class LineArbitrator {
+  static_assert(WindowSize >= 2 && (WindowSize & (WindowSize - 1)) == 0,
+                "WindowSize must be a power of two");
+
+public:
+  static constexpr uint64_t kNoSequence =
+      std::numeric_limits<uint64_t>::max();
+
+  /**
+   * @brief Construct with a pre-allocated ring (the only allocation).
+   */
+  LineArbitrator() : ring_(WindowSize) {}
+
+  // Non-copyable (ring holds pointers into caller-owned buffers)
+  LineArbitrator(const LineArbitrator &) = delete;
+  LineArbitrator &operator=(const LineArbitrator &) = delete;
+
+  // ========================================================================
+  // Input
+  // ========================================================================
+
+  /**
+   * @brief Offer one message received on `line`.
+   *
+   * The message pointer must stay valid until it is delivered (true for
+   * mmap'd captures held open for the whole replay).
+   *
+   * Complexity: O(1) amortized; O(WindowSize) only when the window is
+   * overrun.
+   */
+  template <typename Handler>
+  void offer(Line line, uint64_t sequence, const char *msg, size_t len,
+             Handler &handler) noexcept {
+    if (next_ == kNoSequence) [[unlikely]] {
+      next_ = sequence; // First message defines the stream start
+    }
+
+    if (sequence < next_) {
+      ++stats_.duplicates;
+      return;
+    }
+
+    if (sequence == next_) {
+      deliver(line, msg, len, handler);
+      drain(handler);
+      return;
+    }
+
+    // Jump beyond the window: everything before it is declared lost and
+    // the stream resynchronises on this sequence
+    if (sequence - next_ >= WindowSize) [[unlikely]] {
+      skip_to(sequence, handler);
+      deliver(line, msg, len, handler);
+      drain(handler);
+      return;
+    }
+
+    Slot &slot = ring_[sequence & kMask];
+    if (slot.sequence == sequence) {
+      ++stats_.duplicates;
+      return;
+    }
+    slot = Slot{sequence, msg, len, line};
+    ++buffered_;
+    stats_.max_buffered =
+        std::max<uint64_t>(stats_.max_buffered, buffered_);
+  }
+
+  /**
+   * @brief Record that `line` has sent everything below `next_sequence`.
+   *
+   * Call once per packet (heartbeats included) with
+   * MoldPacket::next_sequence().
+   */
+  void observe(Line line, uint64_t next_sequence) noexcept {
+    uint64_t &high = line_next_[static_cast<std::size_t>(line)];
+    if (high == kNoSequence || next_sequence > high) {
+      high = next_sequence;
+    }
+  }
+
+  /**
+   * @brief Mark a line as finished; it no longer holds gaps open.
+   */
+  void close_line(Line line) noexcept {
+    closed_[static_cast<std::size_t>(line)] = true;
+  }
+
+  /**
+   * @brief Abandon holes that every live line has already moved past.
+   *
+   * Each line is in sequence order, so once all of them are beyond the
+   * next expected sequence it can no longer arrive. This holds with
+   * nothing parked too: a hole no later message follows (a lost tail,
+   * then heartbeats) is reported once every live line has sent past it.
+   */
+  template <typename Handler> void resolve(Handler &handler) noexcept {
+    while (buffered_ > 0 && all_lines_past(next_)) {
+      skip_gap(handler);
+    }
+    if (next_ != kNoSequence && all_lines_past(next_)) {
+      skip_to(lowest_live_next(), handler);
+    }
+  }
+
+  /**
+   * @brief End of input: report remaining holes, including a tail some
+   *        line announced but neither delivered, and deliver parked
+   *        messages.
+   */
+  template <typename Handler> void flush(Handler &handler) noexcept {
+    while (buffered_ > 0) {
+      skip_gap(handler);
+    }
+    if (next_ != kNoSequence) {
+      skip_to(highest_next(), handler);
+    }
+  }
+
+  // ========================================================================
+  // Accessors
+  // ========================================================================
+
+  [[nodiscard]] const ArbitrationStats &stats() const noexcept {
+    return stats_;
+  }
+
+  /// Next sequence number the arbitrator will deliver
+  [[nodiscard]] uint64_t next_sequence() const noexcept { return next_; }
+
+  /// Messages currently parked in the ring
+  [[nodiscard]] std::size_t buffered() const noexcept { return buffered_; }
+
+  static constexpr std::size_t window_size() noexcept { return WindowSize; }
+
+private:
+  static constexpr uint64_t kMask = WindowSize - 1;
+
+  struct Slot {
+    uint64_t sequence = kNoSequence;
+    const char *msg = nullptr;
+    size_t len = 0;
+    Line line = Line::A;
+  };
+
+  template <typename Handler>
+  void deliver(Line line, const char *msg, size_t len,
+               Handler &handler) noexcept {
+    handler.on_message(msg, len, next_);
+    ++stats_.delivered;
+    ++stats_.delivered_from[static_cast<std::size_t>(line)];
+    ++next_;
+  }
+
+  /// Deliver parked messages that are now contiguous with next_
+  template <typename Handler> void drain(Handler &handler) noexcept {
+    while (buffered_ > 0) {
+      Slot &slot = ring_[next_ & kMask];
+      if (slot.sequence != next_) {
+        return;
+      }
+      slot.sequence = kNoSequence;
+      --buffered_;
+      deliver(slot.line, slot.msg, slot.len, handler);
+    }
+  }
+
+  /// Report the hole at next_ up to the next parked message, then drain
+  template <typename Handler> void skip_gap(Handler &handler) noexcept {
+    uint64_t target = next_ + 1;
+    while (ring_[target & kMask].sequence != target) {
+      ++target; // Terminates: buffered_ > 0 means a parked slot exists
+    }
+    report_gap(target, handler);
+    drain(handler);
+  }
+
+  /// Advance next_ to `target`, delivering parked messages on the way
+  template <typename Handler>
+  void skip_to(uint64_t target, Handler &handler) noexcept {
+    while (next_ < target) {
+      if (buffered_ == 0) {
+        report_gap(target, handler); // Nothing parked: one gap to target
+        return;
+      }
+      if (ring_[next_ & kMask].sequence == next_) {
+        drain(handler);
+        continue;
+      }
+      // Parked messages lie within the window, bounding this scan
+      uint64_t hole_end = next_ + 1;
+      while (hole_end < target &&
+             ring_[hole_end & kMask].sequence != hole_end) {
+        ++hole_end;
+      }
+      report_gap(hole_end, handler);
+    }
+  }
+
+  template <typename Handler>
+  void report_gap(uint64_t hole_end, Handler &handler) noexcept {
+    handler.on_gap(next_, hole_end - next_);
+    ++stats_.gaps;
+    stats_.gap_messages += hole_end - next_;
+    next_ = hole_end;
+  }
+
+  [[nodiscard]] bool all_lines_past(uint64_t sequence) const noexcept {
+    for (std::size_t i = 0; i < kLineCount; ++i) {
+      if (!closed_[i] &&
+          (line_next_[i] == kNoSequence || line_next_[i] <= sequence)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Highest next sequence observed on any line (0 if none)
+  [[nodiscard]] uint64_t highest_next() const noexcept {
+    uint64_t highest = 0;
+    for (const uint64_t next : line_next_) {
+      if (next != kNoSequence) {
+        highest = std::max(highest, next);
+      }
+    }
+    return highest;
+  }
+
+  /// Lowest next sequence of the live lines (highest_next() once all are
+  /// closed); only called when all_lines_past(), so each was observed
+  [[nodiscard]] uint64_t lowest_live_next() const noexcept {
+    uint64_t lowest = kNoSequence;
+    for (std::size_t i = 0; i < kLineCount; ++i) {
+      if (!closed_[i]) {
+        lowest = std::min(lowest, line_next_[i]);
+      }
+    }
+    return lowest == kNoSequence ? highest_next() : lowest;
+  }
+
+  std::vector<Slot> ring_; ///< Parked messages, slot = sequence & kMask
+  std::size_t buffered_ = 0;
+  uint64_t next_ = kNoSequence;
+  uint64_t line_next_[kLineCount] = {kNoSequence, kNoSequence};
+  bool closed_[kLineCount] = {false, false};
+  ArbitrationStats stats_;
+};
+
+// ============================================================================
+// Capture Merge
+// ============================================================================
+
+/**
+ * @brief Replay two redundant captures through an arbitrator.
+ *
+ * Packets are interleaved by capture timestamp (the order they would have
+ * arrived live), decoded as MoldUDP64 and offered message by message.
+ *
+ * @return Number of captured packets consumed from both lines.
+ */
+template <std::size_t WindowSize, typename Handler>
+size_t merge_lines(const PcapReader &line_a, const PcapReader &line_b,
+                   LineArbitrator<WindowSize> &arbitrator, Handler &handler) {
+  const PcapReader *readers[kLineCount] = {&line_a, &line_b};
+  const LinkType links[kLineCount] = {
+      static_cast<LinkType>(line_a.link_type()),
+      static_cast<LinkType>(line_b.link_type())};
+  size_t cursors[kLineCount] = {0, 0};
+  PcapPacket heads[kLineCount];
+  bool live[kLineCount];
+  for (std::size_t i = 0; i < kLineCount; ++i) {
+    live[i] = readers[i]->next_packet(cursors[i], heads[i]);
+    if (!live[i]) {
+      arbitrator.close_line(static_cast<Line>(i));
+    }
+  }
+
+  size_t packet_count = 0;
+  while (live[0] || live[1]) {
+    const bool take_a =
+        live[0] &&
+        (!live[1] || heads[0].timestamp_ns <= heads[1].timestamp_ns);
+    const std::size_t i = take_a ? 0 : 1;
+    const Line line = static_cast<Line>(i);
+
+    MoldPacket packet;
+    if (decode_frame(heads[i].data, heads[i].len, packet, links[i]) ==
+        DecodeResult::Ok) {
+      for_each_message(packet,
+                       [&](const char *msg, size_t len, uint64_t sequence) {
+                         arbitrator.offer(line, sequence, msg, len, handler);
+                       });
+      arbitrator.observe(line, packet.next_sequence());
+    }
+    ++packet_count;
+
+    live[i] = readers[i]->next_packet(cursors[i], heads[i]);
+    if (!live[i]) {
+      arbitrator.close_line(line);
+    }
+    arbitrator.resolve(handler);
+  }
+
+  arbitrator.flush(handler);
+  return packet_count;
+}
+
+} // namespace itch
@@ -16,6 +16,7 @@
  */
 
 #include "compat.hpp"
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <type_traits>
@@ -41,7 +42,7 @@ namespace itch {
  *   BigEndian<uint32_t> price;  // Stored as big-endian
  *   uint32_t host_price = price;  // Swapped to host order on access
  */
-template <typename T> class BigEndian {
+template <typename T> class __attribute__((packed)) BigEndian {
   static_assert(std::is_integral_v<T>, "BigEndian<T> requires integral type");
   static_assert(std::is_unsigned_v<T>, "BigEndian<T> requires unsigned type");
 
@@ -189,6 +190,10 @@ inline constexpr char Trade = 'P';
 inline constexpr char CrossTrade = 'Q';
 inline constexpr char BrokenTrade = 'B';
 inline constexpr char NOII = 'I';
+inline constexpr char RetailInterest = 'N';
+inline constexpr char LULDAuctionCollar = 'J';
+inline constexpr char OperationalHalt = 'h';
+inline constexpr char DirectListingCapitalRaise = 'O';
 } // namespace msg_type
 
 // ============================================================================
@@ -217,6 +222,324 @@ static_assert(offsetof(MessageHeader, stock_locate) == 1);
 static_assert(offsetof(MessageHeader, tracking_number) == 3);
 static_assert(offsetof(MessageHeader, timestamp) == 5);
 
+// ============================================================================
+// System Event Message (Type 'S')
+// ============================================================================
+
+/**
+ * @brief System Event message signalling a market or data feed handler event.
+ *
+ * Total size: 12 bytes
+ *
+ * Event codes: 'O' start of messages, 'S' start of system hours,
+ * 'Q' start of market hours, 'M' end of market hours,
+ * 'E' end of system hours, 'C' end of messages.
+ */
+struct __attribute__((packed)) SystemEvent {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'S'
+  be_u16 stock_locate;    // Offset 1: Always 0
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  char event_code; // Offset 11: Event code (see above)
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(SystemEvent) == 12, "SystemEvent must be 12 bytes");
+static_assert(offsetof(SystemEvent, event_code) == 11);
+
+// ============================================================================
+// Stock Directory Message (Type 'R')
+// ============================================================================
+
+/**
+ * @brief Stock Directory message describing a security at start of day.
+ *
+ * Total size: 39 bytes
+ *
+ * Establishes the stock_locate -> symbol mapping used by every later
+ * message for the security.
+ */
+struct __attribute__((packed)) StockDirectory {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'R'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  // Directory fields (28 bytes)
+  StockSymbol stock;                   // Offset 11
+  char market_category;                // Offset 19: 'Q', 'G', 'S', 'N', ...
+  char financial_status_indicator;     // Offset 20
+  be_u32 round_lot_size;               // Offset 21
+  char round_lots_only;                // Offset 25: 'Y' or 'N'
+  char issue_classification;           // Offset 26
+  char issue_subtype[2];               // Offset 27
+  char authenticity;                   // Offset 29: 'P' live, 'T' test
+  char short_sale_threshold_indicator; // Offset 30
+  char ipo_flag;                       // Offset 31
+  char luld_reference_price_tier;      // Offset 32
+  char etp_flag;                       // Offset 33
+  be_u32 etp_leverage_factor;          // Offset 34
+  char inverse_indicator;              // Offset 38
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(StockDirectory) == 39, "StockDirectory must be 39 bytes");
+static_assert(offsetof(StockDirectory, round_lot_size) == 21);
+static_assert(offsetof(StockDirectory, etp_leverage_factor) == 34);
+static_assert(offsetof(StockDirectory, inverse_indicator) == 38);
+
+// ============================================================================
+// Stock Trading Action Message (Type 'H')
+// ============================================================================
+
+/**
+ * @brief Stock Trading Action message (halt / pause / quotation / trading).
+ *
+ * Total size: 25 bytes
+ */
+struct __attribute__((packed)) StockTradingAction {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'H'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  // Action fields (14 bytes)
+  StockSymbol stock;  // Offset 11
+  char trading_state; // Offset 19: 'H', 'P', 'Q' or 'T'
+  char reserved;      // Offset 20
+  char reason[4];     // Offset 21: Trading action reason code
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(StockTradingAction) == 25,
+              "StockTradingAction must be 25 bytes");
+static_assert(offsetof(StockTradingAction, trading_state) == 19);
+static_assert(offsetof(StockTradingAction, reason) == 21);
+
+// ============================================================================
+// Reg SHO Short Sale Price Test Restriction Message (Type 'Y')
+// ============================================================================
+
+/**
+ * @brief Reg SHO short sale price test restriction indicator.
+ *
+ * Total size: 20 bytes
+ */
+struct __attribute__((packed)) RegSHORestriction {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'Y'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  StockSymbol stock;   // Offset 11
+  char reg_sho_action; // Offset 19: '0', '1' or '2'
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(RegSHORestriction) == 20,
+              "RegSHORestriction must be 20 bytes");
+static_assert(offsetof(RegSHORestriction, reg_sho_action) == 19);
+
+// ============================================================================
+// Market Participant Position Message (Type 'L')
+// ============================================================================
+
+/**
+ * @brief Market maker status for a given security.
+ *
+ * Total size: 26 bytes
+ */
+struct __attribute__((packed)) MarketParticipantPosition {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'L'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  // Position fields (15 bytes)
+  char mpid[4];                  // Offset 11: Market participant ID
+  StockSymbol stock;             // Offset 15
+  char primary_market_maker;     // Offset 23: 'Y' or 'N'
+  char market_maker_mode;        // Offset 24
+  char market_participant_state; // Offset 25
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(MarketParticipantPosition) == 26,
+              "MarketParticipantPosition must be 26 bytes");
+static_assert(offsetof(MarketParticipantPosition, stock) == 15);
+static_assert(offsetof(MarketParticipantPosition, market_participant_state) ==
+              25);
+
+// ============================================================================
+// MWCB Decline Level Message (Type 'V')
+// ============================================================================
+
+/**
+ * @brief Market-Wide Circuit Breaker decline levels for the day.
+ *
+ * Total size: 35 bytes
+ *
+ * Prices carry 8 implied decimal places.
+ */
+struct __attribute__((packed)) MWCBDeclineLevel {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'V'
+  be_u16 stock_locate;    // Offset 1: Always 0
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  be_u64 level1; // Offset 11
+  be_u64 level2; // Offset 19
+  be_u64 level3; // Offset 27
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(MWCBDeclineLevel) == 35,
+              "MWCBDeclineLevel must be 35 bytes");
+static_assert(offsetof(MWCBDeclineLevel, level3) == 27);
+
+// ============================================================================
+// MWCB Status Message (Type 'W')
+// ============================================================================
+
+/**
+ * @brief Market-Wide Circuit Breaker level breached.
+ *
+ * Total size: 12 bytes
+ */
+struct __attribute__((packed)) MWCBStatus {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'W'
+  be_u16 stock_locate;    // Offset 1: Always 0
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  char breached_level; // Offset 11: '1', '2' or '3'
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(MWCBStatus) == 12, "MWCBStatus must be 12 bytes");
+static_assert(offsetof(MWCBStatus, breached_level) == 11);
+
+// ============================================================================
+// IPO Quoting Period Update Message (Type 'K')
+// ============================================================================
+
+/**
+ * @brief Anticipated IPO quotation release time for a security.
+ *
+ * Total size: 28 bytes
+ */
+struct __attribute__((packed)) IPOQuotingPeriod {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'K'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  // IPO fields (17 bytes)
+  StockSymbol stock;                    // Offset 11
+  be_u32 ipo_quotation_release_time;    // Offset 19: Seconds since midnight
+  char ipo_quotation_release_qualifier; // Offset 23: 'A' or 'C'
+  be_u32 ipo_price;                     // Offset 24: Price * 10000
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(IPOQuotingPeriod) == 28,
+              "IPOQuotingPeriod must be 28 bytes");
+static_assert(offsetof(IPOQuotingPeriod, ipo_price) == 24);
+
+// ============================================================================
+// LULD Auction Collar Message (Type 'J')
+// ============================================================================
+
+/**
+ * @brief Limit Up-Limit Down auction collar thresholds.
+ *
+ * Total size: 35 bytes
+ */
+struct __attribute__((packed)) LULDAuctionCollar {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'J'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  // Collar fields (24 bytes)
+  StockSymbol stock;                     // Offset 11
+  be_u32 auction_collar_reference_price; // Offset 19: Price * 10000
+  be_u32 upper_auction_collar_price;     // Offset 23: Price * 10000
+  be_u32 lower_auction_collar_price;     // Offset 27: Price * 10000
+  be_u32 auction_collar_extension;       // Offset 31
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(LULDAuctionCollar) == 35,
+              "LULDAuctionCollar must be 35 bytes");
+static_assert(offsetof(LULDAuctionCollar, auction_collar_extension) == 31);
+
+// ============================================================================
+// Operational Halt Message (Type 'h')
+// ============================================================================
+
+/**
+ * @brief Operational halt on a specific market center.
+ *
+ * Total size: 21 bytes
+ */
+struct __attribute__((packed)) OperationalHalt {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'h'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  StockSymbol stock;            // Offset 11
+  char market_code;             // Offset 19: 'Q', 'B' or 'X'
+  char operational_halt_action; // Offset 20: 'H' halted, 'T' resumed
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(OperationalHalt) == 21,
+              "OperationalHalt must be 21 bytes");
+static_assert(offsetof(OperationalHalt, operational_halt_action) == 20);
+
 // ============================================================================
 // Add Order Message (Type 'A') - No MPID Attribution
 // ============================================================================
@@ -321,6 +644,381 @@ static_assert(offsetof(OrderExecuted, order_ref) == 11);
 static_assert(offsetof(OrderExecuted, executed_shares) == 19);
 static_assert(offsetof(OrderExecuted, match_number) == 23);
 
+// ============================================================================
+// Add Order with MPID Attribution Message (Type 'F')
+// ============================================================================
+
+/**
+ * @brief Add Order message carrying the entering firm's MPID.
+ *
+ * Total size: 40 bytes (AddOrder layout + 4-byte attribution)
+ */
+struct __attribute__((packed)) AddOrderMPID {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'F'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  // Order fields (29 bytes)
+  be_u64 order_ref;    // Offset 11: Unique order reference number
+  char side;           // Offset 19: 'B' = Buy, 'S' = Sell
+  be_u32 shares;       // Offset 20: Number of shares
+  StockSymbol stock;   // Offset 24: Stock symbol (8 chars)
+  be_u32 price;        // Offset 32: Price * 10000
+  char attribution[4]; // Offset 36: MPID of the entering firm
+
+  [[nodiscard]] constexpr bool is_buy() const noexcept { return side == 'B'; }
+  [[nodiscard]] constexpr bool is_sell() const noexcept { return side == 'S'; }
+
+  [[nodiscard]] double price_double() const noexcept {
+    return static_cast<double>(static_cast<uint32_t>(price)) / 10000.0;
+  }
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(AddOrderMPID) == 40, "AddOrderMPID must be 40 bytes");
+static_assert(offsetof(AddOrderMPID, order_ref) == 11);
+static_assert(offsetof(AddOrderMPID, price) == 32);
+static_assert(offsetof(AddOrderMPID, attribution) == 36);
+
+// ============================================================================
+// Order Executed With Price Message (Type 'C')
+// ============================================================================
+
+/**
+ * @brief Order executed at a price different from its display price.
+ *
+ * Total size: 36 bytes
+ */
+struct __attribute__((packed)) OrderExecutedWithPrice {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'C'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  // Execution fields (25 bytes)
+  be_u64 order_ref;       // Offset 11: Order being executed
+  be_u32 executed_shares; // Offset 19: Number of shares executed
+  be_u64 match_number;    // Offset 23: Match ID
+  char printable;         // Offset 31: 'Y' printable, 'N' non-printable
+  be_u32 execution_price; // Offset 32: Price * 10000
+
+  [[nodiscard]] double price_double() const noexcept {
+    return static_cast<double>(static_cast<uint32_t>(execution_price)) /
+           10000.0;
+  }
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(OrderExecutedWithPrice) == 36,
+              "OrderExecutedWithPrice must be 36 bytes");
+static_assert(offsetof(OrderExecutedWithPrice, match_number) == 23);
+static_assert(offsetof(OrderExecutedWithPrice, printable) == 31);
+static_assert(offsetof(OrderExecutedWithPrice, execution_price) == 32);
+
+// ============================================================================
+// Order Cancel Message (Type 'X')
+// ============================================================================
+
+/**
+ * @brief Partial cancellation of a resting order.
+ *
+ * Total size: 23 bytes
+ */
+struct __attribute__((packed)) OrderCancel {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'X'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  be_u64 order_ref;        // Offset 11: Order being reduced
+  be_u32 cancelled_shares; // Offset 19: Shares removed from the order
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(OrderCancel) == 23, "OrderCancel must be 23 bytes");
+static_assert(offsetof(OrderCancel, cancelled_shares) == 19);
+
+// ============================================================================
+// Order Delete Message (Type 'D')
+// ============================================================================
+
+/**
+ * @brief Full removal of a resting order.
+ *
+ * Total size: 19 bytes
+ */
+struct __attribute__((packed)) OrderDelete {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'D'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  be_u64 order_ref; // Offset 11: Order being deleted
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(OrderDelete) == 19, "OrderDelete must be 19 bytes");
+static_assert(offsetof(OrderDelete, order_ref) == 11);
+
+// ============================================================================
+// Order Replace Message (Type 'U')
+// ============================================================================
+
+/**
+ * @brief Cancel-replace: original order removed, new order added.
+ *
+ * Total size: 35 bytes
+ *
+ * The replacement keeps the original side and security but loses time
+ * priority.
+ */
+struct __attribute__((packed)) OrderReplace {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'U'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  // Replace fields (24 bytes)
+  be_u64 original_order_ref; // Offset 11: Order being replaced
+  be_u64 new_order_ref;      // Offset 19: Reference of the replacement
+  be_u32 shares;             // Offset 27: New displayed shares
+  be_u32 price;              // Offset 31: New price * 10000
+
+  [[nodiscard]] double price_double() const noexcept {
+    return static_cast<double>(static_cast<uint32_t>(price)) / 10000.0;
+  }
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(OrderReplace) == 35, "OrderReplace must be 35 bytes");
+static_assert(offsetof(OrderReplace, new_order_ref) == 19);
+static_assert(offsetof(OrderReplace, shares) == 27);
+static_assert(offsetof(OrderReplace, price) == 31);
+
+// ============================================================================
+// Trade Message - Non-Cross (Type 'P')
+// ============================================================================
+
+/**
+ * @brief Execution against a non-displayed order.
+ *
+ * Total size: 44 bytes
+ *
+ * Does not affect the displayed book.
+ */
+struct __attribute__((packed)) Trade {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'P'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  // Trade fields (33 bytes)
+  be_u64 order_ref;    // Offset 11: Always 0 since ITCH 5.0
+  char side;           // Offset 19: 'B' (always 'B' since 2014)
+  be_u32 shares;       // Offset 20
+  StockSymbol stock;   // Offset 24
+  be_u32 price;        // Offset 32: Price * 10000
+  be_u64 match_number; // Offset 36
+
+  [[nodiscard]] double price_double() const noexcept {
+    return static_cast<double>(static_cast<uint32_t>(price)) / 10000.0;
+  }
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(Trade) == 44, "Trade must be 44 bytes");
+static_assert(offsetof(Trade, shares) == 20);
+static_assert(offsetof(Trade, price) == 32);
+static_assert(offsetof(Trade, match_number) == 36);
+
+// ============================================================================
+// Cross Trade Message (Type 'Q')
+// ============================================================================
+
+/**
+ * @brief Bulk print from an opening, closing, halt or IPO cross.
+ *
+ * Total size: 40 bytes
+ */
+struct __attribute__((packed)) CrossTrade {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'Q'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  // Cross fields (29 bytes)
+  be_u64 shares;       // Offset 11: Shares matched in the cross
+  StockSymbol stock;   // Offset 19
+  be_u32 cross_price;  // Offset 27: Price * 10000
+  be_u64 match_number; // Offset 31
+  char cross_type;     // Offset 39: 'O', 'C', 'H' or 'I'
+
+  [[nodiscard]] double price_double() const noexcept {
+    return static_cast<double>(static_cast<uint32_t>(cross_price)) / 10000.0;
+  }
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(CrossTrade) == 40, "CrossTrade must be 40 bytes");
+static_assert(offsetof(CrossTrade, cross_price) == 27);
+static_assert(offsetof(CrossTrade, cross_type) == 39);
+
+// ============================================================================
+// Broken Trade Message (Type 'B')
+// ============================================================================
+
+/**
+ * @brief Previously reported execution has been broken.
+ *
+ * Total size: 19 bytes
+ */
+struct __attribute__((packed)) BrokenTrade {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'B'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  be_u64 match_number; // Offset 11: Match ID of the broken execution
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(BrokenTrade) == 19, "BrokenTrade must be 19 bytes");
+static_assert(offsetof(BrokenTrade, match_number) == 11);
+
+// ============================================================================
+// Net Order Imbalance Indicator Message (Type 'I')
+// ============================================================================
+
+/**
+ * @brief NOII: auction imbalance published ahead of a cross.
+ *
+ * Total size: 50 bytes
+ */
+struct __attribute__((packed)) NOII {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'I'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  // Imbalance fields (39 bytes)
+  be_u64 paired_shares;           // Offset 11
+  be_u64 imbalance_shares;        // Offset 19
+  char imbalance_direction;       // Offset 27: 'B', 'S', 'N' or 'O'
+  StockSymbol stock;              // Offset 28
+  be_u32 far_price;               // Offset 36: Price * 10000
+  be_u32 near_price;              // Offset 40: Price * 10000
+  be_u32 current_reference_price; // Offset 44: Price * 10000
+  char cross_type;                // Offset 48: 'O', 'C' or 'H'
+  char price_variation_indicator; // Offset 49
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(NOII) == 50, "NOII must be 50 bytes");
+static_assert(offsetof(NOII, stock) == 28);
+static_assert(offsetof(NOII, current_reference_price) == 44);
+static_assert(offsetof(NOII, price_variation_indicator) == 49);
+
+// ============================================================================
+// Retail Price Improvement Indicator Message (Type 'N')
+// ============================================================================
+
+/**
+ * @brief RPII: presence of retail price improving interest.
+ *
+ * Total size: 20 bytes
+ */
+struct __attribute__((packed)) RetailInterest {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'N'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  StockSymbol stock;  // Offset 11
+  char interest_flag; // Offset 19: 'B', 'S', 'A' or 'N'
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(RetailInterest) == 20, "RetailInterest must be 20 bytes");
+static_assert(offsetof(RetailInterest, interest_flag) == 19);
+
+// ============================================================================
+// Direct Listing with Capital Raise Price Discovery Message (Type 'O')
+// ============================================================================
+
+/**
+ * @brief Price discovery information for a direct listing with capital raise.
+ *
+ * Total size: 48 bytes
+ */
+struct __attribute__((packed)) DirectListingCapitalRaise {
+  // Header fields (11 bytes)
+  char msg_type;          // Offset 0: 'O'
+  be_u16 stock_locate;    // Offset 1
+  be_u16 tracking_number; // Offset 3
+  Timestamp48 timestamp;  // Offset 5
+
+  // Price discovery fields (37 bytes)
+  StockSymbol stock;               // Offset 11
+  char open_eligibility_status;    // Offset 19: 'N' or 'Y'
+  be_u32 minimum_allowable_price;  // Offset 20: Price * 10000
+  be_u32 maximum_allowable_price;  // Offset 24: Price * 10000
+  be_u32 near_execution_price;     // Offset 28: Price * 10000
+  be_u64 near_execution_time;      // Offset 32: Nanoseconds since midnight
+  be_u32 lower_price_range_collar; // Offset 40: Price * 10000
+  be_u32 upper_price_range_collar; // Offset 44: Price * 10000
+
+  [[nodiscard]] const MessageHeader &header() const noexcept {
+    return *reinterpret_cast<const MessageHeader *>(this);
+  }
+};
+
+static_assert(sizeof(DirectListingCapitalRaise) == 48,
+              "DirectListingCapitalRaise must be 48 bytes");
+static_assert(offsetof(DirectListingCapitalRaise, near_execution_time) == 32);
+static_assert(offsetof(DirectListingCapitalRaise, upper_price_range_collar) ==
+              44);
+
 // ============================================================================
 // Zero-Copy Message Parsing
 // ============================================================================
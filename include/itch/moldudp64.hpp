@@ -0,0 +1,321 @@
+#pragma once
+
+/**
+ * @file moldudp64.hpp
+ * @brief Ethernet/VLAN/IPv4/UDP/MoldUDP64 decoder for captured ITCH feeds.
+ *
+ * DESIGN PRINCIPLES:
+ * 1. Decode each header exactly once, at a known position - no probing.
+ * 2. Walk MoldUDP64 message blocks by their 2-byte length prefix.
+ * 3. Zero-copy: decoded packet and messages point into the capture buffer.
+ * 4. Session and sequence number are surfaced to the visitor per packet.
+ *
+ * Frame Layout:
+ *   Link layer:   by the capture's link type (LinkType)
+ *                 Ethernet II 14 bytes (dst MAC, src MAC, EtherType),
+ *                 Linux cooked (SLL) 16 bytes, or none for raw IPv4
+ *   802.1Q/ad:    4 bytes per tag (optional, stacked tags supported)
+ *   IPv4:         IHL * 4 bytes (options honoured)
+ *   UDP:          8 bytes (length bounds the payload, strips frame padding)
+ *   MoldUDP64:    20 bytes (session[10], sequence u64, message count u16)
+ *   Blocks:       message_count x { length u16 BE, ITCH message }
+ */
+
+#include "messages.hpp"
+#include "parser.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace itch {
+
+// ============================================================================
+// Wire Constants
+// ============================================================================
+
+namespace wire {
+inline constexpr size_t kEthernetHeaderSize = 14;
+inline constexpr size_t kLinuxSllHeaderSize = 16; // Protocol at offset 14
+inline constexpr size_t kVlanTagSize = 4;
+inline constexpr size_t kIPv4MinHeaderSize = 20;
+inline constexpr size_t kUdpHeaderSize = 8;
+
+inline constexpr uint16_t kEtherTypeIPv4 = 0x0800;
+inline constexpr uint16_t kEtherTypeVlan = 0x8100; // 802.1Q
+inline constexpr uint16_t kEtherTypeQinQ = 0x88A8; // 802.1ad
+inline constexpr uint8_t kIpProtoUdp = 17;
+
+/// MoldUDP64 message count signalling a heartbeat (no messages)
+inline constexpr uint16_t kMoldHeartbeat = 0;
+/// MoldUDP64 message count signalling end of session
+inline constexpr uint16_t kMoldEndOfSession = 0xFFFF;
+} // namespace wire
+
+/**
+ * @brief Capture link types decode_frame() understands (PCAP "network").
+ */
+enum class LinkType : uint32_t {
+  Ethernet = 1,   ///< LINKTYPE_ETHERNET
+  Raw = 101,      ///< LINKTYPE_RAW (IPv4 or IPv6, no link header)
+  LinuxSll = 113, ///< LINKTYPE_LINUX_SLL ("any" interface captures)
+  IPv4 = 228,     ///< LINKTYPE_IPV4
+};
+
+/**
+ * @brief Check whether decode_frame() can read a capture's link type.
+ */
+[[nodiscard]] constexpr bool is_supported_link_type(uint32_t network) noexcept {
+  switch (static_cast<LinkType>(network)) {
+  case LinkType::Ethernet:
+  case LinkType::Raw:
+  case LinkType::LinuxSll:
+  case LinkType::IPv4:
+    return true;
+  }
+  return false;
+}
+
+// ============================================================================
+// MoldUDP64 Header (20 bytes)
+// ============================================================================
+
+/**
+ * @brief MoldUDP64 downstream packet header.
+ *
+ * Layout:
+ *   Offset  0: Session (10 bytes, ASCII, space-padded)
+ *   Offset 10: Sequence Number (8 bytes) - sequence of first message
+ *   Offset 18: Message Count (2 bytes) - 0 heartbeat, 0xFFFF end of session
+ */
+struct __attribute__((packed)) MoldUDP64Header {
+  char session[10];     // Offset 0
+  be_u64 sequence;      // Offset 10
+  be_u16 message_count; // Offset 18
+};
+
+static_assert(sizeof(MoldUDP64Header) == 20,
+              "MoldUDP64Header must be 20 bytes");
+static_assert(offsetof(MoldUDP64Header, sequence) == 10);
+static_assert(offsetof(MoldUDP64Header, message_count) == 18);
+
+// ============================================================================
+// Decoded Packet
+// ============================================================================
+
+/**
+ * @brief One decoded MoldUDP64 packet (views into the capture buffer).
+ *
+ * Message i of the packet carries sequence number `sequence + i`.
+ */
+struct MoldPacket {
+  const char *session = nullptr; ///< 10 ASCII bytes (not NUL-terminated)
+  uint64_t sequence = 0;         ///< Sequence number of the first message
+  uint16_t message_count = 0;    ///< Blocks in this packet (see wire::kMold*)
+  const char *blocks = nullptr;  ///< First length-prefixed message block
+  size_t blocks_len = 0;         ///< Bytes of message blocks (UDP-bounded)
+
+  /// Session identifier length on the wire
+  static constexpr size_t kSessionSize = 10;
+
+  [[nodiscard]] bool is_heartbeat() const noexcept {
+    return message_count == wire::kMoldHeartbeat;
+  }
+  [[nodiscard]] bool is_end_of_session() const noexcept {
+    return message_count == wire::kMoldEndOfSession;
+  }
+
+  /// Sequence number expected in the packet that follows this one
+  [[nodiscard]] uint64_t next_sequence() const noexcept {
+    return is_end_of_session() ? sequence : sequence + message_count;
+  }
+};
+
+/**
+ * @brief Result of decoding one captured frame.
+ */
+enum class DecodeResult : uint8_t {
+  Ok,           ///< MoldUDP64 packet decoded
+  Truncated,    ///< Frame shorter than a header it announces
+  NotIPv4,      ///< EtherType is not IPv4 (ARP, IPv6, ...)
+  NotUdp,       ///< IPv4 protocol is not UDP
+  Fragmented,   ///< IPv4 fragment (MoldUDP64 packets are never fragmented)
+  BadMoldFrame, ///< Message blocks overrun the UDP payload
+  BadLinkType   ///< Link type decode_frame() cannot read
+};
+
+// ============================================================================
+// Frame Decoding
+// ============================================================================
+
+namespace detail {
+[[nodiscard]] inline uint16_t load_be16(const char *p) noexcept {
+  const auto *u = reinterpret_cast<const unsigned char *>(p);
+  return static_cast<uint16_t>((u[0] << 8) | u[1]);
+}
+} // namespace detail
+
+/**
+ * @brief Decode a captured frame down to its MoldUDP64 packet.
+ *
+ * @param frame Captured frame starting at the link-layer header.
+ * @param len Captured length.
+ * @param out Filled on success.
+ * @param link The capture's link type (PcapReader::link_type()).
+ * @return DecodeResult::Ok if `out` describes a MoldUDP64 packet.
+ *
+ * Complexity: O(VLAN tags) - every header is read once at a fixed offset.
+ */
+[[nodiscard]] inline DecodeResult
+decode_frame(const char *frame, size_t len, MoldPacket &out,
+             LinkType link = LinkType::Ethernet) noexcept {
+  // Link layer: the EtherType (or SLL protocol) sits just before `offset`
+  size_t offset = 0;
+  uint16_t ether_type = wire::kEtherTypeIPv4;
+  switch (link) {
+  case LinkType::Ethernet:
+    offset = wire::kEthernetHeaderSize;
+    break;
+  case LinkType::LinuxSll:
+    offset = wire::kLinuxSllHeaderSize;
+    break;
+  case LinkType::Raw:
+  case LinkType::IPv4:
+    break; // IPv4 header first; its version nibble is checked below
+  default:
+    return DecodeResult::BadLinkType;
+  }
+  if (len < offset) [[unlikely]] {
+    return DecodeResult::Truncated;
+  }
+  if (offset != 0) {
+    ether_type = detail::load_be16(frame + offset - 2);
+  }
+
+  // Stacked 802.1Q / 802.1ad tags
+  while (ether_type == wire::kEtherTypeVlan ||
+         ether_type == wire::kEtherTypeQinQ) {
+    if (len < offset + wire::kVlanTagSize) [[unlikely]] {
+      return DecodeResult::Truncated;
+    }
+    ether_type = detail::load_be16(frame + offset + 2);
+    offset += wire::kVlanTagSize;
+  }
+  if (ether_type != wire::kEtherTypeIPv4) [[unlikely]] {
+    return DecodeResult::NotIPv4;
+  }
+
+  // IPv4
+  if (len < offset + wire::kIPv4MinHeaderSize) [[unlikely]] {
+    return DecodeResult::Truncated;
+  }
+  const auto *ip = reinterpret_cast<const unsigned char *>(frame + offset);
+  const size_t ihl = static_cast<size_t>(ip[0] & 0x0F) * 4;
+  if ((ip[0] >> 4) != 4 || ihl < wire::kIPv4MinHeaderSize) [[unlikely]] {
+    return DecodeResult::NotIPv4;
+  }
+  if (ip[9] != wire::kIpProtoUdp) [[unlikely]] {
+    return DecodeResult::NotUdp;
+  }
+  // More-fragments flag or non-zero fragment offset
+  if ((detail::load_be16(frame + offset + 6) & 0x3FFF) != 0) [[unlikely]] {
+    return DecodeResult::Fragmented;
+  }
+  offset += ihl;
+
+  // UDP - its length field excludes Ethernet trailer padding
+  if (len < offset + wire::kUdpHeaderSize) [[unlikely]] {
+    return DecodeResult::Truncated;
+  }
+  const size_t udp_len = detail::load_be16(frame + offset + 4);
+  if (udp_len < wire::kUdpHeaderSize + sizeof(MoldUDP64Header) ||
+      offset + udp_len > len) [[unlikely]] {
+    return DecodeResult::Truncated;
+  }
+  const size_t payload_end = offset + udp_len;
+  offset += wire::kUdpHeaderSize;
+
+  // MoldUDP64
+  const auto *mold = reinterpret_cast<const MoldUDP64Header *>(frame + offset);
+  offset += sizeof(MoldUDP64Header);
+
+  out.session = mold->session;
+  out.sequence = mold->sequence;
+  out.message_count = mold->message_count;
+  out.blocks = frame + offset;
+  out.blocks_len = payload_end - offset;
+  return DecodeResult::Ok;
+}
+
+/**
+ * @brief Iterate the length-prefixed message blocks of a decoded packet.
+ *
+ * @tparam Callback Function with signature
+ *                  void(const char* msg, size_t len, uint64_t sequence)
+ * @return Number of messages visited, or fewer than message_count if a
+ *         block overruns the packet.
+ */
+template <typename Callback>
+size_t for_each_message(const MoldPacket &packet, Callback &&callback) {
+  if (packet.is_heartbeat() || packet.is_end_of_session()) {
+    return 0;
+  }
+
+  const char *cursor = packet.blocks;
+  const char *const end = packet.blocks + packet.blocks_len;
+  uint64_t sequence = packet.sequence;
+  size_t visited = 0;
+
+  for (uint16_t i = 0; i < packet.message_count; ++i) {
+    if (end - cursor < 2) [[unlikely]] {
+      break;
+    }
+    const size_t msg_len = detail::load_be16(cursor);
+    cursor += 2;
+    if (msg_len == 0 || static_cast<size_t>(end - cursor) < msg_len)
+        [[unlikely]] {
+      break;
+    }
+
+    callback(cursor, msg_len, sequence);
+
+    cursor += msg_len;
+    ++sequence;
+    ++visited;
+  }
+
+  return visited;
+}
+
+/**
+ * @brief Decode a frame and dispatch every ITCH message to the visitor.
+ *
+ * Calls visitor.on_packet(packet) once per decoded MoldUDP64 packet
+ * (including heartbeats), then parser.parse() for each message block.
+ *
+ * @return DecodeResult of the frame; BadMoldFrame if fewer blocks than
+ *         announced could be walked.
+ */
+template <typename Visitor>
+[[nodiscard]] DecodeResult
+parse_frame(const Parser &parser, const char *frame, size_t len,
+            Visitor &visitor, LinkType link = LinkType::Ethernet) noexcept {
+  MoldPacket packet;
+  const DecodeResult result = decode_frame(frame, len, packet, link);
+  if (result != DecodeResult::Ok) [[unlikely]] {
+    return result;
+  }
+
+  visitor.on_packet(packet);
+
+  const size_t visited = for_each_message(
+      packet, [&](const char *msg, size_t msg_len, uint64_t /*sequence*/) {
+        (void)parser.parse(msg, msg_len, visitor);
+      });
+
+  if (!packet.is_heartbeat() && !packet.is_end_of_session() &&
+      visited != packet.message_count) [[unlikely]] {
+    return DecodeResult::BadMoldFrame;
+  }
+  return DecodeResult::Ok;
+}
+
+} // namespace itch
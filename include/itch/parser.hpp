@@ -14,6 +14,7 @@
  *   struct MyHandler {
  *       void on_add_order(const AddOrder& msg) { ... }
  *       void on_order_executed(const OrderExecuted& msg) { ... }
+ *       // ... one on_xxx hook per ITCH 5.0 message type
  *       void on_unknown(char msg_type, const char* data, size_t len) { ... }
  *   };
  *
@@ -40,6 +41,8 @@ enum class ParseResult : uint8_t {
   InvalidLength   ///< Message length doesn't match expected size
 };
 
+struct MoldPacket; // Transport framing, see moldudp64.hpp
+
 // ============================================================================
 // Default Visitor (No-op handlers)
 // ============================================================================
@@ -51,12 +54,40 @@ enum class ParseResult : uint8_t {
  * All methods are intentionally empty - compiler will optimize away.
  */
 struct DefaultVisitor {
-  // System messages
-  void on_system_event(const MessageHeader & /*msg*/) {}
+  // Transport: one call per decoded MoldUDP64 packet (session + sequence)
+  void on_packet(const MoldPacket & /*pkt*/) {}
+
+  // System / administrative messages
+  void on_system_event(const SystemEvent & /*msg*/) {}
+  void on_stock_directory(const StockDirectory & /*msg*/) {}
+  void on_stock_trading_action(const StockTradingAction & /*msg*/) {}
+  void on_reg_sho_restriction(const RegSHORestriction & /*msg*/) {}
+  void on_market_participant_position(const MarketParticipantPosition &
+                                      /*msg*/) {}
+  void on_mwcb_decline_level(const MWCBDeclineLevel & /*msg*/) {}
+  void on_mwcb_status(const MWCBStatus & /*msg*/) {}
+  void on_ipo_quoting_period(const IPOQuotingPeriod & /*msg*/) {}
+  void on_luld_auction_collar(const LULDAuctionCollar & /*msg*/) {}
+  void on_operational_halt(const OperationalHalt & /*msg*/) {}
 
   // Order messages
   void on_add_order(const AddOrder & /*msg*/) {}
+  void on_add_order_mpid(const AddOrderMPID & /*msg*/) {}
   void on_order_executed(const OrderExecuted & /*msg*/) {}
+  void on_order_executed_with_price(const OrderExecutedWithPrice & /*msg*/) {}
+  void on_order_cancel(const OrderCancel & /*msg*/) {}
+  void on_order_delete(const OrderDelete & /*msg*/) {}
+  void on_order_replace(const OrderReplace & /*msg*/) {}
+
+  // Trade messages
+  void on_trade(const Trade & /*msg*/) {}
+  void on_cross_trade(const CrossTrade & /*msg*/) {}
+  void on_broken_trade(const BrokenTrade & /*msg*/) {}
+
+  // Auction / price discovery messages
+  void on_noii(const NOII & /*msg*/) {}
+  void on_retail_interest(const RetailInterest & /*msg*/) {}
+  void on_direct_listing(const DirectListingCapitalRaise & /*msg*/) {}
 
   // Called for unhandled message types
   void on_unknown(char /*msg_type*/, const char * /*data*/, size_t /*len*/) {}
@@ -73,17 +104,59 @@ struct DefaultVisitor {
  */
 [[nodiscard]] constexpr size_t get_message_size(char msg_type) noexcept {
   switch (msg_type) {
+  // System / administrative messages
+  case msg_type::SystemEvent:
+    return sizeof(SystemEvent);
+  case msg_type::StockDirectory:
+    return sizeof(StockDirectory);
+  case msg_type::StockTradingAction:
+    return sizeof(StockTradingAction);
+  case msg_type::RegSHORestriction:
+    return sizeof(RegSHORestriction);
+  case msg_type::MarketParticipantPosition:
+    return sizeof(MarketParticipantPosition);
+  case msg_type::MWCBDeclineLevel:
+    return sizeof(MWCBDeclineLevel);
+  case msg_type::MWCBStatus:
+    return sizeof(MWCBStatus);
+  case msg_type::IPOQuotingPeriod:
+    return sizeof(IPOQuotingPeriod);
+  case msg_type::LULDAuctionCollar:
+    return sizeof(LULDAuctionCollar);
+  case msg_type::OperationalHalt:
+    return sizeof(OperationalHalt);
+
   // Order messages
   case msg_type::AddOrder:
     return sizeof(AddOrder);
+  case msg_type::AddOrderMPID:
+    return sizeof(AddOrderMPID);
   case msg_type::OrderExecuted:
     return sizeof(OrderExecuted);
-
-  // System messages (just header for now)
-  case msg_type::SystemEvent:
-    return sizeof(MessageHeader);
-
-    // TODO: Add more message types as implemented
+  case msg_type::OrderExecutedWithPrice:
+    return sizeof(OrderExecutedWithPrice);
+  case msg_type::OrderCancel:
+    return sizeof(OrderCancel);
+  case msg_type::OrderDelete:
+    return sizeof(OrderDelete);
+  case msg_type::OrderReplace:
+    return sizeof(OrderReplace);
+
+  // Trade messages
+  case msg_type::Trade:
+    return sizeof(Trade);
+  case msg_type::CrossTrade:
+    return sizeof(CrossTrade);
+  case msg_type::BrokenTrade:
+    return sizeof(BrokenTrade);
+
+  // Auction / price discovery messages
+  case msg_type::NOII:
+    return sizeof(NOII);
+  case msg_type::RetailInterest:
+    return sizeof(RetailInterest);
+  case msg_type::DirectListingCapitalRaise:
+    return sizeof(DirectListingCapitalRaise);
 
   default:
     return 0; // Unknown type
@@ -143,35 +216,107 @@ public:
 
     // Dispatch based on message type
     // Using switch-case compiles to efficient jump table
-    // Branch hints: AddOrder is most common (~70% of messages), SystemEvent is
-    // rare
+    // Branch hints: AddOrder is most common (~70% of messages), system and
+    // administrative messages are rare
     switch (msg_type) {
-    [[likely]] case msg_type::AddOrder: {
-      if (length < sizeof(AddOrder)) [[unlikely]] {
-        return ParseResult::BufferTooSmall;
-      }
-      const auto *msg = reinterpret_cast<const AddOrder *>(buffer);
-      visitor.on_add_order(*msg);
-      return ParseResult::Ok;
-    }
-
-    case msg_type::OrderExecuted: {
-      if (length < sizeof(OrderExecuted)) [[unlikely]] {
-        return ParseResult::BufferTooSmall;
-      }
-      const auto *msg = reinterpret_cast<const OrderExecuted *>(buffer);
-      visitor.on_order_executed(*msg);
-      return ParseResult::Ok;
-    }
-
-    [[unlikely]] case msg_type::SystemEvent: {
-      if (length < sizeof(MessageHeader)) [[unlikely]] {
-        return ParseResult::BufferTooSmall;
-      }
-      const auto *msg = reinterpret_cast<const MessageHeader *>(buffer);
-      visitor.on_system_event(*msg);
-      return ParseResult::Ok;
-    }
+    // Order messages
+    [[likely]] case msg_type::AddOrder:
+      return dispatch<AddOrder>(buffer, length, [&](const auto &msg) {
+        visitor.on_add_order(msg);
+      });
+    case msg_type::AddOrderMPID:
+      return dispatch<AddOrderMPID>(buffer, length, [&](const auto &msg) {
+        visitor.on_add_order_mpid(msg);
+      });
+    case msg_type::OrderExecuted:
+      return dispatch<OrderExecuted>(buffer, length, [&](const auto &msg) {
+        visitor.on_order_executed(msg);
+      });
+    case msg_type::OrderExecutedWithPrice:
+      return dispatch<OrderExecutedWithPrice>(
+          buffer, length,
+          [&](const auto &msg) { visitor.on_order_executed_with_price(msg); });
+    case msg_type::OrderCancel:
+      return dispatch<OrderCancel>(buffer, length, [&](const auto &msg) {
+        visitor.on_order_cancel(msg);
+      });
+    case msg_type::OrderDelete:
+      return dispatch<OrderDelete>(buffer, length, [&](const auto &msg) {
+        visitor.on_order_delete(msg);
+      });
+    case msg_type::OrderReplace:
+      return dispatch<OrderReplace>(buffer, length, [&](const auto &msg) {
+        visitor.on_order_replace(msg);
+      });
+
+    // Trade messages
+    case msg_type::Trade:
+      return dispatch<Trade>(buffer, length,
+                             [&](const auto &msg) { visitor.on_trade(msg); });
+    case msg_type::CrossTrade:
+      return dispatch<CrossTrade>(buffer, length, [&](const auto &msg) {
+        visitor.on_cross_trade(msg);
+      });
+    case msg_type::BrokenTrade:
+      return dispatch<BrokenTrade>(buffer, length, [&](const auto &msg) {
+        visitor.on_broken_trade(msg);
+      });
+
+    // Auction / price discovery messages
+    case msg_type::NOII:
+      return dispatch<NOII>(buffer, length,
+                            [&](const auto &msg) { visitor.on_noii(msg); });
+    case msg_type::RetailInterest:
+      return dispatch<RetailInterest>(buffer, length, [&](const auto &msg) {
+        visitor.on_retail_interest(msg);
+      });
+    case msg_type::DirectListingCapitalRaise:
+      return dispatch<DirectListingCapitalRaise>(
+          buffer, length,
+          [&](const auto &msg) { visitor.on_direct_listing(msg); });
+
+    // System / administrative messages
+    [[unlikely]] case msg_type::SystemEvent:
+      return dispatch<SystemEvent>(buffer, length, [&](const auto &msg) {
+        visitor.on_system_event(msg);
+      });
+    case msg_type::StockDirectory:
+      return dispatch<StockDirectory>(buffer, length, [&](const auto &msg) {
+        visitor.on_stock_directory(msg);
+      });
+    case msg_type::StockTradingAction:
+      return dispatch<StockTradingAction>(buffer, length, [&](const auto &msg) {
+        visitor.on_stock_trading_action(msg);
+      });
+    case msg_type::RegSHORestriction:
+      return dispatch<RegSHORestriction>(buffer, length, [&](const auto &msg) {
+        visitor.on_reg_sho_restriction(msg);
+      });
+    case msg_type::MarketParticipantPosition:
+      return dispatch<MarketParticipantPosition>(
+          buffer, length, [&](const auto &msg) {
+            visitor.on_market_participant_position(msg);
+          });
+    case msg_type::MWCBDeclineLevel:
+      return dispatch<MWCBDeclineLevel>(buffer, length, [&](const auto &msg) {
+        visitor.on_mwcb_decline_level(msg);
+      });
+    case msg_type::MWCBStatus:
+      return dispatch<MWCBStatus>(buffer, length, [&](const auto &msg) {
+        visitor.on_mwcb_status(msg);
+      });
+    case msg_type::IPOQuotingPeriod:
+      return dispatch<IPOQuotingPeriod>(buffer, length, [&](const auto &msg) {
+        visitor.on_ipo_quoting_period(msg);
+      });
+    case msg_type::LULDAuctionCollar:
+      return dispatch<LULDAuctionCollar>(buffer, length, [&](const auto &msg) {
+        visitor.on_luld_auction_collar(msg);
+      });
+    case msg_type::OperationalHalt:
+      return dispatch<OperationalHalt>(buffer, length, [&](const auto &msg) {
+        visitor.on_operational_halt(msg);
+      });
 
     default:
       // Unknown message type - still dispatch to on_unknown
@@ -234,6 +379,23 @@ public:
 
     return consumed;
   }
+
+private:
+  /**
+   * @brief Bounds-check and overlay a message of type Msg, then invoke fn.
+   *
+   * Kept as a forced-inline helper so each switch case still compiles to a
+   * single size compare + direct call into the visitor.
+   */
+  template <typename Msg, typename Fn>
+  [[nodiscard]] __attribute__((always_inline)) static ParseResult
+  dispatch(const char *buffer, size_t length, Fn &&fn) noexcept {
+    if (length < sizeof(Msg)) [[unlikely]] {
+      return ParseResult::BufferTooSmall;
+    }
+    fn(*reinterpret_cast<const Msg *>(buffer));
+    return ParseResult::Ok;
+  }
 };
 
 // ============================================================================
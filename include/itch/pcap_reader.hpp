@@ -8,6 +8,9 @@
  * 1. No libpcap dependency - manual header parsing.
  * 2. mmap entire file for zero-copy access.
  * 3. Direct pointer passing to parser (no memcpy).
+ * 4. Bounded footprint on request - PcapMapping::Window maps the file one
+ *    fixed-size window at a time, so captures larger than RAM (or than
+ *    the address space) stream through a constant amount of memory.
  *
  * PCAP File Format:
  *   Global Header: 24 bytes (magic, version, snaplen, etc.)
@@ -16,6 +19,7 @@
  *     Packet Data: incl_len bytes
  */
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -59,6 +63,145 @@ struct __attribute__((packed)) PcapPacketHeader {
 static_assert(sizeof(PcapPacketHeader) == 16,
               "PcapPacketHeader must be 16 bytes");
 
+/**
+ * @brief How PcapReader maps the capture.
+ */
+enum class PcapMapping : uint8_t {
+  Whole,  ///< One mapping of the entire file (default)
+  Window, ///< Sliding fixed-size windows; for_each_packet() only
+};
+
+/**
+ * @brief One captured packet (view into the mmap'd file).
+ */
+struct PcapPacket {
+  const char *data = nullptr; ///< Captured bytes (starts at link header)
+  size_t len = 0;             ///< Captured length (incl_len)
+  uint64_t timestamp_ns = 0;  ///< Capture time, nanoseconds since epoch
+};
+
+// ============================================================================
+// PcapWindow - Sliding Mapping Over a File
+// ============================================================================
+
+/**
+ * @brief Maps one window of a file at a time for a single forward pass.
+ *
+ * view() returns a pointer to any byte range at or after the previous
+ * one. When the range leaves the current window, the window is retired
+ * and a new one is mapped starting at the range's page, so a record that
+ * spans a window boundary is still contiguous (a record larger than the
+ * window gets a window of its own size).
+ *
+ * Each new window is advised MADV_SEQUENTIAL and MADV_WILLNEED, and the
+ * window after it is queued for read-ahead with POSIX_FADV_WILLNEED, so
+ * the disk works ahead of the cursor. The new window is mapped before
+ * the old one is unmapped, and only the old pages behind the new base
+ * are released from the page cache; the boundary page both windows
+ * share stays cached. Neither RSS nor the cache grows with the file.
+ */
+class PcapWindow {
+public:
+  PcapWindow(int fd, size_t file_size, size_t window_bytes) noexcept
+      : fd_(fd), file_size_(file_size), window_bytes_(window_bytes) {}
+
+  ~PcapWindow() { release(base_ + len_); }
+
+  PcapWindow(const PcapWindow &) = delete;
+  PcapWindow &operator=(const PcapWindow &) = delete;
+
+  /**
+   * @brief Pointer to file bytes [offset, offset + len).
+   *
+   * Invalidates pointers from earlier calls if the window slides.
+   *
+   * @pre offset + len <= file size
+   * @return nullptr if the new window cannot be mapped
+   */
+  [[nodiscard]] const char *view(size_t offset, size_t len) noexcept {
+    if (offset < base_ || offset + len > base_ + len_) [[unlikely]] {
+      if (!slide(offset, len)) {
+        return nullptr;
+      }
+    }
+    return data_ + (offset - base_);
+  }
+
+  /**
+   * @brief Windows mapped so far.
+   */
+  [[nodiscard]] size_t windows_mapped() const noexcept { return mapped_; }
+
+  /**
+   * @brief System page size (window offsets are multiples of it).
+   */
+  [[nodiscard]] static size_t page_size() noexcept {
+    return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  }
+
+private:
+  /**
+   * @brief Map a window covering the range, then retire the old one.
+   */
+  bool slide(size_t offset, size_t len) noexcept {
+    const size_t page = page_size();
+    const size_t base = offset & ~(page - 1);
+    const size_t needed = offset + len - base;
+    const size_t rounded = (std::max(window_bytes_, needed) + page - 1) &
+                           ~(page - 1);
+    const size_t mapped_len = std::min(rounded, file_size_ - base);
+
+    void *mapping = mmap(nullptr, mapped_len, PROT_READ, MAP_PRIVATE, fd_,
+                         static_cast<off_t>(base));
+    if (mapping == MAP_FAILED) {
+      release(base_ + len_);
+      len_ = 0;
+      return false;
+    }
+    release(base); // Old pages from `base` on are in the new window
+    data_ = static_cast<const char *>(mapping);
+    base_ = base;
+    len_ = mapped_len;
+    ++mapped_;
+
+    // Ahead of the cursor: read this window now and start on the next
+    (void)madvise(mapping, len_, MADV_SEQUENTIAL);
+    (void)madvise(mapping, len_, MADV_WILLNEED);
+    if (base_ + len_ < file_size_) {
+      (void)posix_fadvise(fd_, static_cast<off_t>(base_ + len_),
+                          static_cast<off_t>(window_bytes_),
+                          POSIX_FADV_WILLNEED);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Unmap the current window and release its cached pages below
+   *        file offset `end` (those behind the cursor).
+   */
+  void release(size_t end) noexcept {
+    if (data_ == nullptr) {
+      return;
+    }
+    munmap(const_cast<char *>(data_), len_);
+    end = std::min(end, base_ + len_);
+    if (end > base_) {
+      (void)posix_fadvise(fd_, static_cast<off_t>(base_),
+                          static_cast<off_t>(end - base_),
+                          POSIX_FADV_DONTNEED);
+    }
+    data_ = nullptr;
+  }
+
+  int fd_;
+  size_t file_size_;
+  size_t window_bytes_;
+  const char *data_ = nullptr;
+  size_t base_ = 0; ///< File offset of data_[0] (page aligned)
+  size_t len_ = 0;  ///< Bytes mapped at data_
+  size_t mapped_ = 0;
+};
+
 // ============================================================================
 // PCAP Reader Class
 // ============================================================================
@@ -76,12 +219,22 @@ static_assert(sizeof(PcapPacketHeader) == 16,
  *   reader.for_each_packet([&](const char* data, size_t len) {
  *       parser.parse(data, len, handler);
  *   });
+ *
+ *   // Multi-GB capture: 8 MB of the file mapped at any time
+ *   PcapReader stream("day.pcap", PcapMapping::Window);
  */
 class PcapReader {
 public:
+  /// Window size for PcapMapping::Window unless one is given to open()
+  static constexpr size_t kDefaultWindowBytes = size_t{8} << 20;
+
   PcapReader() = default;
 
-  explicit PcapReader(const char *filename) { open(filename); }
+  explicit PcapReader(const char *filename,
+                      PcapMapping mapping = PcapMapping::Whole,
+                      size_t window_bytes = kDefaultWindowBytes) {
+    open(filename, mapping, window_bytes);
+  }
 
   ~PcapReader() { close(); }
 
@@ -92,7 +245,9 @@ public:
   // Movable
   PcapReader(PcapReader &&other) noexcept
       : data_(other.data_), size_(other.size_), fd_(other.fd_),
-        needs_swap_(other.needs_swap_) {
+        window_bytes_(other.window_bytes_), mapping_(other.mapping_),
+        needs_swap_(other.needs_swap_), nanosecond_(other.nanosecond_),
+        link_type_(other.link_type_) {
     other.data_ = nullptr;
     other.size_ = 0;
     other.fd_ = -1;
@@ -104,7 +259,11 @@ public:
       data_ = other.data_;
       size_ = other.size_;
       fd_ = other.fd_;
+      window_bytes_ = other.window_bytes_;
+      mapping_ = other.mapping_;
       needs_swap_ = other.needs_swap_;
+      nanosecond_ = other.nanosecond_;
+      link_type_ = other.link_type_;
       other.data_ = nullptr;
       other.size_ = 0;
       other.fd_ = -1;
@@ -115,9 +274,15 @@ public:
   /**
    * @brief Open and mmap a PCAP file.
    * @param filename Path to PCAP file.
+   * @param mapping Whole: map the file now. Window: map it piecewise
+   *        during for_each_packet() (next_packet() and data() are then
+   *        unavailable).
+   * @param window_bytes Window size for PcapMapping::Window (rounded up
+   *        to whole pages)
    * @return true if successful.
    */
-  bool open(const char *filename) {
+  bool open(const char *filename, PcapMapping mapping = PcapMapping::Whole,
+            size_t window_bytes = kDefaultWindowBytes) {
     close();
 
     // Open file
@@ -135,6 +300,21 @@ public:
     }
     size_ = static_cast<size_t>(st.st_size);
 
+    if (mapping == PcapMapping::Window) {
+      // Nothing mapped until for_each_packet(); read the header directly
+      PcapGlobalHeader global_header;
+      if (size_ < sizeof(PcapGlobalHeader) ||
+          pread(fd_, &global_header, sizeof(global_header), 0) !=
+              static_cast<ssize_t>(sizeof(global_header))) {
+        close();
+        return false;
+      }
+      const size_t page = PcapWindow::page_size();
+      mapping_ = PcapMapping::Window;
+      window_bytes_ = (std::max(window_bytes, page) + page - 1) & ~(page - 1);
+      return read_header(global_header);
+    }
+
     // Memory map the file
     data_ = static_cast<const char *>(
         mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0));
@@ -154,21 +334,7 @@ public:
 
     const auto *global_header =
         reinterpret_cast<const PcapGlobalHeader *>(data_);
-
-    // Check magic number
-    // Standard PCAP (microsecond): 0xa1b2c3d4 (native) or 0xd4c3b2a1 (swapped)
-    // Nanosecond PCAP:             0xa1b23c4d (native) or 0x4d3cb2a1 (swapped)
-    const uint32_t magic = global_header->magic_number;
-    if (magic == 0xa1b2c3d4 || magic == 0xa1b23c4d) {
-      needs_swap_ = false; // Native byte order
-    } else if (magic == 0xd4c3b2a1 || magic == 0x4d3cb2a1) {
-      needs_swap_ = true; // Need to swap bytes
-    } else {
-      close(); // Invalid PCAP file
-      return false;
-    }
-
-    return true;
+    return read_header(*global_header);
   }
 
   /**
@@ -184,21 +350,39 @@ public:
       fd_ = -1;
     }
     size_ = 0;
+    window_bytes_ = 0;
+    mapping_ = PcapMapping::Whole;
   }
 
   /**
    * @brief Check if file is open.
    */
-  [[nodiscard]] bool is_open() const noexcept { return data_ != nullptr; }
+  [[nodiscard]] bool is_open() const noexcept { return fd_ >= 0; }
 
   /**
    * @brief Get file size.
    */
   [[nodiscard]] size_t file_size() const noexcept { return size_; }
 
+  [[nodiscard]] PcapMapping mapping() const noexcept { return mapping_; }
+
+  /**
+   * @brief Window size in bytes (0 unless mapping() is Window).
+   */
+  [[nodiscard]] size_t window_bytes() const noexcept { return window_bytes_; }
+
+  /**
+   * @brief Link type of every frame (PcapGlobalHeader::network, host order).
+   *
+   * Check it with is_supported_link_type() and pass it to decode_frame().
+   */
+  [[nodiscard]] uint32_t link_type() const noexcept { return link_type_; }
+
   /**
    * @brief Iterate over all packet payloads.
    *
+   * In Window mapping, `data` is valid only until the callback returns.
+   *
    * @tparam Callback Function with signature void(const char* data, size_t len)
    * @param callback Called for each packet's payload.
    * @return Number of packets processed.
@@ -208,6 +392,9 @@ public:
     if (!is_open()) {
       return 0;
     }
+    if (mapping_ == PcapMapping::Window) {
+      return for_each_windowed(callback);
+    }
 
     size_t offset = sizeof(PcapGlobalHeader);
     size_t packet_count = 0;
@@ -240,15 +427,121 @@ public:
   }
 
   /**
-   * @brief Get raw mmap'd data pointer.
+   * @brief Cursor-style iteration, for interleaving several captures.
+   *
+   * @param cursor Byte offset of the next packet header; start from 0.
+   *               Advanced past the returned packet on success.
+   * @param out Filled with the next packet.
+   * @return false once the file is exhausted (or truncated), and always
+   *         in Window mapping (packets must outlive the call).
+   */
+  [[nodiscard]] bool next_packet(size_t &cursor,
+                                 PcapPacket &out) const noexcept {
+    if (data_ == nullptr) {
+      return false;
+    }
+    if (cursor < sizeof(PcapGlobalHeader)) {
+      cursor = sizeof(PcapGlobalHeader);
+    }
+    if (cursor + sizeof(PcapPacketHeader) > size_) {
+      return false;
+    }
+
+    const auto *pkt_header =
+        reinterpret_cast<const PcapPacketHeader *>(data_ + cursor);
+    const uint32_t ts_sec = field(pkt_header->ts_sec);
+    const uint32_t ts_frac = field(pkt_header->ts_usec);
+    const uint32_t incl_len = field(pkt_header->incl_len);
+
+    const size_t payload = cursor + sizeof(PcapPacketHeader);
+    if (payload + incl_len > size_) {
+      return false; // Truncated packet
+    }
+
+    out.data = data_ + payload;
+    out.len = incl_len;
+    out.timestamp_ns = static_cast<uint64_t>(ts_sec) * 1'000'000'000ULL +
+                       (nanosecond_ ? ts_frac : ts_frac * 1000ULL);
+    cursor = payload + incl_len;
+    return true;
+  }
+
+  /**
+   * @brief Get raw mmap'd data pointer (nullptr in Window mapping).
    */
   [[nodiscard]] const char *data() const noexcept { return data_; }
 
 private:
+  /// Header field in host byte order
+  [[nodiscard]] uint32_t field(uint32_t value) const noexcept {
+    return needs_swap_ ? __builtin_bswap32(value) : value;
+  }
+
+  /**
+   * @brief Accept the global header's magic number (else close) and
+   *        record its link type.
+   */
+  bool read_header(const PcapGlobalHeader &header) {
+    const uint32_t magic = header.magic_number;
+    // Standard PCAP (microsecond): 0xa1b2c3d4 (native) or 0xd4c3b2a1 (swapped)
+    // Nanosecond PCAP:             0xa1b23c4d (native) or 0x4d3cb2a1 (swapped)
+    if (magic == 0xa1b2c3d4 || magic == 0xa1b23c4d) {
+      needs_swap_ = false; // Native byte order
+    } else if (magic == 0xd4c3b2a1 || magic == 0x4d3cb2a1) {
+      needs_swap_ = true; // Need to swap bytes
+    } else {
+      close(); // Invalid PCAP file
+      return false;
+    }
+    nanosecond_ = (magic == 0xa1b23c4d || magic == 0x4d3cb2a1);
+    link_type_ = field(header.network);
+    return true;
+  }
+
+  /**
+   * @brief for_each_packet() through a PcapWindow.
+   */
+  template <typename Callback>
+  size_t for_each_windowed(Callback &callback) const {
+    PcapWindow window(fd_, size_, window_bytes_);
+    size_t offset = sizeof(PcapGlobalHeader);
+    size_t packet_count = 0;
+
+    while (offset + sizeof(PcapPacketHeader) <= size_) {
+      const char *header = window.view(offset, sizeof(PcapPacketHeader));
+      if (header == nullptr) {
+        break; // Window could not be mapped
+      }
+      const uint32_t incl_len = field(
+          reinterpret_cast<const PcapPacketHeader *>(header)->incl_len);
+
+      offset += sizeof(PcapPacketHeader);
+      if (offset + incl_len > size_) {
+        break; // Truncated packet
+      }
+
+      // May slide the window so the whole payload is contiguous
+      const char *payload = window.view(offset, incl_len);
+      if (payload == nullptr) {
+        break;
+      }
+      callback(payload, incl_len);
+
+      offset += incl_len;
+      ++packet_count;
+    }
+
+    return packet_count;
+  }
+
   const char *data_ = nullptr;
   size_t size_ = 0;
   int fd_ = -1;
+  size_t window_bytes_ = 0;
+  PcapMapping mapping_ = PcapMapping::Whole;
   bool needs_swap_ = false;
+  bool nanosecond_ = false; ///< ts_usec field holds nanoseconds
+  uint32_t link_type_ = 0;
 };
 
 } // namespace itch
@@ -0,0 +1,281 @@
+#pragma once
+
+/**
+ * @file latency_histogram.hpp
+ * @brief Fixed-bucket log-linear latency histogram and a per-message-type
+ *        recorder that compiles to nothing when disabled.
+ *
+ * DESIGN PRINCIPLES:
+ * 1. HDR-style buckets - each power of two is split into 2^SubBucketBits
+ *    linear sub-buckets, so every recorded value is kept to a fixed
+ *    relative precision (~3% by default) from 1 tick to 2^64.
+ * 2. O(1) record, no allocation - a bucket index is a bit_width and a
+ *    shift; the counts live in one fixed array.
+ * 3. Tails, not averages - percentiles up to p99.9 and the exact max are
+ *    read from the buckets after the run.
+ * 4. Zero cost when off - LatencyRecorder<false> has no storage and its
+ *    start()/stop() are empty, so a disabled build reads no clock at all.
+ *
+ * USAGE:
+ *   LatencyRecorder<true> latency;
+ *   const uint64_t start = latency.start();
+ *   handle(msg);
+ *   latency.stop(msg[0], start);       // one histogram per message type
+ *   latency.for_each([](uint8_t type, const LatencyHistogram<> &h) {
+ *     print(type, h.value_at_percentile(99.0));
+ *   });
+ */
+
+#include "tsc_clock.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace metrics {
+
+// ============================================================================
+// LatencyHistogram - Log-linear Buckets
+// ============================================================================
+
+/**
+ * @brief Counts of values in log-linear buckets.
+ *
+ * Values below 2^SubBucketBits get one bucket each. Above that, the range
+ * [2^m, 2^(m+1)) is split into 2^SubBucketBits equal buckets, so a bucket
+ * is never wider than 1 / 2^SubBucketBits of the values it holds.
+ *
+ * @tparam SubBucketBits log2 of sub-buckets per power of two (1..16)
+ *
+ * Memory: (65 - SubBucketBits) * 2^SubBucketBits counters (15 KB at 5).
+ */
+template <unsigned SubBucketBits = 5> class LatencyHistogram {
+  static_assert(SubBucketBits >= 1 && SubBucketBits <= 16,
+                "SubBucketBits must be in 1..16");
+
+public:
+  static constexpr uint64_t kSubBuckets = uint64_t{1} << SubBucketBits;
+  static constexpr std::size_t kBucketCount =
+      (65 - SubBucketBits) * kSubBuckets;
+
+  // ========================================================================
+  // Bucket Mapping
+  // ========================================================================
+
+  /**
+   * @brief Bucket holding `value`.
+   */
+  [[nodiscard]] static constexpr std::size_t
+  bucket_index(uint64_t value) noexcept {
+    if (value < kSubBuckets) {
+      return static_cast<std::size_t>(value);
+    }
+    const unsigned magnitude =
+        static_cast<unsigned>(std::bit_width(value)) - 1; // >= SubBucketBits
+    const unsigned shift = magnitude - SubBucketBits;
+    const uint64_t sub = (value >> shift) - kSubBuckets;
+    return static_cast<std::size_t>((shift + 1) * kSubBuckets + sub);
+  }
+
+  /**
+   * @brief Smallest value mapped to bucket `index`.
+   */
+  [[nodiscard]] static constexpr uint64_t
+  bucket_lower(std::size_t index) noexcept {
+    if (index < kSubBuckets) {
+      return index;
+    }
+    const uint64_t shift = index / kSubBuckets - 1;
+    const uint64_t sub = index % kSubBuckets;
+    return (kSubBuckets + sub) << shift;
+  }
+
+  /**
+   * @brief Largest value mapped to bucket `index`.
+   */
+  [[nodiscard]] static constexpr uint64_t
+  bucket_upper(std::size_t index) noexcept {
+    if (index + 1 == kBucketCount) {
+      return std::numeric_limits<uint64_t>::max();
+    }
+    return bucket_lower(index + 1) - 1;
+  }
+
+  // ========================================================================
+  // Recording
+  // ========================================================================
+
+  /**
+   * @brief Count one value. O(1), no allocation.
+   */
+  void record(uint64_t value) noexcept {
+    ++counts_[bucket_index(value)];
+    ++count_;
+    sum_ += value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+
+  /**
+   * @brief Add another histogram's counts (e.g. one per shard).
+   */
+  void merge(const LatencyHistogram &other) noexcept {
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+      counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+  }
+
+  void reset() noexcept { *this = LatencyHistogram(); }
+
+  // ========================================================================
+  // Queries
+  // ========================================================================
+
+  [[nodiscard]] uint64_t count() const noexcept { return count_; }
+
+  /// Exact smallest value recorded (0 if empty)
+  [[nodiscard]] uint64_t min() const noexcept {
+    return count_ == 0 ? 0 : min_;
+  }
+
+  /// Exact largest value recorded (0 if empty)
+  [[nodiscard]] uint64_t max() const noexcept { return max_; }
+
+  [[nodiscard]] double mean() const noexcept {
+    return count_ == 0
+               ? 0.0
+               : static_cast<double>(sum_) / static_cast<double>(count_);
+  }
+
+  /**
+   * @brief Value at or below which `percentile` % of values fall.
+   *
+   * Returns the upper bound of the bucket holding that rank (clamped to
+   * the exact max), so the result never understates a tail.
+   *
+   * @param percentile 0..100 (e.g. 99.9)
+   */
+  [[nodiscard]] uint64_t
+  value_at_percentile(double percentile) const noexcept {
+    if (count_ == 0) {
+      return 0;
+    }
+    const double clamped = std::clamp(percentile, 0.0, 100.0);
+    auto rank = static_cast<uint64_t>(clamped / 100.0 *
+                                      static_cast<double>(count_) +
+                                      0.5);
+    rank = std::clamp<uint64_t>(rank, 1, count_);
+
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+      seen += counts_[i];
+      if (seen >= rank) {
+        return std::min(bucket_upper(i), max_);
+      }
+    }
+    return max_;
+  }
+
+private:
+  std::array<uint64_t, kBucketCount> counts_{};
+  uint64_t count_ = 0;
+  uint64_t sum_ = 0;
+  uint64_t min_ = std::numeric_limits<uint64_t>::max();
+  uint64_t max_ = 0;
+};
+
+// ============================================================================
+// LatencyRecorder - One Histogram per Message Type
+// ============================================================================
+
+/**
+ * @brief TSC-timed histograms keyed by an 8-bit message type.
+ *
+ * A histogram is allocated the first time its type is stopped (cold,
+ * once per type); recording afterwards is a table lookup plus
+ * LatencyHistogram::record(). Values are raw TscClock ticks; convert
+ * with TscClock::to_ns() when printing.
+ *
+ * @tparam Enabled false compiles every call to nothing
+ * @tparam SubBucketBits Precision of each histogram
+ */
+template <bool Enabled, unsigned SubBucketBits = 5> class LatencyRecorder {
+public:
+  using Histogram = LatencyHistogram<SubBucketBits>;
+
+  static constexpr bool kEnabled = true;
+
+  /**
+   * @brief Start stamp for one measurement.
+   */
+  [[nodiscard]] uint64_t start() const noexcept { return TscClock::now(); }
+
+  /**
+   * @brief Record the ticks since `start` under `type`.
+   */
+  void stop(uint8_t type, uint64_t start) {
+    const uint64_t end = TscClock::now();
+    std::unique_ptr<Histogram> &slot = histograms_[type];
+    if (slot == nullptr) [[unlikely]] {
+      slot = std::make_unique<Histogram>();
+    }
+    slot->record(end - start);
+  }
+
+  /**
+   * @brief Fold another recorder's histograms into this one.
+   */
+  void merge(const LatencyRecorder &other) {
+    for (std::size_t type = 0; type < histograms_.size(); ++type) {
+      if (other.histograms_[type] == nullptr) {
+        continue;
+      }
+      if (histograms_[type] == nullptr) {
+        histograms_[type] = std::make_unique<Histogram>();
+      }
+      histograms_[type]->merge(*other.histograms_[type]);
+    }
+  }
+
+  /**
+   * @brief Visit each type that recorded at least one value, in type order.
+   *
+   * @param fn Callable as fn(uint8_t type, const Histogram &histogram)
+   */
+  template <typename Fn> void for_each(Fn &&fn) const {
+    for (std::size_t type = 0; type < histograms_.size(); ++type) {
+      if (histograms_[type] != nullptr) {
+        fn(static_cast<uint8_t>(type), *histograms_[type]);
+      }
+    }
+  }
+
+private:
+  std::array<std::unique_ptr<Histogram>, 256> histograms_;
+};
+
+/**
+ * @brief Disabled recorder: no storage, no clock reads.
+ */
+template <unsigned SubBucketBits>
+class LatencyRecorder<false, SubBucketBits> {
+public:
+  using Histogram = LatencyHistogram<SubBucketBits>;
+
+  static constexpr bool kEnabled = false;
+
+  [[nodiscard]] constexpr uint64_t start() const noexcept { return 0; }
+  constexpr void stop(uint8_t /*type*/, uint64_t /*start*/) noexcept {}
+  constexpr void merge(const LatencyRecorder & /*other*/) noexcept {}
+  template <typename Fn>
+  constexpr void for_each(Fn && /*fn*/) const noexcept {}
+};
+
+} // namespace metrics
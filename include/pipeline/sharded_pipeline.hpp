@@ -0,0 +1,387 @@
+#pragma once
+
+/**
+ * @file sharded_pipeline.hpp
+ * @brief Fan one parsed feed out to N worker threads, sharded by symbol.
+ *
+ * DESIGN PRINCIPLES:
+ * 1. Shared-nothing shards - each worker owns its books and order pool, so
+ *    no lock or atomic is ever taken on book state.
+ * 2. Symbol affinity - a stock_locate always hashes to the same shard,
+ *    which keeps per-symbol event order intact.
+ * 3. Zero-copy handoff - rings carry (pointer, length) views into the
+ *    mapped capture; message bytes are never copied.
+ * 4. One SPSC ring per shard - the router is the only producer and each
+ *    worker the only consumer, so every ring is wait-free on both ends.
+ * 5. Batched handoff - the router stages up to kPublishBatch views per
+ *    shard and publishes them with one store; workers consume up to
+ *    kConsumeBatch per release.
+ *
+ * USAGE:
+ *   ShardedPipeline<MyShard> pipeline(std::move(shards), {true, 2});
+ *   pipeline.start();                         // router thread
+ *   reader.for_each_message([&](const char *msg, size_t len) {
+ *     pipeline.route(msg, len);               // hash stock_locate, enqueue
+ *   });
+ *   pipeline.flush();                         // optional: end of packet
+ *   pipeline.finish();                        // drain and join
+ *   pipeline.stats(i).messages;               // per-shard counters
+ *
+ * Shard requirements:
+ *   void on_message(const char *msg, size_t len);  // runs on its worker
+ */
+
+#include "spsc_ring.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace pipeline {
+
+// ============================================================================
+// Thread Utilities
+// ============================================================================
+
+/**
+ * @brief Spin-wait hint (PAUSE on x86) - frees pipeline resources for a
+ *        sibling hyperthread while polling a ring.
+ */
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * @brief Pin the calling thread to one CPU.
+ *
+ * @return false if the platform has no affinity API or the CPU is not
+ *         available to this process (the thread keeps running unpinned).
+ */
+inline bool pin_current_thread(unsigned cpu) noexcept {
+#if defined(__linux__)
+  if (cpu >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+// ============================================================================
+// Configuration and Statistics
+// ============================================================================
+
+/**
+ * @brief CPU placement for the router and workers.
+ *
+ * When enabled, the thread calling start() (the router) is pinned to
+ * first_cpu and worker i to first_cpu + 1 + i.
+ */
+struct PinPolicy {
+  bool enabled = false;
+  unsigned first_cpu = 0;
+};
+
+/**
+ * @brief Counters for one shard, written by its worker and read after
+ *        finish(). Padded so neighbouring workers never share a line.
+ */
+struct alignas(kCacheLineSize) ShardStats {
+  uint64_t messages = 0;   ///< Messages handed to the shard
+  uint64_t elapsed_ns = 0; ///< Worker wall time from start() to drained
+  uint64_t idle_polls = 0; ///< Pops that found the ring empty
+  uint64_t stalls = 0;     ///< Router publishes that found the ring full
+  bool pinned = false;     ///< Affinity request succeeded
+
+  /// Messages per second over the worker's lifetime
+  [[nodiscard]] double message_rate() const noexcept {
+    return elapsed_ns == 0 ? 0.0
+                           : static_cast<double>(messages) * 1e9 /
+                                 static_cast<double>(elapsed_ns);
+  }
+};
+
+/**
+ * @brief One routed ITCH message: a view into the caller's buffer.
+ *
+ * A null `data` is the end-of-stream sentinel.
+ */
+struct MessageView {
+  const char *data = nullptr;
+  std::size_t len = 0;
+};
+
+// ============================================================================
+// ShardedPipeline - Router Thread + N Shared-Nothing Workers
+// ============================================================================
+
+/**
+ * @brief Routes ITCH messages by stock_locate to per-shard worker threads.
+ *
+ * @tparam Shard Per-worker state (books, pool, visitor); see file header
+ * @tparam RingCapacity Slots per shard ring (power of two)
+ *
+ * Threading contract:
+ * - start(), route(), flush() and finish() run on a single router thread
+ * - Shard i is touched only by worker i between start() and finish(), and
+ *   only by the owner outside that window
+ * - Message bytes must stay valid until finish() returns (mapped files do)
+ */
+template <typename Shard, std::size_t RingCapacity = 65536>
+class ShardedPipeline {
+public:
+  using ShardType = Shard;
+  using Ring = SpscRing<MessageView, RingCapacity>;
+
+  /// Polls before a waiting thread starts yielding its time slice; keeps
+  /// oversubscribed runs (more threads than cores) from starving the peer
+  static constexpr uint32_t kSpinLimit = 64;
+
+  /// Views staged per shard before the router publishes them
+  static constexpr std::size_t kPublishBatch = 32;
+
+  /// Views a worker handles per slot release
+  static constexpr std::size_t kConsumeBatch = 64;
+
+  // ========================================================================
+  // Construction
+  // ========================================================================
+
+  /**
+   * @brief Take ownership of the shards (one worker thread each).
+   *
+   * @param shards Non-empty; shards[i] is driven by worker i
+   * @param pin Optional CPU placement
+   */
+  explicit ShardedPipeline(std::vector<std::unique_ptr<Shard>> shards,
+                           PinPolicy pin = {})
+      : shards_(std::move(shards)), stats_(shards_.size()),
+        staged_(shards_.size()), stalls_(shards_.size(), 0), pin_(pin) {
+    rings_.reserve(shards_.size());
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+      rings_.push_back(std::make_unique<Ring>());
+    }
+  }
+
+  // Non-copyable, non-movable (workers hold `this`)
+  ShardedPipeline(const ShardedPipeline &) = delete;
+  ShardedPipeline &operator=(const ShardedPipeline &) = delete;
+  ShardedPipeline(ShardedPipeline &&) = delete;
+  ShardedPipeline &operator=(ShardedPipeline &&) = delete;
+
+  ~ShardedPipeline() { finish(); }
+
+  // ========================================================================
+  // Lifecycle
+  // ========================================================================
+
+  /**
+   * @brief Pin the router (if requested) and launch one worker per shard.
+   * @return true if the router was pinned (or pinning was not requested)
+   */
+  bool start() {
+    const bool router_pinned =
+        !pin_.enabled || pin_current_thread(pin_.first_cpu);
+    workers_.reserve(shards_.size());
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+      workers_.emplace_back([this, i] { run_worker(i); });
+    }
+    return router_pinned;
+  }
+
+  /**
+   * @brief Send end-of-stream to every shard and wait for all to drain.
+   *
+   * Idempotent; shards and stats are safe to read afterwards.
+   */
+  void finish() {
+    if (workers_.empty()) {
+      return;
+    }
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+      stage(i, MessageView{});
+      publish(i);
+    }
+    for (std::thread &worker : workers_) {
+      worker.join();
+    }
+    workers_.clear();
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+      stats_[i].stalls = stalls_[i];
+    }
+  }
+
+  // ========================================================================
+  // Routing (router thread)
+  // ========================================================================
+
+  /**
+   * @brief Queue one raw ITCH message for its symbol's shard.
+   *
+   * Every ITCH 5.0 message carries stock_locate at bytes 1-2; messages too
+   * short to hold one go to shard 0. The view is published once its
+   * shard's staging batch fills, or at the next flush()/finish().
+   */
+  void route(const char *msg, std::size_t len) noexcept {
+    std::size_t shard = 0;
+    if (len >= 3) [[likely]] {
+      const auto *u = reinterpret_cast<const unsigned char *>(msg);
+      shard = shard_for(static_cast<uint16_t>((u[1] << 8) | u[2]));
+    }
+    if (stage(shard, MessageView{msg, len}) == kPublishBatch) {
+      publish(shard);
+    }
+  }
+
+  /**
+   * @brief Publish every staged view now.
+   *
+   * A live feed calls this at each packet boundary to bound latency;
+   * a file replay can leave batching to route() and finish().
+   */
+  void flush() noexcept {
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+      publish(i);
+    }
+  }
+
+  /**
+   * @brief Shard that owns `locate`.
+   *
+   * Fibonacci hashing spreads consecutive locate codes (which NASDAQ
+   * assigns alphabetically) across shards; the multiply-shift range
+   * reduction avoids a division per message.
+   */
+  [[nodiscard]] std::size_t shard_for(uint16_t locate) const noexcept {
+    const uint32_t hash = static_cast<uint32_t>(locate) * 0x9E3779B1u;
+    return static_cast<std::size_t>(
+        (static_cast<uint64_t>(hash) * shards_.size()) >> 32);
+  }
+
+  // ========================================================================
+  // Accessors
+  // ========================================================================
+
+  [[nodiscard]] std::size_t shard_count() const noexcept {
+    return shards_.size();
+  }
+
+  [[nodiscard]] Shard &shard(std::size_t i) noexcept { return *shards_[i]; }
+
+  [[nodiscard]] const Shard &shard(std::size_t i) const noexcept {
+    return *shards_[i];
+  }
+
+  /**
+   * @brief Counters for shard i (stable once finish() has returned).
+   */
+  [[nodiscard]] const ShardStats &stats(std::size_t i) const noexcept {
+    return stats_[i];
+  }
+
+private:
+  /// Views waiting on the router for one shard
+  struct Staging {
+    std::array<MessageView, kPublishBatch> views;
+    std::size_t count = 0;
+  };
+
+  /// Append to the shard's staging batch; returns the new batch size
+  std::size_t stage(std::size_t shard, const MessageView &msg) noexcept {
+    Staging &staging = staged_[shard];
+    staging.views[staging.count] = msg;
+    return ++staging.count;
+  }
+
+  /// Push the shard's staged views, waiting while its ring is full
+  void publish(std::size_t shard) noexcept {
+    Staging &staging = staged_[shard];
+    Ring &ring = *rings_[shard];
+    std::size_t sent = 0;
+    uint32_t spins = 0;
+    while (sent < staging.count) {
+      const std::size_t n =
+          ring.try_push_n(staging.views.data() + sent, staging.count - sent);
+      if (n == 0) {
+        ++stalls_[shard];
+        backoff(spins);
+      }
+      sent += n;
+    }
+    staging.count = 0;
+  }
+
+  void run_worker(std::size_t i) {
+    ShardStats &stats = stats_[i];
+    stats.pinned = pin_.enabled && pin_current_thread(pin_.first_cpu + 1 +
+                                                      static_cast<unsigned>(i));
+    Ring &ring = *rings_[i];
+    Shard &shard = *shards_[i];
+
+    const auto start = std::chrono::steady_clock::now();
+    bool done = false;
+    uint32_t spins = 0;
+    while (!done) {
+      const std::size_t n = ring.consume(
+          [&](const MessageView &msg) {
+            if (msg.data == nullptr) { // Sentinel is always last
+              done = true;
+              return;
+            }
+            shard.on_message(msg.data, msg.len);
+            ++stats.messages;
+          },
+          kConsumeBatch);
+      if (n == 0) {
+        ++stats.idle_polls;
+        backoff(spins);
+      } else {
+        spins = 0;
+      }
+    }
+    stats.elapsed_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+  }
+
+  static void backoff(uint32_t &spins) noexcept {
+    if (++spins < kSpinLimit) {
+      cpu_relax();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::vector<std::unique_ptr<Ring>> rings_; ///< rings_[i] feeds worker i
+  std::vector<ShardStats> stats_;            ///< Written by workers
+  std::vector<Staging> staged_;              ///< Router-side batches
+  std::vector<uint64_t> stalls_;             ///< Written by the router
+  std::vector<std::thread> workers_;
+  PinPolicy pin_;
+};
+
+} // namespace pipeline
@@ -0,0 +1,201 @@
+#pragma once
+
+/**
+ * @file spsc_ring.hpp
+ * @brief Bounded single-producer / single-consumer ring for thread handoff.
+ *
+ * DESIGN PRINCIPLES:
+ * 1. Lock-free - one atomic store publishes, one atomic load observes.
+ * 2. Power-of-two capacity - slot = index & mask, indices never wrap back.
+ * 3. Head and tail on separate cache lines - producer and consumer never
+ *    write the same line.
+ * 4. Cached peer index - each side re-reads the other's index only when
+ *    its private copy says the ring is full (or empty), so the shared line
+ *    moves between cores once per batch rather than once per element.
+ * 5. Batched publish/consume - N elements cost one release store.
+ * 6. Trivially copyable payloads only - slots are plain memory, so the
+ *    ring carries pointers into a mapped file or compact decoded events.
+ *
+ * USAGE:
+ *   SpscRing<Message, 65536> ring;      // shared by exactly two threads
+ *   while (!ring.try_push(msg)) {}      // producer thread
+ *   ring.try_push_n(msgs, n);           // producer, one publish for n
+ *   if (ring.try_pop(msg)) { ... }      // consumer thread
+ *   ring.consume([](const Message &m) { ... }, 64); // consumer, in place
+ */
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <type_traits>
+
+namespace pipeline {
+
+/// Destructive interference size assumed for padding (x86-64 / ARMv8)
+inline constexpr std::size_t kCacheLineSize = 64;
+
+// ============================================================================
+// SpscRing - Bounded Lock-Free Queue (one producer, one consumer)
+// ============================================================================
+
+/**
+ * @brief Fixed-capacity ring shared by one producer and one consumer thread.
+ *
+ * @tparam T Trivially copyable element (e.g. a pointer + length view)
+ * @tparam Capacity Slot count, a power of two
+ *
+ * Memory ordering: the producer writes the slot, then release-stores tail;
+ * the consumer acquire-loads tail before reading the slot (and mirrors
+ * this with head), so no element is read before it is fully written.
+ * The cached copies are only ever stale in the safe direction: the
+ * producer may think the ring fuller, the consumer emptier, than it is.
+ *
+ * @note Storage is inline; allocate large rings on the heap.
+ */
+template <typename T, std::size_t Capacity> class SpscRing {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SpscRing elements must be trivially copyable");
+  static_assert(std::has_single_bit(Capacity),
+                "SpscRing capacity must be a power of two");
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  SpscRing() = default;
+
+  // Non-copyable, non-movable (shared between threads by address)
+  SpscRing(const SpscRing &) = delete;
+  SpscRing &operator=(const SpscRing &) = delete;
+  SpscRing(SpscRing &&) = delete;
+  SpscRing &operator=(SpscRing &&) = delete;
+
+  // ========================================================================
+  // Producer
+  // ========================================================================
+
+  /**
+   * @brief Append one element.
+   * @return false if the ring is full (nothing written)
+   */
+  bool try_push(const T &value) noexcept {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ == Capacity) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ == Capacity) {
+        return false;
+      }
+    }
+    slots_[tail & kMask] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Append up to `count` elements with a single publish.
+   * @return Number written (a prefix of `values`; 0 if full)
+   */
+  size_type try_push_n(const T *values, size_type count) noexcept {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    size_type free = Capacity - (tail - head_cache_);
+    if (free < count) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      free = Capacity - (tail - head_cache_);
+    }
+    const size_type n = count < free ? count : free;
+    for (size_type i = 0; i < n; ++i) {
+      slots_[(tail + i) & kMask] = values[i];
+    }
+    if (n != 0) {
+      tail_.store(tail + n, std::memory_order_release);
+    }
+    return n;
+  }
+
+  // ========================================================================
+  // Consumer
+  // ========================================================================
+
+  /**
+   * @brief Remove the oldest element.
+   * @return false if the ring is empty (`out` untouched)
+   */
+  bool try_pop(T &out) noexcept {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) {
+        return false;
+      }
+    }
+    out = slots_[head & kMask];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Remove up to `max` elements into `out` with a single release.
+   * @return Number copied (0 if empty)
+   */
+  size_type try_pop_n(T *out, size_type max) noexcept {
+    return consume([&out](const T &value) { *out++ = value; }, max);
+  }
+
+  /**
+   * @brief Visit up to `max` elements in place, then release their slots.
+   *
+   * The slots are not reused by the producer until `visitor` has returned
+   * for every element in the batch, so it may read them without copying.
+   *
+   * @param visitor Called as visitor(const T &) in FIFO order
+   * @return Number visited (0 if empty)
+   */
+  template <typename Visitor>
+  size_type consume(Visitor &&visitor, size_type max) {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    size_type ready = tail_cache_ - head;
+    if (ready < max) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      ready = tail_cache_ - head;
+    }
+    const size_type n = ready < max ? ready : max;
+    for (size_type i = 0; i < n; ++i) {
+      visitor(static_cast<const T &>(slots_[(head + i) & kMask]));
+    }
+    if (n != 0) {
+      head_.store(head + n, std::memory_order_release);
+    }
+    return n;
+  }
+
+  // ========================================================================
+  // Observers (approximate while both threads run)
+  // ========================================================================
+
+  [[nodiscard]] size_type size() const noexcept {
+    return tail_.load(std::memory_order_acquire) -
+           head_.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  [[nodiscard]] static constexpr size_type capacity() noexcept {
+    return Capacity;
+  }
+
+private:
+  static constexpr size_type kMask = Capacity - 1;
+
+  // Consumer line: its index plus its last view of the producer's
+  alignas(kCacheLineSize) std::atomic<size_type> head_{0};
+  size_type tail_cache_ = 0;
+
+  // Producer line: its index plus its last view of the consumer's
+  alignas(kCacheLineSize) std::atomic<size_type> tail_{0};
+  size_type head_cache_ = 0;
+
+  alignas(kCacheLineSize) std::array<T, Capacity> slots_{};
+};
+
+} // namespace pipeline
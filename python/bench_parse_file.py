@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""
+bench_parse_file.py - Wall time and peak memory of itch_handler parsing
+
+Parses a capture once per mode, each in a fresh process so peak RSS
+(ru_maxrss) belongs to that mode alone:
+
+    zero-copy  parse_file() as shipped; the arrays own the C++ columns
+    copy       the same, then every column copied (np.array(copy=True)),
+               which is the footprint of exporting by copy
+    stream     itch_handler.stream() batches of 1M rows, each discarded
+               after use (columns reports the largest batch)
+
+Usage:
+    python bench_parse_file.py <pcap_file> [--mode zero-copy|copy|stream]
+
+Example:
+    python bench_parse_file.py /data/StressTest.pcap
+"""
+
+import argparse
+import resource
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+try:
+    import itch_handler
+except ImportError:
+    build_dir = Path(__file__).parent.parent / "build"
+    sys.path.insert(0, str(build_dir))
+    import itch_handler
+
+import numpy as np
+
+MODES = ("zero-copy", "copy", "stream")
+
+
+def peak_rss_mb() -> float:
+    """Peak resident set size of this process in MB (Linux reports KB)."""
+    return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 1024.0
+
+
+def column_bytes(data: dict) -> int:
+    """Bytes held by the returned AddOrder and OrderExecuted columns."""
+    return sum(column.nbytes
+               for table in ("add_orders", "order_executed")
+               for column in data[table].values())
+
+
+def run_mode(pcap_file: str, mode: str) -> None:
+    """Parse once in this process and print one result row."""
+    baseline = peak_rss_mb()
+    start = time.perf_counter()
+    if mode == "stream":
+        batches = itch_handler.stream(pcap_file, chunk_messages=1 << 20)
+        held = max((column_bytes(batch) for batch in batches), default=0)
+        file_size = batches.file_size
+    else:
+        data = itch_handler.parse_file(pcap_file)
+        if mode == "copy":
+            for table in ("add_orders", "order_executed"):
+                data[table] = {name: np.array(column, copy=True)
+                               for name, column in data[table].items()}
+        held = column_bytes(data)
+        file_size = data["file_size"]
+    elapsed = time.perf_counter() - start
+
+    file_mb = file_size / (1024.0 * 1024.0)
+    print(f"{mode:<10} {elapsed:8.2f} s {file_mb / elapsed:9.0f} MB/s "
+          f"{peak_rss_mb() - baseline:10.0f} MB "
+          f"{held / (1024.0 * 1024.0):10.0f} MB")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("pcap_file")
+    parser.add_argument("--mode", choices=MODES,
+                        help="run one mode in this process")
+    args = parser.parse_args()
+
+    if args.mode:
+        run_mode(args.pcap_file, args.mode)
+        return
+
+    print(f"itch_handler v{itch_handler.version()}: {args.pcap_file}")
+    print(f"{'mode':<10} {'wall':>10} {'rate':>14} {'peak RSS':>13} "
+          f"{'columns':>13}")
+    for mode in MODES:
+        subprocess.run([sys.executable, __file__, args.pcap_file,
+                        "--mode", mode], check=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -2,11 +2,12 @@
  * @file main.cpp
  * @brief PCAP-based ITCH 5.0 feed handler driver.
  *
- * Usage: ./itch_driver <pcap_file>
+ * Usage: ./itch_driver <pcap_or_binary_file>
  *
- * This program demonstrates zero-copy ITCH message parsing from a PCAP file:
- * 1. mmap's the PCAP file into memory
- * 2. Iterates over packets, passing pointers directly to parser
+ * This program demonstrates zero-copy ITCH message parsing from a PCAP file
+ * or a NASDAQ BinaryFILE (2-byte length-prefixed message stream):
+ * 1. mmap's the file into memory
+ * 2. Iterates over packets/messages, passing pointers directly to parser
  * 3. Collects statistics via visitor pattern
  */
 
@@ -14,6 +15,9 @@
 #include <cinttypes>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <itch/binary_file_reader.hpp>
+#include <itch/moldudp64.hpp>
 #include <itch/parser.hpp>
 #include <itch/pcap_reader.hpp>
 
@@ -29,44 +33,146 @@ namespace {
 struct StatsVisitor : itch::DefaultVisitor {
   uint64_t add_order_count = 0;
   uint64_t order_executed_count = 0;
+  uint64_t order_cancel_count = 0;
+  uint64_t order_delete_count = 0;
+  uint64_t order_replace_count = 0;
+  uint64_t trade_count = 0;
   uint64_t system_event_count = 0;
+  uint64_t other_count = 0;
   uint64_t unknown_count = 0;
   uint64_t total_shares = 0;
   uint64_t total_executions = 0;
 
+  // MoldUDP64 transport (PCAP input only)
+  uint64_t mold_packets = 0;
+  uint64_t heartbeats = 0;
+  uint64_t rejected_frames = 0;
+  uint64_t first_sequence = 0;
+  uint64_t next_sequence = 0;
+  char session[itch::MoldPacket::kSessionSize + 1] = {};
+
+  void on_packet(const itch::MoldPacket &pkt) {
+    if (mold_packets++ == 0) {
+      std::memcpy(session, pkt.session, itch::MoldPacket::kSessionSize);
+      first_sequence = pkt.sequence;
+    }
+    if (pkt.is_heartbeat()) {
+      ++heartbeats;
+    }
+    next_sequence = pkt.next_sequence();
+  }
+
   void on_add_order(const itch::AddOrder &msg) {
     ++add_order_count;
     total_shares += static_cast<uint32_t>(msg.shares);
   }
 
+  void on_add_order_mpid(const itch::AddOrderMPID &msg) {
+    ++add_order_count;
+    total_shares += static_cast<uint32_t>(msg.shares);
+  }
+
   void on_order_executed(const itch::OrderExecuted &msg) {
     ++order_executed_count;
     total_executions += static_cast<uint32_t>(msg.executed_shares);
   }
 
-  void on_system_event(const itch::MessageHeader & /*msg*/) {
+  void on_order_executed_with_price(const itch::OrderExecutedWithPrice &msg) {
+    ++order_executed_count;
+    total_executions += static_cast<uint32_t>(msg.executed_shares);
+  }
+
+  void on_order_cancel(const itch::OrderCancel & /*msg*/) {
+    ++order_cancel_count;
+  }
+
+  void on_order_delete(const itch::OrderDelete & /*msg*/) {
+    ++order_delete_count;
+  }
+
+  void on_order_replace(const itch::OrderReplace & /*msg*/) {
+    ++order_replace_count;
+  }
+
+  void on_trade(const itch::Trade & /*msg*/) { ++trade_count; }
+
+  void on_cross_trade(const itch::CrossTrade & /*msg*/) { ++trade_count; }
+
+  void on_system_event(const itch::SystemEvent & /*msg*/) {
     ++system_event_count;
   }
 
+  // Administrative / auction messages are only counted in aggregate
+  void on_stock_directory(const itch::StockDirectory & /*msg*/) {
+    ++other_count;
+  }
+  void on_stock_trading_action(const itch::StockTradingAction & /*msg*/) {
+    ++other_count;
+  }
+  void on_reg_sho_restriction(const itch::RegSHORestriction & /*msg*/) {
+    ++other_count;
+  }
+  void on_market_participant_position(
+      const itch::MarketParticipantPosition & /*msg*/) {
+    ++other_count;
+  }
+  void on_mwcb_decline_level(const itch::MWCBDeclineLevel & /*msg*/) {
+    ++other_count;
+  }
+  void on_mwcb_status(const itch::MWCBStatus & /*msg*/) { ++other_count; }
+  void on_ipo_quoting_period(const itch::IPOQuotingPeriod & /*msg*/) {
+    ++other_count;
+  }
+  void on_luld_auction_collar(const itch::LULDAuctionCollar & /*msg*/) {
+    ++other_count;
+  }
+  void on_operational_halt(const itch::OperationalHalt & /*msg*/) {
+    ++other_count;
+  }
+  void on_broken_trade(const itch::BrokenTrade & /*msg*/) { ++other_count; }
+  void on_noii(const itch::NOII & /*msg*/) { ++other_count; }
+  void on_retail_interest(const itch::RetailInterest & /*msg*/) {
+    ++other_count;
+  }
+  void on_direct_listing(const itch::DirectListingCapitalRaise & /*msg*/) {
+    ++other_count;
+  }
+
   void on_unknown(char /*msg_type*/, const char * /*data*/, size_t /*len*/) {
     ++unknown_count;
   }
 
   [[nodiscard]] uint64_t total_messages() const {
-    return add_order_count + order_executed_count + system_event_count +
-           unknown_count;
+    return add_order_count + order_executed_count + order_cancel_count +
+           order_delete_count + order_replace_count + trade_count +
+           system_event_count + other_count + unknown_count;
   }
 
   void print_stats() const {
     std::printf("\n=== ITCH Message Statistics ===\n");
     std::printf("Add Orders:       %12" PRIu64 "\n", add_order_count);
     std::printf("Order Executed:   %12" PRIu64 "\n", order_executed_count);
+    std::printf("Order Cancel:     %12" PRIu64 "\n", order_cancel_count);
+    std::printf("Order Delete:     %12" PRIu64 "\n", order_delete_count);
+    std::printf("Order Replace:    %12" PRIu64 "\n", order_replace_count);
+    std::printf("Trades:           %12" PRIu64 "\n", trade_count);
     std::printf("System Events:    %12" PRIu64 "\n", system_event_count);
+    std::printf("Other:            %12" PRIu64 "\n", other_count);
     std::printf("Unknown:          %12" PRIu64 "\n", unknown_count);
     std::printf("--------------------------------\n");
     std::printf("Total Messages:   %12" PRIu64 "\n", total_messages());
     std::printf("Total Shares:     %12" PRIu64 "\n", total_shares);
     std::printf("Total Executions: %12" PRIu64 "\n", total_executions);
+
+    if (mold_packets > 0 || rejected_frames > 0) {
+      std::printf("\n=== MoldUDP64 Transport ===\n");
+      std::printf("Session:          %12s\n", session);
+      std::printf("Packets:          %12" PRIu64 "\n", mold_packets);
+      std::printf("Heartbeats:       %12" PRIu64 "\n", heartbeats);
+      std::printf("Sequence range:   %" PRIu64 " .. %" PRIu64 "\n",
+                  first_sequence, next_sequence);
+      std::printf("Rejected frames:  %12" PRIu64 "\n", rejected_frames);
+    }
   }
 };
 
@@ -75,9 +181,12 @@ struct StatsVisitor : itch::DefaultVisitor {
 // ============================================================================
 
 void print_usage(const char *program) {
-  std::fprintf(stderr, "Usage: %s <pcap_file>\n", program);
+  std::fprintf(stderr, "Usage: %s <pcap_or_binary_file>\n", program);
   std::fprintf(stderr, "\nZero-copy ITCH 5.0 feed handler.\n");
-  std::fprintf(stderr, "Parses NASDAQ ITCH messages from a PCAP file.\n");
+  std::fprintf(stderr, "Parses NASDAQ ITCH messages from a PCAP file or a\n");
+  std::fprintf(stderr,
+               "BinaryFILE (2-byte big-endian length + message stream).\n");
+  std::fprintf(stderr, "The format is detected from the PCAP magic number.\n");
 }
 
 } // anonymous namespace
@@ -93,18 +202,28 @@ int main(int argc, char *argv[]) {
     return 1;
   }
 
-  const char *pcap_file = argv[1];
+  const char *input_file = argv[1];
 
-  // Open PCAP file
-  std::printf("Opening PCAP file: %s\n", pcap_file);
-  itch::PcapReader reader(pcap_file);
+  // Open input: PCAP if the magic number matches, BinaryFILE otherwise
+  std::printf("Opening file: %s\n", input_file);
+  itch::PcapReader reader;
+  itch::BinaryFileReader binary_reader;
+  const bool is_pcap = reader.open(input_file);
 
-  if (!reader.is_open()) {
-    std::fprintf(stderr, "Error: Failed to open PCAP file: %s\n", pcap_file);
+  if (!is_pcap && !binary_reader.open(input_file)) {
+    std::fprintf(stderr, "Error: Failed to open file: %s\n", input_file);
+    return 1;
+  }
+  if (is_pcap && !itch::is_supported_link_type(reader.link_type())) {
+    std::fprintf(stderr, "Error: Unsupported PCAP link type %u: %s\n",
+                 reader.link_type(), input_file);
     return 1;
   }
 
-  std::printf("File size: %.2f MB\n", reader.file_size() / (1024.0 * 1024.0));
+  const size_t file_size =
+      is_pcap ? reader.file_size() : binary_reader.file_size();
+  std::printf("Format: %s\n", is_pcap ? "PCAP" : "BinaryFILE");
+  std::printf("File size: %.2f MB\n", file_size / (1024.0 * 1024.0));
 
   // Prepare parser and visitor
   itch::Parser parser;
@@ -115,114 +234,23 @@ int main(int argc, char *argv[]) {
 
   auto start_time = std::chrono::high_resolution_clock::now();
 
-  // ============================================================================
-  // Network Header Offset Heuristics
-  // ============================================================================
-  //
-  // Standard network headers before ITCH payload:
-  //   - Ethernet: 14 bytes
-  //   - IP:       20 bytes
-  //   - UDP:      8 bytes
-  //   - Total:    42 bytes
-  //
-  // Some captures may have VLAN tags (+4 bytes) or other variations.
-  // We use a heuristic: search for valid ITCH message type in first 64 bytes.
-  // ============================================================================
-
-  // Valid ITCH message types
-  auto is_valid_itch_type = [](char c) {
-    // Order messages
-    if (c == 'A' || c == 'F' || c == 'E' || c == 'C' || c == 'X' || c == 'D' ||
-        c == 'U')
-      return true;
-    // Trade messages
-    if (c == 'P' || c == 'Q' || c == 'B')
-      return true;
-    // System/stock messages
-    if (c == 'S' || c == 'R' || c == 'H' || c == 'Y' || c == 'L')
-      return true;
-    // Net order imbalance
-    if (c == 'I' || c == 'N')
-      return true;
-    // MWCB and IPO
-    if (c == 'V' || c == 'W' || c == 'K')
-      return true;
-    return false;
-  };
-
-  // Find ITCH payload offset within a packet
-  auto find_itch_offset = [&is_valid_itch_type](const char *data,
-                                                size_t len) -> size_t {
-    // Common header configurations:
-    // 1. Standard: Ethernet(14) + IP(20) + UDP(8) = 42 bytes
-    // 2. With VLAN: Ethernet(14) + VLAN(4) + IP(20) + UDP(8) = 46 bytes
-    // 3. MoldUDP64: ... + Session(10) + Seq(8) + Count(2) = +20 bytes
-    // 4. Message length prefix: +2 bytes before each ITCH message
-    //
-    // Common offsets to try (in order):
-    constexpr size_t OFFSETS[] = {
-        42, // Standard UDP
-        46, // With VLAN tag
-        62, // Standard + MoldUDP header
-        64, // Standard + MoldUDP + length prefix
-        66, // VLAN + MoldUDP header
-        68, // VLAN + MoldUDP + length prefix
-    };
-
-    // Try each known offset
-    for (size_t offset : OFFSETS) {
-      if (offset < len) {
-        char msg_type = data[offset];
-        if (is_valid_itch_type(msg_type)) {
-          // Additional validation: check stock_locate is reasonable
-          if (len >= offset + 3) {
-            uint16_t stock_locate = static_cast<uint16_t>(
-                (static_cast<uint8_t>(data[offset + 1]) << 8) |
-                static_cast<uint8_t>(data[offset + 2]));
-            if (stock_locate > 0 && stock_locate < 10000) {
-              return offset;
-            }
-          }
-          // Even without stock_locate validation, valid message type is good
-          return offset;
-        }
-      }
-    }
-
-    // Fallback: Search first 100 bytes for valid ITCH message type
-    constexpr size_t SEARCH_LIMIT = 100;
-    size_t search_end = (len < SEARCH_LIMIT) ? len : SEARCH_LIMIT;
-
-    for (size_t offset = 0; offset < search_end; ++offset) {
-      char msg_type = data[offset];
-      if (is_valid_itch_type(msg_type)) {
-        // Validate with stock_locate
-        if (len >= offset + 3) {
-          uint16_t stock_locate = static_cast<uint16_t>(
-              (static_cast<uint8_t>(data[offset + 1]) << 8) |
-              static_cast<uint8_t>(data[offset + 2]));
-          if (stock_locate > 0 && stock_locate < 10000) {
-            return offset;
-          }
-        }
+  size_t packet_count = 0;
+  if (is_pcap) {
+    const auto link = static_cast<itch::LinkType>(reader.link_type());
+    packet_count = reader.for_each_packet([&](const char *data, size_t len) {
+      // Decode link/VLAN/IPv4/UDP/MoldUDP64, then each message block
+      if (itch::parse_frame(parser, data, len, stats, link) !=
+          itch::DecodeResult::Ok) {
+        ++stats.rejected_frames;
       }
-    }
-
-    // Last resort: return 42 and let parser handle it
-    return 42;
-  };
-
-  size_t packet_count =
-      reader.for_each_packet([&](const char *data, size_t len) {
-        // Find ITCH payload offset (skip network headers)
-        size_t offset = find_itch_offset(data, len);
-
-        if (offset < len) {
-          const char *itch_data = data + offset;
-          size_t itch_len = len - offset;
-          (void)parser.parse_buffer(itch_data, itch_len, stats);
-        }
-      });
+    });
+  } else {
+    // BinaryFILE: one framed message per callback, no headers to skip
+    packet_count =
+        binary_reader.for_each_message([&](const char *data, size_t len) {
+          (void)parser.parse(data, len, stats);
+        });
+  }
 
   auto end_time = std::chrono::high_resolution_clock::now();
   auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
@@ -230,15 +258,16 @@ int main(int argc, char *argv[]) {
 
   // Print results
   std::printf("\n=== Performance ===\n");
-  std::printf("Packets processed: %zu\n", packet_count);
+  const char *unit = is_pcap ? "packets" : "messages";
+  std::printf("%s processed: %zu\n", is_pcap ? "Packets" : "Messages",
+              packet_count);
   std::printf("Time: %.3f ms\n", duration.count() / 1000.0);
 
   if (duration.count() > 0) {
     double packets_per_sec = packet_count * 1e6 / duration.count();
-    double mb_per_sec =
-        reader.file_size() / (1024.0 * 1024.0) * 1e6 / duration.count();
-    std::printf("Throughput: %.2f million packets/sec\n",
-                packets_per_sec / 1e6);
+    double mb_per_sec = file_size / (1024.0 * 1024.0) * 1e6 / duration.count();
+    std::printf("Throughput: %.2f million %s/sec\n", packets_per_sec / 1e6,
+                unit);
     std::printf("Bandwidth: %.2f MB/sec\n", mb_per_sec);
   }
 
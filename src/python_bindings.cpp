@@ -6,20 +6,47 @@
  * and returns data as NumPy arrays for easy Pandas integration.
  *
  * DESIGN:
- * - PythonAccumulator collects data in C++ vectors (no Python callbacks)
- * - parse_file() returns a dict of NumPy arrays (zero-copy where possible)
- * - Reuses offset detection logic from main.cpp for PCAP header handling
+ * - ColumnAccumulator (itch/column_accumulator.hpp) collects data in C++
+ *   vectors (no Python callbacks); this file only wraps it for Python
+ * - parse_file() returns a dict of NumPy arrays that take ownership of
+ *   those vectors through a capsule (zero-copy, one copy of the data)
+ * - Column capacity is reserved up front from the file size, as address
+ *   space only, so columns never reallocate while growing
+ * - stream() walks a file lazily in fixed-size batches, reusing the same
+ *   columns for every batch, for files larger than memory
+ * - Parsing runs with the GIL released; parse_file(threads=N) splits the
+ *   file into packet ranges parsed in parallel and merged in file order
+ * - parse_file() filters (stock_locate, symbol, message type, time) are
+ *   evaluated in C++ before any column append
+ * - replay_book() runs the per-symbol market-by-order book over a file and
+ *   samples L1/L2 snapshots into columns handed to NumPy the same way
+ * - Frames are decoded by the capture's link type down to MoldUDP64
+ *   (moldudp64.hpp)
  */
 
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include <book/book_sampler.hpp>
+#include <book/order_book.hpp>
+#include <book/segmented_pool.hpp>
+#include <itch/column_accumulator.hpp>
 #include <itch/messages.hpp>
+#include <itch/moldudp64.hpp>
 #include <itch/parser.hpp>
 #include <itch/pcap_reader.hpp>
 
@@ -27,221 +54,361 @@ namespace py = pybind11;
 
 namespace {
 
+using itch::Column;
+using itch::ColumnAccumulator;
+using itch::LocateMatch;
+using itch::ParseFilter;
+using itch::reserve_columns;
+
 // ============================================================================
-// ITCH Message Type Validation (reused from main.cpp)
+// NumPy Export - Columns Handed Over Without a Copy
 // ============================================================================
 
-inline bool is_valid_itch_type(char c) {
-  // Order messages
-  if (c == 'A' || c == 'F' || c == 'E' || c == 'C' || c == 'X' || c == 'D' ||
-      c == 'U')
-    return true;
-  // Trade messages
-  if (c == 'P' || c == 'Q' || c == 'B')
-    return true;
-  // System/stock messages
-  if (c == 'S' || c == 'R' || c == 'H' || c == 'Y' || c == 'L')
-    return true;
-  // Net order imbalance
-  if (c == 'I' || c == 'N')
-    return true;
-  // MWCB and IPO
-  if (c == 'V' || c == 'W' || c == 'K')
-    return true;
-  return false;
+/**
+ * @brief Move a column into a NumPy array that owns it (no copy).
+ *
+ * The vector is moved to the heap and freed by a capsule when the array
+ * (and every view of it) is garbage collected.
+ */
+template <typename T> py::array_t<T> to_numpy(Column<T> &&column) {
+  auto owned = std::make_unique<Column<T>>(std::move(column));
+  const T *data = owned->data();
+  const auto size = static_cast<py::ssize_t>(owned->size());
+  py::capsule owner(owned.get(), [](void *p) {
+    delete static_cast<Column<T> *>(p);
+  });
+  owned.release(); // The capsule owns it now
+  return py::array_t<T>(size, data, owner);
 }
 
-// ============================================================================
-// PCAP Offset Detection (reused from main.cpp)
-// ============================================================================
+/**
+ * @brief Move a row-major column into a (rows, columns) NumPy array that
+ *        owns it (no copy).
+ */
+template <typename T>
+py::array_t<T> to_numpy(Column<T> &&column, std::size_t columns) {
+  auto owned = std::make_unique<Column<T>>(std::move(column));
+  const T *data = owned->data();
+  const auto rows = static_cast<py::ssize_t>(owned->size() / columns);
+  py::capsule owner(owned.get(), [](void *p) {
+    delete static_cast<Column<T> *>(p);
+  });
+  owned.release(); // The capsule owns it now
+  return py::array_t<T>({rows, static_cast<py::ssize_t>(columns)}, data,
+                        owner);
+}
 
-inline size_t find_itch_offset(const char *data, size_t len) {
-  // Common header configurations
-  constexpr size_t OFFSETS[] = {
-      42, // Standard UDP
-      46, // With VLAN tag
-      62, // Standard + MoldUDP header
-      64, // Standard + MoldUDP + length prefix
-      66, // VLAN + MoldUDP header
-      68, // VLAN + MoldUDP + length prefix
-  };
-
-  // Try each known offset
-  for (size_t offset : OFFSETS) {
-    if (offset < len) {
-      char msg_type = data[offset];
-      if (is_valid_itch_type(msg_type)) {
-        if (len >= offset + 3) {
-          uint16_t stock_locate = static_cast<uint16_t>(
-              (static_cast<uint8_t>(data[offset + 1]) << 8) |
-              static_cast<uint8_t>(data[offset + 2]));
-          if (stock_locate > 0 && stock_locate < 10000) {
-            return offset;
-          }
-        }
-        return offset;
-      }
-    }
-  }
+/**
+ * @brief Copy the first `rows` of a column into a new NumPy array.
+ */
+template <typename T>
+py::array_t<T> head_to_numpy(const Column<T> &column, std::size_t rows) {
+  return py::array_t<T>(static_cast<py::ssize_t>(rows), column.data());
+}
 
-  // Fallback: Search first 100 bytes
-  constexpr size_t SEARCH_LIMIT = 100;
-  size_t search_end = (len < SEARCH_LIMIT) ? len : SEARCH_LIMIT;
-
-  for (size_t offset = 0; offset < search_end; ++offset) {
-    char msg_type = data[offset];
-    if (is_valid_itch_type(msg_type)) {
-      if (len >= offset + 3) {
-        uint16_t stock_locate = static_cast<uint16_t>(
-            (static_cast<uint8_t>(data[offset + 1]) << 8) |
-            static_cast<uint8_t>(data[offset + 2]));
-        if (stock_locate > 0 && stock_locate < 10000) {
-          return offset;
-        }
-      }
-    }
-  }
+/**
+ * @brief Hand the columns `visit` reaches to a dict of NumPy arrays.
+ *
+ * The arrays take ownership of the columns (no copy); the columns are
+ * empty afterwards.
+ */
+template <typename Visit> py::dict take_columns(Visit visit) {
+  py::dict result;
+  visit([&](const char *name, auto &column) {
+    result[name] = to_numpy(std::move(column));
+  });
+  return result;
+}
 
-  return 42; // Last resort
+/**
+ * @brief Open a PCAP file whose frames decode_frame() can read.
+ * @throws std::runtime_error if it cannot be opened or has another
+ *         link type
+ */
+itch::LinkType open_pcap(itch::PcapReader &reader,
+                         const std::string &filename) {
+  if (!reader.open(filename.c_str())) {
+    throw std::runtime_error("Failed to open PCAP file: " + filename);
+  }
+  if (!itch::is_supported_link_type(reader.link_type())) {
+    throw std::runtime_error("Unsupported PCAP link type " +
+                             std::to_string(reader.link_type()) + ": " +
+                             filename);
+  }
+  return static_cast<itch::LinkType>(reader.link_type());
 }
 
 // ============================================================================
-// Python Accumulator - Collects data in C++ vectors
+// Streaming - Fixed-Size Batches in Bounded Memory
 // ============================================================================
 
 /**
- * @brief Accumulates parsed ITCH messages into vectors.
+ * @brief Python iterator over a capture in batches of at most
+ *        `chunk_messages` rows per message type (itch::ColumnStream).
  *
- * This is much faster than calling back into Python for each message.
- * After parsing, vectors are converted to NumPy arrays.
+ * Each batch costs one chunk-sized copy into NumPy, since the stream
+ * reuses its columns. Parsing runs with the GIL released, so calls from
+ * several threads are serialised by a mutex: each gets the next batch.
  */
-class PythonAccumulator : public itch::DefaultVisitor {
+class ParseStream {
 public:
-  // AddOrder data
-  std::vector<uint64_t> add_order_refs;
-  std::vector<uint64_t> add_timestamps;
-  std::vector<uint16_t> add_stock_locates;
-  std::vector<uint32_t> add_shares;
-  std::vector<uint32_t> add_prices;
-  std::vector<char> add_sides;
-
-  // OrderExecuted data
-  std::vector<uint64_t> exec_order_refs;
-  std::vector<uint64_t> exec_timestamps;
-  std::vector<uint16_t> exec_stock_locates;
-  std::vector<uint32_t> exec_shares;
-  std::vector<uint64_t> exec_match_numbers;
-
-  void on_add_order(const itch::AddOrder &msg) {
-    add_order_refs.push_back(static_cast<uint64_t>(msg.order_ref));
-    add_timestamps.push_back(msg.timestamp.nanoseconds());
-    add_stock_locates.push_back(static_cast<uint16_t>(msg.stock_locate));
-    add_shares.push_back(static_cast<uint32_t>(msg.shares));
-    add_prices.push_back(static_cast<uint32_t>(msg.price));
-    add_sides.push_back(msg.side);
-  }
-
-  void on_order_executed(const itch::OrderExecuted &msg) {
-    exec_order_refs.push_back(static_cast<uint64_t>(msg.order_ref));
-    exec_timestamps.push_back(msg.timestamp.nanoseconds());
-    exec_stock_locates.push_back(static_cast<uint16_t>(msg.stock_locate));
-    exec_shares.push_back(static_cast<uint32_t>(msg.executed_shares));
-    exec_match_numbers.push_back(static_cast<uint64_t>(msg.match_number));
-  }
+  ParseStream(const std::string &filename, std::size_t chunk_messages)
+      : stream_(opened(reader_, filename), checked_chunk(chunk_messages)) {}
 
   /**
-   * @brief Convert accumulated AddOrder data to Python dict of NumPy arrays.
+   * @brief Parse up to the next batch and return it as a dict of NumPy
+   *        arrays; raises StopIteration at the end of the file.
    */
-  py::dict get_add_orders() const {
-    py::dict result;
-
-    // Convert vectors to NumPy arrays
-    result["order_ref"] =
-        py::array_t<uint64_t>(add_order_refs.size(), add_order_refs.data());
-    result["timestamp"] =
-        py::array_t<uint64_t>(add_timestamps.size(), add_timestamps.data());
-    result["stock_locate"] = py::array_t<uint16_t>(add_stock_locates.size(),
-                                                   add_stock_locates.data());
-    result["shares"] =
-        py::array_t<uint32_t>(add_shares.size(), add_shares.data());
-    result["price"] =
-        py::array_t<uint32_t>(add_prices.size(), add_prices.data());
-
-    // Side needs special handling (char array)
-    py::array_t<char> sides(add_sides.size());
-    auto sides_buf = sides.mutable_unchecked<1>();
-    for (size_t i = 0; i < add_sides.size(); ++i) {
-      sides_buf(i) = add_sides[i];
+  py::dict next() {
+    // Lock without the GIL: a holder of the mutex may be waiting for it
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    bool has_batch = false;
+    {
+      py::gil_scoped_release release;
+      lock.lock();
+      has_batch = stream_.fill();
     }
-    result["side"] = sides;
+    if (!has_batch) {
+      throw py::stop_iteration();
+    }
+
+    py::dict adds;
+    stream_.take_add_batch(
+        [&](const char *name, const auto &column, std::size_t rows) {
+          adds[name] = head_to_numpy(column, rows);
+        });
+    py::dict execs;
+    stream_.take_exec_batch(
+        [&](const char *name, const auto &column, std::size_t rows) {
+          execs[name] = head_to_numpy(column, rows);
+        });
 
+    py::dict result;
+    result["add_orders"] = adds;
+    result["order_executed"] = execs;
+    result["packet_count"] = stream_.packet_count();
+    result["session"] = stream_.accumulator().session;
+    result["next_sequence"] = stream_.accumulator().next_sequence;
     return result;
   }
 
-  /**
-   * @brief Convert accumulated OrderExecuted data to Python dict of NumPy
-   * arrays.
-   */
-  py::dict get_order_executed() const {
-    py::dict result;
+  [[nodiscard]] std::size_t chunk_messages() const noexcept {
+    return stream_.chunk_messages();
+  }
+  [[nodiscard]] std::size_t packet_count() {
+    py::gil_scoped_release release;
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return stream_.packet_count();
+  }
+  [[nodiscard]] std::size_t file_size() const noexcept {
+    return reader_.file_size();
+  }
 
-    result["order_ref"] =
-        py::array_t<uint64_t>(exec_order_refs.size(), exec_order_refs.data());
-    result["timestamp"] =
-        py::array_t<uint64_t>(exec_timestamps.size(), exec_timestamps.data());
-    result["stock_locate"] = py::array_t<uint16_t>(exec_stock_locates.size(),
-                                                   exec_stock_locates.data());
-    result["executed_shares"] =
-        py::array_t<uint32_t>(exec_shares.size(), exec_shares.data());
-    result["match_number"] = py::array_t<uint64_t>(exec_match_numbers.size(),
-                                                   exec_match_numbers.data());
+private:
+  static const itch::PcapReader &opened(itch::PcapReader &reader,
+                                        const std::string &filename) {
+    (void)open_pcap(reader, filename);
+    return reader;
+  }
 
-    return result;
+  static std::size_t checked_chunk(std::size_t chunk_messages) {
+    if (chunk_messages == 0) {
+      throw std::invalid_argument("chunk_messages must be positive");
+    }
+    return chunk_messages;
   }
+
+  itch::PcapReader reader_;
+  std::mutex mutex_; ///< Held while a batch is parsed and cut
+  itch::ColumnStream stream_;
 };
 
+// ============================================================================
+// Book Replay - Sampled L1/L2 Snapshots
+// ============================================================================
+
+/// Order storage for replay_book(); grows by segments on busy days
+using BookPool = book::SegmentedPool<book::Order>;
+
+/// Orders reserved before replay_book() starts (the pool grows past it)
+constexpr std::size_t kReplayInitialOrders = std::size_t{1} << 20;
+using ReplayBook = book::BasicOrderBook<BookPool>;
+
+using BookSampler = book::BookSampler<ReplayBook>;
+
 // ============================================================================
 // Main Parse Function
 // ============================================================================
 
+/**
+ * @brief Build a ParseFilter from parse_file()'s keyword arguments (None
+ *        disables a predicate); bad values raise ValueError.
+ */
+ParseFilter make_filter(const py::object &stock_locates,
+                        const py::object &symbols,
+                        const py::object &message_types,
+                        std::optional<uint64_t> start_ns,
+                        std::optional<uint64_t> end_ns) {
+  ParseFilter filter;
+  if (!stock_locates.is_none()) {
+    filter.by_locate = true;
+    for (const py::handle locate : stock_locates) {
+      filter.locates.set(locate.cast<uint16_t>());
+    }
+  }
+  if (!symbols.is_none()) {
+    for (const py::handle item : symbols) {
+      const auto symbol = item.cast<std::string>();
+      if (symbol.empty() || symbol.size() > sizeof(itch::StockSymbol)) {
+        throw std::invalid_argument("symbol must be 1-8 characters: " +
+                                    symbol);
+      }
+      ParseFilter::Symbol padded;
+      padded.fill(' ');
+      std::memcpy(padded.data(), symbol.data(), symbol.size());
+      filter.symbols.push_back(padded);
+    }
+    if (filter.symbols.empty()) {
+      // An empty selection keeps nothing, like an empty stock_locates
+      filter.by_locate = true;
+    }
+  }
+  if (!message_types.is_none()) {
+    filter.keep_adds = false;
+    filter.keep_executions = false;
+    for (const py::handle item : message_types) {
+      const auto type = item.cast<std::string>();
+      if (type == std::string(1, itch::msg_type::AddOrder)) {
+        filter.keep_adds = true;
+      } else if (type == std::string(1, itch::msg_type::OrderExecuted)) {
+        filter.keep_executions = true;
+      } else {
+        throw std::invalid_argument("message_types accepts 'A' and 'E': " +
+                                    type);
+      }
+    }
+  }
+  filter.start_ns = start_ns.value_or(filter.start_ns);
+  filter.end_ns = end_ns.value_or(filter.end_ns);
+  if (filter.start_ns > filter.end_ns) {
+    throw std::invalid_argument("start_ns is after end_ns");
+  }
+  return filter;
+}
+
 /**
  * @brief Parse a PCAP file and return ITCH data as NumPy arrays.
  *
+ * The parse runs with the GIL released, so other Python threads (e.g. a
+ * concurrent.futures pool parsing other files) proceed meanwhile. With
+ * threads > 1 the file is split into packet ranges, each parsed into its
+ * own accumulator on its own thread, then merged in file order
+ * (itch::parse_file_columns()). A worker's exception (std::bad_alloc)
+ * is raised here once every worker has finished.
+ *
+ * Filtered-out rows are never appended. Columns are reserved as address
+ * space only, so memory is committed for kept rows alone.
+ *
  * @param filename Path to PCAP file
+ * @param threads Worker threads (0: one per hardware thread)
+ * @param filter Row predicates (see make_filter())
  * @return dict with 'add_orders' and 'order_executed' sub-dicts,
  *         each containing NumPy arrays for each field.
  */
-py::dict parse_file(const std::string &filename) {
-  itch::PcapReader reader(filename.c_str());
-
-  if (!reader.is_open()) {
-    throw std::runtime_error("Failed to open PCAP file: " + filename);
+py::dict parse_file(const std::string &filename, std::size_t threads,
+                    const ParseFilter &filter) {
+  itch::PcapReader reader;
+  (void)open_pcap(reader, filename);
+  if (threads == 0) {
+    threads = std::max(1U, std::thread::hardware_concurrency());
   }
 
-  itch::Parser parser;
-  PythonAccumulator accumulator;
-
-  // Process all packets
-  size_t packet_count =
-      reader.for_each_packet([&](const char *data, size_t len) {
-        size_t offset = find_itch_offset(data, len);
-        if (offset < len) {
-          const char *itch_data = data + offset;
-          size_t itch_len = len - offset;
-          (void)parser.parse_buffer(itch_data, itch_len, accumulator);
-        }
-      });
+  ColumnAccumulator accumulator;
+  std::size_t packet_count = 0;
+  {
+    py::gil_scoped_release release;
+    packet_count =
+        itch::parse_file_columns(reader, threads, filter, accumulator);
+  }
 
   // Build result dictionary
   py::dict result;
-  result["add_orders"] = accumulator.get_add_orders();
-  result["order_executed"] = accumulator.get_order_executed();
+  result["add_orders"] = take_columns(
+      [&](auto &&fn) { accumulator.visit_add_columns(fn); });
+  result["order_executed"] = take_columns(
+      [&](auto &&fn) { accumulator.visit_exec_columns(fn); });
   result["packet_count"] = packet_count;
+  result["session"] = accumulator.session;
+  result["next_sequence"] = accumulator.next_sequence;
   result["file_size"] = reader.file_size();
 
   return result;
 }
 
+/**
+ * @brief Replay a PCAP file through per-symbol books and return sampled
+ *        L1/L2 snapshots as NumPy arrays (see BookSampler).
+ *
+ * @param filename Path to PCAP file
+ * @param depth Price levels per side in each snapshot (1 = L1)
+ * @param interval_ns Sampling interval (0: after every event)
+ * @param filter Instruments to replay and time window to keep
+ */
+py::dict replay_book(const std::string &filename, std::size_t depth,
+                     uint64_t interval_ns, const ParseFilter &filter) {
+  itch::PcapReader reader;
+  const itch::LinkType link = open_pcap(reader, filename);
+  if (depth == 0) {
+    throw std::invalid_argument("depth must be positive");
+  }
+
+  BookPool pool(kReplayInitialOrders);
+  BookSampler::Manager books(pool);
+  BookSampler sampler(books, filter, depth, interval_ns);
+  sampler.reserve_for(reader.file_size());
+
+  std::size_t packet_count = 0;
+  {
+    py::gil_scoped_release release;
+    const itch::Parser parser;
+    packet_count = reader.for_each_packet([&](const char *data, size_t len) {
+      (void)itch::parse_frame(parser, data, len, sampler, link);
+    });
+    sampler.finish();
+  }
+
+  const book::MarketByOrderStats &stats = sampler.stats();
+  py::dict counters;
+  counters["adds"] = stats.adds;
+  counters["executions"] = stats.executions;
+  counters["cancels"] = stats.cancels;
+  counters["deletes"] = stats.deletes;
+  counters["replaces"] = stats.replaces;
+  counters["rejected"] = stats.rejected;
+  counters["unknown"] = stats.unknown;
+
+  py::dict result;
+  result["timestamp"] = to_numpy(std::move(sampler.timestamps));
+  result["stock_locate"] = to_numpy(std::move(sampler.stock_locates));
+  result["bid_price"] = to_numpy(std::move(sampler.bid_prices), depth);
+  result["bid_size"] = to_numpy(std::move(sampler.bid_sizes), depth);
+  result["ask_price"] = to_numpy(std::move(sampler.ask_prices), depth);
+  result["ask_size"] = to_numpy(std::move(sampler.ask_sizes), depth);
+  result["stats"] = counters;
+  result["books"] = books.book_count();
+  result["packet_count"] = packet_count;
+  result["file_size"] = reader.file_size();
+  return result;
+}
+
+/**
+ * @brief Open a capture as a batch iterator (see ParseStream).
+ */
+std::unique_ptr<ParseStream> stream(const std::string &filename,
+                                    std::size_t chunk_messages) {
+  return std::make_unique<ParseStream>(filename, chunk_messages);
+}
+
 /**
  * @brief Get version information.
  */
@@ -268,12 +435,40 @@ PYBIND11_MODULE(itch_handler, m) {
             print(f"Parsed {len(add_orders['order_ref'])} add orders")
     )pbdoc";
 
-  m.def("parse_file", &parse_file, py::arg("filename"),
-        R"pbdoc(
+  m.def(
+      "parse_file",
+      [](const std::string &filename, std::size_t threads,
+         const py::object &stock_locates, const py::object &symbols,
+         const py::object &message_types, std::optional<uint64_t> start_ns,
+         std::optional<uint64_t> end_ns) {
+        const ParseFilter filter = make_filter(
+            stock_locates, symbols, message_types, start_ns, end_ns);
+        return parse_file(filename, threads, filter);
+      },
+      py::arg("filename"), py::arg("threads") = std::size_t{1}, py::kw_only(),
+      py::arg("stock_locates") = py::none(), py::arg("symbols") = py::none(),
+      py::arg("message_types") = py::none(),
+      py::arg("start_ns") = py::none(), py::arg("end_ns") = py::none(),
+      R"pbdoc(
             Parse a PCAP file containing ITCH 5.0 messages.
 
+            The GIL is released while parsing. Filters are applied in C++
+            before a row is stored, so a filtered extract only allocates
+            the rows it keeps.
+
             Args:
                 filename: Path to the PCAP file.
+                threads: Worker threads splitting the file by packet
+                         ranges (0: one per core). Results are identical
+                         to threads=1.
+                stock_locates: Iterable of stock_locate codes to keep.
+                symbols: Iterable of symbols to keep ('AAPL'). Resolved
+                         to stock_locate from Stock Directory and AddOrder
+                         messages; either selection keeps a row.
+                message_types: Iterable of 'A' (add_orders) and 'E'
+                         (order_executed) to materialize.
+                start_ns, end_ns: Keep timestamps in [start_ns, end_ns),
+                         nanoseconds since midnight.
 
             Returns:
                 dict with keys:
@@ -282,9 +477,84 @@ PYBIND11_MODULE(itch_handler, m) {
                     - 'order_executed': dict of NumPy arrays (order_ref, timestamp,
                                         stock_locate, executed_shares, match_number)
                     - 'packet_count': Number of packets processed
+                    - 'session': MoldUDP64 session of the first packet
+                    - 'next_sequence': Sequence expected after the last packet
                     - 'file_size': Size of PCAP file in bytes
         )pbdoc");
 
+  py::class_<ParseStream>(m, "ParseStream",
+                          "Iterator over a PCAP file in fixed-size batches")
+      .def("__iter__",
+           [](ParseStream &self) -> ParseStream & { return self; },
+           py::return_value_policy::reference_internal)
+      .def("__next__", &ParseStream::next)
+      .def_property_readonly("chunk_messages", &ParseStream::chunk_messages)
+      .def_property_readonly("packet_count", &ParseStream::packet_count)
+      .def_property_readonly("file_size", &ParseStream::file_size);
+
+  m.def("stream", &stream, py::arg("filename"),
+        py::arg("chunk_messages") = std::size_t{1} << 20,
+        R"pbdoc(
+            Iterate over a PCAP file in batches, in bounded memory.
+
+            Args:
+                filename: Path to the PCAP file.
+                chunk_messages: Most rows per message type in one batch.
+
+            Yields:
+                dict with the same 'add_orders' and 'order_executed'
+                sub-dicts as parse_file(); the type that filled the batch
+                has exactly chunk_messages rows (fewer in the last batch).
+                Also 'packet_count' (packets read so far), 'session' and
+                'next_sequence'.
+
+            Example:
+                for batch in itch_handler.stream(path, chunk_messages=1 << 20):
+                    process(batch['add_orders'])
+        )pbdoc");
+
+  m.def(
+      "replay_book",
+      [](const std::string &filename, std::size_t depth, uint64_t interval_ns,
+         const py::object &stock_locates, const py::object &symbols,
+         std::optional<uint64_t> start_ns, std::optional<uint64_t> end_ns) {
+        const ParseFilter filter = make_filter(stock_locates, symbols,
+                                               py::none(), start_ns, end_ns);
+        return replay_book(filename, depth, interval_ns, filter);
+      },
+      py::arg("filename"), py::kw_only(), py::arg("depth") = std::size_t{1},
+      py::arg("interval_ns") = uint64_t{0},
+      py::arg("stock_locates") = py::none(), py::arg("symbols") = py::none(),
+      py::arg("start_ns") = py::none(), py::arg("end_ns") = py::none(),
+      R"pbdoc(
+            Replay a PCAP file through the C++ market-by-order book (one
+            book per symbol) and sample depth snapshots.
+
+            The GIL is released while replaying.
+
+            Args:
+                filename: Path to the PCAP file.
+                depth: Price levels per side in each snapshot (1 = L1).
+                interval_ns: 0 samples after every book event. Otherwise
+                         one row per book per interval in which it changed,
+                         stamped with the interval end and holding the
+                         book after the interval's last event.
+                stock_locates, symbols: Instruments to replay (as in
+                         parse_file). Default: every instrument.
+                start_ns, end_ns: Keep snapshots in [start_ns, end_ns);
+                         the book is still built from every event.
+
+            Returns:
+                dict with keys:
+                    - 'timestamp', 'stock_locate': one entry per snapshot
+                    - 'bid_price', 'bid_size', 'ask_price', 'ask_size':
+                      (snapshots, depth) arrays, best level first, zero
+                      where a side has fewer levels
+                    - 'stats': applied/rejected/unknown event counters
+                    - 'books': number of books built
+                    - 'packet_count', 'file_size'
+        )pbdoc");
+
   m.def("version", &version, "Get library version string");
 
   m.attr("__version__") = "1.0.0";
@@ -4,21 +4,56 @@
  * engine.
  *
  * This driver demonstrates the full HFT pipeline:
- * 1. PCAP packet reading (zero-copy)
+ * 1. PCAP packet / BinaryFILE message reading (zero-copy)
  * 2. ITCH message parsing (zero-copy)
- * 3. Order book management (matching engine)
- * 4. Performance metrics collection
+ * 3. Order book management (one book per stock_locate), either
+ *    market-by-order (apply A/F/E/C/X/D/U exactly) or simulated matching,
+ *    optionally sharded by stock_locate across worker threads
+ * 4. Performance metrics collection, including TSC-timed per-message-type
+ *    latency histograms (compiled out with CHRONOS_LATENCY_HISTOGRAMS=0)
  *
- * Usage: ./chronos_replay [pcap_file]
- *        Default: data/Multiple.Packets.pcap
+ * Usage: ./chronos_replay [--engine=vector|ladder] [--mode=mbo|match]
+ *                         [--line-b=pcap] [--shards=N [--pin[=cpu]]]
+ *                         [--numa=node] [--pool-init=lazy|eager]
+ *                         [--pool-orders=N] [--stream[=MB]]
+ *                         [--io=mmap|uring] [pcap_or_binary_file]
+ *        Default: data/Multiple.Packets.pcap, vector engine, mbo mode
  */
 
+#include <book/book_manager.hpp>
+#include <book/ladder_order_book.hpp>
+#include <book/market_by_order.hpp>
 #include <book/order_book.hpp>
+#include <book/segmented_pool.hpp>
 #include <chrono>
+#include <cctype>
 #include <cinttypes>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <itch/binary_file_reader.hpp>
+#include <itch/line_arbitrator.hpp>
+#include <itch/moldudp64.hpp>
 #include <itch/parser.hpp>
 #include <itch/pcap_reader.hpp>
+#include <itch/uring_reader.hpp>
+#include <memory>
+#include <metrics/latency_histogram.hpp>
+#include <metrics/tsc_clock.hpp>
+#include <pipeline/sharded_pipeline.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+/// Record per-message-type latency histograms (set by the CMake option of
+/// the same name; 0 removes every clock read from the replay loop)
+#ifndef CHRONOS_LATENCY_HISTOGRAMS
+#define CHRONOS_LATENCY_HISTOGRAMS 1
+#endif
 
 namespace {
 
@@ -26,8 +61,13 @@ namespace {
 // Configuration
 // ============================================================================
 
-/// Pool capacity for orders (10 million = typical full trading day)
-constexpr std::size_t POOL_CAPACITY = 10'000'000;
+/// Orders reserved up front per pool (--pool-orders). Pools grow by whole
+/// segments past this, so it only needs to cover a typical day's peak.
+constexpr std::size_t DEFAULT_POOL_ORDERS = 4 * 1'048'576;
+
+/// Orders per pool segment: 1M x 37-byte Orders = 37 MB, which
+/// HugePageAllocation rounds up to 38 MB (a whole number of 2 MB pages)
+constexpr std::size_t POOL_SEGMENT_ORDERS = 1'048'576;
 
 /// Every Nth order is made marketable to trigger matches
 constexpr uint64_t MATCH_TRIGGER_INTERVAL = 100;
@@ -35,6 +75,81 @@ constexpr uint64_t MATCH_TRIGGER_INTERVAL = 100;
 /// Default PCAP file if none specified
 constexpr const char *DEFAULT_PCAP = "data/Multiple.Packets.pcap";
 
+/// Pool segments are mapped on huge pages (falling back to 4 KB pages):
+/// random cancels across hundreds of MB of orders otherwise miss the TLB
+using PoolAllocation = book::HugePageAllocation;
+
+/// Order pool sized at runtime; a busy day adds segments instead of
+/// rejecting orders, and resting Order* never move.
+using PoolType =
+    book::SegmentedPool<book::Order, POOL_SEGMENT_ORDERS, PoolAllocation>;
+
+/// Book engines selectable on the command line. One book exists per
+/// symbol, so the ladder ring is kept at 1024 ticks ($10.24 at 1 cent,
+/// 64 KB per book) rather than the 4096-tick default.
+using VectorBook = book::BasicOrderBook<PoolType>;
+using LadderBook = book::BasicLadderOrderBook<PoolType, 1024>;
+
+/// Messages the router may queue ahead of each worker
+constexpr std::size_t SHARD_RING_CAPACITY = 65536;
+
+/// Upper bound for --shards (one pool each)
+constexpr std::size_t MAX_SHARDS = 64;
+
+/**
+ * @brief How the order pools are built (--numa, --pool-init, --pool-orders).
+ *
+ * Lazy pools construct in O(1) and fault pages in as books grow; eager
+ * pools construct and pre-fault every reserved slot (and each later
+ * segment) before use. Every shard reserves initial_orders of its own.
+ */
+struct PoolConfig {
+  book::PoolPlacement placement;
+  book::PoolInit init = book::PoolInit::Lazy;
+  std::size_t initial_orders = DEFAULT_POOL_ORDERS;
+
+  /// Slots the pool actually reserves (initial_orders in whole segments)
+  [[nodiscard]] std::size_t reserved_orders() const noexcept {
+    return (initial_orders + POOL_SEGMENT_ORDERS - 1) / POOL_SEGMENT_ORDERS *
+           POOL_SEGMENT_ORDERS;
+  }
+};
+
+/**
+ * @brief How the input capture is read (--stream, --io).
+ *
+ * By default the file is mapped whole. A streamed or io_uring input hands
+ * out messages that are valid only until the handler returns.
+ */
+struct InputConfig {
+  std::size_t stream_window = 0; ///< PCAP window bytes (0 = map whole)
+  bool uring = false;            ///< PCAP through io_uring block reads
+
+  [[nodiscard]] bool transient() const noexcept {
+    return stream_window != 0 || uring;
+  }
+};
+
+/// Sequence window for A/B arbitration (messages one line may lead by)
+constexpr std::size_t ARBITRATION_WINDOW = 65536;
+using Arbitrator = itch::LineArbitrator<ARBITRATION_WINDOW>;
+
+/// Unrecoverable gaps printed individually before summarising
+constexpr uint64_t MAX_GAPS_REPORTED = 10;
+
+/// Books listed individually in the final state
+constexpr std::size_t MAX_BOOKS_REPORTED = 5;
+
+/// Parse + book update time per ITCH message type, in TSC ticks
+using LatencyRecorder =
+    metrics::LatencyRecorder<CHRONOS_LATENCY_HISTOGRAMS != 0>;
+
+/// How ITCH order events drive the books
+enum class ReplayMode {
+  MarketByOrder, ///< Apply feed events exactly, keyed by order_ref
+  Match          ///< Feed adds into the matching engine (simulation)
+};
+
 // ============================================================================
 // Metrics
 // ============================================================================
@@ -44,7 +159,6 @@ struct ReplayMetrics {
   uint64_t orders_added = 0;
   uint64_t orders_cancelled = 0;
   uint64_t matches_executed = 0;
-  uint64_t add_order_time_ns = 0; // Total time in add_order calls
 
   void print() const {
     std::printf("\n=== Market Replay Metrics ===\n");
@@ -52,37 +166,76 @@ struct ReplayMetrics {
     std::printf("Orders Added to Book: %12" PRIu64 "\n", orders_added);
     std::printf("Orders Cancelled:     %12" PRIu64 "\n", orders_cancelled);
     std::printf("Matches Executed:     %12" PRIu64 "\n", matches_executed);
-
-    if (orders_processed > 0) {
-      double avg_latency_ns = static_cast<double>(add_order_time_ns) /
-                              static_cast<double>(orders_processed);
-      std::printf("Avg add_order latency: %.1f ns\n", avg_latency_ns);
-    }
   }
 };
 
+/**
+ * @brief Latency histogram key for a message: its ITCH type byte.
+ */
+uint8_t message_type(const char *msg, size_t len) noexcept {
+  return len > 0 ? static_cast<uint8_t>(msg[0]) : 0;
+}
+
+/**
+ * @brief Percentiles of each message type's parse + book update latency.
+ */
+void print_latency(const LatencyRecorder &latency) {
+  if constexpr (!LatencyRecorder::kEnabled) {
+    return;
+  }
+  // Calibrated after the replay so the 20 ms spin is not in its timing
+  const metrics::TscClock clock = metrics::TscClock::calibrate();
+  std::printf("\n=== Latency per Message Type (parse + book update) ===\n");
+  std::printf("Clock: %s at %.3f GHz%s\n",
+              metrics::TscClock::hardware() ? "TSC" : "steady_clock",
+              clock.ghz(),
+              metrics::TscClock::invariant() ? "" : " (not invariant)");
+  std::printf("Type        Count      p50      p90      p99    p99.9"
+              "        max  (ns)\n");
+  latency.for_each([&](uint8_t type, const LatencyRecorder::Histogram &h) {
+    auto ns = [&](double percentile) {
+      return clock.to_ns(h.value_at_percentile(percentile));
+    };
+    std::printf("   %c %12" PRIu64 " %8.0f %8.0f %8.0f %8.0f %10.0f\n",
+                std::isprint(type) != 0 ? static_cast<char>(type) : '?',
+                h.count(), ns(50.0), ns(90.0), ns(99.0), ns(99.9),
+                clock.to_ns(h.max()));
+  });
+}
+
+void print_market_by_order(const book::MarketByOrderStats &stats) {
+  std::printf("\n=== Market-by-Order Events ===\n");
+  std::printf("Adds (A/F):           %12" PRIu64 "\n", stats.adds);
+  std::printf("Executions (E/C):     %12" PRIu64 "\n", stats.executions);
+  std::printf("Partial Cancels (X):  %12" PRIu64 "\n", stats.cancels);
+  std::printf("Deletes (D):          %12" PRIu64 "\n", stats.deletes);
+  std::printf("Replaces (U):         %12" PRIu64 "\n", stats.replaces);
+  std::printf("Rejected (A/F/U):     %12" PRIu64 "\n", stats.rejected);
+  std::printf("Unknown Order Refs:   %12" PRIu64 "\n", stats.unknown);
+}
+
 // ============================================================================
-// ReplayVisitor - The Bridge between Parser and OrderBook
+// ReplayVisitor - The Bridge between Parser and OrderBook (match mode)
 // ============================================================================
 
 /**
- * @brief Visitor that forwards ITCH messages to the OrderBook.
+ * @brief Visitor that forwards ITCH messages to the per-symbol books.
  *
  * Design:
  * - Inherits from DefaultVisitor for no-op handling of uninterested messages
- * - Holds reference to OrderBook for order management
+ * - Routes each message to its stock_locate's book via BookManager
  * - Collects metrics for performance analysis
  * - Simulation: Every 100th order is made marketable to trigger matching
  *
- * @tparam Capacity Pool capacity for the OrderBook
+ * @tparam Book Book engine (OrderBook or LadderOrderBook)
  */
-template <std::size_t Capacity>
-class ReplayVisitor : public itch::DefaultVisitor {
+template <typename Book> class ReplayVisitor : public itch::DefaultVisitor {
 public:
-  using BookType = book::OrderBook<Capacity>;
+  using BookType = Book;
+  using Manager = book::BookManager<Book>;
 
-  ReplayVisitor(BookType &book, ReplayMetrics &metrics) noexcept
-      : book_(book), metrics_(metrics), simulated_order_id_(1) {}
+  ReplayVisitor(Manager &books, ReplayMetrics &metrics) noexcept
+      : books_(books), metrics_(metrics), simulated_order_id_(1) {}
 
   /**
    * @brief Handle Add Order messages (Type 'A').
@@ -93,6 +246,7 @@ public:
    */
   void on_add_order(const itch::AddOrder &msg) {
     ++metrics_.orders_processed;
+    BookType &book = books_.book(msg.stock_locate);
 
     // FIX: Generate unique ID to bypass duplicate check in stress tests
     // The template PCAP repeats the same order_ref, causing all but first to be
@@ -110,13 +264,13 @@ public:
       // Make price marketable (cross the spread)
       if (side == book::Side::Buy) {
         // Aggressive buy: price above best ask
-        auto best_ask = book_.best_ask();
+        auto best_ask = book.best_ask();
         if (best_ask) {
           price = *best_ask + 100; // 1 cent above best ask
         }
       } else {
         // Aggressive sell: price below best bid
-        auto best_bid = book_.best_bid();
+        auto best_bid = book.best_bid();
         if (best_bid) {
           price =
               (*best_bid > 100) ? *best_bid - 100 : 0; // 1 cent below best bid
@@ -125,17 +279,10 @@ public:
     }
 
     // Track order count before add to detect matches
-    size_t orders_before = book_.order_count();
+    size_t orders_before = book.order_count();
 
-    // Time the add_order call
-    auto start = std::chrono::high_resolution_clock::now();
-
-    bool added = book_.add_order(id, price, qty, side);
-
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration =
-        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
-    metrics_.add_order_time_ns += static_cast<uint64_t>(duration.count());
+    // Latency is recorded per message by the replay loop (LatencyRecorder)
+    bool added = book.add_order(id, price, qty, side);
 
     if (added) {
       ++metrics_.orders_added;
@@ -143,7 +290,7 @@ public:
       // Check if matching occurred by comparing order counts
       // If orders_before decreased or stayed same but we added, matches
       // happened
-      size_t orders_after = book_.order_count();
+      size_t orders_after = book.order_count();
       if (orders_after <= orders_before && orders_before > 0) {
         // At least one match occurred (filled orders were removed)
         ++metrics_.matches_executed;
@@ -160,93 +307,261 @@ public:
   void on_order_executed(const itch::OrderExecuted &msg) {
     uint64_t id = static_cast<uint64_t>(msg.order_ref);
 
-    if (book_.cancel_order(id)) {
+    BookType *book = books_.find(msg.stock_locate);
+    if (book != nullptr && book->cancel_order(id)) {
       ++metrics_.orders_cancelled;
     }
   }
 
 private:
-  BookType &book_;
+  Manager &books_;
   ReplayMetrics &metrics_;
   uint64_t simulated_order_id_; ///< Counter for generating unique order IDs
 };
 
 // ============================================================================
-// ITCH Payload Detection (reused from main.cpp)
+// ArbitratedFeed - Bridge between LineArbitrator and a Message Handler
 // ============================================================================
 
-/// Valid ITCH message types
-bool is_valid_itch_type(char c) {
-  // Order messages
-  if (c == 'A' || c == 'F' || c == 'E' || c == 'C' || c == 'X' || c == 'D' ||
-      c == 'U')
-    return true;
-  // Trade messages
-  if (c == 'P' || c == 'Q' || c == 'B')
-    return true;
-  // System/stock messages
-  if (c == 'S' || c == 'R' || c == 'H' || c == 'Y' || c == 'L')
-    return true;
-  // Net order imbalance
-  if (c == 'I' || c == 'N')
-    return true;
-  // MWCB and IPO
-  if (c == 'V' || c == 'W' || c == 'K')
-    return true;
-  return false;
+/**
+ * @brief Arbitrator handler that forwards each winning message.
+ *
+ * Gaps are printed to stderr (the first MAX_GAPS_REPORTED of them) and
+ * otherwise only counted in the arbitrator's statistics.
+ *
+ * @tparam Handler Callable as handler(const char* msg, size_t len)
+ */
+template <typename Handler> class ArbitratedFeed {
+public:
+  explicit ArbitratedFeed(Handler &handler) noexcept : handler_(handler) {}
+
+  void on_message(const char *msg, size_t len, uint64_t /*sequence*/) {
+    handler_(msg, len);
+  }
+
+  void on_gap(uint64_t first_sequence, uint64_t count) {
+    if (gaps_reported_++ < MAX_GAPS_REPORTED) {
+      std::fprintf(stderr,
+                   "Gap: sequence %" PRIu64 "..%" PRIu64
+                   " lost on both lines\n",
+                   first_sequence, first_sequence + count - 1);
+    }
+  }
+
+private:
+  Handler &handler_;
+  uint64_t gaps_reported_ = 0;
+};
+
+void print_arbitration(const itch::ArbitrationStats &stats) {
+  std::printf("\n=== A/B Arbitration ===\n");
+  std::printf("Messages Delivered:   %12" PRIu64 "\n", stats.delivered);
+  std::printf("  won by line A:      %12" PRIu64 "\n",
+              stats.delivered_from[0]);
+  std::printf("  won by line B:      %12" PRIu64 "\n",
+              stats.delivered_from[1]);
+  std::printf("Duplicates Dropped:   %12" PRIu64 "\n", stats.duplicates);
+  std::printf("Unrecoverable Gaps:   %12" PRIu64 " (%" PRIu64 " messages)\n",
+              stats.gaps, stats.gap_messages);
+  std::printf("Peak Reorder Buffer:  %12" PRIu64 " / %zu\n",
+              stats.max_buffered, ARBITRATION_WINDOW);
 }
 
-/// Find ITCH payload offset within a packet
-size_t find_itch_offset(const char *data, size_t len) {
-  // Common header configurations
-  constexpr size_t OFFSETS[] = {
-      42, // Standard: Ethernet(14) + IP(20) + UDP(8)
-      46, // With VLAN tag
-      62, // Standard + MoldUDP header
-      64, // Standard + MoldUDP + length prefix
-      66, // VLAN + MoldUDP header
-      68, // VLAN + MoldUDP + length prefix
-  };
+// ============================================================================
+// ReplayInput - PCAP, BinaryFILE or Arbitrated A/B Source
+// ============================================================================
 
-  // Try each known offset
-  for (size_t offset : OFFSETS) {
-    if (offset < len) {
-      char msg_type = data[offset];
-      if (is_valid_itch_type(msg_type)) {
-        // Additional validation: check stock_locate is reasonable
-        if (len >= offset + 3) {
-          uint16_t stock_locate = static_cast<uint16_t>(
-              (static_cast<uint8_t>(data[offset + 1]) << 8) |
-              static_cast<uint8_t>(data[offset + 2]));
-          if (stock_locate > 0 && stock_locate < 10000) {
-            return offset;
-          }
-        }
-        return offset;
+/**
+ * @brief Owns the mapped input file(s) and walks their ITCH messages.
+ *
+ * Messages are views into the mappings, so they stay valid for the
+ * lifetime of the ReplayInput (which the sharded replay relies on).
+ * A streamed or io_uring PCAP is the exception: its messages are valid
+ * only until the handler returns.
+ */
+class ReplayInput {
+public:
+  /**
+   * @brief Open the A line (PCAP or BinaryFILE) and optional B line.
+   * @param config How a PCAP A line is read (whole, windowed, io_uring)
+   * @return false (after printing an error) if either cannot be used
+   */
+  bool open(const char *input_file, const char *line_b_file,
+            const InputConfig &config = {}) {
+    // PCAP if the magic number matches, BinaryFILE otherwise
+    std::printf("Opening file: %s\n", input_file);
+    if (config.uring) {
+      uring_ = is_pcap_ = uring_reader_.open(input_file);
+    } else if (config.stream_window != 0) {
+      is_pcap_ = reader_.open(input_file, itch::PcapMapping::Window,
+                              config.stream_window);
+    } else {
+      is_pcap_ = reader_.open(input_file);
+    }
+    if (!is_pcap_ && !binary_reader_.open(input_file)) {
+      std::fprintf(stderr, "Error: Failed to open file: %s\n", input_file);
+      return false;
+    }
+
+    if (is_pcap_) {
+      const uint32_t network =
+          uring_ ? uring_reader_.link_type() : reader_.link_type();
+      if (!check_link_type(input_file, network)) {
+        return false;
+      }
+      link_ = static_cast<itch::LinkType>(network);
+    }
+
+    if (line_b_file != nullptr) {
+      std::printf("Opening B line: %s\n", line_b_file);
+      if (!is_pcap_ || !reader_b_.open(line_b_file)) {
+        std::fprintf(stderr, "Error: A/B arbitration needs two PCAP files\n");
+        return false;
+      }
+      if (!check_link_type(line_b_file, reader_b_.link_type())) {
+        return false;
       }
     }
-  }
 
-  // Fallback: Search first 100 bytes
-  constexpr size_t SEARCH_LIMIT = 100;
-  size_t search_end = (len < SEARCH_LIMIT) ? len : SEARCH_LIMIT;
+    std::printf("  Format: %s\n", is_pcap_ ? "PCAP" : "BinaryFILE");
+    if (is_pcap_ && reader_.mapping() == itch::PcapMapping::Window) {
+      std::printf("  Mapping: %.0f MB sliding window\n",
+                  reader_.window_bytes() / (1024.0 * 1024.0));
+    }
+    if (uring_) {
+      const itch::BlockFileReader &blocks = uring_reader_.blocks();
+      std::printf("  Reader: %s, %s I/O, %u x %zu KB blocks\n",
+                  blocks.backend() == itch::ReadBackend::IoUring
+                      ? (blocks.registered_buffers() ? "io_uring (fixed)"
+                                                     : "io_uring")
+                      : "pread (io_uring unavailable)",
+                  blocks.direct_io() ? "direct" : "cached",
+                  blocks.queue_depth(), blocks.block_bytes() >> 10);
+    }
+    std::printf("  File size: %.2f MB\n\n", file_size() / (1024.0 * 1024.0));
+    return true;
+  }
 
-  for (size_t offset = 0; offset < search_end; ++offset) {
-    char msg_type = data[offset];
-    if (is_valid_itch_type(msg_type)) {
-      if (len >= offset + 3) {
-        uint16_t stock_locate = static_cast<uint16_t>(
-            (static_cast<uint8_t>(data[offset + 1]) << 8) |
-            static_cast<uint8_t>(data[offset + 2]));
-        if (stock_locate > 0 && stock_locate < 10000) {
-          return offset;
+  /**
+   * @brief Call handler(msg, len) for every ITCH message, in feed order.
+   * @return Packets (PCAP) or messages (BinaryFILE) read
+   */
+  template <typename Handler> size_t for_each_message(Handler &&handler) {
+    if (arbitrated()) {
+      // A/B: interleave both captures, first copy of each sequence wins
+      ArbitratedFeed<std::remove_reference_t<Handler>> feed(handler);
+      return itch::merge_lines(reader_, reader_b_, arbitrator_, feed);
+    }
+    if (is_pcap_) {
+      auto on_packet = [&](const char *data, size_t len) {
+        // Decode Ethernet/VLAN/IPv4/UDP/MoldUDP64, then each message block
+        itch::MoldPacket packet;
+        if (itch::decode_frame(data, len, packet, link_) ==
+            itch::DecodeResult::Ok) {
+          (void)itch::for_each_message(
+              packet, [&](const char *msg, size_t msg_len, uint64_t) {
+                handler(msg, msg_len);
+              });
         }
-      }
+      };
+      return uring_ ? uring_reader_.for_each_packet(on_packet)
+                    : reader_.for_each_packet(on_packet);
     }
+    // BinaryFILE: one framed message per callback, no headers to skip
+    return binary_reader_.for_each_message(handler);
+  }
+
+  [[nodiscard]] bool is_pcap() const noexcept { return is_pcap_; }
+
+  /**
+   * @brief True if the last for_each_message() stopped at a read error
+   *        (only block reads can fail once the input is open).
+   */
+  [[nodiscard]] bool read_failed() const noexcept {
+    return uring_ && uring_reader_.read_failed();
+  }
+
+  [[nodiscard]] bool arbitrated() const noexcept {
+    return reader_b_.is_open();
+  }
+
+  [[nodiscard]] size_t file_size() const noexcept {
+    const size_t a_size = uring_     ? uring_reader_.file_size()
+                          : is_pcap_ ? reader_.file_size()
+                                     : binary_reader_.file_size();
+    return a_size + reader_b_.file_size();
+  }
+
+  [[nodiscard]] const itch::ArbitrationStats &arbitration() const noexcept {
+    return arbitrator_.stats();
+  }
+
+private:
+  /// Print an error unless decode_frame() can read `network` frames
+  static bool check_link_type(const char *file, uint32_t network) {
+    if (itch::is_supported_link_type(network)) {
+      return true;
+    }
+    std::fprintf(stderr, "Error: Unsupported PCAP link type %u: %s\n",
+                 network, file);
+    return false;
+  }
+
+  itch::PcapReader reader_;
+  itch::PcapReader reader_b_;
+  itch::UringPcapReader uring_reader_;
+  itch::BinaryFileReader binary_reader_;
+  Arbitrator arbitrator_;
+  bool is_pcap_ = false;
+  bool uring_ = false; ///< A line read by uring_reader_
+  itch::LinkType link_ = itch::LinkType::Ethernet; ///< A line's frames
+};
+
+/**
+ * @brief Print throughput lines shared by every replay mode.
+ * @return Elapsed microseconds (for mode-specific rates)
+ */
+int64_t print_performance(const ReplayInput &input, size_t packet_count,
+                          std::chrono::microseconds duration) {
+  std::printf("\n=== Performance ===\n");
+  const bool is_pcap = input.is_pcap();
+  std::printf("%s processed: %zu\n", is_pcap ? "Packets" : "Messages",
+              packet_count);
+  std::printf("Total time: %.3f ms\n", duration.count() / 1000.0);
+
+  if (duration.count() > 0) {
+    double packets_per_sec = packet_count * 1e6 / duration.count();
+    std::printf("Throughput: %.2f million %s/sec\n", packets_per_sec / 1e6,
+                is_pcap ? "packets" : "messages");
+  }
+  return duration.count();
+}
+
+void print_event_rate(uint64_t events, int64_t duration_us) {
+  if (duration_us <= 0) {
+    return;
+  }
+  std::printf("Event Rate: %.2f million order events/sec",
+              events * 1e6 / duration_us / 1e6);
+  if (events > 0) {
+    std::printf(" (%.1f ns/event)", duration_us * 1e3 / events);
   }
+  std::printf("\n");
+}
 
-  // Last resort: return 42
-  return 42;
+void print_input_summary(const ReplayInput &input, int64_t duration_us) {
+  if (duration_us > 0) {
+    std::printf("Bandwidth: %.2f MB/sec\n",
+                input.file_size() / (1024.0 * 1024.0) * 1e6 / duration_us);
+  }
+  if (input.arbitrated()) {
+    const itch::ArbitrationStats &stats = input.arbitration();
+    if (duration_us > 0) {
+      std::printf("Message Rate: %.2f million arbitrated msgs/sec\n",
+                  stats.delivered * 1e6 / duration_us / 1e6);
+    }
+    print_arbitration(stats);
+  }
 }
 
 // ============================================================================
@@ -254,133 +569,554 @@ size_t find_itch_offset(const char *data, size_t len) {
 // ============================================================================
 
 void print_usage(const char *program) {
-  std::fprintf(stderr, "Usage: %s [pcap_file]\n", program);
+  std::fprintf(stderr,
+               "Usage: %s [--engine=vector|ladder] [--mode=mbo|match] "
+               "[--line-b=pcap] [--shards=N [--pin[=cpu]]] "
+               "[--numa=node] [--pool-init=lazy|eager] "
+               "[--pool-orders=N] [--stream[=MB]] [--io=mmap|uring] "
+               "[pcap_or_binary_file]\n",
+               program);
   std::fprintf(stderr, "\nChronos Market Replay Engine\n");
   std::fprintf(stderr,
                "Integrates ITCH parser with OrderBook matching engine.\n");
+  std::fprintf(stderr, "\nEngines:\n");
+  std::fprintf(stderr, "  vector  Sorted price-level vectors (default)\n");
+  std::fprintf(stderr, "  ladder  Tick-indexed ring with occupancy bitmap\n");
+  std::fprintf(stderr, "\nModes:\n");
+  std::fprintf(stderr, "  mbo    Market-by-order: apply A/F/E/C/X/D/U by "
+                       "order_ref (default)\n");
+  std::fprintf(stderr, "  match  Run adds through the matching engine "
+                       "(simulation)\n");
+  std::fprintf(stderr, "\nOptions:\n");
+  std::fprintf(stderr, "  --line-b=pcap  Redundant B-line capture; the input\n"
+                       "                 is line A and both are arbitrated on\n"
+                       "                 MoldUDP64 sequence numbers\n");
+  std::fprintf(stderr, "  --shards=N     mbo only: route messages by\n"
+                       "                 stock_locate to N worker threads,\n"
+                       "                 each with its own books and pool\n"
+                       "                 (1..%zu)\n",
+               MAX_SHARDS);
+  std::fprintf(stderr, "  --pin[=cpu]    Pin the router to cpu (default 0)\n"
+                       "                 and worker i to cpu + 1 + i\n");
+  std::fprintf(stderr, "  --numa=node    Bind order pools to a NUMA node\n");
+  std::fprintf(stderr, "  --pool-init=lazy|eager\n"
+                       "                 Fault pool pages in as books grow\n"
+                       "                 (default) or all before replay\n");
+  std::fprintf(stderr, "  --pool-orders=N\n"
+                       "                 Orders each pool reserves up front\n"
+                       "                 (default %zu); pools grow by %zu\n"
+                       "                 when full\n",
+               DEFAULT_POOL_ORDERS, POOL_SEGMENT_ORDERS);
+  std::fprintf(stderr, "  --stream[=MB]  Map a PCAP input through a sliding\n"
+                       "                 window (default %zu MB) instead of\n"
+                       "                 whole, for captures larger than RAM\n",
+               itch::PcapReader::kDefaultWindowBytes >> 20);
+  std::fprintf(stderr, "  --io=mmap|uring\n"
+                       "                 Map a PCAP input (default) or read\n"
+                       "                 it with io_uring direct I/O, several\n"
+                       "                 blocks in flight (pread if io_uring\n"
+                       "                 is unavailable)\n");
+  std::fprintf(stderr,
+               "\nInput is read as PCAP when the magic number matches,\n");
+  std::fprintf(stderr,
+               "otherwise as a NASDAQ BinaryFILE (length-prefixed).\n");
   std::fprintf(stderr, "\nDefault PCAP: %s\n", DEFAULT_PCAP);
 }
 
-} // anonymous namespace
-
 // ============================================================================
-// Main Driver
+// Replay Run (single thread)
 // ============================================================================
 
-int main(int argc, char *argv[]) {
-  // Parse arguments
-  const char *pcap_file = (argc >= 2) ? argv[1] : DEFAULT_PCAP;
-
-  if (argc > 2 || (argc == 2 && (std::string(argv[1]) == "-h" ||
-                                 std::string(argv[1]) == "--help"))) {
-    print_usage(argv[0]);
-    return (argc > 2) ? 1 : 0;
+/**
+ * @brief Resident set size of this process in MB (0 if unavailable).
+ */
+double resident_mb() {
+#if defined(__linux__)
+  std::FILE *statm = std::fopen("/proc/self/statm", "r");
+  if (statm == nullptr) {
+    return 0.0;
   }
+  unsigned long total_pages = 0;
+  unsigned long resident_pages = 0;
+  const int fields = std::fscanf(statm, "%lu %lu", &total_pages,
+                                 &resident_pages);
+  std::fclose(statm);
+  if (fields != 2) {
+    return 0.0;
+  }
+  return static_cast<double>(resident_pages) *
+         static_cast<double>(::sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+#else
+  return 0.0;
+#endif
+}
 
-  std::printf(
-      "╔══════════════════════════════════════════════════════════════╗\n");
-  std::printf(
-      "║           CHRONOS - Market Replay Engine                     ║\n");
-  std::printf(
-      "║   Zero-Copy ITCH Parser + High-Frequency Matching Engine     ║\n");
-  std::printf(
-      "╚══════════════════════════════════════════════════════════════╝\n\n");
+/**
+ * @brief Time and RSS cost of building the order pool(s).
+ */
+struct PoolStartup {
+  double rss_before_mb = 0.0;
+  std::chrono::steady_clock::time_point start;
 
-  // ============================================================================
-  // Initialize Components
-  // ============================================================================
+  PoolStartup()
+      : rss_before_mb(resident_mb()), start(std::chrono::steady_clock::now()) {}
+
+  void print() const {
+    const double ms = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+    std::printf("  Pool Construction: %.3f ms (RSS %.1f MB -> %.1f MB)\n", ms,
+                rss_before_mb, resident_mb());
+  }
+};
 
-  std::printf("Initializing Memory Pool (Capacity: %zu orders)...\n",
-              POOL_CAPACITY);
-  book::MemPool<book::Order, POOL_CAPACITY> pool;
-  std::printf("  Pool Memory: %.2f MB\n",
-              (POOL_CAPACITY * sizeof(book::Order)) / (1024.0 * 1024.0));
+/**
+ * @brief Storage for `orders` pool slots in MB.
+ */
+double orders_mb(std::size_t orders) {
+  return static_cast<double>(orders * sizeof(book::Order)) /
+         (1024.0 * 1024.0);
+}
+
+/**
+ * @brief Report how a pool was built and the NUMA binding it obtained.
+ */
+void print_pool_placement(const PoolType &pool, const PoolConfig &config) {
+  std::printf("  Pool Backing: %s, %s\n",
+              book::page_backing_name(pool.page_backing()),
+              pool.lazy() ? "lazy (faulted in on use)" : "eager (pre-faulted)");
+  if (config.placement.numa_node >= 0) {
+    std::printf("  NUMA Node: %d (%s)\n", config.placement.numa_node,
+                pool.numa_bound() ? "bound" : "binding failed");
+  }
+}
 
-  std::printf("Initializing OrderBook...\n");
-  book::OrderBook<POOL_CAPACITY> book(pool);
+/**
+ * @brief Replay a capture through the given book engine on this thread.
+ *
+ * @param line_b_file Optional B-line capture to arbitrate against input_file.
+ * @param mode Market-by-order or matching simulation
+ * @param pool_config Order pool initialization and NUMA placement
+ * @param input_config How the PCAP input is read
+ * @tparam Book Book engine over PoolType
+ * @return Process exit code
+ */
+template <typename Book>
+int run_replay(const char *input_file, const char *line_b_file,
+               ReplayMode mode, const PoolConfig &pool_config,
+               const InputConfig &input_config) {
+  const bool passive = mode == ReplayMode::MarketByOrder;
 
-  std::printf("Opening PCAP file: %s\n", pcap_file);
-  itch::PcapReader reader(pcap_file);
+  std::printf("Initializing Memory Pool (Initial: %zu orders, grows by "
+              "%zu)...\n",
+              pool_config.reserved_orders(), POOL_SEGMENT_ORDERS);
+  const PoolStartup startup;
+  PoolType pool(pool_config.initial_orders, PoolType::kUnbounded,
+                pool_config.placement, pool_config.init);
+  startup.print();
+  std::printf("  Pool Memory: %.2f MB\n", orders_mb(pool.capacity()));
+  print_pool_placement(pool, pool_config);
+  std::printf("Initializing BookManager (one book per stock_locate)...\n");
+  book::BookManager<Book> books(pool);
 
-  if (!reader.is_open()) {
-    std::fprintf(stderr, "Error: Failed to open PCAP file: %s\n", pcap_file);
+  ReplayInput input;
+  if (!input.open(input_file, line_b_file, input_config)) {
     return 1;
   }
 
-  std::printf("  File size: %.2f MB\n\n",
-              reader.file_size() / (1024.0 * 1024.0));
-
   // ============================================================================
   // Run Replay
   // ============================================================================
 
   std::printf("Starting market replay...\n");
-  std::printf("  Match trigger interval: every %luth order\n\n",
-              static_cast<unsigned long>(MATCH_TRIGGER_INTERVAL));
+  if (passive) {
+    std::printf("  Mode: market-by-order (exchange events, no matching)\n\n");
+  } else {
+    std::printf("  Mode: matching simulation\n");
+    std::printf("  Match trigger interval: every %luth order\n\n",
+                static_cast<unsigned long>(MATCH_TRIGGER_INTERVAL));
+  }
 
   ReplayMetrics metrics;
-  ReplayVisitor<POOL_CAPACITY> visitor(book, metrics);
+  ReplayVisitor<Book> matcher(books, metrics);
+  book::MarketByOrderVisitor<Book> mbo(books);
   itch::Parser parser;
+  LatencyRecorder latency;
 
-  auto start_time = std::chrono::high_resolution_clock::now();
+  // Drive one visitor over whichever input was opened
+  auto replay = [&](auto &visitor) -> size_t {
+    return input.for_each_message([&](const char *msg, size_t len) {
+      const uint64_t start = latency.start();
+      (void)parser.parse(msg, len, visitor);
+      latency.stop(message_type(msg, len), start);
+    });
+  };
 
-  size_t packet_count =
-      reader.for_each_packet([&](const char *data, size_t len) {
-        // Find ITCH payload offset (skip network headers)
-        size_t offset = find_itch_offset(data, len);
+  auto start_time = std::chrono::high_resolution_clock::now();
 
-        if (offset < len) {
-          const char *itch_data = data + offset;
-          size_t itch_len = len - offset;
-          (void)parser.parse_buffer(itch_data, itch_len, visitor);
-        }
-      });
+  const size_t packet_count = passive ? replay(mbo) : replay(matcher);
 
   auto end_time = std::chrono::high_resolution_clock::now();
   auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
       end_time - start_time);
+  if (input.read_failed()) {
+    std::fprintf(stderr, "Error: Read failed after %zu packets: %s\n",
+                 packet_count, input_file);
+    return 1;
+  }
 
   // ============================================================================
   // Print Results
   // ============================================================================
 
-  std::printf("\n=== Performance ===\n");
-  std::printf("Packets processed: %zu\n", packet_count);
-  std::printf("Total time: %.3f ms\n", duration.count() / 1000.0);
-
-  if (duration.count() > 0) {
-    double packets_per_sec = packet_count * 1e6 / duration.count();
-    double orders_per_sec = metrics.orders_processed * 1e6 / duration.count();
-    double mb_per_sec =
-        reader.file_size() / (1024.0 * 1024.0) * 1e6 / duration.count();
-
-    std::printf("Throughput: %.2f million packets/sec\n",
-                packets_per_sec / 1e6);
+  const int64_t duration_us = print_performance(input, packet_count, duration);
+  if (passive) {
+    print_event_rate(mbo.stats().messages(), duration_us);
+  } else if (duration_us > 0) {
+    double orders_per_sec = metrics.orders_processed * 1e6 / duration_us;
     std::printf("Order Rate: %.2f million orders/sec\n", orders_per_sec / 1e6);
-    std::printf("Bandwidth: %.2f MB/sec\n", mb_per_sec);
   }
+  print_input_summary(input, duration_us);
 
-  metrics.print();
+  if (passive) {
+    print_market_by_order(mbo.stats());
+  } else {
+    metrics.print();
+  }
+  print_latency(latency);
 
   // Final book state
   std::printf("\n=== Final Book State ===\n");
-  std::printf("Orders Resting: %zu\n", book.order_count());
-  std::printf("Bid Levels: %zu\n", book.bid_level_count());
-  std::printf("Ask Levels: %zu\n", book.ask_level_count());
+  std::printf("Books (symbols): %zu\n", books.book_count());
+  std::printf("Orders Resting: %zu\n", books.order_count());
 
-  if (book.best_bid()) {
-    std::printf("Best Bid: %.4f\n", *book.best_bid() / 10000.0);
+  std::size_t listed = 0;
+  books.for_each_book([&](uint16_t locate, const Book &book) {
+    if (listed++ >= MAX_BOOKS_REPORTED) {
+      return;
+    }
+    std::printf("  locate %5u: %zu orders, %zu bid / %zu ask levels",
+                static_cast<unsigned>(locate), book.order_count(),
+                book.bid_level_count(), book.ask_level_count());
+    if (book.best_bid()) {
+      std::printf(", bid %.4f", *book.best_bid() / 10000.0);
+    }
+    if (book.best_ask()) {
+      std::printf(", ask %.4f", *book.best_ask() / 10000.0);
+    }
+    std::printf("\n");
+  });
+  if (books.book_count() > MAX_BOOKS_REPORTED) {
+    std::printf("  ... %zu more\n", books.book_count() - MAX_BOOKS_REPORTED);
   }
-  if (book.best_ask()) {
-    std::printf("Best Ask: %.4f\n", *book.best_ask() / 10000.0);
+
+  std::printf("\nPool Utilization: %.2f%% (%zu / %zu)\n",
+              100.0 * pool.allocated() / pool.capacity(), pool.allocated(),
+              pool.capacity());
+  std::printf("Pool High Water: %zu orders\n", pool.high_water_mark());
+  std::printf("Pool Segments: %zu (%.2f MB)\n", pool.segment_count(),
+              orders_mb(pool.capacity()));
+  std::printf("RSS After Replay: %.1f MB\n", resident_mb());
+
+  return 0;
+}
+
+// ============================================================================
+// Sharded Replay (router thread + one worker per shard)
+// ============================================================================
+
+/**
+ * @brief Everything one worker owns: its pool, books, visitor and parser.
+ *
+ * Shards never share state, so the worker applies events with no
+ * synchronisation beyond its inbound ring.
+ */
+template <typename Book> class ReplayShard {
+public:
+  explicit ReplayShard(const PoolConfig &config)
+      : pool_(config.initial_orders, PoolType::kUnbounded, config.placement,
+              config.init),
+        books_(pool_),
+        visitor_(books_) {}
+
+  void on_message(const char *msg, size_t len) {
+    const uint64_t start = latency_.start();
+    (void)parser_.parse(msg, len, visitor_);
+    latency_.stop(message_type(msg, len), start);
   }
-  if (book.spread()) {
-    std::printf("Spread: %.4f\n", *book.spread() / 10000.0);
+
+  [[nodiscard]] const book::MarketByOrderStats &stats() const noexcept {
+    return visitor_.stats();
   }
 
-  std::printf("\nPool Utilization: %.2f%% (%zu / %zu)\n",
-              100.0 * pool.allocated() / POOL_CAPACITY, pool.allocated(),
-              POOL_CAPACITY);
+  [[nodiscard]] const book::BookManager<Book> &books() const noexcept {
+    return books_;
+  }
+
+  [[nodiscard]] const PoolType &pool() const noexcept { return pool_; }
+
+  [[nodiscard]] const LatencyRecorder &latency() const noexcept {
+    return latency_;
+  }
+
+private:
+  PoolType pool_;
+  book::BookManager<Book> books_;
+  book::MarketByOrderVisitor<Book> visitor_;
+  itch::Parser parser_;
+  LatencyRecorder latency_;
+};
+
+void accumulate(book::MarketByOrderStats &total,
+                const book::MarketByOrderStats &shard) {
+  total.adds += shard.adds;
+  total.executions += shard.executions;
+  total.cancels += shard.cancels;
+  total.deletes += shard.deletes;
+  total.replaces += shard.replaces;
+  total.rejected += shard.rejected;
+  total.unknown += shard.unknown;
+}
+
+/**
+ * @brief Market-by-order replay split across `shard_count` worker threads.
+ *
+ * The calling thread reads and routes; workers parse and apply. Each shard
+ * owns a disjoint set of stock_locates and its own growable pool.
+ *
+ * @tparam Book Book engine over PoolType
+ * @return Process exit code
+ */
+template <typename Book>
+int run_sharded(const char *input_file, const char *line_b_file,
+                std::size_t shard_count, pipeline::PinPolicy pin,
+                const PoolConfig &pool_config) {
+  using Shard = ReplayShard<Book>;
+
+  std::printf("Initializing %zu shards (pool: %zu orders, %.2f MB each)...\n",
+              shard_count, pool_config.reserved_orders(),
+              orders_mb(pool_config.reserved_orders()));
+  const PoolStartup startup;
+  std::vector<std::unique_ptr<Shard>> shards;
+  shards.reserve(shard_count);
+  for (std::size_t i = 0; i < shard_count; ++i) {
+    shards.push_back(std::make_unique<Shard>(pool_config));
+  }
+  startup.print();
+  print_pool_placement(shards.front()->pool(), pool_config);
+  pipeline::ShardedPipeline<Shard, SHARD_RING_CAPACITY> sharded(
+      std::move(shards), pin);
+
+  ReplayInput input;
+  if (!input.open(input_file, line_b_file)) {
+    return 1;
+  }
+
+  std::printf("Starting market replay...\n");
+  std::printf("  Mode: market-by-order, %zu shards by stock_locate\n\n",
+              shard_count);
+
+  auto start_time = std::chrono::high_resolution_clock::now();
+
+  if (!sharded.start()) {
+    std::fprintf(stderr, "Warning: could not pin router to cpu %u\n",
+                 pin.first_cpu);
+  }
+  const size_t packet_count = input.for_each_message(
+      [&](const char *msg, size_t len) { sharded.route(msg, len); });
+  sharded.finish();
+
+  auto end_time = std::chrono::high_resolution_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      end_time - start_time);
+
+  // ============================================================================
+  // Print Results
+  // ============================================================================
+
+  book::MarketByOrderStats total;
+  LatencyRecorder latency;
+  for (std::size_t i = 0; i < shard_count; ++i) {
+    accumulate(total, sharded.shard(i).stats());
+    latency.merge(sharded.shard(i).latency());
+  }
+
+  const int64_t duration_us = print_performance(input, packet_count, duration);
+  print_event_rate(total.messages(), duration_us);
+  print_input_summary(input, duration_us);
+
+  std::printf("\n=== Shards ===\n");
+  std::printf("Shard    Messages  M msgs/sec   Books    Orders  Pool %%"
+              "    Stalls  Pinned\n");
+  std::size_t book_count = 0;
+  std::size_t order_count = 0;
+  for (std::size_t i = 0; i < shard_count; ++i) {
+    const pipeline::ShardStats &stats = sharded.stats(i);
+    const Shard &shard = sharded.shard(i);
+    book_count += shard.books().book_count();
+    order_count += shard.books().order_count();
+    std::printf("%5zu %11" PRIu64 " %11.2f %7zu %9zu %6.2f %9" PRIu64
+                "  %s\n",
+                i, stats.messages, stats.message_rate() / 1e6,
+                shard.books().book_count(), shard.books().order_count(),
+                100.0 * shard.pool().allocated() / shard.pool().capacity(),
+                stats.stalls,
+                pin.enabled ? (stats.pinned ? "yes" : "failed") : "no");
+  }
+
+  print_market_by_order(total);
+  print_latency(latency);
+
+  std::printf("\n=== Final Book State ===\n");
+  std::printf("Books (symbols): %zu\n", book_count);
+  std::printf("Orders Resting: %zu\n", order_count);
 
   return 0;
 }
+
+} // anonymous namespace
+
+// ============================================================================
+// Main Driver
+// ============================================================================
+
+int main(int argc, char *argv[]) {
+  // Parse arguments
+  const char *input_file = DEFAULT_PCAP;
+  const char *line_b_file = nullptr;
+  ReplayMode mode = ReplayMode::MarketByOrder;
+  bool use_ladder = false;
+  std::size_t shard_count = 0;
+  pipeline::PinPolicy pin;
+  PoolConfig pool_config;
+  InputConfig input_config;
+  int positional = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    if (std::strcmp(arg, "-h") == 0 || std::strcmp(arg, "--help") == 0) {
+      print_usage(argv[0]);
+      return 0;
+    }
+    if (std::strcmp(arg, "--engine=ladder") == 0) {
+      use_ladder = true;
+    } else if (std::strcmp(arg, "--engine=vector") == 0) {
+      use_ladder = false;
+    } else if (std::strcmp(arg, "--mode=mbo") == 0) {
+      mode = ReplayMode::MarketByOrder;
+    } else if (std::strcmp(arg, "--mode=match") == 0) {
+      mode = ReplayMode::Match;
+    } else if (std::strncmp(arg, "--line-b=", 9) == 0 && arg[9] != '\0') {
+      line_b_file = arg + 9;
+    } else if (std::strncmp(arg, "--shards=", 9) == 0) {
+      char *end = nullptr;
+      const unsigned long n = std::strtoul(arg + 9, &end, 10);
+      if (end == arg + 9 || *end != '\0' || n == 0 || n > MAX_SHARDS) {
+        print_usage(argv[0]);
+        return 1;
+      }
+      shard_count = n;
+    } else if (std::strcmp(arg, "--pin") == 0) {
+      pin.enabled = true;
+    } else if (std::strncmp(arg, "--pin=", 6) == 0) {
+      char *end = nullptr;
+      const unsigned long cpu = std::strtoul(arg + 6, &end, 10);
+      if (end == arg + 6 || *end != '\0') {
+        print_usage(argv[0]);
+        return 1;
+      }
+      pin.enabled = true;
+      pin.first_cpu = static_cast<unsigned>(cpu);
+    } else if (std::strncmp(arg, "--numa=", 7) == 0) {
+      char *end = nullptr;
+      const unsigned long node = std::strtoul(arg + 7, &end, 10);
+      if (end == arg + 7 || *end != '\0' || node > 63) {
+        print_usage(argv[0]);
+        return 1;
+      }
+      pool_config.placement.numa_node = static_cast<int>(node);
+    } else if (std::strcmp(arg, "--pool-init=lazy") == 0) {
+      pool_config.init = book::PoolInit::Lazy;
+    } else if (std::strcmp(arg, "--pool-init=eager") == 0) {
+      pool_config.init = book::PoolInit::Eager;
+    } else if (std::strncmp(arg, "--pool-orders=", 14) == 0) {
+      char *end = nullptr;
+      const unsigned long long orders = std::strtoull(arg + 14, &end, 10);
+      if (end == arg + 14 || *end != '\0' || orders == 0) {
+        print_usage(argv[0]);
+        return 1;
+      }
+      pool_config.initial_orders = static_cast<std::size_t>(orders);
+    } else if (std::strcmp(arg, "--stream") == 0) {
+      input_config.stream_window = itch::PcapReader::kDefaultWindowBytes;
+    } else if (std::strncmp(arg, "--stream=", 9) == 0) {
+      char *end = nullptr;
+      const unsigned long mb = std::strtoul(arg + 9, &end, 10);
+      if (end == arg + 9 || *end != '\0' || mb == 0 || mb > 65536) {
+        print_usage(argv[0]);
+        return 1;
+      }
+      input_config.stream_window = static_cast<size_t>(mb) << 20;
+    } else if (std::strcmp(arg, "--io=mmap") == 0) {
+      input_config.uring = false;
+    } else if (std::strcmp(arg, "--io=uring") == 0) {
+      input_config.uring = true;
+    } else if (arg[0] != '-' && positional == 0) {
+      input_file = arg;
+      ++positional;
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (shard_count > 0 && mode != ReplayMode::MarketByOrder) {
+    std::fprintf(stderr, "Error: --shards requires --mode=mbo (the matching "
+                         "simulation numbers orders globally)\n");
+    return 1;
+  }
+  if (pin.enabled && shard_count == 0) {
+    std::fprintf(stderr, "Error: --pin requires --shards=N\n");
+    return 1;
+  }
+  if (input_config.stream_window != 0 && input_config.uring) {
+    std::fprintf(stderr, "Error: --stream and --io=uring are alternatives\n");
+    return 1;
+  }
+  if (input_config.transient() &&
+      (shard_count > 0 || line_b_file != nullptr)) {
+    std::fprintf(stderr, "Error: --stream and --io=uring cannot be combined "
+                         "with --shards or --line-b (both hold messages "
+                         "after the reader moves on)\n");
+    return 1;
+  }
+
+  std::printf(
+      "╔══════════════════════════════════════════════════════════════╗\n");
+  std::printf(
+      "║           CHRONOS - Market Replay Engine                     ║\n");
+  std::printf(
+      "║   Zero-Copy ITCH Parser + High-Frequency Matching Engine     ║\n");
+  std::printf(
+      "╚══════════════════════════════════════════════════════════════╝\n\n");
+
+  // ============================================================================
+  // Initialize Components
+  // ============================================================================
+
+  std::printf("Book engine: %s\n", use_ladder ? "ladder" : "vector");
+  std::printf("Book mode: %s\n",
+              mode == ReplayMode::MarketByOrder ? "market-by-order" : "match");
+
+  if (shard_count > 0) {
+    return use_ladder
+               ? run_sharded<LadderBook>(input_file, line_b_file,
+                                         shard_count, pin, pool_config)
+               : run_sharded<VectorBook>(input_file, line_b_file,
+                                         shard_count, pin, pool_config);
+  }
+  return use_ladder ? run_replay<LadderBook>(input_file, line_b_file, mode,
+                                             pool_config, input_config)
+                    : run_replay<VectorBook>(input_file, line_b_file, mode,
+                                             pool_config, input_config);
+}
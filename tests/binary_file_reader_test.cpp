@@ -0,0 +1,113 @@
+/**
+ * @file binary_file_reader_test.cpp
+ * @brief Unit tests for BinaryFileReader (length-prefixed ITCH stream).
+ */
+
+#include <gtest/gtest.h>
+#include <itch/binary_file_reader.hpp>
+#include <itch/parser.hpp>
+
+#include "test_files.hpp"
+
+#include <string>
+#include <vector>
+
+namespace itch::test {
+
+// ============================================================================
+// Test Fixture - writes a temporary BinaryFILE
+// ============================================================================
+
+class BinaryFileReaderTest : public ::testing::Test {
+protected:
+  /// Write `bytes` to the test's temporary file and return its path
+  const char *write_file(const std::vector<unsigned char> &bytes) {
+    return file_.write(bytes);
+  }
+
+  /// Append a length-prefixed, zero-filled message of `type`
+  static void append_message(std::vector<unsigned char> &out, char type) {
+    const size_t size = get_message_size(type);
+    append_be(out, size, 2);
+    out.push_back(static_cast<unsigned char>(type));
+    out.insert(out.end(), size - 1, 0);
+  }
+
+  TempFile file_{"itch_binfile"};
+};
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+TEST_F(BinaryFileReaderTest, MissingFile_FailsToOpen) {
+  BinaryFileReader reader("/nonexistent/itch.bin");
+  EXPECT_FALSE(reader.is_open());
+  EXPECT_EQ(reader.for_each_message([](const char *, size_t) {}), 0u);
+}
+
+TEST_F(BinaryFileReaderTest, WalksLengthPrefixedMessages) {
+  std::vector<unsigned char> bytes;
+  append_message(bytes, 'S');
+  append_message(bytes, 'A');
+  append_message(bytes, 'D');
+  append_message(bytes, 'U');
+
+  BinaryFileReader reader(write_file(bytes));
+  ASSERT_TRUE(reader.is_open());
+  EXPECT_EQ(reader.file_size(), bytes.size());
+
+  std::string types;
+  std::vector<size_t> lengths;
+  const size_t count = reader.for_each_message([&](const char *msg,
+                                                   size_t len) {
+    // Zero-copy: message pointer lies inside the mapping
+    EXPECT_GE(msg, reader.data());
+    EXPECT_LE(msg + len, reader.data() + reader.file_size());
+    types += msg[0];
+    lengths.push_back(len);
+  });
+
+  EXPECT_EQ(count, 4u);
+  EXPECT_EQ(types, "SADU");
+  EXPECT_EQ(lengths, (std::vector<size_t>{12, 36, 19, 35}));
+}
+
+TEST_F(BinaryFileReaderTest, TruncatedTail_IsDropped) {
+  std::vector<unsigned char> bytes;
+  append_message(bytes, 'A');
+  append_message(bytes, 'E');
+  bytes.resize(bytes.size() - 5); // Cut into the second message
+
+  BinaryFileReader reader(write_file(bytes));
+  ASSERT_TRUE(reader.is_open());
+  EXPECT_EQ(reader.for_each_message([](const char *, size_t) {}), 1u);
+}
+
+TEST_F(BinaryFileReaderTest, FeedsParser) {
+  std::vector<unsigned char> bytes;
+  append_message(bytes, 'A');
+  append_message(bytes, 'X');
+  append_message(bytes, 'A');
+
+  struct Counter : DefaultVisitor {
+    int adds = 0;
+    int cancels = 0;
+    void on_add_order(const AddOrder &) { ++adds; }
+    void on_order_cancel(const OrderCancel &) { ++cancels; }
+  };
+
+  BinaryFileReader reader(write_file(bytes));
+  ASSERT_TRUE(reader.is_open());
+
+  Counter visitor;
+  Parser parser;
+  reader.for_each_message([&](const char *msg, size_t len) {
+    EXPECT_EQ(parser.parse(msg, len, visitor), ParseResult::Ok);
+  });
+
+  EXPECT_EQ(visitor.adds, 2);
+  EXPECT_EQ(visitor.cancels, 1);
+}
+
+} // namespace itch::test
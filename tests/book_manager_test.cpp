@@ -0,0 +1,105 @@
+/**
+ * @file book_manager_test.cpp
+ * @brief Tests for BookManager (one book per stock_locate, shared pool).
+ */
+
+#include "book/book_manager.hpp"
+#include "book/compact_order_book.hpp"
+#include "book/ladder_order_book.hpp"
+#include "book/order_book.hpp"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace book;
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+template <typename Book> class BookManagerTest : public ::testing::Test {
+protected:
+  typename Book::PoolType pool_;
+  BookManager<Book> books_{pool_, 4};
+};
+
+constexpr std::size_t kPoolCapacity = 1000;
+using BookTypes = ::testing::Types<OrderBook<kPoolCapacity>,
+                                   LadderOrderBook<kPoolCapacity, 64>,
+                                   CompactOrderBook<kPoolCapacity>>;
+TYPED_TEST_SUITE(BookManagerTest, BookTypes);
+
+// ============================================================================
+// Routing
+// ============================================================================
+
+TYPED_TEST(BookManagerTest, BooksCreatedLazilyPerLocate) {
+  EXPECT_EQ(this->books_.book_count(), 0u);
+  EXPECT_EQ(this->books_.find(7), nullptr);
+
+  ASSERT_TRUE(this->books_.book(7).add_order(1, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(this->books_.book(65535).add_order(2, 500000, 10, Side::Sell));
+
+  EXPECT_EQ(this->books_.book_count(), 2u);
+  EXPECT_NE(this->books_.find(7), nullptr);
+  EXPECT_EQ(this->books_.find(8), nullptr);
+  EXPECT_EQ(this->books_.locates(), (std::vector<uint16_t>{7, 65535}));
+  EXPECT_EQ(&this->books_.book(7), this->books_.find(7));
+}
+
+TYPED_TEST(BookManagerTest, SymbolsDoNotCross) {
+  // Would match if both orders shared one book
+  ASSERT_TRUE(this->books_.book(1).add_order(1, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(this->books_.book(2).add_order(2, 990000, 100, Side::Sell));
+
+  EXPECT_EQ(this->books_.order_count(), 2u);
+  EXPECT_EQ(this->books_.find(1)->best_bid().value(), 1000000u);
+  EXPECT_EQ(this->books_.find(2)->best_ask().value(), 990000u);
+}
+
+TYPED_TEST(BookManagerTest, BooksShareOnePool) {
+  ASSERT_TRUE(this->books_.book(1).add_order(1, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(this->books_.book(2).add_order(2, 1000000, 100, Side::Buy));
+  EXPECT_EQ(this->pool_.allocated(), 2u);
+
+  ASSERT_TRUE(this->books_.find(1)->cancel_order(1));
+  EXPECT_EQ(this->pool_.allocated(), 1u);
+}
+
+TYPED_TEST(BookManagerTest, BusyBookGrowsPastInitialIndexSize) {
+  // Initial index holds 4 orders; a busy symbol must keep accepting
+  auto &book = this->books_.book(42);
+  for (uint64_t id = 1; id <= 100; ++id) {
+    ASSERT_TRUE(book.add_order(id, 1000000 - id * 100, 10, Side::Buy));
+  }
+  EXPECT_EQ(book.order_count(), 100u);
+
+  for (uint64_t id = 1; id <= 100; ++id) {
+    ASSERT_TRUE(book.cancel_order(id));
+  }
+  EXPECT_TRUE(book.empty());
+}
+
+TYPED_TEST(BookManagerTest, ZeroOrdersPerBookStillGrows) {
+  // An index sized for no orders must grow on the first add, not refuse it
+  BookManager<TypeParam> books(this->pool_, 0);
+  auto &book = books.book(1);
+  for (uint64_t id = 1; id <= 20; ++id) {
+    ASSERT_TRUE(book.insert_order(id, 1000000 - id * 100, 10, Side::Buy));
+  }
+  EXPECT_EQ(book.order_count(), 20u);
+  EXPECT_TRUE(book.cancel_order(1));
+  EXPECT_TRUE(book.cancel_order(20));
+  EXPECT_EQ(this->pool_.allocated(), 18u);
+}
+
+TYPED_TEST(BookManagerTest, ForEachBookVisitsInCreationOrder) {
+  (void)this->books_.book(30);
+  (void)this->books_.book(10);
+  (void)this->books_.book(20);
+
+  std::vector<uint16_t> visited;
+  this->books_.for_each_book(
+      [&](uint16_t locate, const TypeParam &) { visited.push_back(locate); });
+  EXPECT_EQ(visited, (std::vector<uint16_t>{30, 10, 20}));
+}
@@ -0,0 +1,466 @@
+/**
+ * @file book_sampler_test.cpp
+ * @brief Tests for BookSampler snapshots (per event and per interval)
+ *        against a reference book on a synthetic feed.
+ */
+
+#include "book/book_sampler.hpp"
+#include "book/order_book.hpp"
+#include "test_files.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <itch/parser.hpp>
+#include <map>
+#include <vector>
+
+using namespace book;
+
+namespace {
+
+// ============================================================================
+// Synthetic Feed
+// ============================================================================
+
+/// One ITCH order message, written at its 5.0 offsets (big-endian)
+struct FeedMessage {
+  std::vector<char> bytes;
+  uint64_t timestamp;
+  uint16_t locate;
+};
+
+class FeedWriter {
+public:
+  void add(uint16_t locate, uint64_t ts, uint64_t ref, char side,
+           uint32_t shares, uint32_t price) {
+    FeedMessage &msg = start('A', locate, ts);
+    put(msg, 11, ref, 8);
+    msg.bytes[19] = side;
+    put(msg, 20, shares, 4);
+    put(msg, 32, price, 4);
+  }
+
+  void executed(uint16_t locate, uint64_t ts, uint64_t ref, uint32_t shares) {
+    FeedMessage &msg = start('E', locate, ts);
+    put(msg, 11, ref, 8);
+    put(msg, 19, shares, 4);
+  }
+
+  void cancel(uint16_t locate, uint64_t ts, uint64_t ref, uint32_t shares) {
+    FeedMessage &msg = start('X', locate, ts);
+    put(msg, 11, ref, 8);
+    put(msg, 19, shares, 4);
+  }
+
+  void del(uint16_t locate, uint64_t ts, uint64_t ref) {
+    FeedMessage &msg = start('D', locate, ts);
+    put(msg, 11, ref, 8);
+  }
+
+  void replace(uint16_t locate, uint64_t ts, uint64_t old_ref,
+               uint64_t new_ref, uint32_t shares, uint32_t price) {
+    FeedMessage &msg = start('U', locate, ts);
+    put(msg, 11, old_ref, 8);
+    put(msg, 19, new_ref, 8);
+    put(msg, 27, shares, 4);
+    put(msg, 31, price, 4);
+  }
+
+  std::vector<FeedMessage> messages;
+
+private:
+  FeedMessage &start(char type, uint16_t locate, uint64_t ts) {
+    FeedMessage &msg = messages.emplace_back();
+    msg.bytes.assign(itch::get_message_size(type), 0);
+    msg.bytes[0] = type;
+    msg.timestamp = ts;
+    msg.locate = locate;
+    put(msg, 1, locate, 2);
+    put(msg, 5, ts, 6);
+    return msg;
+  }
+
+  static void put(FeedMessage &msg, std::size_t offset, uint64_t value,
+                  std::size_t width) {
+    itch::test::put_be(&msg.bytes[offset], value, width);
+  }
+};
+
+// ============================================================================
+// Reference Book - Orders in a std::map, Levels Summed on Demand
+// ============================================================================
+
+/// One snapshot row: top levels of both sides, zero-padded
+struct Snapshot {
+  uint64_t timestamp = 0;
+  uint16_t locate = 0;
+  std::vector<uint32_t> bid_prices;
+  std::vector<uint64_t> bid_sizes;
+  std::vector<uint32_t> ask_prices;
+  std::vector<uint64_t> ask_sizes;
+};
+
+/**
+ * @brief The market-by-order rules applied to a map of live orders.
+ */
+class ReferenceBook {
+public:
+  void add(uint16_t locate, uint64_t ref, char side, uint32_t shares,
+           uint32_t price) {
+    books_[locate]; // A book exists from its first add
+    orders_.try_emplace(ref, Order{locate, side, shares, price});
+  }
+
+  void reduce(uint16_t locate, uint64_t ref, uint32_t shares) {
+    const auto it = find(locate, ref);
+    if (it == orders_.end()) {
+      return;
+    }
+    if (shares >= it->second.shares) {
+      orders_.erase(it);
+    } else {
+      it->second.shares -= shares;
+    }
+  }
+
+  void del(uint16_t locate, uint64_t ref) {
+    const auto it = find(locate, ref);
+    if (it != orders_.end()) {
+      orders_.erase(it);
+    }
+  }
+
+  void replace(uint16_t locate, uint64_t old_ref, uint64_t new_ref,
+               uint32_t shares, uint32_t price) {
+    const auto it = find(locate, old_ref);
+    if (it == orders_.end() || orders_.contains(new_ref)) {
+      return;
+    }
+    const char side = it->second.side;
+    orders_.erase(it);
+    orders_.emplace(new_ref, Order{locate, side, shares, price});
+  }
+
+  [[nodiscard]] bool has_book(uint16_t locate) const {
+    return books_.contains(locate);
+  }
+
+  [[nodiscard]] Snapshot snapshot(uint64_t ts, uint16_t locate,
+                                  std::size_t depth) const {
+    std::map<uint32_t, uint64_t, std::greater<>> bids;
+    std::map<uint32_t, uint64_t> asks;
+    for (const auto &[ref, order] : orders_) {
+      if (order.locate == locate) {
+        (order.side == 'B' ? bids[order.price] : asks[order.price]) +=
+            order.shares;
+      }
+    }
+    Snapshot row{ts, locate, {}, {}, {}, {}};
+    fill(bids, depth, row.bid_prices, row.bid_sizes);
+    fill(asks, depth, row.ask_prices, row.ask_sizes);
+    return row;
+  }
+
+private:
+  struct Order {
+    uint16_t locate;
+    char side;
+    uint32_t shares;
+    uint32_t price;
+  };
+
+  std::map<uint64_t, Order>::iterator find(uint16_t locate, uint64_t ref) {
+    const auto it = orders_.find(ref);
+    return it != orders_.end() && it->second.locate == locate ? it
+                                                              : orders_.end();
+  }
+
+  template <typename Levels>
+  static void fill(const Levels &levels, std::size_t depth,
+                   std::vector<uint32_t> &prices,
+                   std::vector<uint64_t> &sizes) {
+    prices.assign(depth, 0);
+    sizes.assign(depth, 0);
+    std::size_t i = 0;
+    for (auto it = levels.begin(); it != levels.end() && i < depth;
+         ++it, ++i) {
+      prices[i] = it->first;
+      sizes[i] = it->second;
+    }
+  }
+
+  std::map<uint16_t, bool> books_;
+  std::map<uint64_t, Order> orders_;
+};
+
+/// Replay step: the reference book after one event, if it has a book
+struct Step {
+  uint64_t timestamp;
+  uint16_t locate;
+  bool has_book;
+  Snapshot after;
+};
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class BookSamplerTest : public ::testing::Test {
+protected:
+  static constexpr std::size_t kPoolCapacity = 4096;
+  static constexpr std::size_t kDepth = 3;
+  static constexpr uint64_t kInterval = 10'000;
+  using Book = OrderBook<kPoolCapacity>;
+
+  /**
+   * @brief 3000 events over 4 locates: adds, partial and full executions,
+   *        cancels, deletes, replaces, events for unknown orders and
+   *        quiet stretches longer than an interval. Also builds `steps_`.
+   */
+  void build_feed() {
+    ReferenceBook ref_book;
+    std::map<uint16_t, std::vector<uint64_t>> live;
+    uint32_t state = 2024;
+    const auto next = [&](uint32_t bound) {
+      state = state * 1'103'515'245 + 12345;
+      return (state >> 16) % bound;
+    };
+    uint64_t ts = 34'200'000'000'000;
+    uint64_t next_ref = 1;
+    for (int event = 0; event < 3000; ++event) {
+      const auto locate = static_cast<uint16_t>(1 + next(4));
+      ts += next(20) == 0 ? 25'000 + next(40'000) : next(3'000);
+      std::vector<uint64_t> &orders = live[locate];
+      const uint32_t kind = orders.empty() ? 0 : next(20);
+      const uint64_t pick =
+          orders.empty() ? 0 : orders[next(static_cast<uint32_t>(
+                                   orders.size()))];
+
+      if (kind < 8) {
+        const char side = next(2) == 0 ? 'B' : 'S';
+        const uint32_t shares = 100 * (1 + next(5));
+        const uint32_t price = side == 'B' ? 1000 + next(6) : 1004 + next(6);
+        feed_.add(locate, ts, next_ref, side, shares, price);
+        ref_book.add(locate, next_ref, side, shares, price);
+        orders.push_back(next_ref++);
+      } else if (kind < 11) {
+        const uint32_t shares = 50 * (1 + next(6));
+        feed_.executed(locate, ts, pick, shares);
+        ref_book.reduce(locate, pick, shares);
+      } else if (kind < 14) {
+        const uint32_t shares = 50 * (1 + next(6));
+        feed_.cancel(locate, ts, pick, shares);
+        ref_book.reduce(locate, pick, shares);
+      } else if (kind < 17) {
+        feed_.del(locate, ts, pick);
+        ref_book.del(locate, pick);
+      } else if (kind < 19) {
+        const uint32_t price = 1000 + next(10);
+        feed_.replace(locate, ts, pick, next_ref, 300, price);
+        ref_book.replace(locate, pick, next_ref, 300, price);
+        orders.push_back(next_ref++);
+      } else {
+        // Unknown order (never added): rejected by both books
+        feed_.executed(locate, ts, 1'000'000 + next_ref, 10);
+      }
+      steps_.push_back({ts, locate, ref_book.has_book(locate),
+                        ref_book.snapshot(ts, locate, kDepth)});
+    }
+  }
+
+  /// Replay the whole feed into a fresh sampler and return its rows
+  std::vector<Snapshot> replay(uint64_t interval_ns, bool finish = true,
+                               const itch::ParseFilter &filter = {}) {
+    // The filter is referenced by the sampler, so keep a copy alive
+    filter_ = filter;
+    Book::PoolType pool;
+    BookManager<Book> books(pool, 16);
+    BookSampler<Book> sampler(books, filter_, kDepth, interval_ns);
+    const itch::Parser parser;
+    for (const FeedMessage &msg : feed_.messages) {
+      EXPECT_EQ(parser.parse(msg.bytes.data(), msg.bytes.size(), sampler),
+                itch::ParseResult::Ok);
+    }
+    if (finish) {
+      sampler.finish();
+    }
+
+    std::vector<Snapshot> rows(sampler.timestamps.size());
+    EXPECT_EQ(sampler.stock_locates.size(), rows.size());
+    EXPECT_EQ(sampler.bid_prices.size(), rows.size() * kDepth);
+    EXPECT_EQ(sampler.ask_sizes.size(), rows.size() * kDepth);
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+      const auto level = [&](const auto &column) {
+        const auto first = column.begin() +
+                           static_cast<std::ptrdiff_t>(i * kDepth);
+        return std::vector(first, first + kDepth);
+      };
+      rows[i] = {sampler.timestamps[i], sampler.stock_locates[i],
+                 level(sampler.bid_prices), level(sampler.bid_sizes),
+                 level(sampler.ask_prices), level(sampler.ask_sizes)};
+    }
+    return rows;
+  }
+
+  static void expect_rows(const std::vector<Snapshot> &actual,
+                          const std::vector<Snapshot> &expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < actual.size(); ++i) {
+      SCOPED_TRACE(i);
+      EXPECT_EQ(actual[i].timestamp, expected[i].timestamp);
+      EXPECT_EQ(actual[i].locate, expected[i].locate);
+      EXPECT_EQ(actual[i].bid_prices, expected[i].bid_prices);
+      EXPECT_EQ(actual[i].bid_sizes, expected[i].bid_sizes);
+      EXPECT_EQ(actual[i].ask_prices, expected[i].ask_prices);
+      EXPECT_EQ(actual[i].ask_sizes, expected[i].ask_sizes);
+    }
+  }
+
+  /**
+   * @brief Expected interval rows: for each interval and each book with
+   *        an event in it, the book after its last event there, stamped
+   *        with the interval end; books in order of first event.
+   */
+  std::vector<Snapshot> expected_interval_rows() const {
+    std::vector<Snapshot> rows;
+    std::size_t begin = 0;
+    while (begin < steps_.size()) {
+      const uint64_t end =
+          steps_[begin].timestamp / kInterval * kInterval + kInterval;
+      std::size_t stop = begin;
+      while (stop < steps_.size() && steps_[stop].timestamp < end) {
+        ++stop;
+      }
+      std::vector<uint16_t> order;
+      for (std::size_t i = begin; i < stop; ++i) {
+        if (std::find(order.begin(), order.end(), steps_[i].locate) ==
+            order.end()) {
+          order.push_back(steps_[i].locate);
+        }
+      }
+      for (const uint16_t locate : order) {
+        for (std::size_t i = stop; i-- > begin;) {
+          if (steps_[i].locate == locate) {
+            if (steps_[i].has_book) {
+              Snapshot row = steps_[i].after;
+              row.timestamp = end;
+              rows.push_back(row);
+            }
+            break;
+          }
+        }
+      }
+      begin = stop;
+    }
+    return rows;
+  }
+
+  FeedWriter feed_;
+  std::vector<Step> steps_;
+  itch::ParseFilter filter_;
+};
+
+} // namespace
+
+// ============================================================================
+// Per-Event Sampling
+// ============================================================================
+
+TEST_F(BookSamplerTest, EveryEvent_RowAfterEachEventMatchesReference) {
+  build_feed();
+  std::vector<Snapshot> expected;
+  for (const Step &step : steps_) {
+    if (step.has_book) {
+      expected.push_back(step.after);
+    }
+  }
+  ASSERT_GT(expected.size(), 2000u);
+  expect_rows(replay(0), expected);
+}
+
+// ============================================================================
+// Interval Sampling
+// ============================================================================
+
+TEST_F(BookSamplerTest, Interval_RowsHoldBookAfterIntervalsLastEvent) {
+  build_feed();
+  const std::vector<Snapshot> expected = expected_interval_rows();
+  ASSERT_GT(expected.size(), 500u);
+  ASSERT_LT(expected.size(), steps_.size());
+  expect_rows(replay(kInterval), expected);
+}
+
+TEST_F(BookSamplerTest, Interval_ForwardFillEqualsBookAtEveryGridTime) {
+  build_feed();
+  const std::vector<Snapshot> rows = replay(kInterval);
+  ASSERT_FALSE(rows.empty());
+
+  // At grid time T, the latest row stamped <= T must equal the book
+  // after every event before T, for every locate
+  const uint64_t first = steps_.front().timestamp / kInterval * kInterval;
+  const uint64_t last = steps_.back().timestamp + 3 * kInterval;
+  std::map<uint16_t, Snapshot> filled;
+  std::map<uint16_t, Snapshot> truth;
+  std::size_t row = 0;
+  std::size_t step = 0;
+  std::size_t checked = 0;
+  for (uint64_t grid = first; grid <= last; grid += kInterval) {
+    for (; row < rows.size() && rows[row].timestamp <= grid; ++row) {
+      filled[rows[row].locate] = rows[row];
+    }
+    for (; step < steps_.size() && steps_[step].timestamp < grid; ++step) {
+      if (steps_[step].has_book) {
+        truth[steps_[step].locate] = steps_[step].after;
+      }
+    }
+    ASSERT_EQ(filled.size(), truth.size()) << grid;
+    for (const auto &[locate, book] : truth) {
+      SCOPED_TRACE(grid);
+      EXPECT_EQ(filled[locate].bid_prices, book.bid_prices);
+      EXPECT_EQ(filled[locate].bid_sizes, book.bid_sizes);
+      EXPECT_EQ(filled[locate].ask_prices, book.ask_prices);
+      EXPECT_EQ(filled[locate].ask_sizes, book.ask_sizes);
+      ++checked;
+    }
+  }
+  EXPECT_EQ(row, rows.size());
+  EXPECT_GT(checked, 1000u);
+}
+
+TEST_F(BookSamplerTest, Interval_FinishFlushesTheLastInterval) {
+  build_feed();
+  const std::vector<Snapshot> flushed = replay(kInterval);
+  const std::vector<Snapshot> unflushed = replay(kInterval, false);
+
+  // Without finish() the last interval's books are missing
+  const uint64_t last_end =
+      steps_.back().timestamp / kInterval * kInterval + kInterval;
+  ASSERT_FALSE(flushed.empty());
+  EXPECT_EQ(flushed.back().timestamp, last_end);
+  ASSERT_LT(unflushed.size(), flushed.size());
+  EXPECT_LT(unflushed.back().timestamp, last_end);
+  expect_rows(unflushed,
+              std::vector(flushed.begin(),
+                          flushed.begin() +
+                              static_cast<std::ptrdiff_t>(unflushed.size())));
+}
+
+TEST_F(BookSamplerTest, Interval_WindowKeepsRowsByStamp) {
+  build_feed();
+  const std::vector<Snapshot> all = expected_interval_rows();
+  ASSERT_GT(all.size(), 100u);
+
+  itch::ParseFilter filter;
+  filter.start_ns = all[20].timestamp;
+  filter.end_ns = all[all.size() - 20].timestamp;
+  std::vector<Snapshot> expected;
+  std::copy_if(all.begin(), all.end(), std::back_inserter(expected),
+               [&](const Snapshot &row) {
+                 return filter.in_window(row.timestamp);
+               });
+  expect_rows(replay(kInterval, true, filter), expected);
+}
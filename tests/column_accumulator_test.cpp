@@ -0,0 +1,566 @@
+/**
+ * @file column_accumulator_test.cpp
+ * @brief Unit tests for ColumnAccumulator, the columnar extraction behind
+ *        the Python module.
+ */
+
+#include <gtest/gtest.h>
+#include <itch/column_accumulator.hpp>
+
+#include "test_files.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace itch::test {
+
+// ============================================================================
+// Feed Builder - MoldUDP64 packets in an Ethernet PCAP
+// ============================================================================
+
+/// One AddOrder or OrderExecuted row, as the columns should hold it
+struct Row {
+  char type;
+  uint16_t locate;
+  uint64_t timestamp;
+  uint64_t order_ref;
+  uint32_t shares;
+  uint32_t price;        ///< AddOrder only
+  char side;             ///< AddOrder only
+  uint64_t match_number; ///< OrderExecuted only
+};
+
+/**
+ * @brief Writes ITCH messages at their 5.0 offsets (big-endian) into
+ *        MoldUDP64 packets, and remembers the rows they should produce.
+ */
+class FeedBuilder {
+public:
+  std::vector<Row> rows;
+
+  void stock_directory(uint16_t locate, uint64_t ts, const char *symbol) {
+    std::vector<unsigned char> msg = header(msg_type::StockDirectory,
+                                            locate, ts);
+    put_symbol(msg, 11, symbol);
+    packet_.push_back(msg);
+  }
+
+  void add(uint16_t locate, uint64_t ts, uint64_t ref, const char *symbol,
+           char side = 'B', uint32_t shares = 100, uint32_t price = 1500) {
+    std::vector<unsigned char> msg = header(msg_type::AddOrder, locate, ts);
+    put(msg, 11, ref, 8);
+    msg[19] = static_cast<unsigned char>(side);
+    put(msg, 20, shares, 4);
+    put_symbol(msg, 24, symbol);
+    put(msg, 32, price, 4);
+    packet_.push_back(msg);
+    rows.push_back({'A', locate, ts, ref, shares, price, side, 0});
+  }
+
+  void executed(uint16_t locate, uint64_t ts, uint64_t ref,
+                uint32_t shares = 10) {
+    const uint64_t match = ref * 7 + 1;
+    std::vector<unsigned char> msg =
+        header(msg_type::OrderExecuted, locate, ts);
+    put(msg, 11, ref, 8);
+    put(msg, 19, shares, 4);
+    put(msg, 23, match, 8);
+    packet_.push_back(msg);
+    rows.push_back({'E', locate, ts, ref, shares, 0, 0, match});
+  }
+
+  /// A message the accumulator ignores
+  void deleted(uint16_t locate, uint64_t ts, uint64_t ref) {
+    std::vector<unsigned char> msg = header(msg_type::OrderDelete, locate, ts);
+    put(msg, 11, ref, 8);
+    packet_.push_back(msg);
+  }
+
+  /// Close the current packet (a packet with no messages is a heartbeat)
+  void end_packet() {
+    pcap_.packet(mold_udp_frame(kSession, sequence_, packet_));
+    sequence_ += packet_.size();
+    packet_.clear();
+    ++packet_count_;
+  }
+
+  /// Native-order Ethernet PCAP holding every closed packet
+  [[nodiscard]] const std::vector<unsigned char> &pcap() const {
+    return pcap_.bytes();
+  }
+
+  [[nodiscard]] std::size_t packet_count() const { return packet_count_; }
+  [[nodiscard]] uint64_t next_sequence() const { return sequence_; }
+
+  static constexpr char kSession[] = "SESSION001";
+
+private:
+  static void put(std::vector<unsigned char> &msg, std::size_t offset,
+                  uint64_t value, std::size_t width) {
+    put_be(&msg[offset], value, width);
+  }
+
+  static void put_symbol(std::vector<unsigned char> &msg, std::size_t offset,
+                         const char *symbol) {
+    std::memset(&msg[offset], ' ', sizeof(StockSymbol));
+    std::memcpy(&msg[offset], symbol, std::strlen(symbol));
+  }
+
+  static std::vector<unsigned char> header(char type, uint16_t locate,
+                                           uint64_t ts) {
+    std::vector<unsigned char> msg(get_message_size(type), 0);
+    msg[0] = static_cast<unsigned char>(type);
+    put(msg, 1, locate, 2);
+    put(msg, 5, ts, 6);
+    return msg;
+  }
+
+  std::vector<std::vector<unsigned char>> packet_;
+  PcapBuilder pcap_;
+  std::size_t packet_count_ = 0;
+  uint64_t sequence_ = 1;
+};
+
+// ============================================================================
+// Test Fixture - writes a temporary PCAP file
+// ============================================================================
+
+class ColumnAccumulatorTest : public ::testing::Test {
+protected:
+  /// Write the feed to the test's temporary file and open it
+  PcapReader &open(const FeedBuilder &feed) {
+    EXPECT_TRUE(reader_.open(file_.write(feed.pcap())));
+    return reader_;
+  }
+
+  /// Mixed feed: 400 packets of 0-5 messages over 12 locates
+  static FeedBuilder mixed_feed() {
+    static const char *const kSymbols[] = {"AAPL", "MSFT", "QQQ", "IBM"};
+    FeedBuilder feed;
+    uint64_t ts = 34'200'000'000'000;
+    uint64_t ref = 1;
+    uint32_t state = 12345;
+    const auto next = [&] { return state = state * 1'103'515'245 + 12345; };
+    for (int packet = 0; packet < 400; ++packet) {
+      const uint32_t messages = (next() >> 16) % 6;
+      for (uint32_t i = 0; i < messages; ++i) {
+        const auto locate = static_cast<uint16_t>(1 + (next() >> 16) % 12);
+        ts += (next() >> 16) % 1000;
+        switch ((next() >> 16) % 4) {
+        case 0:
+        case 1:
+          feed.add(locate, ts, ref, kSymbols[locate % 4],
+                   (ref & 1) != 0 ? 'B' : 'S',
+                   static_cast<uint32_t>(ref % 900 + 100),
+                   static_cast<uint32_t>(1000 + locate * 10 + ref % 7));
+          ++ref;
+          break;
+        case 2:
+          feed.executed(locate, ts, ref * 3);
+          break;
+        default:
+          feed.deleted(locate, ts, ref);
+        }
+      }
+      feed.end_packet();
+    }
+    return feed;
+  }
+
+  /// Assert the columns hold exactly `rows`, in order
+  static void expect_rows(ColumnAccumulator &acc,
+                          const std::vector<Row> &rows) {
+    std::size_t adds = 0;
+    std::size_t execs = 0;
+    for (const Row &row : rows) {
+      if (row.type == 'A') {
+        ASSERT_LT(adds, acc.add_order_refs.size());
+        EXPECT_EQ(acc.add_order_refs[adds], row.order_ref);
+        EXPECT_EQ(acc.add_timestamps[adds], row.timestamp);
+        EXPECT_EQ(acc.add_stock_locates[adds], row.locate);
+        EXPECT_EQ(acc.add_shares[adds], row.shares);
+        EXPECT_EQ(acc.add_prices[adds], row.price);
+        EXPECT_EQ(acc.add_sides[adds], row.side);
+        ++adds;
+      } else {
+        ASSERT_LT(execs, acc.exec_order_refs.size());
+        EXPECT_EQ(acc.exec_order_refs[execs], row.order_ref);
+        EXPECT_EQ(acc.exec_timestamps[execs], row.timestamp);
+        EXPECT_EQ(acc.exec_stock_locates[execs], row.locate);
+        EXPECT_EQ(acc.exec_shares[execs], row.shares);
+        EXPECT_EQ(acc.exec_match_numbers[execs], row.match_number);
+        ++execs;
+      }
+    }
+    acc.visit_add_columns([&](const char *name, const auto &column) {
+      EXPECT_EQ(column.size(), adds) << name;
+    });
+    acc.visit_exec_columns([&](const char *name, const auto &column) {
+      EXPECT_EQ(column.size(), execs) << name;
+    });
+  }
+
+  /// Feed whose executions on locates 20-27 come before those locates'
+  /// Stock Directory messages, which arrive in the last packets (no
+  /// AddOrder names them), so a symbol filter settles them late
+  static FeedBuilder late_directory_feed() {
+    static const char *const kSymbols[] = {"AAPL", "MSFT", "QQQ", "IBM"};
+    FeedBuilder feed;
+    uint64_t ts = 34'200'000'000'000;
+    for (uint64_t ref = 1; ref <= 300; ++ref) {
+      const auto add_locate = static_cast<uint16_t>(1 + ref % 12);
+      feed.add(add_locate, ts += 10, ref, kSymbols[add_locate % 4]);
+      feed.executed(static_cast<uint16_t>(20 + ref % 8), ts += 10, ref);
+      feed.end_packet();
+    }
+    for (uint16_t locate = 20; locate < 28; ++locate) {
+      feed.stock_directory(locate, ts += 10, locate % 2 == 0 ? "AAPL" : "ZZZ");
+      feed.end_packet();
+    }
+    return feed;
+  }
+
+  /// A symbol as ParseFilter holds it (space-padded)
+  static ParseFilter::Symbol symbol(const char *name) {
+    ParseFilter::Symbol padded;
+    padded.fill(' ');
+    std::memcpy(padded.data(), name, std::strlen(name));
+    return padded;
+  }
+
+  /// Expect every thread count to keep exactly the feed rows `keep`
+  /// selects, in order
+  template <typename Keep>
+  static void expect_filtered(const PcapReader &reader,
+                              const FeedBuilder &feed,
+                              const ParseFilter &filter, Keep keep) {
+    std::vector<Row> kept;
+    std::copy_if(feed.rows.begin(), feed.rows.end(),
+                 std::back_inserter(kept), keep);
+    for (std::size_t threads = 1; threads <= 6; ++threads) {
+      SCOPED_TRACE(threads);
+      ColumnAccumulator acc;
+      EXPECT_EQ(parse_file_columns(reader, threads, filter, acc),
+                feed.packet_count());
+      expect_rows(acc, kept);
+      EXPECT_TRUE(acc.pending_exec_rows.empty());
+    }
+  }
+
+  TempFile file_{"itch_columns"};
+  PcapReader reader_;
+};
+
+// ============================================================================
+// Columns
+// ============================================================================
+
+TEST_F(ColumnAccumulatorTest, Columns_MatchEveryMessageInOrder) {
+  const FeedBuilder feed = mixed_feed();
+  const PcapReader &reader = open(feed);
+
+  ColumnAccumulator acc;
+  EXPECT_EQ(parse_packets(reader, 0, reader.file_size(), acc),
+            feed.packet_count());
+
+  expect_rows(acc, feed.rows);
+  EXPECT_EQ(acc.session, FeedBuilder::kSession);
+  EXPECT_EQ(acc.next_sequence, feed.next_sequence());
+}
+
+TEST_F(ColumnAccumulatorTest, ReserveFor_ColumnsNeverReallocate) {
+  const FeedBuilder feed = mixed_feed();
+  const PcapReader &reader = open(feed);
+
+  ColumnAccumulator acc;
+  acc.reserve_for(reader.file_size());
+  const uint64_t *add_data = acc.add_order_refs.data();
+  const uint64_t *exec_data = acc.exec_match_numbers.data();
+  EXPECT_EQ(acc.add_prices.capacity(),
+            reader.file_size() / ColumnAccumulator::kMinAddBytes);
+  EXPECT_EQ(acc.exec_shares.capacity(),
+            reader.file_size() / ColumnAccumulator::kMinExecBytes);
+
+  (void)parse_packets(reader, 0, reader.file_size(), acc);
+  ASSERT_FALSE(acc.add_order_refs.empty());
+  ASSERT_FALSE(acc.exec_match_numbers.empty());
+  EXPECT_EQ(acc.add_order_refs.data(), add_data);
+  EXPECT_EQ(acc.exec_match_numbers.data(), exec_data);
+}
+
+TEST_F(ColumnAccumulatorTest, ReserveColumns_RefusedAddressSpaceIsNotFatal) {
+  // 2^48 bytes is more address space than a process has
+  Column<uint64_t> column;
+  reserve_columns(std::size_t{1} << 45, column);
+  EXPECT_EQ(column.capacity(), 0u);
+
+  column.push_back(7); // Still grows normally
+  EXPECT_EQ(column.front(), 7u);
+}
+
+// ============================================================================
+// Packet Ranges
+// ============================================================================
+
+TEST_F(ColumnAccumulatorTest, SplitRanges_AppendedInOrderMatchWholeParse) {
+  const FeedBuilder feed = mixed_feed();
+  const PcapReader &reader = open(feed);
+
+  for (std::size_t parts = 1; parts <= 5; ++parts) {
+    const std::vector<std::size_t> bounds =
+        split_packet_ranges(reader, parts);
+    ASSERT_GE(bounds.size(), 2u);
+    EXPECT_LE(bounds.size(), parts + 1);
+    EXPECT_EQ(bounds.front(), sizeof(PcapGlobalHeader));
+    EXPECT_EQ(bounds.back(), reader.file_size());
+
+    ColumnAccumulator merged;
+    std::size_t packets = 0;
+    for (std::size_t i = 0; i + 1 < bounds.size(); ++i) {
+      ASSERT_LT(bounds[i], bounds[i + 1]);
+      ColumnAccumulator range;
+      packets += parse_packets(reader, bounds[i], bounds[i + 1], range);
+      merged.append(range);
+    }
+    EXPECT_EQ(packets, feed.packet_count());
+    expect_rows(merged, feed.rows);
+    EXPECT_EQ(merged.session, FeedBuilder::kSession);
+    EXPECT_EQ(merged.next_sequence, feed.next_sequence());
+  }
+}
+
+TEST_F(ColumnAccumulatorTest, ParseFileColumns_AnyThreadCountMatchesOne) {
+  const FeedBuilder feed = mixed_feed();
+  const PcapReader &reader = open(feed);
+  const ParseFilter no_filter;
+
+  for (std::size_t threads = 1; threads <= 6; ++threads) {
+    SCOPED_TRACE(threads);
+    ColumnAccumulator acc;
+    EXPECT_EQ(parse_file_columns(reader, threads, no_filter, acc),
+              feed.packet_count());
+    expect_rows(acc, feed.rows);
+    EXPECT_EQ(acc.session, FeedBuilder::kSession);
+    EXPECT_EQ(acc.next_sequence, feed.next_sequence());
+  }
+}
+
+// ============================================================================
+// Filters
+// ============================================================================
+
+TEST_F(ColumnAccumulatorTest, Filter_ExecutionsBeforeStockDirectoryAreSettled) {
+  const FeedBuilder feed = late_directory_feed();
+  const PcapReader &reader = open(feed);
+
+  // Locates 20, 22, 24 and 26 are AAPL, but only their last packets say
+  // so; with several threads that is another shard than the executions
+  ParseFilter filter;
+  filter.symbols = {symbol("AAPL")};
+  expect_filtered(reader, feed, filter, [](const Row &row) {
+    return row.type == 'A' ? row.locate % 4 == 0
+                           : row.locate >= 20 && row.locate % 2 == 0;
+  });
+}
+
+TEST_F(ColumnAccumulatorTest, Filter_UnresolvedPendingExecutionsAreDropped) {
+  FeedBuilder feed;
+  feed.executed(30, 100, 1); // Never named by a Stock Directory or add
+  feed.executed(31, 110, 2);
+  feed.end_packet();
+  feed.stock_directory(31, 120, "MSFT");
+  feed.end_packet();
+  const PcapReader &reader = open(feed);
+
+  ParseFilter filter;
+  filter.symbols = {symbol("MSFT")};
+  expect_filtered(reader, feed, filter,
+                  [](const Row &row) { return row.locate == 31; });
+}
+
+TEST_F(ColumnAccumulatorTest, Filter_EmptySelectionKeepsNothing) {
+  const FeedBuilder feed = mixed_feed();
+  const PcapReader &reader = open(feed);
+
+  // What parse_file() builds for symbols=[] or stock_locates=[]
+  ParseFilter filter;
+  filter.by_locate = true;
+  expect_filtered(reader, feed, filter, [](const Row &) { return false; });
+}
+
+TEST_F(ColumnAccumulatorTest, Filter_LocatesAndSymbolsSelectEither) {
+  const FeedBuilder feed = mixed_feed();
+  const PcapReader &reader = open(feed);
+
+  // QQQ is every locate with locate % 4 == 2 (2, 6, 10)
+  ParseFilter filter;
+  filter.by_locate = true;
+  filter.locates.set(1);
+  filter.locates.set(2);
+  filter.symbols = {symbol("QQQ")};
+  expect_filtered(reader, feed, filter, [](const Row &row) {
+    return row.locate == 1 || row.locate % 4 == 2;
+  });
+}
+
+TEST_F(ColumnAccumulatorTest, Filter_WindowIncludesStartExcludesEnd) {
+  const FeedBuilder feed = mixed_feed();
+  const PcapReader &reader = open(feed);
+  ASSERT_GT(feed.rows.size(), 200u);
+
+  ParseFilter filter;
+  filter.start_ns = feed.rows[50].timestamp;
+  filter.end_ns = feed.rows[150].timestamp;
+  ASSERT_LT(filter.start_ns, filter.end_ns);
+  expect_filtered(reader, feed, filter, [&](const Row &row) {
+    return row.timestamp >= filter.start_ns && row.timestamp < filter.end_ns;
+  });
+
+  ColumnAccumulator acc;
+  (void)parse_file_columns(reader, 1, filter, acc);
+  const auto &ts = feed.rows[50].type == 'A' ? acc.add_timestamps
+                                             : acc.exec_timestamps;
+  ASSERT_FALSE(acc.add_timestamps.empty());
+  ASSERT_FALSE(acc.exec_timestamps.empty());
+  EXPECT_EQ(ts.front(), filter.start_ns);
+  EXPECT_LT(std::max(acc.add_timestamps.back(), acc.exec_timestamps.back()),
+            filter.end_ns);
+}
+
+TEST_F(ColumnAccumulatorTest, Filter_MessageTypesAndSymbolsCombine) {
+  const FeedBuilder feed = mixed_feed();
+  const PcapReader &reader = open(feed);
+
+  ParseFilter filter;
+  filter.keep_adds = false;
+  filter.symbols = {symbol("MSFT"), symbol("IBM")};
+  expect_filtered(reader, feed, filter, [](const Row &row) {
+    return row.type == 'E' && row.locate % 2 == 1;
+  });
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+TEST(RunWorkersTest, RunsEveryTaskOnce) {
+  std::vector<std::atomic<int>> runs(5);
+  run_workers(runs.size(), [&](std::size_t i) { ++runs[i]; });
+  for (const auto &count : runs) {
+    EXPECT_EQ(count.load(), 1);
+  }
+}
+
+TEST(RunWorkersTest, ThrowingWorkerIsRethrownAfterEveryWorkerFinishes) {
+  for (std::size_t thrower = 0; thrower < 4; ++thrower) {
+    SCOPED_TRACE(thrower);
+    std::atomic<int> finished{0};
+    const auto task = [&](std::size_t i) {
+      if (i == thrower) {
+        throw std::bad_alloc();
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      ++finished;
+    };
+    EXPECT_THROW(run_workers(4, task), std::bad_alloc);
+    EXPECT_EQ(finished.load(), 3);
+  }
+}
+
+TEST(RunWorkersTest, LowestFailingTaskWins) {
+  try {
+    run_workers(4, [](std::size_t i) {
+      if (i % 2 == 1) {
+        throw std::runtime_error("task " + std::to_string(i));
+      }
+    });
+    FAIL() << "expected an exception";
+  } catch (const std::runtime_error &error) {
+    EXPECT_STREQ(error.what(), "task 1");
+  }
+}
+
+// ============================================================================
+// Streaming
+// ============================================================================
+
+TEST_F(ColumnAccumulatorTest, Stream_SmallBatchesConcatenateToWholeParse) {
+  const FeedBuilder feed = mixed_feed();
+  const PcapReader &reader = open(feed);
+
+  for (const std::size_t chunk : {1u, 2u, 7u, 64u, 100000u}) {
+    SCOPED_TRACE(chunk);
+    ColumnStream stream(reader, chunk);
+    ColumnAccumulator concatenated;
+    const auto append = [](auto &columns) {
+      return [&columns](const char *, const auto &column, std::size_t rows) {
+        ASSERT_LE(rows, column.size());
+        columns.emplace_back(
+            column.begin(),
+            column.begin() + static_cast<std::ptrdiff_t>(rows));
+      };
+    };
+    std::size_t batches = 0;
+    while (stream.fill()) {
+      std::vector<std::vector<uint64_t>> adds;
+      std::vector<std::vector<uint64_t>> execs;
+      stream.take_add_batch(append(adds));
+      stream.take_exec_batch(append(execs));
+      ASSERT_EQ(adds.size(), 6u);
+      ASSERT_EQ(execs.size(), 5u);
+      EXPECT_LE(adds[0].size(), chunk);
+      EXPECT_LE(execs[0].size(), chunk);
+      EXPECT_TRUE(!adds[0].empty() || !execs[0].empty());
+      ++batches;
+
+      std::size_t i = 0;
+      concatenated.visit_add_columns([&](const char *, auto &column) {
+        for (const uint64_t value : adds[i]) {
+          column.push_back(static_cast<std::decay_t<decltype(column[0])>>(
+              value));
+        }
+        ++i;
+      });
+      i = 0;
+      concatenated.visit_exec_columns([&](const char *, auto &column) {
+        for (const uint64_t value : execs[i]) {
+          column.push_back(static_cast<std::decay_t<decltype(column[0])>>(
+              value));
+        }
+        ++i;
+      });
+    }
+    EXPECT_FALSE(stream.fill()); // Stays exhausted
+    EXPECT_GE(batches * chunk, feed.rows.size() / 2);
+
+    expect_rows(concatenated, feed.rows);
+    EXPECT_EQ(stream.packet_count(), feed.packet_count());
+    EXPECT_EQ(stream.accumulator().session, FeedBuilder::kSession);
+    EXPECT_EQ(stream.accumulator().next_sequence, feed.next_sequence());
+  }
+}
+
+TEST_F(ColumnAccumulatorTest, Stream_OverflowNeverReallocates) {
+  const FeedBuilder feed = mixed_feed();
+  const PcapReader &reader = open(feed);
+
+  // A packet holds up to 5 messages, so batches of 3 overflow often
+  ColumnStream stream(reader, 3);
+  const uint64_t *data = stream.accumulator().add_order_refs.data();
+  while (stream.fill()) {
+    EXPECT_EQ(stream.accumulator().add_order_refs.data(), data);
+    stream.take_add_batch([](const char *, const auto &, std::size_t) {});
+    stream.take_exec_batch([](const char *, const auto &, std::size_t) {});
+  }
+}
+
+} // namespace itch::test
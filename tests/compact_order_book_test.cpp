@@ -0,0 +1,197 @@
+/**
+ * @file compact_order_book_test.cpp
+ * @brief Tests for CompactOrderBook (32-byte orders linked by pool index).
+ *
+ * Verifies the record layout and that the compact engine reproduces
+ * OrderBook matching, FIFO and cancel semantics.
+ */
+
+#include "book/compact_order_book.hpp"
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace book;
+
+// ============================================================================
+// Layout
+// ============================================================================
+
+TEST(CompactOrderTest, HalfCacheLineAndAligned) {
+  EXPECT_EQ(sizeof(CompactOrder), 32u);
+  EXPECT_EQ(alignof(CompactOrder), 32u);
+
+  MemPool<CompactOrder, 16> pool;
+  for (std::size_t i = 0; i < 16; ++i) {
+    CompactOrder *order = pool.allocate();
+    ASSERT_NE(order, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(order) % 32, 0u);
+    EXPECT_EQ(&pool.at(pool.index_of(order)), order);
+  }
+}
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class CompactBookTest : public ::testing::Test {
+protected:
+  static constexpr std::size_t POOL_CAPACITY = 1000;
+
+  MemPool<CompactOrder, POOL_CAPACITY> pool_;
+  CompactOrderBook<POOL_CAPACITY> book_{pool_};
+
+  static std::vector<Execution> executions_;
+  static void record(const Execution &exec) { executions_.push_back(exec); }
+
+  void SetUp() override { executions_.clear(); }
+};
+
+std::vector<Execution> CompactBookTest::executions_;
+
+// ============================================================================
+// Matching Semantics (mirrors matching_test.cpp)
+// ============================================================================
+
+TEST_F(CompactBookTest, RestingOrders_NoMatch) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 1010000, 50, Side::Sell));
+
+  EXPECT_EQ(book_.order_count(), 2);
+  EXPECT_EQ(book_.best_bid().value(), 1000000);
+  EXPECT_EQ(book_.best_ask().value(), 1010000);
+  EXPECT_EQ(book_.spread().value(), 10000);
+  EXPECT_EQ(book_.best_bid_volume(), 100);
+  EXPECT_EQ(book_.best_ask_volume(), 50);
+}
+
+TEST_F(CompactBookTest, CrossingOrder_MultipleLevels) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 50, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 999900, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(3, 999800, 200, Side::Buy));
+
+  ASSERT_TRUE(book_.add_order(4, 999800, 120, Side::Sell, record));
+
+  ASSERT_EQ(executions_.size(), 2u);
+  EXPECT_EQ(executions_[0].maker_id, 1u);
+  EXPECT_EQ(executions_[0].price, 1000000u);
+  EXPECT_EQ(executions_[0].maker_side, Side::Buy);
+  EXPECT_EQ(executions_[1].maker_id, 2u);
+  EXPECT_EQ(executions_[1].qty, 70u);
+
+  EXPECT_EQ(book_.bid_level_count(), 2);
+  EXPECT_EQ(book_.best_bid().value(), 999900);
+  EXPECT_EQ(book_.best_bid_volume(), 30);
+  EXPECT_EQ(pool_.allocated(), 2u);
+}
+
+TEST_F(CompactBookTest, CrossingOrder_PartialFill_TakerRests) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 50, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 999900, 100, Side::Sell));
+
+  EXPECT_FALSE(book_.best_bid().has_value());
+  EXPECT_EQ(book_.best_ask().value(), 999900);
+  EXPECT_EQ(book_.best_ask_volume(), 50);
+  EXPECT_EQ(book_.order_count(), 1);
+}
+
+TEST_F(CompactBookTest, FIFO_SamePriceLevel) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(3, 1000000, 100, Side::Buy));
+  EXPECT_EQ(book_.queue(book_.bids().front()),
+            (std::vector<uint64_t>{1, 2, 3}));
+
+  ASSERT_TRUE(book_.add_order(4, 999900, 150, Side::Sell));
+
+  EXPECT_EQ(book_.order_count(), 2);
+  EXPECT_EQ(book_.best_bid_volume(), 150);
+  EXPECT_EQ(book_.queue(book_.bids().front()),
+            (std::vector<uint64_t>{2, 3}));
+  EXPECT_FALSE(book_.cancel_order(1));
+}
+
+TEST_F(CompactBookTest, CancelHeadMiddleTailKeepsQueueLinked) {
+  for (uint64_t id = 1; id <= 5; ++id) {
+    ASSERT_TRUE(book_.add_order(id, 1000000, 10, Side::Sell));
+  }
+  const LevelRef ref = book_.asks().front();
+
+  ASSERT_TRUE(book_.cancel_order(3)); // Middle
+  ASSERT_TRUE(book_.cancel_order(1)); // Head
+  ASSERT_TRUE(book_.cancel_order(5)); // Tail
+  EXPECT_EQ(book_.queue(ref), (std::vector<uint64_t>{2, 4}));
+  EXPECT_EQ(book_.best_ask_volume(), 20u);
+
+  ASSERT_TRUE(book_.add_order(6, 1000000, 10, Side::Sell));
+  EXPECT_EQ(book_.queue(ref), (std::vector<uint64_t>{2, 4, 6}));
+
+  ASSERT_TRUE(book_.cancel_order(2));
+  ASSERT_TRUE(book_.cancel_order(4));
+  ASSERT_TRUE(book_.cancel_order(6));
+  EXPECT_TRUE(book_.empty());
+  EXPECT_EQ(pool_.allocated(), 0u);
+}
+
+TEST_F(CompactBookTest, CancelReduceReplace) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 999900, 100, Side::Buy));
+
+  ASSERT_TRUE(book_.reduce_order(1, 40));
+  EXPECT_EQ(book_.best_bid_volume(), 60);
+
+  ASSERT_TRUE(book_.replace_order(1, 10, 999800, 25));
+  EXPECT_EQ(book_.best_bid().value(), 999900);
+  EXPECT_EQ(book_.bid_level_count(), 2);
+
+  ASSERT_TRUE(book_.cancel_order(2));
+  EXPECT_EQ(book_.best_bid().value(), 999800);
+  EXPECT_EQ(book_.best_bid_volume(), 25);
+
+  ASSERT_TRUE(book_.reduce_order(10, 25));
+  EXPECT_TRUE(book_.empty());
+  EXPECT_EQ(book_.bid_level_count(), 0);
+}
+
+TEST_F(CompactBookTest, ReplaceKeepsSideFromLevel) {
+  ASSERT_TRUE(book_.add_order(1, 1010000, 100, Side::Sell));
+  ASSERT_EQ(book_.replace_passive(1, 2, 990000, 50), // Crosses nothing
+            ReplaceResult::Applied);
+  EXPECT_FALSE(book_.best_bid().has_value());
+  EXPECT_EQ(book_.best_ask().value(), 990000u);
+}
+
+TEST_F(CompactBookTest, DuplicateOrderId_Rejected) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+  EXPECT_FALSE(book_.add_order(1, 1010000, 50, Side::Sell));
+  EXPECT_FALSE(book_.insert_order(1, 1010000, 50, Side::Sell));
+  EXPECT_EQ(book_.order_count(), 1);
+}
+
+TEST_F(CompactBookTest, ReservedOrderId_Rejected) {
+  ASSERT_TRUE(book_.add_order(1, 1010000, 100, Side::Sell));
+  EXPECT_FALSE(book_.add_order(kInvalidOrderId, 1010000, 50, Side::Buy));
+  EXPECT_FALSE(book_.insert_order(kInvalidOrderId, 990000, 50, Side::Buy));
+  EXPECT_EQ(book_.replace_passive(1, kInvalidOrderId, 1020000, 10),
+            ReplaceResult::Rejected);
+  EXPECT_EQ(book_.order_count(), 1);
+  EXPECT_EQ(book_.bid_level_count(), 0);
+  EXPECT_EQ(pool_.allocated(), 1);
+}
+
+TEST_F(CompactBookTest, LevelStoreGrowthKeepsQueues) {
+  // More levels than the initial reservation forces the store to grow
+  for (uint64_t i = 0; i < 300; ++i) {
+    ASSERT_TRUE(book_.add_order(2 * i + 1, 1000000 - i * 100, 10, Side::Buy));
+    ASSERT_TRUE(book_.add_order(2 * i + 2, 1000000 - i * 100, 10, Side::Buy));
+  }
+  EXPECT_EQ(book_.bid_level_count(), 300u);
+  EXPECT_EQ(book_.queue(book_.bids().back()),
+            (std::vector<uint64_t>{599, 600}));
+
+  ASSERT_TRUE(book_.add_order(1000, 1000000 - 299 * 100, 20 * 300,
+                              Side::Sell));
+  EXPECT_TRUE(book_.empty());
+  EXPECT_EQ(pool_.allocated(), 0u);
+}
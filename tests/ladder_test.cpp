@@ -0,0 +1,228 @@
+/**
+ * @file ladder_test.cpp
+ * @brief Tests for LadderOrderBook (tick-indexed ring) and LevelBitmap.
+ *
+ * Verifies that the ladder engine reproduces OrderBook matching semantics
+ * and that window re-centring / overflow levels keep the book consistent.
+ */
+
+#include "book/ladder_order_book.hpp"
+#include <gtest/gtest.h>
+
+using namespace book;
+
+// ============================================================================
+// LevelBitmap
+// ============================================================================
+
+TEST(LevelBitmapTest, FindFirstAndLast) {
+  LevelBitmap<256> bits;
+  EXPECT_TRUE(bits.none());
+  EXPECT_EQ(bits.find_first_from(0), bits.npos);
+  EXPECT_EQ(bits.find_last_below(256), bits.npos);
+
+  bits.set(3);
+  bits.set(64);
+  bits.set(200);
+
+  EXPECT_EQ(bits.find_first_from(0), 3u);
+  EXPECT_EQ(bits.find_first_from(4), 64u);
+  EXPECT_EQ(bits.find_first_from(65), 200u);
+  EXPECT_EQ(bits.find_first_from(201), bits.npos);
+
+  EXPECT_EQ(bits.find_last_below(256), 200u);
+  EXPECT_EQ(bits.find_last_below(200), 64u);
+  EXPECT_EQ(bits.find_last_below(64), 3u);
+  EXPECT_EQ(bits.find_last_below(3), bits.npos);
+
+  bits.clear(64);
+  EXPECT_EQ(bits.find_first_from(4), 200u);
+  EXPECT_TRUE(bits.test(3));
+  EXPECT_FALSE(bits.test(64));
+}
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class LadderTest : public ::testing::Test {
+protected:
+  static constexpr std::size_t POOL_CAPACITY = 1000;
+  static constexpr std::size_t LADDER_TICKS = 64;
+
+  MemPool<Order, POOL_CAPACITY> pool_;
+  LadderOrderBook<POOL_CAPACITY, LADDER_TICKS> book_{pool_};
+};
+
+// ============================================================================
+// Matching Semantics (mirrors matching_test.cpp)
+// ============================================================================
+
+TEST_F(LadderTest, RestingOrders_NoMatch) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 1010000, 50, Side::Sell));
+
+  EXPECT_EQ(book_.order_count(), 2);
+  EXPECT_EQ(book_.best_bid().value(), 1000000);
+  EXPECT_EQ(book_.best_ask().value(), 1010000);
+  EXPECT_EQ(book_.spread().value(), 10000);
+  EXPECT_EQ(book_.best_bid_volume(), 100);
+  EXPECT_EQ(book_.best_ask_volume(), 50);
+}
+
+TEST_F(LadderTest, CrossingOrder_MultipleLevels) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 50, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 999900, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(3, 999800, 200, Side::Buy));
+  EXPECT_EQ(book_.bid_level_count(), 3);
+
+  ASSERT_TRUE(book_.add_order(4, 999800, 120, Side::Sell));
+
+  EXPECT_EQ(book_.bid_level_count(), 2);
+  EXPECT_EQ(book_.best_bid().value(), 999900);
+  EXPECT_EQ(book_.best_bid_volume(), 30);
+}
+
+TEST_F(LadderTest, CrossingOrder_PartialFill_TakerRests) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 50, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 999900, 100, Side::Sell));
+
+  EXPECT_FALSE(book_.best_bid().has_value());
+  EXPECT_EQ(book_.best_ask().value(), 999900);
+  EXPECT_EQ(book_.best_ask_volume(), 50);
+  EXPECT_EQ(book_.order_count(), 1);
+}
+
+TEST_F(LadderTest, FIFO_SamePriceLevel) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(3, 1000000, 100, Side::Buy));
+
+  ASSERT_TRUE(book_.add_order(4, 999900, 150, Side::Sell));
+
+  EXPECT_EQ(book_.order_count(), 2);
+  EXPECT_EQ(book_.best_bid_volume(), 150);
+  EXPECT_FALSE(book_.cancel_order(1));
+  EXPECT_TRUE(book_.cancel_order(2));
+}
+
+TEST_F(LadderTest, CancelReduceReplace) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 999900, 100, Side::Buy));
+
+  ASSERT_TRUE(book_.reduce_order(1, 40));
+  EXPECT_EQ(book_.best_bid_volume(), 60);
+
+  ASSERT_TRUE(book_.replace_order(1, 10, 999800, 25));
+  EXPECT_EQ(book_.best_bid().value(), 999900);
+  EXPECT_EQ(book_.bid_level_count(), 2);
+
+  ASSERT_TRUE(book_.cancel_order(2));
+  EXPECT_EQ(book_.best_bid().value(), 999800);
+  EXPECT_EQ(book_.best_bid_volume(), 25);
+
+  ASSERT_TRUE(book_.reduce_order(10, 25));
+  EXPECT_TRUE(book_.empty());
+  EXPECT_EQ(book_.bid_level_count(), 0);
+}
+
+TEST_F(LadderTest, DuplicateOrderId_Rejected) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+  EXPECT_FALSE(book_.add_order(1, 1010000, 50, Side::Sell));
+  EXPECT_EQ(book_.order_count(), 1);
+}
+
+TEST_F(LadderTest, ReservedOrderId_Rejected) {
+  ASSERT_TRUE(book_.add_order(1, 1010000, 100, Side::Sell));
+  EXPECT_FALSE(book_.add_order(kInvalidOrderId, 1010000, 50, Side::Buy));
+  EXPECT_FALSE(book_.insert_order(kInvalidOrderId, 990000, 50, Side::Buy));
+  EXPECT_EQ(book_.replace_passive(1, kInvalidOrderId, 1020000, 10),
+            ReplaceResult::Rejected);
+  EXPECT_EQ(book_.order_count(), 1);
+  EXPECT_EQ(book_.bid_level_count(), 0);
+  EXPECT_EQ(pool_.allocated(), 1);
+}
+
+// ============================================================================
+// Window / Overflow Behaviour
+// ============================================================================
+
+TEST_F(LadderTest, FarPricesSpillToOverflow) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+
+  // 100 ticks below the best bid - outside a 64-tick window
+  ASSERT_TRUE(book_.add_order(2, 990000, 100, Side::Buy));
+
+  EXPECT_EQ(book_.overflow_level_count(), 1u);
+  EXPECT_EQ(book_.bid_level_count(), 2);
+  EXPECT_EQ(book_.best_bid().value(), 1000000);
+
+  // Draining the ring falls back to the overflow level
+  ASSERT_TRUE(book_.cancel_order(1));
+  EXPECT_EQ(book_.best_bid().value(), 990000);
+  ASSERT_TRUE(book_.cancel_order(2));
+  EXPECT_TRUE(book_.empty());
+  EXPECT_EQ(book_.overflow_level_count(), 0u);
+}
+
+TEST_F(LadderTest, NewTouchOutsideWindowRecenters) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 1000100, 100, Side::Sell));
+
+  // New best ask far above: window moves, old levels spill and stay valid
+  ASSERT_TRUE(book_.cancel_order(2));
+  ASSERT_TRUE(book_.add_order(3, 1020000, 100, Side::Sell));
+  ASSERT_TRUE(book_.add_order(4, 1019000, 100, Side::Buy));
+
+  EXPECT_LE(book_.window_low(), 1019000u);
+  EXPECT_GE(book_.window_high(), 1020000u);
+  EXPECT_EQ(book_.best_bid().value(), 1019000);
+  EXPECT_EQ(book_.best_ask().value(), 1020000);
+  EXPECT_EQ(book_.bid_level_count(), 2);
+
+  // Order 1 now lives in the overflow and is still cancellable
+  ASSERT_TRUE(book_.cancel_order(1));
+  EXPECT_EQ(book_.bid_level_count(), 1);
+
+  // Sweep back down through the window
+  ASSERT_TRUE(book_.add_order(5, 1019000, 150, Side::Sell));
+  EXPECT_FALSE(book_.best_bid().has_value());
+  EXPECT_EQ(book_.best_ask().value(), 1019000);
+  EXPECT_EQ(book_.best_ask_volume(), 50);
+}
+
+TEST_F(LadderTest, OffTickPricesAreSupported) {
+  ASSERT_TRUE(book_.add_order(1, 1000050, 100, Side::Buy)); // Sub-penny
+  ASSERT_TRUE(book_.add_order(2, 1000000, 100, Side::Buy));
+
+  EXPECT_EQ(book_.best_bid().value(), 1000050);
+  EXPECT_EQ(book_.bid_level_count(), 2);
+
+  ASSERT_TRUE(book_.add_order(3, 1000000, 150, Side::Sell));
+  EXPECT_EQ(book_.best_bid().value(), 1000000);
+  EXPECT_EQ(book_.best_bid_volume(), 50);
+}
+
+TEST_F(LadderTest, WindowWrapAroundKeepsPriceOrder) {
+  // Anchor, then move the window so its base is not slot-aligned
+  ASSERT_TRUE(book_.add_order(1, 1000000, 10, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 1005000, 10, Side::Buy)); // re-centre
+
+  for (uint64_t i = 0; i < 20; ++i) {
+    ASSERT_TRUE(book_.add_order(100 + i, 1005000 - i * 100, 10, Side::Buy));
+    ASSERT_TRUE(book_.add_order(200 + i, 1006000 + i * 100, 10, Side::Sell));
+  }
+
+  EXPECT_EQ(book_.best_bid().value(), 1005000);
+  EXPECT_EQ(book_.best_ask().value(), 1006000);
+
+  // Walk the bid side down level by level
+  uint64_t expected = 1005000;
+  ASSERT_TRUE(book_.cancel_order(2));
+  for (uint64_t i = 0; i < 20; ++i) {
+    EXPECT_EQ(book_.best_bid().value(), expected);
+    ASSERT_TRUE(book_.cancel_order(100 + i));
+    expected -= 100;
+  }
+  EXPECT_EQ(book_.best_bid().value(), 1000000);
+}
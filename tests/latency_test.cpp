@@ -0,0 +1,187 @@
+/**
+ * @file latency_test.cpp
+ * @brief Unit tests for the TSC clock and latency histograms.
+ */
+
+#include <gtest/gtest.h>
+#include <metrics/latency_histogram.hpp>
+#include <metrics/tsc_clock.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace metrics::test {
+
+using Histogram = LatencyHistogram<5>;
+
+// ============================================================================
+// LatencyHistogram - Bucket Mapping
+// ============================================================================
+
+TEST(LatencyHistogramTest, SmallValuesHaveExactBuckets) {
+  for (uint64_t v = 0; v < Histogram::kSubBuckets; ++v) {
+    EXPECT_EQ(Histogram::bucket_index(v), v);
+    EXPECT_EQ(Histogram::bucket_lower(v), v);
+    EXPECT_EQ(Histogram::bucket_upper(v), v);
+  }
+}
+
+TEST(LatencyHistogramTest, BucketsTileTheRangeWithBoundedWidth) {
+  for (std::size_t i = 1; i < Histogram::kBucketCount; ++i) {
+    ASSERT_EQ(Histogram::bucket_lower(i), Histogram::bucket_upper(i - 1) + 1);
+    ASSERT_EQ(Histogram::bucket_index(Histogram::bucket_lower(i)), i);
+    ASSERT_EQ(Histogram::bucket_index(Histogram::bucket_upper(i)), i);
+
+    // Width never exceeds 1/32 of the bucket's smallest value
+    const uint64_t width =
+        Histogram::bucket_upper(i) - Histogram::bucket_lower(i);
+    ASSERT_LE(width, Histogram::bucket_lower(i) / Histogram::kSubBuckets);
+  }
+  EXPECT_EQ(Histogram::bucket_index(UINT64_MAX), Histogram::kBucketCount - 1);
+}
+
+// ============================================================================
+// LatencyHistogram - Recording and Percentiles
+// ============================================================================
+
+TEST(LatencyHistogramTest, EmptyHistogramReportsZero) {
+  const Histogram h;
+  EXPECT_EQ(h.count(), 0u);
+  EXPECT_EQ(h.min(), 0u);
+  EXPECT_EQ(h.max(), 0u);
+  EXPECT_EQ(h.value_at_percentile(99.0), 0u);
+  EXPECT_DOUBLE_EQ(h.mean(), 0.0);
+}
+
+TEST(LatencyHistogramTest, PercentilesOfUniformValues) {
+  Histogram h;
+  for (uint64_t v = 1; v <= 10000; ++v) {
+    h.record(v);
+  }
+  EXPECT_EQ(h.count(), 10000u);
+  EXPECT_EQ(h.min(), 1u);
+  EXPECT_EQ(h.max(), 10000u);
+  EXPECT_DOUBLE_EQ(h.mean(), 5000.5);
+
+  // Never below the true value, at most one bucket (~3%) above it
+  const auto near = [](uint64_t reported, uint64_t exact) {
+    return reported >= exact && reported <= exact + exact / 32;
+  };
+  EXPECT_TRUE(near(h.value_at_percentile(50.0), 5000));
+  EXPECT_TRUE(near(h.value_at_percentile(90.0), 9000));
+  EXPECT_TRUE(near(h.value_at_percentile(99.0), 9900));
+  EXPECT_TRUE(near(h.value_at_percentile(99.9), 9990));
+  EXPECT_EQ(h.value_at_percentile(100.0), 10000u);
+}
+
+TEST(LatencyHistogramTest, TailIsNotHiddenByTheBulk) {
+  Histogram h;
+  for (int i = 0; i < 999; ++i) {
+    h.record(40);
+  }
+  h.record(50000); // One outlier in a thousand
+
+  EXPECT_EQ(h.value_at_percentile(50.0), 40u);
+  EXPECT_EQ(h.value_at_percentile(99.0), 40u);
+  EXPECT_EQ(h.value_at_percentile(99.95), 50000u);
+  EXPECT_EQ(h.max(), 50000u);
+}
+
+TEST(LatencyHistogramTest, MergeAddsCounts) {
+  Histogram a;
+  Histogram b;
+  a.record(10);
+  b.record(1000);
+  b.record(5);
+  a.merge(b);
+
+  EXPECT_EQ(a.count(), 3u);
+  EXPECT_EQ(a.min(), 5u);
+  EXPECT_EQ(a.max(), 1000u);
+  EXPECT_EQ(a.value_at_percentile(50.0), 10u);
+
+  a.reset();
+  EXPECT_EQ(a.count(), 0u);
+}
+
+// ============================================================================
+// LatencyRecorder
+// ============================================================================
+
+TEST(LatencyRecorderTest, OneHistogramPerType) {
+  LatencyRecorder<true> recorder;
+  for (int i = 0; i < 3; ++i) {
+    recorder.stop('A', recorder.start());
+  }
+  recorder.stop('D', recorder.start());
+
+  std::vector<uint8_t> types;
+  std::vector<uint64_t> counts;
+  recorder.for_each([&](uint8_t type, const auto &histogram) {
+    types.push_back(type);
+    counts.push_back(histogram.count());
+  });
+  EXPECT_EQ(types, (std::vector<uint8_t>{'A', 'D'}));
+  EXPECT_EQ(counts, (std::vector<uint64_t>{3, 1}));
+
+  LatencyRecorder<true> other;
+  other.stop('D', other.start());
+  other.stop('X', other.start());
+  recorder.merge(other);
+  types.clear();
+  counts.clear();
+  recorder.for_each([&](uint8_t type, const auto &histogram) {
+    types.push_back(type);
+    counts.push_back(histogram.count());
+  });
+  EXPECT_EQ(types, (std::vector<uint8_t>{'A', 'D', 'X'}));
+  EXPECT_EQ(counts, (std::vector<uint64_t>{3, 2, 1}));
+}
+
+TEST(LatencyRecorderTest, DisabledRecorderIsEmpty) {
+  static_assert(std::is_empty_v<LatencyRecorder<false>>);
+  LatencyRecorder<false> recorder;
+  EXPECT_EQ(recorder.start(), 0u);
+  recorder.stop('A', recorder.start());
+  int visited = 0;
+  recorder.for_each([&](uint8_t, const auto &) { ++visited; });
+  EXPECT_EQ(visited, 0);
+}
+
+// ============================================================================
+// TscClock
+// ============================================================================
+
+TEST(TscClockTest, TicksAdvance) {
+  const uint64_t first = TscClock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  EXPECT_GT(TscClock::now(), first);
+}
+
+TEST(TscClockTest, CalibratedRateMeasuresWallTime) {
+  const TscClock clock = TscClock::calibrate(std::chrono::milliseconds(5));
+  EXPECT_GT(clock.ghz(), 0.0);
+
+  const auto wall_start = std::chrono::steady_clock::now();
+  const uint64_t start = TscClock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  const uint64_t end = TscClock::now();
+  const double wall_ns = std::chrono::duration<double, std::nano>(
+                             std::chrono::steady_clock::now() - wall_start)
+                             .count();
+
+  // Generous bounds: a loaded CI machine can stretch either interval
+  EXPECT_GT(clock.to_ns(end - start), wall_ns * 0.8);
+  EXPECT_LT(clock.to_ns(end - start), wall_ns * 1.2);
+}
+
+TEST(TscClockTest, FixedRateConversion) {
+  constexpr TscClock clock(0.5); // 2 GHz
+  static_assert(clock.to_ns(100) == 50.0);
+  EXPECT_DOUBLE_EQ(clock.ghz(), 2.0);
+}
+
+} // namespace metrics::test
@@ -0,0 +1,218 @@
+/**
+ * @file line_arbitrator_test.cpp
+ * @brief Unit tests for A/B line arbitration on MoldUDP64 sequence numbers.
+ */
+
+#include <gtest/gtest.h>
+#include <itch/line_arbitrator.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace itch::test {
+
+// ============================================================================
+// Recording Handler
+// ============================================================================
+
+/**
+ * @brief Records delivered sequences and reported gaps.
+ *
+ * Each message's payload is one byte holding its sequence number, so the
+ * test can check the arbitrator delivered the right pointer too.
+ */
+struct Recorder {
+  std::vector<uint64_t> sequences;
+  std::vector<std::pair<uint64_t, uint64_t>> gaps; // (first, count)
+
+  void on_message(const char *msg, size_t len, uint64_t sequence) {
+    EXPECT_EQ(len, 1u);
+    EXPECT_EQ(static_cast<unsigned char>(*msg),
+              static_cast<unsigned char>(sequence));
+    sequences.push_back(sequence);
+  }
+
+  void on_gap(uint64_t first, uint64_t count) {
+    gaps.emplace_back(first, count);
+  }
+};
+
+class LineArbitratorTest : public ::testing::Test {
+protected:
+  static constexpr std::size_t kWindow = 8;
+
+  LineArbitratorTest() {
+    for (std::size_t i = 0; i < payload_.size(); ++i) {
+      payload_[i] = static_cast<char>(i);
+    }
+  }
+
+  /// Offer one packet of `count` messages starting at `first` on `line`
+  void packet(Line line, uint64_t first, uint64_t count) {
+    for (uint64_t seq = first; seq < first + count; ++seq) {
+      arb_.offer(line, seq, &payload_[seq], 1, recorder_);
+    }
+    arb_.observe(line, first + count);
+    arb_.resolve(recorder_);
+  }
+
+  std::vector<uint64_t> range(uint64_t first, uint64_t last) const {
+    std::vector<uint64_t> out;
+    for (uint64_t seq = first; seq <= last; ++seq) {
+      out.push_back(seq);
+    }
+    return out;
+  }
+
+  std::vector<char> payload_ = std::vector<char>(256);
+  LineArbitrator<kWindow> arb_;
+  Recorder recorder_;
+};
+
+// ============================================================================
+// Duplicates and Gap Fill
+// ============================================================================
+
+TEST_F(LineArbitratorTest, IdenticalLines_DropDuplicates) {
+  packet(Line::A, 1, 3);
+  packet(Line::B, 1, 3);
+  packet(Line::B, 4, 2);
+  packet(Line::A, 4, 2);
+
+  EXPECT_EQ(recorder_.sequences, range(1, 5));
+  EXPECT_TRUE(recorder_.gaps.empty());
+
+  const ArbitrationStats &stats = arb_.stats();
+  EXPECT_EQ(stats.delivered, 5u);
+  EXPECT_EQ(stats.delivered_from[0], 3u);
+  EXPECT_EQ(stats.delivered_from[1], 2u);
+  EXPECT_EQ(stats.duplicates, 5u);
+  EXPECT_EQ(arb_.next_sequence(), 6u);
+}
+
+TEST_F(LineArbitratorTest, GapOnA_FilledFromB) {
+  packet(Line::A, 1, 2);
+  packet(Line::A, 5, 2); // 3..4 lost on A: parked
+  EXPECT_EQ(arb_.buffered(), 2u);
+  EXPECT_EQ(recorder_.sequences, range(1, 2));
+
+  packet(Line::B, 1, 2);
+  packet(Line::B, 3, 2); // Fills the hole and releases 5..6
+  packet(Line::B, 5, 2);
+
+  EXPECT_EQ(recorder_.sequences, range(1, 6));
+  EXPECT_TRUE(recorder_.gaps.empty());
+  EXPECT_EQ(arb_.buffered(), 0u);
+  EXPECT_EQ(arb_.stats().delivered_from[1], 2u);
+  EXPECT_EQ(arb_.stats().max_buffered, 2u);
+}
+
+TEST_F(LineArbitratorTest, DuplicateOfParkedMessage_Dropped) {
+  packet(Line::A, 1, 1);
+  packet(Line::A, 3, 1);
+  arb_.offer(Line::B, 3, &payload_[3], 1, recorder_); // Same, from B
+  EXPECT_EQ(arb_.stats().duplicates, 1u);
+  EXPECT_EQ(arb_.buffered(), 1u);
+}
+
+// ============================================================================
+// Unrecoverable Gaps
+// ============================================================================
+
+TEST_F(LineArbitratorTest, GapOnBothLines_ReportedOncePast) {
+  packet(Line::A, 1, 2);
+  packet(Line::A, 6, 2);
+  EXPECT_TRUE(recorder_.gaps.empty()); // B may still deliver 3..5
+
+  packet(Line::B, 1, 2);
+  packet(Line::B, 6, 2); // B skipped them too
+
+  ASSERT_EQ(recorder_.gaps.size(), 1u);
+  EXPECT_EQ(recorder_.gaps[0], std::make_pair(uint64_t{3}, uint64_t{3}));
+  EXPECT_EQ(recorder_.sequences, (std::vector<uint64_t>{1, 2, 6, 7}));
+  EXPECT_EQ(arb_.stats().gaps, 1u);
+  EXPECT_EQ(arb_.stats().gap_messages, 3u);
+}
+
+TEST_F(LineArbitratorTest, ClosedLine_DoesNotHoldGapOpen) {
+  packet(Line::A, 1, 2);
+  arb_.close_line(Line::B);
+  packet(Line::A, 4, 1);
+
+  ASSERT_EQ(recorder_.gaps.size(), 1u);
+  EXPECT_EQ(recorder_.gaps[0], std::make_pair(uint64_t{3}, uint64_t{1}));
+  EXPECT_EQ(recorder_.sequences, (std::vector<uint64_t>{1, 2, 4}));
+}
+
+TEST_F(LineArbitratorTest, WindowOverflow_AbandonsOldestHole) {
+  packet(Line::A, 1, 1);
+  // Line A races kWindow + 2 messages ahead of the hole at 2
+  for (uint64_t seq = 3; seq <= 3 + kWindow + 1; ++seq) {
+    arb_.offer(Line::A, seq, &payload_[seq], 1, recorder_);
+  }
+
+  ASSERT_EQ(recorder_.gaps.size(), 1u);
+  EXPECT_EQ(recorder_.gaps[0], std::make_pair(uint64_t{2}, uint64_t{1}));
+  EXPECT_EQ(recorder_.sequences.front(), 1u);
+  EXPECT_EQ(recorder_.sequences.back(), 3 + kWindow + 1);
+  EXPECT_LE(arb_.stats().max_buffered, kWindow);
+}
+
+TEST_F(LineArbitratorTest, LargeJump_ResynchronisesInOneGap) {
+  packet(Line::A, 1, 1);
+  packet(Line::A, 100, 3); // Far beyond the window
+  packet(Line::B, 100, 3); // Late copies are duplicates
+
+  ASSERT_EQ(recorder_.gaps.size(), 1u);
+  EXPECT_EQ(recorder_.gaps[0], std::make_pair(uint64_t{2}, uint64_t{98}));
+  EXPECT_EQ(recorder_.sequences, (std::vector<uint64_t>{1, 100, 101, 102}));
+  EXPECT_EQ(arb_.stats().duplicates, 3u);
+}
+
+TEST_F(LineArbitratorTest, Flush_ReportsTrailingHoles) {
+  packet(Line::A, 1, 1);
+  arb_.offer(Line::A, 4, &payload_[4], 1, recorder_);
+  arb_.offer(Line::A, 7, &payload_[7], 1, recorder_);
+
+  arb_.flush(recorder_);
+
+  EXPECT_EQ(recorder_.sequences, (std::vector<uint64_t>{1, 4, 7}));
+  ASSERT_EQ(recorder_.gaps.size(), 2u);
+  EXPECT_EQ(recorder_.gaps[0], std::make_pair(uint64_t{2}, uint64_t{2}));
+  EXPECT_EQ(recorder_.gaps[1], std::make_pair(uint64_t{5}, uint64_t{2}));
+  EXPECT_EQ(arb_.buffered(), 0u);
+}
+
+TEST_F(LineArbitratorTest, TailLostOnBothLines_ReportedByHeartbeats) {
+  packet(Line::A, 1, 2);
+  packet(Line::B, 1, 2);
+  packet(Line::A, 6, 0); // Heartbeat: A has sent 3..5
+  EXPECT_TRUE(recorder_.gaps.empty()); // B may still deliver them
+
+  packet(Line::B, 6, 0); // So has B: nothing parked, but lost on both
+
+  ASSERT_EQ(recorder_.gaps.size(), 1u);
+  EXPECT_EQ(recorder_.gaps[0], std::make_pair(uint64_t{3}, uint64_t{3}));
+  EXPECT_EQ(recorder_.sequences, range(1, 2));
+  EXPECT_EQ(arb_.next_sequence(), 6u);
+
+  packet(Line::A, 6, 1); // The stream continues without a second gap
+  EXPECT_EQ(recorder_.sequences, (std::vector<uint64_t>{1, 2, 6}));
+  EXPECT_EQ(recorder_.gaps.size(), 1u);
+}
+
+TEST_F(LineArbitratorTest, Flush_ReportsTailLostOnBothLines) {
+  packet(Line::A, 1, 2);
+  packet(Line::B, 1, 2);
+  arb_.observe(Line::A, 5); // A announced 3..4, neither line delivered
+
+  arb_.flush(recorder_);
+
+  ASSERT_EQ(recorder_.gaps.size(), 1u);
+  EXPECT_EQ(recorder_.gaps[0], std::make_pair(uint64_t{3}, uint64_t{2}));
+  EXPECT_EQ(arb_.stats().gap_messages, 2u);
+  EXPECT_EQ(arb_.next_sequence(), 5u);
+}
+
+} // namespace itch::test
@@ -0,0 +1,241 @@
+/**
+ * @file market_by_order_test.cpp
+ * @brief Tests for the passive market-by-order book (ITCH events applied
+ *        exactly, no matching).
+ */
+
+#include "book/compact_order_book.hpp"
+#include "book/ladder_order_book.hpp"
+#include "book/market_by_order.hpp"
+#include "book/order_book.hpp"
+#include <gtest/gtest.h>
+
+#include <itch/parser.hpp>
+#include <vector>
+
+using namespace book;
+
+namespace {
+
+// ============================================================================
+// ITCH Message Builder
+// ============================================================================
+
+/**
+ * @brief Writes order messages at their ITCH 5.0 offsets (big-endian).
+ */
+class ItchMessage {
+public:
+  explicit ItchMessage(char type, uint16_t locate)
+      : bytes_(itch::get_message_size(type), 0) {
+    bytes_[0] = type;
+    put(1, locate, 2);
+  }
+
+  ItchMessage &put(std::size_t offset, uint64_t value, std::size_t width) {
+    for (std::size_t i = 0; i < width; ++i) {
+      bytes_[offset + i] =
+          static_cast<char>(value >> (8 * (width - 1 - i)));
+    }
+    return *this;
+  }
+
+  ItchMessage &put_char(std::size_t offset, char c) {
+    bytes_[offset] = c;
+    return *this;
+  }
+
+  const char *data() const { return bytes_.data(); }
+  std::size_t size() const { return bytes_.size(); }
+
+private:
+  std::vector<char> bytes_;
+};
+
+ItchMessage add(uint16_t locate, uint64_t ref, char side, uint32_t shares,
+                uint32_t price, char type = 'A') {
+  ItchMessage msg(type, locate);
+  msg.put(11, ref, 8).put_char(19, side).put(20, shares, 4).put(32, price, 4);
+  return msg;
+}
+
+ItchMessage executed(uint16_t locate, uint64_t ref, uint32_t shares) {
+  ItchMessage msg('E', locate);
+  msg.put(11, ref, 8).put(19, shares, 4);
+  return msg;
+}
+
+ItchMessage executed_with_price(uint16_t locate, uint64_t ref,
+                                uint32_t shares) {
+  ItchMessage msg('C', locate);
+  msg.put(11, ref, 8).put(19, shares, 4).put_char(31, 'Y');
+  return msg;
+}
+
+ItchMessage cancel(uint16_t locate, uint64_t ref, uint32_t shares) {
+  ItchMessage msg('X', locate);
+  msg.put(11, ref, 8).put(19, shares, 4);
+  return msg;
+}
+
+ItchMessage del(uint16_t locate, uint64_t ref) {
+  ItchMessage msg('D', locate);
+  msg.put(11, ref, 8);
+  return msg;
+}
+
+ItchMessage replace(uint16_t locate, uint64_t old_ref, uint64_t new_ref,
+                    uint32_t shares, uint32_t price) {
+  ItchMessage msg('U', locate);
+  msg.put(11, old_ref, 8).put(19, new_ref, 8).put(27, shares, 4);
+  msg.put(31, price, 4);
+  return msg;
+}
+
+} // namespace
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+template <typename Book> class MarketByOrderTest : public ::testing::Test {
+protected:
+  void apply(const ItchMessage &msg) {
+    ASSERT_EQ(parser_.parse(msg.data(), msg.size(), visitor_),
+              itch::ParseResult::Ok);
+  }
+
+  Book &book(uint16_t locate) { return *books_.find(locate); }
+
+  typename Book::PoolType pool_;
+  BookManager<Book> books_{pool_, 16};
+  MarketByOrderVisitor<Book> visitor_{books_};
+  itch::Parser parser_;
+};
+
+constexpr std::size_t kPoolCapacity = 1000;
+using BookTypes = ::testing::Types<OrderBook<kPoolCapacity>,
+                                   LadderOrderBook<kPoolCapacity, 64>,
+                                   CompactOrderBook<kPoolCapacity>>;
+TYPED_TEST_SUITE(MarketByOrderTest, BookTypes);
+
+// ============================================================================
+// Event Semantics
+// ============================================================================
+
+TYPED_TEST(MarketByOrderTest, CrossingAddsRestWithoutMatching) {
+  this->apply(add(5, 1001, 'B', 100, 1000000));
+  this->apply(add(5, 1002, 'S', 40, 999900)); // Would cross a matching book
+
+  auto &book = this->book(5);
+  EXPECT_EQ(book.order_count(), 2u);
+  EXPECT_EQ(book.best_bid().value(), 1000000u);
+  EXPECT_EQ(book.best_ask().value(), 999900u);
+  EXPECT_EQ(book.best_bid_volume(), 100u);
+  EXPECT_EQ(this->visitor_.stats().adds, 2u);
+}
+
+TYPED_TEST(MarketByOrderTest, ExecutionsReduceByExchangeRef) {
+  this->apply(add(5, 1001, 'B', 100, 1000000));
+  this->apply(add(5, 1002, 'B', 50, 1000000));
+
+  this->apply(executed(5, 1001, 30));
+  EXPECT_EQ(this->book(5).best_bid_volume(), 120u);
+  EXPECT_EQ(this->book(5).order_count(), 2u);
+
+  this->apply(executed_with_price(5, 1001, 70)); // Fully executed
+  EXPECT_EQ(this->book(5).best_bid_volume(), 50u);
+  EXPECT_EQ(this->book(5).order_count(), 1u);
+  EXPECT_EQ(this->visitor_.stats().executions, 2u);
+}
+
+TYPED_TEST(MarketByOrderTest, PartialCancelAndDelete) {
+  this->apply(add(5, 1001, 'S', 100, 1010000, 'F'));
+  this->apply(cancel(5, 1001, 25));
+  EXPECT_EQ(this->book(5).best_ask_volume(), 75u);
+
+  this->apply(del(5, 1001));
+  EXPECT_TRUE(this->book(5).empty());
+  EXPECT_EQ(this->pool_.allocated(), 0u);
+  EXPECT_EQ(this->visitor_.stats().cancels, 1u);
+  EXPECT_EQ(this->visitor_.stats().deletes, 1u);
+}
+
+TYPED_TEST(MarketByOrderTest, ReplaceMovesOrderUnderNewRef) {
+  this->apply(add(5, 1001, 'B', 100, 1000000));
+  this->apply(add(5, 1002, 'S', 100, 1010000));
+  this->apply(replace(5, 1001, 2001, 60, 1020000)); // Crosses: still rests
+
+  auto &book = this->book(5);
+  EXPECT_EQ(book.order_count(), 2u);
+  EXPECT_EQ(book.best_bid().value(), 1020000u);
+  EXPECT_EQ(book.best_bid_volume(), 60u);
+
+  this->apply(del(5, 1001)); // Old ref is gone
+  EXPECT_EQ(this->visitor_.stats().unknown, 1u);
+  this->apply(del(5, 2001));
+  EXPECT_EQ(book.order_count(), 1u);
+  EXPECT_EQ(this->visitor_.stats().replaces, 1u);
+}
+
+TYPED_TEST(MarketByOrderTest, ReplaceOntoLiveRefRejected) {
+  this->apply(add(5, 1001, 'B', 100, 1000000));
+  this->apply(add(5, 1002, 'B', 50, 999900));
+  this->apply(replace(5, 1001, 1002, 60, 1000100)); // New ref already live
+
+  // Both orders are untouched, and the U counts as refused, not unknown
+  auto &book = this->book(5);
+  EXPECT_EQ(book.order_count(), 2u);
+  EXPECT_EQ(book.best_bid().value(), 1000000u);
+  EXPECT_EQ(book.best_bid_volume(), 100u);
+  EXPECT_EQ(this->visitor_.stats().rejected, 1u);
+  EXPECT_EQ(this->visitor_.stats().unknown, 0u);
+  EXPECT_EQ(this->visitor_.stats().replaces, 0u);
+  EXPECT_EQ(this->visitor_.stats().messages(), 3u);
+}
+
+// ============================================================================
+// Routing and Bookkeeping
+// ============================================================================
+
+TYPED_TEST(MarketByOrderTest, SymbolsAreIsolated) {
+  this->apply(add(1, 1001, 'B', 100, 1000000));
+  this->apply(add(2, 1002, 'B', 100, 500000));
+  this->apply(del(2, 1001)); // Right ref, wrong symbol
+
+  EXPECT_EQ(this->book(1).order_count(), 1u);
+  EXPECT_EQ(this->book(2).order_count(), 1u);
+  EXPECT_EQ(this->visitor_.stats().unknown, 1u);
+}
+
+TYPED_TEST(MarketByOrderTest, UnknownRefsCountedWithoutCreatingBooks) {
+  this->apply(executed(9, 42, 10));
+  this->apply(cancel(9, 42, 10));
+  this->apply(del(9, 42));
+  this->apply(replace(9, 42, 43, 10, 1000000));
+
+  EXPECT_EQ(this->books_.book_count(), 0u);
+  EXPECT_EQ(this->visitor_.stats().unknown, 4u);
+  EXPECT_EQ(this->visitor_.stats().messages(), 4u);
+}
+
+TYPED_TEST(MarketByOrderTest, MaxOrderRefIsUnknownNotAnEmptySlot) {
+  // 0xFFFFFFFFFFFFFFFF is the order index's empty-slot key
+  constexpr uint64_t kMaxRef = ~uint64_t{0};
+  this->apply(add(5, 1001, 'B', 100, 1000000));
+  this->apply(executed(5, kMaxRef, 10));
+  this->apply(cancel(5, kMaxRef, 10));
+  this->apply(del(5, kMaxRef));
+  this->apply(replace(5, kMaxRef, 1002, 10, 1000000));
+
+  EXPECT_EQ(this->visitor_.stats().unknown, 4u);
+  EXPECT_EQ(this->book(5).order_count(), 1u);
+  EXPECT_EQ(this->book(5).best_bid_volume(), 100u);
+}
+
+TYPED_TEST(MarketByOrderTest, DuplicateAddRejected) {
+  this->apply(add(5, 1001, 'B', 100, 1000000));
+  this->apply(add(5, 1001, 'B', 100, 1000000));
+  EXPECT_EQ(this->visitor_.stats().rejected, 1u);
+  EXPECT_EQ(this->book(5).order_count(), 1u);
+}
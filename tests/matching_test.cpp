@@ -7,8 +7,13 @@
  */
 
 #include "book/order_book.hpp"
+#include "book/segmented_pool.hpp"
 #include <gtest/gtest.h>
 
+#include <array>
+#include <utility>
+#include <vector>
+
 using namespace book;
 
 // ============================================================================
@@ -194,6 +199,83 @@ TEST_F(MatchingTest, CancelOrder_RemovesPriceLevel) {
   EXPECT_EQ(book_.best_bid().value(), 990000);
 }
 
+TEST_F(MatchingTest, CancelOrder_DeepBookKeepsOtherLevels) {
+  // 100 bid levels, cancel one in the middle of the ladder
+  for (uint64_t i = 0; i < 100; ++i) {
+    ASSERT_TRUE(book_.add_order(i + 1, 1000000 - i * 100, 10, Side::Buy));
+  }
+  EXPECT_EQ(book_.bid_level_count(), 100);
+
+  ASSERT_TRUE(book_.cancel_order(51)); // Level at 995000
+
+  EXPECT_EQ(book_.bid_level_count(), 99);
+  EXPECT_EQ(book_.best_bid().value(), 1000000);
+  for (const LevelRef &ref : book_.bids()) {
+    EXPECT_NE(ref.price, 995000u);
+    EXPECT_EQ(book_.level(ref).price, ref.price);
+  }
+
+  // Level slot is recycled for a new price
+  ASSERT_TRUE(book_.add_order(1000, 1000100, 10, Side::Buy));
+  EXPECT_EQ(book_.best_bid().value(), 1000100);
+  EXPECT_EQ(book_.best_bid_volume(), 10);
+}
+
+// ============================================================================
+// Scenario 3b: Reduce / Replace (ITCH E, C, X, U)
+// ============================================================================
+
+TEST_F(MatchingTest, ReduceOrder_Partial) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 1000000, 50, Side::Buy));
+
+  ASSERT_TRUE(book_.reduce_order(1, 30));
+
+  EXPECT_EQ(book_.order_count(), 2);
+  EXPECT_EQ(book_.best_bid_volume(), 120);
+
+  // Order 1 keeps time priority: a 70-share sell fills it exactly
+  ASSERT_TRUE(book_.add_order(3, 1000000, 70, Side::Sell));
+  EXPECT_EQ(book_.order_count(), 1);
+  EXPECT_FALSE(book_.cancel_order(1));
+  EXPECT_TRUE(book_.cancel_order(2));
+}
+
+TEST_F(MatchingTest, ReduceOrder_FullRemovesOrderAndLevel) {
+  ASSERT_TRUE(book_.add_order(1, 1010000, 100, Side::Sell));
+  ASSERT_TRUE(book_.add_order(2, 1020000, 100, Side::Sell));
+
+  ASSERT_TRUE(book_.reduce_order(1, 100));
+
+  EXPECT_EQ(book_.order_count(), 1);
+  EXPECT_EQ(book_.ask_level_count(), 1);
+  EXPECT_EQ(book_.best_ask().value(), 1020000);
+  EXPECT_FALSE(book_.reduce_order(1, 10));
+}
+
+TEST_F(MatchingTest, ReplaceOrder_MovesPriceAndId) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 990000, 100, Side::Buy));
+
+  ASSERT_TRUE(book_.replace_order(1, 10, 980000, 40));
+
+  EXPECT_EQ(book_.order_count(), 2);
+  EXPECT_EQ(book_.bid_level_count(), 2);
+  EXPECT_EQ(book_.best_bid().value(), 990000);
+  EXPECT_FALSE(book_.cancel_order(1));
+  EXPECT_TRUE(book_.cancel_order(10));
+}
+
+TEST_F(MatchingTest, ReplaceOrder_RejectsUnknownOrLiveId) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 990000, 100, Side::Buy));
+
+  EXPECT_FALSE(book_.replace_order(99, 100, 1000000, 10));
+  EXPECT_FALSE(book_.replace_order(1, 2, 1000000, 10));
+  EXPECT_EQ(book_.order_count(), 2);
+  EXPECT_EQ(book_.best_bid_volume(), 100);
+}
+
 // ============================================================================
 // Scenario 4: Price-Time Priority (FIFO)
 // ============================================================================
@@ -225,6 +307,59 @@ TEST_F(MatchingTest, FIFO_VerifyOrderRemoval) {
   EXPECT_TRUE(book_.cancel_order(2));  // Can cancel - still resting
 }
 
+// ============================================================================
+// Scenario 5: Execution Sinks
+// ============================================================================
+
+TEST_F(MatchingTest, ExecutionSink_StatefulLambda) {
+  ASSERT_TRUE(book_.add_order(1, 1010000, 100, Side::Sell));
+  ASSERT_TRUE(book_.add_order(2, 1020000, 100, Side::Sell));
+
+  uint64_t filled = 0;
+  uint64_t notional = 0;
+  ASSERT_TRUE(book_.add_order(3, 1020000, 150, Side::Buy,
+                              [&](const Execution &exec) {
+                                filled += exec.qty;
+                                notional += exec.qty * exec.price;
+                              }));
+
+  EXPECT_EQ(filled, 150u);
+  EXPECT_EQ(notional, 100u * 1010000 + 50u * 1020000);
+}
+
+TEST_F(MatchingTest, ExecutionSink_BufferRecordsSweepInOrder) {
+  for (uint64_t id = 1; id <= 6; ++id) {
+    ASSERT_TRUE(book_.add_order(id, 1000000 - (id % 3) * 100, 10, Side::Buy));
+  }
+
+  std::array<Execution, 4> storage{};
+  ExecutionBuffer sink(storage);
+  ASSERT_TRUE(book_.add_order(7, 990000, 60, Side::Sell, sink));
+
+  // Best price first (ids 3, 6 at 1000000), FIFO within a level
+  ASSERT_EQ(sink.size(), 4u);
+  EXPECT_EQ(sink.dropped(), 2u); // Buffer full: counted, not written
+  EXPECT_EQ(sink.executions()[0].maker_id, 3u);
+  EXPECT_EQ(sink.executions()[1].maker_id, 6u);
+  EXPECT_EQ(sink.executions()[2].maker_id, 1u);
+  EXPECT_EQ(sink.executions()[3].maker_id, 4u);
+  EXPECT_EQ(sink.executions()[3].taker_id, 7u);
+  EXPECT_EQ(sink.executions()[3].maker_side, Side::Buy);
+  EXPECT_TRUE(book_.empty());
+
+  sink.clear();
+  EXPECT_EQ(sink.size(), 0u);
+  EXPECT_EQ(sink.dropped(), 0u);
+}
+
+TEST_F(MatchingTest, ExecutionSink_NullFunctionPointerIsSkipped) {
+  ASSERT_TRUE(book_.add_order(1, 1000000, 100, Side::Buy));
+
+  OrderBook<POOL_CAPACITY>::ExecutionCallback none = nullptr;
+  ASSERT_TRUE(book_.add_order(2, 1000000, 40, Side::Sell, none));
+  EXPECT_EQ(book_.best_bid_volume(), 60);
+}
+
 // ============================================================================
 // Edge Cases
 // ============================================================================
@@ -235,6 +370,22 @@ TEST_F(MatchingTest, DuplicateOrderId_Rejected) {
   EXPECT_EQ(book_.order_count(), 1);
 }
 
+TEST_F(MatchingTest, ReservedOrderId_Rejected) {
+  // kInvalidOrderId marks empty index slots: it must never reach the book
+  ASSERT_TRUE(book_.add_order(1, 1010000, 100, Side::Sell));
+  EXPECT_FALSE(book_.add_order(kInvalidOrderId, 1010000, 50, Side::Buy));
+  EXPECT_FALSE(book_.insert_order(kInvalidOrderId, 990000, 50, Side::Buy));
+  EXPECT_FALSE(book_.replace_order(1, kInvalidOrderId, 1020000, 10));
+  EXPECT_EQ(book_.replace_passive(1, kInvalidOrderId, 1020000, 10),
+            ReplaceResult::Rejected);
+
+  // Nothing matched, rested or leaked, and the original order survived
+  EXPECT_EQ(book_.order_count(), 1);
+  EXPECT_EQ(book_.best_ask_volume(), 100);
+  EXPECT_FALSE(book_.best_bid().has_value());
+  EXPECT_EQ(pool_.allocated(), 1);
+}
+
 TEST_F(MatchingTest, SellSide_Matching) {
   // Build ask book
   ASSERT_TRUE(book_.add_order(1, 1010000, 100, Side::Sell)); // 101.00
@@ -273,6 +424,27 @@ TEST_F(MatchingTest, PoolExhaustion) {
   EXPECT_FALSE(small_book.add_order(3, 990000, 50, Side::Buy));
 }
 
+TEST_F(MatchingTest, SegmentedPool_GrowsInsteadOfRejecting) {
+  SegmentedPool<Order, 4> grown(4, 8);
+  BasicOrderBook<SegmentedPool<Order, 4>> grown_book(grown);
+
+  for (uint64_t id = 1; id <= 8; ++id) {
+    ASSERT_TRUE(grown_book.add_order(id, 1000000 - id * 100, 10, Side::Buy));
+  }
+  EXPECT_EQ(grown.segment_count(), 2u);
+  EXPECT_EQ(grown_book.order_count(), 8u);
+  EXPECT_EQ(grown_book.best_bid(), 999900u);
+
+  // Growth limit reached: the book rejects like a full MemPool
+  EXPECT_FALSE(grown_book.add_order(9, 990000, 10, Side::Buy));
+
+  // Orders in the first segment still match after the pool grew
+  ASSERT_TRUE(grown_book.add_order(10, 999900, 10, Side::Sell));
+  EXPECT_FALSE(grown_book.cancel_order(1));
+  EXPECT_EQ(grown_book.best_bid(), 999800u);
+  EXPECT_TRUE(grown_book.add_order(9, 990000, 10, Side::Buy));
+}
+
 // ============================================================================
 // Volume Tracking
 // ============================================================================
@@ -299,6 +471,36 @@ TEST_F(MatchingTest, VolumeTracking_AfterCancel) {
   EXPECT_EQ(book_.best_bid_volume(), 200);
 }
 
+// ============================================================================
+// Depth
+// ============================================================================
+
+TEST_F(MatchingTest, ForEachLevel_BestFirstUpToLimit) {
+  ASSERT_TRUE(book_.add_order(1, 990000, 10, Side::Buy));
+  ASSERT_TRUE(book_.add_order(2, 1000000, 20, Side::Buy));
+  ASSERT_TRUE(book_.add_order(3, 1000000, 5, Side::Buy));
+  ASSERT_TRUE(book_.add_order(4, 980000, 30, Side::Buy));
+  ASSERT_TRUE(book_.add_order(5, 1020000, 40, Side::Sell));
+  ASSERT_TRUE(book_.add_order(6, 1010000, 50, Side::Sell));
+
+  std::vector<std::pair<uint64_t, uint64_t>> bids;
+  EXPECT_EQ(book_.for_each_level(Side::Buy, 2,
+                                 [&](const PriceLevel &level) {
+                                   bids.emplace_back(level.price,
+                                                     level.total_volume);
+                                 }),
+            2u);
+  EXPECT_EQ(bids, (std::vector<std::pair<uint64_t, uint64_t>>{
+                      {1000000, 25}, {990000, 10}}));
+
+  std::vector<uint64_t> asks;
+  EXPECT_EQ(book_.for_each_level(
+                Side::Sell, 10,
+                [&](const PriceLevel &level) { asks.push_back(level.price); }),
+            2u);
+  EXPECT_EQ(asks, (std::vector<uint64_t>{1010000, 1020000}));
+}
+
 // ============================================================================
 // Main (if needed for standalone execution)
 // ============================================================================
@@ -3,21 +3,37 @@
  * @brief Benchmarks and unit tests for memory infrastructure.
  *
  * Tests:
- * 1. IntrusiveList correctness (push, pop, remove, iteration)
- * 2. MemPool correctness (allocate, deallocate, capacity)
- * 3. Performance comparison: IntrusiveList vs std::list
+ * 1. IntrusiveList and IndexedIntrusiveList correctness (push, pop,
+ *    remove, iteration, relocation)
+ * 2. MemPool correctness (allocate, deallocate, capacity, storage policy)
+ *    and SegmentedPool growth
+ * 3. FlatOrderIndex correctness (insert, find, backward-shift erase)
+ * 4. Performance comparison: IntrusiveList vs std::list
  */
 
 #include <gtest/gtest.h>
 
+#include <book/indexed_intrusive_list.hpp>
 #include <book/intrusive_list.hpp>
 #include <book/memory_pool.hpp>
+#include <book/order_index.hpp>
+#include <book/pool_allocation.hpp>
+#include <book/segmented_pool.hpp>
 #include <book/types.hpp>
 
+#include <array>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <memory>
+#include <new>
+#include <random>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 using namespace book;
@@ -178,6 +194,204 @@ TEST_F(IntrusiveListTest, ElementUnlinkedAfterRemove) {
   EXPECT_FALSE(elements_[0].is_linked());
 }
 
+// ============================================================================
+// IndexedIntrusiveList Unit Tests (same contract as IntrusiveList)
+// ============================================================================
+
+// Declared outside the fixture so MemPool sees a complete, default
+// constructible type
+struct IndexedTestElement : IndexedNode {
+  int value = 0;
+};
+
+class IndexedIntrusiveListTest : public ::testing::Test {
+protected:
+  using TestElement = IndexedTestElement;
+  static constexpr std::size_t kNumElements = 100;
+  using Pool = MemPool<TestElement, kNumElements>;
+  using List = IndexedIntrusiveList<TestElement, Pool>;
+
+  Pool pool_;
+  List list_{pool_};
+  std::vector<TestElement *> elements_;
+
+  void SetUp() override {
+    for (std::size_t i = 0; i < kNumElements; ++i) {
+      TestElement *elem = pool_.allocate();
+      elem->value = static_cast<int>(i);
+      elements_.push_back(elem);
+    }
+  }
+};
+
+TEST_F(IndexedIntrusiveListTest, HalfTheLinkBytesAndTriviallyCopyable) {
+  EXPECT_EQ(sizeof(IndexedNode), sizeof(IntrusiveNode) / 2);
+  EXPECT_TRUE(std::is_trivially_copyable_v<List>);
+  EXPECT_FALSE(std::is_trivially_copyable_v<IntrusiveList<Order>>);
+}
+
+TEST_F(IndexedIntrusiveListTest, EmptyListProperties) {
+  EXPECT_TRUE(list_.empty());
+  EXPECT_EQ(list_.size(), 0u);
+  EXPECT_EQ(list_.begin(), list_.end());
+}
+
+TEST_F(IndexedIntrusiveListTest, PushBackSingleElement) {
+  list_.push_back(elements_[0]);
+
+  EXPECT_FALSE(list_.empty());
+  EXPECT_EQ(list_.size(), 1u);
+  EXPECT_EQ(list_.front().value, 0);
+  EXPECT_EQ(list_.back().value, 0);
+}
+
+TEST_F(IndexedIntrusiveListTest, PushFrontSingleElement) {
+  list_.push_front(elements_[0]);
+
+  EXPECT_FALSE(list_.empty());
+  EXPECT_EQ(list_.size(), 1u);
+  EXPECT_EQ(list_.front().value, 0);
+  EXPECT_EQ(list_.back().value, 0);
+}
+
+TEST_F(IndexedIntrusiveListTest, PushBackMultipleElements) {
+  for (int i = 0; i < 10; ++i) {
+    list_.push_back(elements_[i]);
+  }
+
+  EXPECT_EQ(list_.size(), 10u);
+  EXPECT_EQ(list_.front().value, 0);
+  EXPECT_EQ(list_.back().value, 9);
+}
+
+TEST_F(IndexedIntrusiveListTest, PushFrontMultipleElements) {
+  for (int i = 0; i < 10; ++i) {
+    list_.push_front(elements_[i]);
+  }
+
+  EXPECT_EQ(list_.size(), 10u);
+  EXPECT_EQ(list_.front().value, 9); // Last pushed is first
+  EXPECT_EQ(list_.back().value, 0);  // First pushed is last
+}
+
+TEST_F(IndexedIntrusiveListTest, PopFront) {
+  for (int i = 0; i < 5; ++i) {
+    list_.push_back(elements_[i]);
+  }
+
+  list_.pop_front();
+  EXPECT_EQ(list_.size(), 4u);
+  EXPECT_EQ(list_.front().value, 1);
+}
+
+TEST_F(IndexedIntrusiveListTest, PopBack) {
+  for (int i = 0; i < 5; ++i) {
+    list_.push_back(elements_[i]);
+  }
+
+  list_.pop_back();
+  EXPECT_EQ(list_.size(), 4u);
+  EXPECT_EQ(list_.back().value, 3);
+}
+
+TEST_F(IndexedIntrusiveListTest, RemoveFromMiddle) {
+  for (int i = 0; i < 5; ++i) {
+    list_.push_back(elements_[i]);
+  }
+
+  list_.remove(elements_[2]);
+
+  EXPECT_EQ(list_.size(), 4u);
+
+  // Verify order: 0, 1, 3, 4
+  auto it = list_.begin();
+  EXPECT_EQ((it++)->value, 0);
+  EXPECT_EQ((it++)->value, 1);
+  EXPECT_EQ((it++)->value, 3);
+  EXPECT_EQ((it++)->value, 4);
+  EXPECT_EQ(it, list_.end());
+}
+
+TEST_F(IndexedIntrusiveListTest, IterationForwardAndBackward) {
+  for (int i = 0; i < 10; ++i) {
+    list_.push_back(elements_[i]);
+  }
+
+  int expected = 0;
+  for (const auto &elem : list_) {
+    EXPECT_EQ(elem.value, expected++);
+  }
+  EXPECT_EQ(expected, 10);
+
+  auto it = list_.end();
+  for (int i = 9; i >= 0; --i) {
+    EXPECT_EQ((--it)->value, i);
+  }
+  EXPECT_EQ(it, list_.begin());
+}
+
+TEST_F(IndexedIntrusiveListTest, InsertAndErase) {
+  list_.push_back(elements_[0]);
+  list_.push_back(elements_[2]);
+
+  auto it = list_.insert(std::next(list_.begin()), elements_[1]);
+  EXPECT_EQ(it->value, 1);
+  list_.insert(list_.end(), elements_[3]); // end() appends
+
+  it = list_.erase(list_.begin());
+  EXPECT_EQ(it->value, 1);
+  it = list_.erase(std::next(it, 2));
+  EXPECT_EQ(it, list_.end());
+
+  std::vector<int> values;
+  for (const auto &elem : list_) {
+    values.push_back(elem.value);
+  }
+  EXPECT_EQ(values, (std::vector<int>{1, 2}));
+}
+
+TEST_F(IndexedIntrusiveListTest, Clear) {
+  for (int i = 0; i < 10; ++i) {
+    list_.push_back(elements_[i]);
+  }
+
+  list_.clear();
+
+  EXPECT_TRUE(list_.empty());
+  EXPECT_EQ(list_.size(), 0u);
+  EXPECT_FALSE(elements_[5]->is_linked());
+}
+
+TEST_F(IndexedIntrusiveListTest, ElementUnlinkedAfterRemove) {
+  list_.push_back(elements_[0]);
+  EXPECT_TRUE(elements_[0]->is_linked()); // Lone element: both ends null
+
+  list_.remove(elements_[0]);
+  EXPECT_FALSE(elements_[0]->is_linked());
+}
+
+TEST_F(IndexedIntrusiveListTest, RelocatedListsKeepTheirElements) {
+  // Lists stored by value in a vector survive growth (memmove) intact
+  std::vector<List> lists;
+  for (int i = 0; i < 50; ++i) {
+    lists.emplace_back(pool_);
+    lists.back().push_back(elements_[2 * i]);
+    lists.back().push_back(elements_[2 * i + 1]);
+  }
+  lists.erase(lists.begin()); // Shifts every list down one slot
+
+  std::array<unsigned char, sizeof(List)> bytes{};
+  std::memcpy(bytes.data(), &lists[0], sizeof(List));
+  List moved{pool_};
+  std::memcpy(&moved, bytes.data(), sizeof(List));
+
+  EXPECT_EQ(moved.front().value, 2);
+  EXPECT_EQ(moved.back().value, 3);
+  moved.remove(elements_[2]);
+  EXPECT_EQ(moved.front().value, 3);
+  EXPECT_EQ(lists.back().back().value, 99);
+}
+
 // ============================================================================
 // MemPool Unit Tests
 // ============================================================================
@@ -277,6 +491,327 @@ TEST_F(MemPoolTest, AllocateDeallocateCycle) {
   EXPECT_TRUE(pool_.full());
 }
 
+// ============================================================================
+// MemPool Allocation Policies
+// ============================================================================
+
+struct alignas(64) LineObject {
+  uint64_t value = 7;
+};
+
+TEST(MemPoolAllocationTest, HeapPoolHonoursOverAlignment) {
+  MemPool<LineObject, 8> pool;
+  EXPECT_EQ(pool.page_backing(), PageBacking::Heap);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(pool.data()) % 64, 0u);
+  EXPECT_EQ(pool.at(5).value, 7u); // Slots are value-initialized
+}
+
+TEST(MemPoolAllocationTest, HugePagePoolBehavesLikeHeapPool) {
+  constexpr std::size_t kSlots = 100'000; // Spans several 2 MB pages
+  auto pool = std::make_unique<MemPool<Order, kSlots, HugePageAllocation>>();
+
+#if defined(__linux__)
+  EXPECT_NE(pool->page_backing(), PageBacking::Heap);
+  EXPECT_EQ(pool->reserved_bytes() % HugePageAllocation::kHugePageSize, 0u);
+#endif
+  EXPECT_GE(pool->reserved_bytes(),
+            kSlots * (sizeof(Order) + sizeof(std::size_t)));
+
+  std::vector<Order *> orders;
+  for (std::size_t i = 0; i < kSlots; ++i) {
+    Order *order = pool->allocate();
+    ASSERT_NE(order, nullptr);
+    EXPECT_EQ(pool->index_of(order), i); // Same LIFO order as the heap pool
+    order->id = i;
+    orders.push_back(order);
+  }
+  EXPECT_TRUE(pool->full());
+  EXPECT_EQ(pool->at(kSlots - 1).id, kSlots - 1);
+
+  for (Order *order : orders) {
+    pool->deallocate(order);
+  }
+  EXPECT_TRUE(pool->empty());
+}
+
+TEST(MemPoolAllocationTest, UnavailableNumaNodeFallsBackUnbound) {
+  MemPool<Order, 1024, HugePageAllocation> pool(
+      PoolPlacement{.numa_node = 63, .prefault = false});
+  EXPECT_FALSE(pool.numa_bound());
+  EXPECT_NE(pool.allocate(), nullptr);
+}
+
+TEST(MemPoolAllocationTest, LazyPoolStartsUntouched) {
+  MemPool<LineObject, 16> pool({}, PoolInit::Lazy);
+  EXPECT_TRUE(pool.lazy());
+  EXPECT_TRUE(pool.empty());
+  EXPECT_EQ(pool.available(), 16u);
+  EXPECT_EQ(pool.high_water_mark(), 0u);
+
+  LineObject *first = pool.allocate();
+  EXPECT_EQ(first->value, 7u); // Constructed on first use
+  EXPECT_EQ(pool.high_water_mark(), 1u);
+
+  pool.deallocate(first);
+  EXPECT_EQ(pool.allocate(), first); // Recycled before bumping
+  EXPECT_EQ(pool.high_water_mark(), 1u);
+
+  for (std::size_t i = 1; i < 16; ++i) {
+    ASSERT_NE(pool.allocate(), nullptr);
+  }
+  EXPECT_TRUE(pool.full());
+  EXPECT_EQ(pool.allocate(), nullptr);
+}
+
+TEST(MemPoolAllocationTest, LazyAndEagerHandOutSameSlots) {
+  MemPool<Order, 64> eager;
+  MemPool<Order, 64> lazy({}, PoolInit::Lazy);
+  std::vector<Order *> live_eager;
+  std::vector<Order *> live_lazy;
+  std::mt19937 rng(7);
+
+  for (int step = 0; step < 1000; ++step) {
+    if (live_eager.empty() || (rng() % 3 != 0 && !eager.full())) {
+      Order *a = eager.allocate();
+      Order *b = lazy.allocate();
+      ASSERT_EQ(eager.index_of(a), lazy.index_of(b));
+      live_eager.push_back(a);
+      live_lazy.push_back(b);
+    } else {
+      const std::size_t pick = rng() % live_eager.size();
+      eager.deallocate(live_eager[pick]);
+      lazy.deallocate(live_lazy[pick]);
+      live_eager.erase(live_eager.begin() + static_cast<long>(pick));
+      live_lazy.erase(live_lazy.begin() + static_cast<long>(pick));
+    }
+    ASSERT_EQ(eager.allocated(), lazy.allocated());
+  }
+}
+
+TEST(MemPoolAllocationTest, BackingNames) {
+  EXPECT_STREQ(page_backing_name(PageBacking::Heap), "heap");
+  EXPECT_STREQ(page_backing_name(PageBacking::TransparentHuge),
+               "transparent huge pages");
+}
+
+// ============================================================================
+// SegmentedPool Unit Tests
+// ============================================================================
+
+TEST(SegmentedPoolTest, InitialCapacityRoundsUpToSegments) {
+  SegmentedPool<Order, 64> pool(100);
+  EXPECT_EQ(pool.segment_count(), 2u);
+  EXPECT_EQ(pool.capacity(), 128u);
+  EXPECT_TRUE(pool.empty());
+  EXPECT_EQ(pool.available(), 128u);
+
+  SegmentedPool<Order, 64> minimal(0);
+  EXPECT_EQ(minimal.capacity(), 64u);
+}
+
+TEST(SegmentedPoolTest, GrowthKeepsExistingObjectsInPlace) {
+  SegmentedPool<LineObject, 16> pool(16);
+  std::vector<LineObject *> live;
+  for (uint64_t i = 0; i < 100; ++i) {
+    LineObject *obj = pool.allocate();
+    ASSERT_NE(obj, nullptr);
+    obj->value = i;
+    live.push_back(obj);
+  }
+  EXPECT_EQ(pool.segment_count(), 7u);
+  EXPECT_EQ(pool.allocated(), 100u);
+
+  // Earlier objects were never moved by the growth steps
+  for (uint64_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(live[i]->value, i);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(live[i]) % 64, 0u);
+    EXPECT_TRUE(pool.owns(live[i]));
+    EXPECT_EQ(&pool.at(pool.index_of(live[i])), live[i]);
+  }
+  LineObject outside;
+  EXPECT_FALSE(pool.owns(&outside));
+}
+
+TEST(SegmentedPoolTest, RecyclesBeforeGrowing) {
+  SegmentedPool<Order, 8> pool(8);
+  std::array<Order *, 8> orders{};
+  for (auto &order : orders) {
+    order = pool.allocate();
+  }
+  pool.deallocate(orders[3]);
+  EXPECT_EQ(pool.allocate(), orders[3]);
+  EXPECT_EQ(pool.segment_count(), 1u);
+
+  ASSERT_NE(pool.allocate(), nullptr); // Every slot in use: grow
+  EXPECT_EQ(pool.segment_count(), 2u);
+  EXPECT_EQ(pool.high_water_mark(), 9u);
+}
+
+TEST(SegmentedPoolTest, MaxCapacityBoundsGrowth) {
+  SegmentedPool<Order, 8> pool(8, 16);
+  EXPECT_EQ(pool.max_capacity(), 16u);
+  for (int i = 0; i < 16; ++i) {
+    ASSERT_NE(pool.allocate(), nullptr);
+  }
+  EXPECT_TRUE(pool.full());
+  EXPECT_EQ(pool.allocate(), nullptr);
+  EXPECT_EQ(pool.segment_count(), 2u);
+}
+
+TEST(SegmentedPoolTest, EagerSegmentsAreConstructedOnGrowth) {
+  SegmentedPool<LineObject, 4, HugePageAllocation> pool(4, 8, {},
+                                                        PoolInit::Eager);
+  EXPECT_FALSE(pool.lazy());
+  EXPECT_NE(pool.page_backing(), PageBacking::Heap);
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_NE(pool.allocate(), nullptr);
+  }
+  EXPECT_EQ(pool.at(7).value, 7u); // Whole new segment value-initialized
+}
+
+/// Heap policy that throws std::bad_alloc once `budget` regions are out
+struct BudgetAllocation {
+  static inline int budget = 0;
+
+  static PoolRegion allocate(std::size_t bytes, std::size_t alignment,
+                             const PoolPlacement &placement) {
+    if (budget-- <= 0) {
+      throw std::bad_alloc();
+    }
+    return HeapAllocation::allocate(bytes, alignment, placement);
+  }
+
+  static void release(const PoolRegion &region) noexcept {
+    HeapAllocation::release(region);
+  }
+};
+
+TEST(SegmentedPoolTest, RefusedGrowthReturnsNullptr) {
+  using Pool = SegmentedPool<Order, 8, BudgetAllocation>;
+  static_assert(noexcept(std::declval<Pool &>().allocate()));
+
+  BudgetAllocation::budget = 1;
+  Pool pool(8);
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_NE(pool.allocate(), nullptr);
+  }
+  EXPECT_EQ(pool.allocate(), nullptr); // bad_alloc stays inside the pool
+  EXPECT_EQ(pool.segment_count(), 1u);
+  EXPECT_EQ(pool.allocated(), 8u);
+
+  BudgetAllocation::budget = 1;
+  ASSERT_NE(pool.allocate(), nullptr); // Memory is back: growth resumes
+  EXPECT_EQ(pool.segment_count(), 2u);
+}
+
+// ============================================================================
+// FlatOrderIndex Unit Tests
+// ============================================================================
+
+TEST(FlatOrderIndexTest, SizedFromMaxEntries) {
+  FlatOrderIndex<uint32_t> index(1000);
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(index.max_entries(), 1000u);
+  EXPECT_EQ(index.slot_count(), 2048u); // bit_ceil(1.25 x 1000)
+}
+
+TEST(FlatOrderIndexTest, InsertFindErase) {
+  FlatOrderIndex<uint32_t> index(16);
+
+  EXPECT_TRUE(index.insert(42, 7));
+  EXPECT_FALSE(index.insert(42, 8)); // Duplicate rejected
+  ASSERT_NE(index.find(42), nullptr);
+  EXPECT_EQ(*index.find(42), 7u);
+  EXPECT_EQ(index.find(43), nullptr);
+
+  *index.find(42) = 9;
+  EXPECT_EQ(*index.find(42), 9u);
+
+  EXPECT_TRUE(index.erase(42));
+  EXPECT_FALSE(index.erase(42));
+  EXPECT_FALSE(index.contains(42));
+  EXPECT_TRUE(index.empty());
+}
+
+TEST(FlatOrderIndexTest, RejectsWhenFullOrReservedKey) {
+  FlatOrderIndex<uint32_t> index(4);
+  for (uint64_t id = 1; id <= 4; ++id) {
+    ASSERT_TRUE(index.insert(id, 0));
+  }
+  EXPECT_FALSE(index.insert(5, 0));
+  EXPECT_FALSE(index.insert(FlatOrderIndex<uint32_t>::kEmptyKey, 0));
+  EXPECT_EQ(index.size(), 4u);
+}
+
+TEST(FlatOrderIndexTest, ReservedKeyIsNeverFoundOrErased) {
+  using Index = FlatOrderIndex<uint32_t>;
+  Index empty(16);
+  EXPECT_EQ(empty.find(Index::kEmptyKey), nullptr);
+  EXPECT_FALSE(empty.erase(Index::kEmptyKey));
+  EXPECT_EQ(empty.size(), 0u);
+
+  // Empty slots hold kEmptyKey; a lookup must not match them
+  Index index(16);
+  ASSERT_TRUE(index.insert(7, 1));
+  EXPECT_EQ(index.find(Index::kEmptyKey), nullptr);
+  EXPECT_FALSE(index.contains(Index::kEmptyKey));
+  EXPECT_FALSE(index.erase(Index::kEmptyKey));
+  EXPECT_EQ(index.size(), 1u);
+  EXPECT_EQ(*index.find(7), 1u);
+}
+
+TEST(FlatOrderIndexTest, ReserveGrowsAndKeepsKeys) {
+  FlatOrderIndex<uint32_t> index(4);
+  for (uint64_t id = 1; id <= 4; ++id) {
+    ASSERT_TRUE(index.insert(id, static_cast<uint32_t>(id * 10)));
+  }
+
+  index.reserve(100);
+  EXPECT_EQ(index.max_entries(), 100u);
+  EXPECT_GE(index.slot_count(), 125u);
+  EXPECT_EQ(index.size(), 4u);
+  for (uint64_t id = 1; id <= 4; ++id) {
+    ASSERT_NE(index.find(id), nullptr);
+    EXPECT_EQ(*index.find(id), id * 10);
+  }
+  EXPECT_TRUE(index.insert(5, 50));
+
+  index.reserve(10); // Never shrinks
+  EXPECT_EQ(index.max_entries(), 100u);
+}
+
+TEST(FlatOrderIndexTest, EraseKeepsProbeChainsIntact) {
+  // Fill a small table to its load limit and churn it against a reference
+  // map; backward-shift deletion must never lose a displaced key.
+  constexpr std::size_t kMaxEntries = 200;
+  FlatOrderIndex<uint64_t> index(kMaxEntries);
+  std::unordered_map<uint64_t, uint64_t> reference;
+  std::mt19937_64 rng(7);
+
+  for (int step = 0; step < 20000; ++step) {
+    const uint64_t key = rng() % 512;
+    if (reference.size() < kMaxEntries && (rng() & 1) != 0) {
+      const bool inserted = reference.emplace(key, key * 3).second;
+      EXPECT_EQ(index.insert(key, key * 3), inserted);
+    } else {
+      const bool erased = reference.erase(key) != 0;
+      EXPECT_EQ(index.erase(key), erased);
+    }
+  }
+
+  EXPECT_EQ(index.size(), reference.size());
+  for (uint64_t key = 0; key < 512; ++key) {
+    const uint64_t *value = index.find(key);
+    auto it = reference.find(key);
+    if (it == reference.end()) {
+      EXPECT_EQ(value, nullptr);
+    } else {
+      ASSERT_NE(value, nullptr);
+      EXPECT_EQ(*value, it->second);
+    }
+  }
+}
+
 // ============================================================================
 // Order Type Tests
 // ============================================================================
@@ -356,7 +891,7 @@ TEST_F(PerformanceTest, IntrusiveListPushBackAndIterate) {
   volatile uint64_t sum = 0; // Prevent optimization
   double iterate_time = measure_ms([&]() {
     for (const auto &order : list) {
-      sum += order.qty;
+      sum = sum + order.qty;
     }
   });
 
@@ -386,7 +921,7 @@ TEST_F(PerformanceTest, StdListPushBackAndIterate) {
   volatile uint64_t sum = 0;
   double iterate_time = measure_ms([&]() {
     for (const auto &order : list) {
-      sum += order.qty;
+      sum = sum + order.qty;
     }
   });
 
@@ -456,12 +991,12 @@ TEST_F(PerformanceTest, ComparisonSummary) {
 
   double intrusive_iter = measure_ms([&]() {
     for (const auto &o : intrusive_list)
-      sum1 += o.qty;
+      sum1 = sum1 + o.qty;
   });
 
   double std_iter = measure_ms([&]() {
     for (const auto &o : std_list)
-      sum2 += o.qty;
+      sum2 = sum2 + o.qty;
   });
 
   std::cout << "\n========================================\n";
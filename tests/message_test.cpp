@@ -225,6 +225,73 @@ TEST(OrderExecutedTest, ParsesRealMessage) {
   EXPECT_EQ(static_cast<uint64_t>(msg->match_number), 1234567890123ull);
 }
 
+// ============================================================================
+// Order Lifecycle Message Tests (C, X, D, U)
+// ============================================================================
+
+TEST(OrderReplaceTest, ParsesRealMessage) {
+  unsigned char buffer[35] = {
+      // Offset 0: msg_type
+      'U',
+      // Offset 1-4: stock_locate = 7, tracking_number = 1
+      0x00, 0x07, 0x00, 0x01,
+      // Offset 5-10: timestamp = 1 ns
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+      // Offset 11-18: original_order_ref = 1000
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xE8,
+      // Offset 19-26: new_order_ref = 1001
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xE9,
+      // Offset 27-30: shares = 300
+      0x00, 0x00, 0x01, 0x2C,
+      // Offset 31-34: price = 1000000 (100.0000)
+      0x00, 0x0F, 0x42, 0x40};
+
+  const auto *msg = parse<OrderReplace>(reinterpret_cast<const char *>(buffer));
+
+  EXPECT_EQ(static_cast<uint16_t>(msg->stock_locate), 7);
+  EXPECT_EQ(static_cast<uint64_t>(msg->original_order_ref), 1000ull);
+  EXPECT_EQ(static_cast<uint64_t>(msg->new_order_ref), 1001ull);
+  EXPECT_EQ(static_cast<uint32_t>(msg->shares), 300u);
+  EXPECT_DOUBLE_EQ(msg->price_double(), 100.0);
+}
+
+TEST(OrderExecutedWithPriceTest, ParsesPriceAndPrintable) {
+  unsigned char buffer[36] = {};
+  buffer[0] = 'C';
+  buffer[18] = 0x05; // order_ref = 5
+  buffer[22] = 0x64; // executed_shares = 100
+  buffer[30] = 0x09; // match_number = 9
+  buffer[31] = 'Y';  // printable
+  buffer[33] = 0x01; // execution_price = 0x00010000 = 65536 (6.5536)
+
+  const auto *msg =
+      parse<OrderExecutedWithPrice>(reinterpret_cast<const char *>(buffer));
+
+  EXPECT_EQ(static_cast<uint64_t>(msg->order_ref), 5ull);
+  EXPECT_EQ(static_cast<uint32_t>(msg->executed_shares), 100u);
+  EXPECT_EQ(static_cast<uint64_t>(msg->match_number), 9ull);
+  EXPECT_EQ(msg->printable, 'Y');
+  EXPECT_EQ(static_cast<uint32_t>(msg->execution_price), 65536u);
+}
+
+TEST(OrderCancelDeleteTest, ParseOrderRefAndShares) {
+  unsigned char cancel[23] = {};
+  cancel[0] = 'X';
+  cancel[18] = 0x2A; // order_ref = 42
+  cancel[22] = 0x0A; // cancelled_shares = 10
+
+  unsigned char del[19] = {};
+  del[0] = 'D';
+  del[18] = 0x2B; // order_ref = 43
+
+  const auto *x = parse<OrderCancel>(reinterpret_cast<const char *>(cancel));
+  const auto *d = parse<OrderDelete>(reinterpret_cast<const char *>(del));
+
+  EXPECT_EQ(static_cast<uint64_t>(x->order_ref), 42ull);
+  EXPECT_EQ(static_cast<uint32_t>(x->cancelled_shares), 10u);
+  EXPECT_EQ(static_cast<uint64_t>(d->order_ref), 43ull);
+}
+
 // ============================================================================
 // Zero-Copy Verification
 // ============================================================================
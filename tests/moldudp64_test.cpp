@@ -0,0 +1,280 @@
+/**
+ * @file moldudp64_test.cpp
+ * @brief Unit tests for the Ethernet/VLAN/IPv4/UDP/MoldUDP64 decoder.
+ */
+
+#include <gtest/gtest.h>
+#include <itch/moldudp64.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace itch::test {
+
+// ============================================================================
+// Frame Builder
+// ============================================================================
+
+/**
+ * @brief Builds captured frames: link [+ VLAN] + IPv4 + UDP + MoldUDP64.
+ */
+struct FrameBuilder {
+  LinkType link = LinkType::Ethernet;
+  bool vlan = false;
+  uint8_t ip_protocol = wire::kIpProtoUdp;
+  uint16_t ether_type = wire::kEtherTypeIPv4;
+  uint16_t frag_field = 0x4000; // Don't Fragment
+  uint64_t sequence = 1000;
+  int count_override = -1;      // Message count to announce (-1 = actual)
+  size_t trailer_padding = 0;   // Ethernet padding after the UDP payload
+  std::vector<std::vector<unsigned char>> messages;
+
+  static void put16(std::vector<unsigned char> &out, uint16_t v) {
+    out.push_back(static_cast<unsigned char>(v >> 8));
+    out.push_back(static_cast<unsigned char>(v & 0xFF));
+  }
+
+  void add_message(char type) {
+    std::vector<unsigned char> msg(get_message_size(type), 0);
+    msg[0] = static_cast<unsigned char>(type);
+    messages.push_back(msg);
+  }
+
+  std::vector<unsigned char> build() const {
+    std::vector<unsigned char> mold(10, '0'); // Session "0000000000"
+    for (int shift = 56; shift >= 0; shift -= 8) {
+      mold.push_back(static_cast<unsigned char>(sequence >> shift));
+    }
+    const auto count = count_override >= 0
+                           ? static_cast<uint16_t>(count_override)
+                           : static_cast<uint16_t>(messages.size());
+    put16(mold, count);
+    for (const auto &msg : messages) {
+      put16(mold, static_cast<uint16_t>(msg.size()));
+      mold.insert(mold.end(), msg.begin(), msg.end());
+    }
+
+    std::vector<unsigned char> frame;
+    if (link == LinkType::Ethernet || link == LinkType::LinuxSll) {
+      // MAC addresses, or SLL packet type/ARPHRD/address length/address
+      frame.assign(link == LinkType::Ethernet ? 12 : 14, 0xAB);
+      if (vlan) {
+        put16(frame, wire::kEtherTypeVlan);
+        put16(frame, 0x008D); // TCI
+      }
+      put16(frame, ether_type);
+    }
+
+    // IPv4 header (no options)
+    const auto udp_len = static_cast<uint16_t>(8 + mold.size());
+    frame.push_back(0x45);
+    frame.push_back(0x00);
+    put16(frame, static_cast<uint16_t>(20 + udp_len));
+    put16(frame, 0x1234);
+    put16(frame, frag_field);
+    frame.push_back(64);
+    frame.push_back(ip_protocol);
+    put16(frame, 0);
+    frame.insert(frame.end(), 8, 0x0A); // src/dst addresses
+
+    // UDP header
+    put16(frame, 26477);
+    put16(frame, 26477);
+    put16(frame, udp_len);
+    put16(frame, 0);
+
+    frame.insert(frame.end(), mold.begin(), mold.end());
+    frame.insert(frame.end(), trailer_padding, 0);
+    return frame;
+  }
+};
+
+struct PacketVisitor : DefaultVisitor {
+  std::vector<uint64_t> packet_sequences;
+  std::string session;
+  std::string types;
+
+  void on_packet(const MoldPacket &pkt) {
+    packet_sequences.push_back(pkt.sequence);
+    session.assign(pkt.session, MoldPacket::kSessionSize);
+  }
+  void on_add_order(const AddOrder &msg) { types += msg.msg_type; }
+  void on_order_delete(const OrderDelete &msg) { types += msg.msg_type; }
+  void on_order_executed(const OrderExecuted &msg) { types += msg.msg_type; }
+};
+
+DecodeResult decode(const std::vector<unsigned char> &frame, MoldPacket &pkt,
+                    LinkType link = LinkType::Ethernet) {
+  return decode_frame(reinterpret_cast<const char *>(frame.data()),
+                      frame.size(), pkt, link);
+}
+
+// ============================================================================
+// decode_frame Tests
+// ============================================================================
+
+TEST(MoldUDP64Test, DecodesVlanTaggedFrame) {
+  FrameBuilder builder;
+  builder.vlan = true;
+  builder.sequence = 14764496;
+  builder.add_message('D');
+  const auto frame = builder.build();
+
+  MoldPacket pkt;
+  ASSERT_EQ(decode(frame, pkt), DecodeResult::Ok);
+  EXPECT_EQ(std::string(pkt.session, MoldPacket::kSessionSize), "0000000000");
+  EXPECT_EQ(pkt.sequence, 14764496u);
+  EXPECT_EQ(pkt.message_count, 1u);
+  EXPECT_EQ(pkt.blocks_len, 2u + 19u);
+  EXPECT_EQ(pkt.next_sequence(), 14764497u);
+}
+
+TEST(MoldUDP64Test, UdpLengthStripsEthernetPadding) {
+  FrameBuilder builder;
+  builder.add_message('D');
+  builder.trailer_padding = 6;
+  const auto frame = builder.build();
+
+  MoldPacket pkt;
+  ASSERT_EQ(decode(frame, pkt), DecodeResult::Ok);
+  EXPECT_EQ(pkt.blocks_len, 2u + 19u);
+}
+
+TEST(MoldUDP64Test, DecodesLinuxCookedAndRawIPv4Frames) {
+  for (const LinkType link :
+       {LinkType::LinuxSll, LinkType::Raw, LinkType::IPv4}) {
+    FrameBuilder builder;
+    builder.link = link;
+    builder.vlan = (link == LinkType::LinuxSll);
+    builder.sequence = 77;
+    builder.add_message('D');
+    const auto frame = builder.build();
+
+    MoldPacket pkt;
+    ASSERT_EQ(decode(frame, pkt, link), DecodeResult::Ok);
+    EXPECT_EQ(pkt.sequence, 77u);
+    EXPECT_EQ(pkt.message_count, 1u);
+    EXPECT_EQ(pkt.blocks_len, 2u + 19u);
+  }
+}
+
+TEST(MoldUDP64Test, RawFrameMustBeIPv4) {
+  FrameBuilder builder;
+  builder.link = LinkType::Raw;
+  auto frame = builder.build();
+  frame[0] = 0x60; // IPv6 version nibble
+
+  MoldPacket pkt;
+  EXPECT_EQ(decode(frame, pkt, LinkType::Raw), DecodeResult::NotIPv4);
+  EXPECT_EQ(decode({}, pkt, LinkType::Raw), DecodeResult::Truncated);
+  EXPECT_EQ(decode(std::vector<unsigned char>(15, 0), pkt,
+                   LinkType::LinuxSll),
+            DecodeResult::Truncated);
+}
+
+TEST(MoldUDP64Test, UnsupportedLinkTypeIsRejected) {
+  EXPECT_TRUE(is_supported_link_type(1));
+  EXPECT_TRUE(is_supported_link_type(101));
+  EXPECT_TRUE(is_supported_link_type(113));
+  EXPECT_TRUE(is_supported_link_type(228));
+  EXPECT_FALSE(is_supported_link_type(0));   // BSD loopback
+  EXPECT_FALSE(is_supported_link_type(276)); // Linux SLL2
+
+  FrameBuilder builder;
+  builder.add_message('D');
+  MoldPacket pkt;
+  EXPECT_EQ(decode(builder.build(), pkt, static_cast<LinkType>(276)),
+            DecodeResult::BadLinkType);
+}
+
+TEST(MoldUDP64Test, RejectsNonItchFrames) {
+  MoldPacket pkt;
+
+  FrameBuilder ipv6;
+  ipv6.ether_type = 0x86DD;
+  EXPECT_EQ(decode(ipv6.build(), pkt), DecodeResult::NotIPv4);
+
+  FrameBuilder tcp;
+  tcp.ip_protocol = 6;
+  EXPECT_EQ(decode(tcp.build(), pkt), DecodeResult::NotUdp);
+
+  FrameBuilder fragment;
+  fragment.frag_field = 0x2000; // More fragments
+  EXPECT_EQ(decode(fragment.build(), pkt), DecodeResult::Fragmented);
+
+  FrameBuilder full;
+  full.add_message('A');
+  auto truncated = full.build();
+  truncated.resize(40);
+  EXPECT_EQ(decode(truncated, pkt), DecodeResult::Truncated);
+}
+
+// ============================================================================
+// Message Block Iteration
+// ============================================================================
+
+TEST(MoldUDP64Test, ParseFrame_DispatchesEveryBlockWithSequence) {
+  FrameBuilder builder;
+  builder.vlan = true;
+  builder.sequence = 500;
+  builder.add_message('A');
+  builder.add_message('E');
+  builder.add_message('D');
+  const auto frame = builder.build();
+
+  MoldPacket pkt;
+  ASSERT_EQ(decode(frame, pkt), DecodeResult::Ok);
+  std::vector<uint64_t> sequences;
+  EXPECT_EQ(for_each_message(pkt,
+                             [&](const char *, size_t, uint64_t seq) {
+                               sequences.push_back(seq);
+                             }),
+            3u);
+  EXPECT_EQ(sequences, (std::vector<uint64_t>{500, 501, 502}));
+
+  PacketVisitor visitor;
+  Parser parser;
+  EXPECT_EQ(parse_frame(parser, reinterpret_cast<const char *>(frame.data()),
+                        frame.size(), visitor),
+            DecodeResult::Ok);
+  EXPECT_EQ(visitor.types, "AED");
+  EXPECT_EQ(visitor.packet_sequences, (std::vector<uint64_t>{500}));
+}
+
+TEST(MoldUDP64Test, HeartbeatAndEndOfSession_HaveNoMessages) {
+  FrameBuilder heartbeat;
+  heartbeat.sequence = 42;
+  const auto frame = heartbeat.build();
+
+  PacketVisitor visitor;
+  Parser parser;
+  EXPECT_EQ(parse_frame(parser, reinterpret_cast<const char *>(frame.data()),
+                        frame.size(), visitor),
+            DecodeResult::Ok);
+  EXPECT_EQ(visitor.packet_sequences, (std::vector<uint64_t>{42}));
+  EXPECT_TRUE(visitor.types.empty());
+
+  FrameBuilder eos;
+  eos.count_override = wire::kMoldEndOfSession;
+  MoldPacket pkt;
+  ASSERT_EQ(decode(eos.build(), pkt), DecodeResult::Ok);
+  EXPECT_TRUE(pkt.is_end_of_session());
+  EXPECT_EQ(pkt.next_sequence(), pkt.sequence);
+}
+
+TEST(MoldUDP64Test, OverstatedMessageCount_IsBadMoldFrame) {
+  FrameBuilder builder;
+  builder.add_message('A');
+  builder.count_override = 2;
+  const auto frame = builder.build();
+
+  PacketVisitor visitor;
+  Parser parser;
+  EXPECT_EQ(parse_frame(parser, reinterpret_cast<const char *>(frame.data()),
+                        frame.size(), visitor),
+            DecodeResult::BadMoldFrame);
+  EXPECT_EQ(visitor.types, "A"); // Walkable prefix is still delivered
+}
+
+} // namespace itch::test
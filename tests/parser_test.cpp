@@ -5,6 +5,8 @@
 
 #include <gtest/gtest.h>
 #include <itch/parser.hpp>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace itch::test {
@@ -24,7 +26,7 @@ struct CountingVisitor : DefaultVisitor {
   void on_order_executed(const OrderExecuted & /*msg*/) {
     ++order_executed_count;
   }
-  void on_system_event(const MessageHeader & /*msg*/) { ++system_event_count; }
+  void on_system_event(const SystemEvent & /*msg*/) { ++system_event_count; }
   void on_unknown(char msg_type, const char * /*data*/, size_t /*len*/) {
     ++unknown_count;
     last_unknown_type = msg_type;
@@ -212,6 +214,71 @@ TEST(ParserTest, ParseBuffer_IncompleteMessage_StopsEarly) {
   EXPECT_EQ(visitor.add_order_count, 1);
 }
 
+TEST(ParserTest, ParseBuffer_AllMessageTypes_DispatchesEachHook) {
+  // One zero-filled message of every ITCH 5.0 type, back to back
+  const char types[] = {'S', 'R', 'H', 'Y', 'L', 'V', 'W', 'K',
+                        'J', 'h', 'A', 'F', 'E', 'C', 'X', 'D',
+                        'U', 'P', 'Q', 'B', 'I', 'N', 'O'};
+  std::vector<char> buffer;
+  for (char type : types) {
+    const size_t size = get_message_size(type);
+    ASSERT_GT(size, 0u);
+    buffer.push_back(type);
+    buffer.insert(buffer.end(), size - 1, '\0');
+  }
+
+  struct HookVisitor : DefaultVisitor {
+    std::string seen;
+    void on_system_event(const SystemEvent &m) { seen += m.msg_type; }
+    void on_stock_directory(const StockDirectory &m) { seen += m.msg_type; }
+    void on_stock_trading_action(const StockTradingAction &m) {
+      seen += m.msg_type;
+    }
+    void on_reg_sho_restriction(const RegSHORestriction &m) {
+      seen += m.msg_type;
+    }
+    void on_market_participant_position(const MarketParticipantPosition &m) {
+      seen += m.msg_type;
+    }
+    void on_mwcb_decline_level(const MWCBDeclineLevel &m) {
+      seen += m.msg_type;
+    }
+    void on_mwcb_status(const MWCBStatus &m) { seen += m.msg_type; }
+    void on_ipo_quoting_period(const IPOQuotingPeriod &m) {
+      seen += m.msg_type;
+    }
+    void on_luld_auction_collar(const LULDAuctionCollar &m) {
+      seen += m.msg_type;
+    }
+    void on_operational_halt(const OperationalHalt &m) { seen += m.msg_type; }
+    void on_add_order(const AddOrder &m) { seen += m.msg_type; }
+    void on_add_order_mpid(const AddOrderMPID &m) { seen += m.msg_type; }
+    void on_order_executed(const OrderExecuted &m) { seen += m.msg_type; }
+    void on_order_executed_with_price(const OrderExecutedWithPrice &m) {
+      seen += m.msg_type;
+    }
+    void on_order_cancel(const OrderCancel &m) { seen += m.msg_type; }
+    void on_order_delete(const OrderDelete &m) { seen += m.msg_type; }
+    void on_order_replace(const OrderReplace &m) { seen += m.msg_type; }
+    void on_trade(const Trade &m) { seen += m.msg_type; }
+    void on_cross_trade(const CrossTrade &m) { seen += m.msg_type; }
+    void on_broken_trade(const BrokenTrade &m) { seen += m.msg_type; }
+    void on_noii(const NOII &m) { seen += m.msg_type; }
+    void on_retail_interest(const RetailInterest &m) { seen += m.msg_type; }
+    void on_direct_listing(const DirectListingCapitalRaise &m) {
+      seen += m.msg_type;
+    }
+    void on_unknown(char, const char *, size_t) { seen += '?'; }
+  };
+
+  HookVisitor visitor;
+  Parser parser;
+  size_t consumed = parser.parse_buffer(buffer.data(), buffer.size(), visitor);
+
+  EXPECT_EQ(consumed, buffer.size());
+  EXPECT_EQ(visitor.seen, std::string(types, sizeof(types)));
+}
+
 // ============================================================================
 // get_message_size Tests
 // ============================================================================
@@ -219,7 +286,20 @@ TEST(ParserTest, ParseBuffer_IncompleteMessage_StopsEarly) {
 TEST(MessageSizeTest, KnownTypes) {
   EXPECT_EQ(get_message_size(msg_type::AddOrder), 36u);
   EXPECT_EQ(get_message_size(msg_type::OrderExecuted), 31u);
-  EXPECT_EQ(get_message_size(msg_type::SystemEvent), sizeof(MessageHeader));
+  EXPECT_EQ(get_message_size(msg_type::SystemEvent), 12u);
+}
+
+TEST(MessageSizeTest, AllItch50Types) {
+  // Wire sizes from the NASDAQ TotalView-ITCH 5.0 specification
+  const std::pair<char, size_t> expected[] = {
+      {'S', 12}, {'R', 39}, {'H', 25}, {'Y', 20}, {'L', 26}, {'V', 35},
+      {'W', 12}, {'K', 28}, {'J', 35}, {'h', 21}, {'A', 36}, {'F', 40},
+      {'E', 31}, {'C', 36}, {'X', 23}, {'D', 19}, {'U', 35}, {'P', 44},
+      {'Q', 40}, {'B', 19}, {'I', 50}, {'N', 20}, {'O', 48}};
+
+  for (const auto &[type, size] : expected) {
+    EXPECT_EQ(get_message_size(type), size) << "msg_type " << type;
+  }
 }
 
 TEST(MessageSizeTest, UnknownType_ReturnsZero) {
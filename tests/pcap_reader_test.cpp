@@ -0,0 +1,143 @@
+/**
+ * @file pcap_reader_test.cpp
+ * @brief Unit tests for PcapReader, whole-file and sliding-window mapping.
+ */
+
+#include <gtest/gtest.h>
+#include <itch/pcap_reader.hpp>
+
+#include "test_files.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace itch::test {
+
+// ============================================================================
+// Test Fixture - writes a temporary PCAP file
+// ============================================================================
+
+class PcapReaderTest : public ::testing::Test {
+protected:
+  /// Write `bytes` to the test's temporary file and return its path
+  const char *write_file(const std::vector<unsigned char> &bytes) {
+    return file_.write(bytes);
+  }
+
+  /// (length, tag) of every packet, read through `reader`
+  static std::vector<std::pair<size_t, unsigned char>>
+  collect(const PcapReader &reader) {
+    std::vector<std::pair<size_t, unsigned char>> packets;
+    reader.for_each_packet([&](const char *data, size_t len) {
+      // Every byte is present and contiguous
+      const auto tag = static_cast<unsigned char>(data[0]);
+      for (size_t i = 1; i < len; ++i) {
+        EXPECT_EQ(static_cast<unsigned char>(data[i]), tag);
+      }
+      packets.emplace_back(len, tag);
+    });
+    return packets;
+  }
+
+  TempFile file_{"itch_pcap"};
+};
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+TEST_F(PcapReaderTest, MissingFile_FailsToOpen) {
+  PcapReader whole("/nonexistent/itch.pcap");
+  EXPECT_FALSE(whole.is_open());
+  PcapReader window("/nonexistent/itch.pcap", PcapMapping::Window);
+  EXPECT_FALSE(window.is_open());
+  EXPECT_EQ(window.for_each_packet([](const char *, size_t) {}), 0u);
+}
+
+TEST_F(PcapReaderTest, BadMagic_FailsToOpenInBothMappings) {
+  std::vector<unsigned char> bytes(sizeof(PcapGlobalHeader), 0);
+  const char *path = write_file(bytes);
+  EXPECT_FALSE(PcapReader(path).is_open());
+  EXPECT_FALSE(PcapReader(path, PcapMapping::Window).is_open());
+}
+
+TEST_F(PcapReaderTest, LinkType_ReadInHostOrderInBothMappings) {
+  std::vector<unsigned char> bytes = PcapBuilder().bytes();
+  EXPECT_EQ(PcapReader(write_file(bytes)).link_type(), 1u);
+
+  // Big-endian capture of Linux cooked frames
+  PcapGlobalHeader header{};
+  header.magic_number = 0xd4c3b2a1;
+  header.network = __builtin_bswap32(113);
+  const auto *raw = reinterpret_cast<const unsigned char *>(&header);
+  bytes.assign(raw, raw + sizeof(header));
+  const char *path = write_file(bytes);
+  EXPECT_EQ(PcapReader(path).link_type(), 113u);
+  EXPECT_EQ(PcapReader(path, PcapMapping::Window).link_type(), 113u);
+
+  PcapReader source(path);
+  PcapReader moved(std::move(source));
+  EXPECT_EQ(moved.link_type(), 113u);
+}
+
+TEST_F(PcapReaderTest, Window_RoundsToWholePages) {
+  PcapReader reader(write_file(PcapBuilder().bytes()), PcapMapping::Window,
+                    100);
+  ASSERT_TRUE(reader.is_open());
+  EXPECT_EQ(reader.mapping(), PcapMapping::Window);
+  EXPECT_EQ(reader.window_bytes(), PcapWindow::page_size());
+  EXPECT_EQ(reader.data(), nullptr);
+}
+
+TEST_F(PcapReaderTest, Window_MatchesWholeAcrossBoundaries) {
+  // Odd packet sizes so headers and payloads straddle every page
+  // boundary, plus one packet larger than the window itself
+  const size_t page = PcapWindow::page_size();
+  PcapBuilder pcap;
+  unsigned char tag = 0;
+  for (uint32_t len = 1; len < 3000; len += 97) {
+    pcap.fill_packet(len, ++tag);
+  }
+  pcap.fill_packet(3 * page + 5, ++tag);
+  pcap.fill_packet(0, ++tag);
+  pcap.fill_packet(64, ++tag);
+
+  const char *path = write_file(pcap.bytes());
+  const PcapReader whole(path);
+  const PcapReader window(path, PcapMapping::Window, page);
+  ASSERT_TRUE(whole.is_open());
+  ASSERT_TRUE(window.is_open());
+
+  const auto expected = collect(whole);
+  EXPECT_EQ(expected.size(), static_cast<size_t>(tag));
+  EXPECT_EQ(collect(window), expected);
+
+  // A second pass maps the file again from the start
+  EXPECT_EQ(collect(window), expected);
+}
+
+TEST_F(PcapReaderTest, Window_TruncatedTailIsDropped) {
+  PcapBuilder pcap;
+  pcap.fill_packet(100, 1);
+  pcap.fill_packet(100, 2);
+  pcap.bytes().resize(pcap.bytes().size() - 10); // Cut into the 2nd payload
+
+  PcapReader reader(write_file(pcap.bytes()), PcapMapping::Window);
+  ASSERT_TRUE(reader.is_open());
+  EXPECT_EQ(reader.for_each_packet([](const char *, size_t) {}), 1u);
+}
+
+TEST_F(PcapReaderTest, Window_HasNoCursorIteration) {
+  PcapBuilder pcap;
+  pcap.fill_packet(10, 1);
+
+  const char *path = write_file(pcap.bytes());
+  PcapPacket packet;
+  size_t cursor = 0;
+  EXPECT_TRUE(PcapReader(path).next_packet(cursor, packet));
+  cursor = 0;
+  EXPECT_FALSE(
+      PcapReader(path, PcapMapping::Window).next_packet(cursor, packet));
+}
+
+} // namespace itch::test
@@ -0,0 +1,258 @@
+/**
+ * @file pipeline_test.cpp
+ * @brief Unit tests for the SPSC ring and the sharded replay pipeline.
+ */
+
+#include <gtest/gtest.h>
+#include <pipeline/sharded_pipeline.hpp>
+#include <pipeline/spsc_ring.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace pipeline::test {
+
+// ============================================================================
+// SpscRing
+// ============================================================================
+
+TEST(SpscRingTest, PushPopPreservesOrder) {
+  SpscRing<int, 8> ring;
+  EXPECT_TRUE(ring.empty());
+
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(ring.try_push(i));
+  }
+  EXPECT_EQ(ring.size(), 5u);
+
+  int value = -1;
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(ring.try_pop(value));
+  EXPECT_EQ(value, 4); // Untouched on failure
+}
+
+TEST(SpscRingTest, FullRingRejectsPushUntilPopped) {
+  SpscRing<int, 4> ring;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(ring.try_push(i));
+  }
+  EXPECT_FALSE(ring.try_push(99));
+
+  int value = 0;
+  ASSERT_TRUE(ring.try_pop(value));
+  EXPECT_TRUE(ring.try_push(4)); // Wraps into the freed slot
+
+  for (int expected = 1; expected <= 4; ++expected) {
+    ASSERT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, expected);
+  }
+}
+
+TEST(SpscRingTest, PushNWritesPrefixThatFits) {
+  SpscRing<int, 8> ring;
+  const std::array<int, 6> first{0, 1, 2, 3, 4, 5};
+  EXPECT_EQ(ring.try_push_n(first.data(), first.size()), 6u);
+  EXPECT_EQ(ring.try_push_n(first.data(), first.size()), 2u); // Only 2 free
+  EXPECT_EQ(ring.try_push_n(first.data(), 1), 0u);
+  EXPECT_EQ(ring.size(), 8u);
+}
+
+TEST(SpscRingTest, PopNAndConsumeReleaseInBatches) {
+  SpscRing<int, 8> ring;
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_TRUE(ring.try_push(i));
+  }
+
+  std::array<int, 3> out{};
+  ASSERT_EQ(ring.try_pop_n(out.data(), out.size()), 3u);
+  EXPECT_EQ(out, (std::array<int, 3>{0, 1, 2}));
+
+  std::vector<int> seen;
+  EXPECT_EQ(ring.consume([&](const int &v) { seen.push_back(v); }, 4), 4u);
+  EXPECT_EQ(seen, (std::vector<int>{3, 4, 5, 6}));
+
+  // Freed slots are visible to the producer after the batch releases
+  const std::array<int, 4> more{8, 9, 10, 11};
+  EXPECT_EQ(ring.try_push_n(more.data(), more.size()), 4u);
+
+  seen.clear();
+  EXPECT_EQ(ring.consume([&](const int &v) { seen.push_back(v); }, 64), 5u);
+  EXPECT_EQ(seen, (std::vector<int>{7, 8, 9, 10, 11}));
+  EXPECT_EQ(ring.consume([](const int &) {}, 64), 0u);
+}
+
+TEST(SpscRingTest, HeadAndTailOnSeparateCacheLines) {
+  EXPECT_GE(sizeof(SpscRing<int, 4>), 3 * kCacheLineSize);
+}
+
+TEST(SpscRingTest, TwoThreadsTransferEveryValueInOrder) {
+  constexpr uint64_t kCount = 200'000;
+  auto ring = std::make_unique<SpscRing<uint64_t, 1024>>();
+
+  std::thread producer([&] {
+    for (uint64_t i = 0; i < kCount; ++i) {
+      while (!ring->try_push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint64_t expected = 0;
+  uint64_t value = 0;
+  while (expected < kCount) {
+    if (ring->try_pop(value)) {
+      ASSERT_EQ(value, expected);
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(ring->empty());
+}
+
+TEST(SpscRingTest, TwoThreadsTransferBatchesInOrder) {
+  constexpr uint64_t kCount = 200'000;
+  auto ring = std::make_unique<SpscRing<uint64_t, 256>>();
+
+  std::thread producer([&] {
+    std::array<uint64_t, 37> batch{}; // Not a divisor of the capacity
+    uint64_t next = 0;
+    while (next < kCount) {
+      std::size_t n = 0;
+      while (n < batch.size() && next + n < kCount) {
+        batch[n] = next + n;
+        ++n;
+      }
+      std::size_t sent = 0;
+      while (sent < n) {
+        sent += ring->try_push_n(batch.data() + sent, n - sent);
+        std::this_thread::yield();
+      }
+      next += n;
+    }
+  });
+
+  uint64_t expected = 0;
+  bool in_order = true;
+  while (expected < kCount) {
+    const std::size_t n = ring->consume(
+        [&](const uint64_t &value) { in_order &= value == expected++; }, 50);
+    if (n == 0) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(in_order);
+  EXPECT_TRUE(ring->empty());
+}
+
+// ============================================================================
+// ShardedPipeline
+// ============================================================================
+
+/**
+ * @brief Records the locate of every message it receives, in order.
+ */
+struct LocateShard {
+  std::vector<uint16_t> locates;
+
+  void on_message(const char *msg, size_t len) {
+    ASSERT_GE(len, 3u);
+    const auto *u = reinterpret_cast<const unsigned char *>(msg);
+    locates.push_back(static_cast<uint16_t>((u[1] << 8) | u[2]));
+  }
+};
+
+using LocatePipeline = ShardedPipeline<LocateShard, 64>;
+
+std::vector<std::unique_ptr<LocateShard>> make_shards(std::size_t n) {
+  std::vector<std::unique_ptr<LocateShard>> shards;
+  for (std::size_t i = 0; i < n; ++i) {
+    shards.push_back(std::make_unique<LocateShard>());
+  }
+  return shards;
+}
+
+/// 'D' message stub: type byte plus big-endian stock_locate
+std::array<char, 3> message_for(uint16_t locate) {
+  return {'D', static_cast<char>(locate >> 8), static_cast<char>(locate)};
+}
+
+TEST(ShardedPipelineTest, ShardForIsStableAndInRange) {
+  LocatePipeline pipeline(make_shards(3));
+  std::array<std::size_t, 3> hits{};
+  for (uint32_t locate = 0; locate < 65536; ++locate) {
+    const std::size_t shard = pipeline.shard_for(static_cast<uint16_t>(locate));
+    ASSERT_LT(shard, 3u);
+    EXPECT_EQ(shard, pipeline.shard_for(static_cast<uint16_t>(locate)));
+    ++hits[shard];
+  }
+  for (const std::size_t count : hits) {
+    EXPECT_GT(count, 65536u / 4); // Roughly even
+  }
+}
+
+TEST(ShardedPipelineTest, EachLocateLandsOnOneShardInOrder) {
+  constexpr std::size_t kShards = 4;
+  constexpr uint16_t kLocates = 50;
+  constexpr int kRounds = 200; // Far more messages than ring slots
+
+  std::vector<std::array<char, 3>> messages;
+  for (int round = 0; round < kRounds; ++round) {
+    for (uint16_t locate = 1; locate <= kLocates; ++locate) {
+      messages.push_back(message_for(locate));
+    }
+  }
+
+  LocatePipeline pipeline(make_shards(kShards));
+  pipeline.start();
+  for (const auto &msg : messages) {
+    pipeline.route(msg.data(), msg.size());
+  }
+  pipeline.finish();
+
+  uint64_t total = 0;
+  for (std::size_t i = 0; i < kShards; ++i) {
+    const std::vector<uint16_t> &seen = pipeline.shard(i).locates;
+    EXPECT_EQ(pipeline.stats(i).messages, seen.size());
+    total += seen.size();
+
+    std::array<int, kLocates + 1> per_locate{};
+    for (const uint16_t locate : seen) {
+      EXPECT_EQ(pipeline.shard_for(locate), i);
+      ++per_locate[locate];
+    }
+    for (uint16_t locate = 1; locate <= kLocates; ++locate) {
+      if (pipeline.shard_for(locate) == i) {
+        EXPECT_EQ(per_locate[locate], kRounds);
+      }
+    }
+  }
+  EXPECT_EQ(total, messages.size());
+}
+
+TEST(ShardedPipelineTest, FinishIsIdempotentAndStartOptional) {
+  LocatePipeline idle(make_shards(2));
+  idle.finish(); // Never started: no-op
+
+  LocatePipeline pipeline(make_shards(2));
+  pipeline.start();
+  const auto msg = message_for(7);
+  pipeline.route(msg.data(), msg.size());
+  pipeline.flush();
+  pipeline.route(msg.data(), msg.size()); // Still staged: finish() sends it
+  pipeline.finish();
+  pipeline.finish();
+
+  EXPECT_EQ(pipeline.stats(0).messages + pipeline.stats(1).messages, 2u);
+  EXPECT_FALSE(pipeline.stats(0).pinned);
+}
+
+} // namespace pipeline::test
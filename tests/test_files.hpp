@@ -0,0 +1,238 @@
+#pragma once
+
+/**
+ * @file test_files.hpp
+ * @brief Shared builders for reader tests and benchmarks: big-endian
+ *        field writers, temporary files, MoldUDP64 frames and PCAP
+ *        captures.
+ *
+ * Exception-free, as the benchmarks build with -fno-exceptions: failures
+ * come back as return values for the caller to check.
+ *
+ * USAGE:
+ *   PcapBuilder pcap;
+ *   pcap.packet(mold_udp_frame("SESSION001", 1, messages));
+ *   TempFile file("itch_feed");
+ *   PcapReader reader(file.write(pcap.bytes()));
+ */
+
+#include <itch/moldudp64.hpp>
+#include <itch/pcap_reader.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace itch::test {
+
+// ============================================================================
+// Big-Endian Fields (ITCH and network byte order)
+// ============================================================================
+
+/**
+ * @brief Write the low `width` bytes of `value` at `out`, most
+ *        significant first.
+ */
+template <typename Byte>
+void put_be(Byte *out, uint64_t value, std::size_t width) {
+  for (std::size_t i = 0; i < width; ++i) {
+    out[i] = static_cast<Byte>(value >> (8 * (width - 1 - i)));
+  }
+}
+
+/**
+ * @brief Append the low `width` bytes of `value`, most significant first.
+ */
+template <typename Byte>
+void append_be(std::vector<Byte> &out, uint64_t value, std::size_t width) {
+  out.resize(out.size() + width);
+  put_be(out.data() + out.size() - width, value, width);
+}
+
+// ============================================================================
+// TempFile - File Under /tmp, Removed on Destruction
+// ============================================================================
+
+class TempFile {
+public:
+  /**
+   * @brief Create an empty file named after `prefix` (path() is empty if
+   *        it cannot be created).
+   */
+  explicit TempFile(const char *prefix = "itch_test") {
+    std::string name = std::string("/tmp/") + prefix + "_XXXXXX";
+    const int fd = ::mkstemp(name.data());
+    if (fd >= 0) {
+      ::close(fd);
+      path_ = name;
+    }
+  }
+
+  ~TempFile() {
+    if (!path_.empty()) {
+      ::unlink(path_.c_str());
+    }
+  }
+
+  TempFile(const TempFile &) = delete;
+  TempFile &operator=(const TempFile &) = delete;
+
+  [[nodiscard]] const char *path() const noexcept { return path_.c_str(); }
+
+  /**
+   * @brief Replace the file's contents with `bytes`.
+   * @return path(), or "" if the file could not be written (so a reader
+   *         opened on the result fails instead of reading stale bytes)
+   */
+  template <typename Byte> const char *write(const std::vector<Byte> &bytes) {
+    const int fd = path_.empty() ? -1 : ::open(path(), O_WRONLY | O_TRUNC);
+    if (fd < 0) {
+      return "";
+    }
+    const auto *data = reinterpret_cast<const char *>(bytes.data());
+    std::size_t done = 0;
+    while (done < bytes.size()) {
+      const ssize_t n = ::write(fd, data + done, bytes.size() - done);
+      if (n <= 0) {
+        break;
+      }
+      done += static_cast<std::size_t>(n);
+    }
+    ::close(fd);
+    return done == bytes.size() ? path() : "";
+  }
+
+private:
+  std::string path_;
+};
+
+// ============================================================================
+// Frames - Ethernet/IPv4/UDP/MoldUDP64
+// ============================================================================
+
+/**
+ * @brief One captured Ethernet frame carrying a MoldUDP64 packet of
+ *        `messages` (an empty list is a heartbeat).
+ *
+ * @param session 10-character MoldUDP64 session
+ */
+inline std::vector<unsigned char>
+mold_udp_frame(const char *session, uint64_t sequence,
+               const std::vector<std::vector<unsigned char>> &messages) {
+  std::vector<unsigned char> mold(session, session + 10);
+  append_be(mold, sequence, 8);
+  append_be(mold, messages.size(), 2);
+  for (const auto &msg : messages) {
+    append_be(mold, msg.size(), 2);
+    mold.insert(mold.end(), msg.begin(), msg.end());
+  }
+
+  std::vector<unsigned char> frame(12, 0xAB); // MAC addresses
+  append_be(frame, wire::kEtherTypeIPv4, 2);
+  const std::size_t udp_len = 8 + mold.size();
+  frame.insert(frame.end(), {0x45, 0x00});
+  append_be(frame, 20 + udp_len, 2);
+  append_be(frame, 0, 4); // Identification, flags
+  frame.insert(frame.end(), {64, wire::kIpProtoUdp, 0, 0});
+  frame.insert(frame.end(), 8, 0x0A); // Addresses
+  append_be(frame, 26477, 2);
+  append_be(frame, 26477, 2);
+  append_be(frame, udp_len, 2);
+  append_be(frame, 0, 2);
+  frame.insert(frame.end(), mold.begin(), mold.end());
+  return frame;
+}
+
+// ============================================================================
+// PcapBuilder - Native-Order Microsecond Capture
+// ============================================================================
+
+/**
+ * @brief Builds a PCAP capture in memory, or streams a large one to a
+ *        file with flush().
+ *
+ * Records are stamped 1 us apart.
+ */
+class PcapBuilder {
+public:
+  /// Start with the global header for `network` frames (1 = Ethernet)
+  explicit PcapBuilder(uint32_t network = 1) {
+    PcapGlobalHeader global{};
+    global.magic_number = 0xa1b2c3d4;
+    global.version_major = 2;
+    global.version_minor = 4;
+    global.snaplen = 65535;
+    global.network = network;
+    append(&global, sizeof(global));
+  }
+
+  /// Append a record of `len` bytes from `data`
+  void packet(const void *data, std::size_t len) {
+    append_header(len);
+    append(data, len);
+  }
+
+  void packet(const std::vector<unsigned char> &frame) {
+    packet(frame.data(), frame.size());
+  }
+
+  /// Append a record of `len` bytes, each equal to `fill`
+  void fill_packet(std::size_t len, unsigned char fill) {
+    append_header(len);
+    bytes_.insert(bytes_.end(), len, fill);
+    total_ += len;
+  }
+
+  /// Capture bytes not yet flushed (the whole capture if never flushed)
+  [[nodiscard]] std::vector<unsigned char> &bytes() noexcept { return bytes_; }
+
+  [[nodiscard]] const std::vector<unsigned char> &bytes() const noexcept {
+    return bytes_;
+  }
+
+  /// Bytes built so far, flushed or not
+  [[nodiscard]] std::size_t total_bytes() const noexcept { return total_; }
+
+  /**
+   * @brief Append the unflushed bytes to `out` and drop them.
+   * @return false on a write error
+   */
+  bool flush(std::FILE *out) {
+    const bool ok =
+        std::fwrite(bytes_.data(), 1, bytes_.size(), out) == bytes_.size();
+    bytes_.clear();
+    return ok;
+  }
+
+private:
+  void append(const void *data, std::size_t len) {
+    if (len != 0) {
+      const std::size_t at = bytes_.size();
+      bytes_.resize(at + len);
+      std::memcpy(bytes_.data() + at, data, len);
+      total_ += len;
+    }
+  }
+
+  void append_header(std::size_t len) {
+    PcapPacketHeader header{};
+    ++ts_usec_;
+    header.ts_sec = ts_usec_ / 1'000'000;
+    header.ts_usec = ts_usec_ % 1'000'000;
+    header.incl_len = static_cast<uint32_t>(len);
+    header.orig_len = header.incl_len;
+    append(&header, sizeof(header));
+  }
+
+  std::vector<unsigned char> bytes_;
+  std::size_t total_ = 0;
+  uint32_t ts_usec_ = 0;
+};
+
+} // namespace itch::test
@@ -0,0 +1,643 @@
+#!/usr/bin/env python3
+"""
+test_itch_handler.py - Smoke tests of the itch_handler Python module
+
+Every result is checked against a pure-Python decoder of the same capture
+(the captures in data/ and generated ones). ctest runs this file when
+NumPy is found, with the module's directory on PYTHONPATH:
+
+    PYTHONPATH=build python3 tests/test_itch_handler.py
+"""
+
+import os
+import random
+import struct
+import tempfile
+import threading
+import unittest
+from pathlib import Path
+
+import numpy as np
+
+import itch_handler
+
+DATA_DIR = Path(__file__).resolve().parent.parent / "data"
+
+ADD_FIELDS = ("order_ref", "timestamp", "stock_locate", "shares", "price",
+              "side")
+EXEC_FIELDS = ("order_ref", "timestamp", "stock_locate", "executed_shares",
+               "match_number")
+ADD_DTYPES = (np.uint64, np.uint64, np.uint16, np.uint32, np.uint32,
+              np.int8)  # side is a C char: ord('B') / ord('S')
+EXEC_DTYPES = (np.uint64, np.uint64, np.uint16, np.uint32, np.uint64)
+
+# =============================================================================
+# Capture Writer - ITCH 5.0 messages in MoldUDP64 over Ethernet/IPv4/UDP
+# =============================================================================
+
+
+def _header(msg_type: bytes, locate: int, ts: int) -> bytes:
+    """Type, stock_locate, tracking number and 6-byte timestamp."""
+    return msg_type + struct.pack(">HH", locate, 0) + ts.to_bytes(6, "big")
+
+
+def _symbol(symbol: str) -> bytes:
+    return symbol.encode().ljust(8)
+
+
+def stock_directory(locate: int, ts: int, symbol: str) -> bytes:
+    return (_header(b"R", locate, ts) + _symbol(symbol) +
+            b"Q" + b"N" + struct.pack(">I", 100) + b"N" * 8 +
+            struct.pack(">I", 0) + b"N")
+
+
+def add_order(locate: int, ts: int, ref: int, symbol: str, side: bytes = b"B",
+              shares: int = 100, price: int = 1500) -> bytes:
+    return (_header(b"A", locate, ts) + struct.pack(">Q", ref) + side +
+            struct.pack(">I", shares) + _symbol(symbol) +
+            struct.pack(">I", price))
+
+
+def order_executed(locate: int, ts: int, ref: int, shares: int = 10,
+                   match: int = 0) -> bytes:
+    return (_header(b"E", locate, ts) +
+            struct.pack(">QIQ", ref, shares, match))
+
+
+def order_cancel(locate: int, ts: int, ref: int, shares: int) -> bytes:
+    return _header(b"X", locate, ts) + struct.pack(">QI", ref, shares)
+
+
+def order_delete(locate: int, ts: int, ref: int) -> bytes:
+    return _header(b"D", locate, ts) + struct.pack(">Q", ref)
+
+
+def order_replace(locate: int, ts: int, old_ref: int, new_ref: int,
+                  shares: int, price: int) -> bytes:
+    return (_header(b"U", locate, ts) +
+            struct.pack(">QQII", old_ref, new_ref, shares, price))
+
+
+def write_pcap(path: str, packets, session: bytes = b"SESSION001") -> None:
+    """Write one MoldUDP64 packet (list of messages) per captured frame."""
+    sequence = 1
+    with open(path, "wb") as out:
+        out.write(struct.pack("<IHHiIII", 0xa1b2c3d4, 2, 4, 0, 0, 65535, 1))
+        for messages in packets:
+            mold = session + struct.pack(">QH", sequence, len(messages))
+            for msg in messages:
+                mold += struct.pack(">H", len(msg)) + msg
+            sequence += len(messages)
+            udp = struct.pack(">HHHH", 26477, 26477, 8 + len(mold), 0) + mold
+            ip = struct.pack(">BBHHHBBH4s4s", 0x45, 0, 20 + len(udp), 0,
+                             0x4000, 64, 17, 0, bytes(4), bytes(4))
+            frame = b"\xab" * 12 + b"\x08\x00" + ip + udp
+            out.write(struct.pack("<IIII", 0, 0, len(frame), len(frame)))
+            out.write(frame)
+
+
+def random_feed(seed: int, packets: int = 600, locates: int = 12):
+    """Packets of 0-5 add/execute/cancel/delete messages over `locates`
+    instruments, with each Stock Directory message sent part-way through
+    (after some of its instrument's executions)."""
+    rng = random.Random(seed)
+    symbols = ["SYM%d" % locate for locate in range(locates + 1)]
+    announced = set()
+    ts = 34_200_000_000_000
+    next_ref = 1
+    feed = []
+    for _ in range(packets):
+        messages = []
+        for _ in range(rng.randrange(6)):
+            locate = rng.randrange(1, locates + 1)
+            ts += rng.randrange(1000)
+            kind = rng.randrange(10)
+            if kind == 0 and locate not in announced:
+                announced.add(locate)
+                messages.append(stock_directory(locate, ts, symbols[locate]))
+            elif kind < 5:
+                messages.append(add_order(
+                    locate, ts, next_ref, symbols[locate],
+                    rng.choice((b"B", b"S")), rng.randrange(1, 1000),
+                    10_000 + rng.randrange(-50, 50) * 100))
+                next_ref += 1
+            elif kind < 8:
+                messages.append(order_executed(
+                    locate, ts, rng.randrange(1, next_ref + 1),
+                    rng.randrange(1, 100), rng.randrange(1 << 40)))
+            else:
+                messages.append(order_delete(locate, ts,
+                                             rng.randrange(1, next_ref + 1)))
+        feed.append(messages)
+    return feed, symbols
+
+def book_feed(seed: int, packets: int = 800, locates: int = 4):
+    """Packets of order events on live orders (adds, executions, cancels,
+    deletes, replaces), with gaps longer than a 10 us interval."""
+    rng = random.Random(seed)
+    live = {locate: [] for locate in range(1, locates + 1)}
+    ts = 34_200_000_000_000
+    next_ref = 1
+    feed = []
+    for _ in range(packets):
+        messages = []
+        for _ in range(rng.randrange(1, 5)):
+            locate = rng.randrange(1, locates + 1)
+            ts += (25_000 + rng.randrange(40_000) if rng.randrange(20) == 0
+                   else rng.randrange(3_000))
+            orders = live[locate]
+            kind = rng.randrange(10) if orders else 0
+            pick = rng.choice(orders) if orders else 0
+            if kind < 4:
+                side = rng.choice((b"B", b"S"))
+                price = 1000 + rng.randrange(6) + (4 if side == b"S" else 0)
+                messages.append(add_order(locate, ts, next_ref, "SYM",
+                                          side, 100 * rng.randrange(1, 6),
+                                          price))
+                orders.append(next_ref)
+                next_ref += 1
+            elif kind < 6:
+                messages.append(order_executed(locate, ts, pick,
+                                               50 * rng.randrange(1, 7)))
+            elif kind < 7:
+                messages.append(order_cancel(locate, ts, pick,
+                                             50 * rng.randrange(1, 7)))
+            elif kind < 9:
+                messages.append(order_delete(locate, ts, pick))
+            else:
+                messages.append(order_replace(locate, ts, pick, next_ref,
+                                              300, 1000 + rng.randrange(10)))
+                orders.append(next_ref)
+                next_ref += 1
+        feed.append(messages)
+    return feed
+
+# =============================================================================
+# Reference Decoder
+# =============================================================================
+
+
+def read_packets(path: str):
+    """Yield (link type, frame) for every packet of a PCAP file."""
+    with open(path, "rb") as f:
+        data = f.read()
+    magic = struct.unpack_from("<I", data)[0]
+    order = "<" if magic in (0xa1b2c3d4, 0xa1b23c4d) else ">"
+    link = struct.unpack_from(order + "I", data, 20)[0]
+    offset = 24
+    while offset + 16 <= len(data):
+        incl_len = struct.unpack_from(order + "I", data, offset + 8)[0]
+        offset += 16
+        if offset + incl_len > len(data):
+            break
+        yield link, data[offset:offset + incl_len]
+        offset += incl_len
+
+
+def mold_payload(link: int, frame: bytes):
+    """MoldUDP64 payload of a frame, or None if it is not IPv4/UDP."""
+    offset = {1: 14, 113: 16}.get(link, 0)
+    ether_type = (struct.unpack_from(">H", frame, offset - 2)[0]
+                  if offset else 0x0800)
+    while ether_type in (0x8100, 0x88a8):
+        ether_type = struct.unpack_from(">H", frame, offset + 2)[0]
+        offset += 4
+    if ether_type != 0x0800 or frame[offset + 9] != 17:
+        return None
+    ihl = (frame[offset] & 0x0f) * 4
+    udp_len = struct.unpack_from(">H", frame, offset + ihl + 4)[0]
+    start = offset + ihl + 8
+    return frame[start:start + udp_len - 8]
+
+
+def decode(path: str) -> dict:
+    """parse_file()'s result for `path`, as lists, decoded in Python."""
+    adds = {name: [] for name in ADD_FIELDS}
+    execs = {name: [] for name in EXEC_FIELDS}
+    result = {"add_orders": adds, "order_executed": execs,
+              "packet_count": 0, "session": "", "next_sequence": 0,
+              "messages": []}
+    for link, frame in read_packets(path):
+        result["packet_count"] += 1
+        mold = mold_payload(link, frame)
+        if mold is None:
+            continue
+        sequence, count = struct.unpack_from(">QH", mold, 10)
+        if not result["session"]:
+            result["session"] = mold[:10].decode()
+        result["next_sequence"] = sequence + count
+        offset = 20
+        for _ in range(count):
+            (length,) = struct.unpack_from(">H", mold, offset)
+            msg = mold[offset + 2:offset + 2 + length]
+            offset += 2 + length
+            result["messages"].append(msg)
+            locate = struct.unpack_from(">H", msg, 1)[0]
+            ts = int.from_bytes(msg[5:11], "big")
+            if msg[:1] == b"A":
+                ref, side, shares, _, price = struct.unpack_from(
+                    ">QcI8sI", msg, 11)
+                for name, value in zip(ADD_FIELDS, (ref, ts, locate, shares,
+                                                    price, ord(side))):
+                    adds[name].append(value)
+            elif msg[:1] == b"E":
+                ref, shares, match = struct.unpack_from(">QIQ", msg, 11)
+                for name, value in zip(EXEC_FIELDS, (ref, ts, locate, shares,
+                                                     match)):
+                    execs[name].append(value)
+    return result
+
+
+def message_rows(path: str):
+    """(type, stock_locate, timestamp, order_ref, symbol) of every AddOrder,
+    OrderExecuted and Stock Directory message, in feed order."""
+    rows = []
+    for msg in decode(path)["messages"]:
+        locate = struct.unpack_from(">H", msg, 1)[0]
+        ts = int.from_bytes(msg[5:11], "big")
+        if msg[:1] == b"R":
+            rows.append(("R", locate, ts, 0, msg[11:19].decode().rstrip()))
+        elif msg[:1] == b"A":
+            rows.append(("A", locate, ts, struct.unpack_from(">Q", msg, 11)[0],
+                         msg[24:32].decode().rstrip()))
+        elif msg[:1] == b"E":
+            rows.append(("E", locate, ts, struct.unpack_from(">Q", msg, 11)[0],
+                         None))
+    return rows
+
+def book_steps(path: str, depth: int):
+    """(timestamp, locate, snapshot or None) after every order event of
+    the capture, from a dict-of-orders book. A snapshot is
+    (bid_prices, bid_sizes, ask_prices, ask_sizes), zero-padded to
+    `depth`; None while the locate has no book (no add yet)."""
+    orders = {}  # order_ref -> [locate, side, shares, price]
+    books = set()
+    steps = []
+
+    def find(locate, ref):
+        order = orders.get(ref)
+        return order if order is not None and order[0] == locate else None
+
+    def snapshot(locate):
+        levels = {b"B": {}, b"S": {}}
+        for order_locate, side, shares, price in orders.values():
+            if order_locate == locate:
+                levels[side][price] = levels[side].get(price, 0) + shares
+        result = []
+        for side, best_first in ((b"B", True), (b"S", False)):
+            prices = sorted(levels[side], reverse=best_first)[:depth]
+            pad = [0] * (depth - len(prices))
+            result += [prices + pad,
+                       [levels[side][price] for price in prices] + pad]
+        return tuple(tuple(column) for column in result)
+
+    for msg in decode(path)["messages"]:
+        kind = msg[:1]
+        if kind not in (b"A", b"E", b"X", b"D", b"U"):
+            continue
+        locate = struct.unpack_from(">H", msg, 1)[0]
+        ts = int.from_bytes(msg[5:11], "big")
+        if kind == b"A":
+            ref, side, shares, _, price = struct.unpack_from(">QcI8sI",
+                                                             msg, 11)
+            books.add(locate)
+            orders.setdefault(ref, [locate, side, shares, price])
+        elif kind in b"EX":
+            ref, shares = struct.unpack_from(">QI", msg, 11)
+            order = find(locate, ref)
+            if order is not None:
+                order[2] -= shares
+                if order[2] <= 0:
+                    del orders[ref]
+        elif kind == b"D":
+            (ref,) = struct.unpack_from(">Q", msg, 11)
+            if find(locate, ref) is not None:
+                del orders[ref]
+        else:
+            old, new, shares, price = struct.unpack_from(">QQII", msg, 11)
+            order = find(locate, old)
+            if order is not None and new not in orders:
+                del orders[old]
+                orders[new] = [locate, order[1], shares, price]
+        steps.append((ts, locate,
+                      snapshot(locate) if locate in books else None))
+    return steps
+
+
+def interval_rows(steps, interval_ns: int):
+    """Per interval, each book with an event in it after its last event
+    there, stamped with the interval end (books in order of first
+    event)."""
+    rows = []
+    latest = {}
+    end = None
+    for ts, locate, snap in steps + [(None, None, None)]:
+        if ts is None or end is None or ts >= end:
+            rows += [(end, lid, s) for lid, s in latest.items()
+                     if s is not None]
+            latest = {}
+            if ts is None:
+                break
+            end = ts // interval_ns * interval_ns + interval_ns
+        latest[locate] = snap  # dict keeps first-insertion order
+    return rows
+
+# =============================================================================
+# Tests
+# =============================================================================
+
+
+class CaptureTestCase(unittest.TestCase):
+    """Writes generated captures to a temporary directory."""
+
+    def setUp(self):
+        self._dir = tempfile.TemporaryDirectory()
+        self.addCleanup(self._dir.cleanup)
+
+    def write(self, packets, name="feed.pcap") -> str:
+        path = os.path.join(self._dir.name, name)
+        write_pcap(path, packets)
+        return path
+
+    def assertTablesEqual(self, actual: dict, expected: dict):
+        """Same columns, same rows (arrays or lists)."""
+        for table in ("add_orders", "order_executed"):
+            self.assertEqual(sorted(actual[table]), sorted(expected[table]))
+            for name, column in expected[table].items():
+                np.testing.assert_array_equal(
+                    np.asarray(actual[table][name]),
+                    np.asarray(column, dtype=actual[table][name].dtype),
+                    err_msg="%s.%s" % (table, name))
+
+
+class ParseFileTest(CaptureTestCase):
+
+    def assertMatchesReference(self, path: str):
+        data = itch_handler.parse_file(path)
+        expected = decode(path)
+        self.assertTablesEqual(data, expected)
+        for key in ("packet_count", "session", "next_sequence"):
+            self.assertEqual(data[key], expected[key], key)
+        self.assertEqual(data["file_size"], os.path.getsize(path))
+
+    def test_data_captures_match_reference(self):
+        captures = sorted(DATA_DIR.glob("*.pcap"))
+        self.assertTrue(captures)
+        for path in captures:
+            with self.subTest(capture=path.name):
+                self.assertMatchesReference(str(path))
+
+    def test_generated_capture_matches_reference(self):
+        feed, _ = random_feed(seed=1)
+        path = self.write(feed)
+        self.assertGreater(len(decode(path)["order_executed"]["order_ref"]),
+                           100)
+        self.assertMatchesReference(path)
+
+    def test_columns_are_typed_and_own_the_parsed_data(self):
+        feed, _ = random_feed(seed=2)
+        data = itch_handler.parse_file(self.write(feed))
+        for table, fields, dtypes in (
+                ("add_orders", ADD_FIELDS, ADD_DTYPES),
+                ("order_executed", EXEC_FIELDS, EXEC_DTYPES)):
+            for name, dtype in zip(fields, dtypes):
+                column = data[table][name]
+                self.assertEqual(column.dtype, np.dtype(dtype), name)
+                # Zero-copy: the array views memory a capsule owns
+                self.assertFalse(column.flags.owndata, name)
+                self.assertEqual(type(column.base).__name__, "PyCapsule")
+
+    def test_any_thread_count_matches_one_thread(self):
+        feed, _ = random_feed(seed=6, packets=2000)
+        path = self.write(feed)
+        single = itch_handler.parse_file(path, threads=1)
+        for threads in (0, 2, 3, 8):
+            with self.subTest(threads=threads):
+                data = itch_handler.parse_file(path, threads=threads)
+                self.assertTablesEqual(data, single)
+                for key in ("packet_count", "session", "next_sequence"):
+                    self.assertEqual(data[key], single[key], key)
+
+    def test_empty_and_missing_files(self):
+        path = self.write([])
+        data = itch_handler.parse_file(path)
+        self.assertEqual(data["packet_count"], 0)
+        self.assertEqual(len(data["add_orders"]["order_ref"]), 0)
+        with self.assertRaises(RuntimeError):
+            itch_handler.parse_file(os.path.join(self._dir.name, "missing"))
+
+
+def concatenate(batches) -> dict:
+    """Join stream() batches into parse_file()'s table layout."""
+    return {table: {name: np.concatenate([b[table][name] for b in batches])
+                    for name in fields}
+            for table, fields in (("add_orders", ADD_FIELDS),
+                                  ("order_executed", EXEC_FIELDS))}
+
+
+def sorted_rows(tables: dict, table: str):
+    """Rows of one table as sorted tuples (order-free comparison)."""
+    columns = tables[table]
+    return sorted(zip(*(columns[name].tolist() for name in columns)))
+
+
+class StreamTest(CaptureTestCase):
+
+    def test_small_chunks_concatenate_to_parse_file(self):
+        feed, _ = random_feed(seed=3)
+        path = self.write(feed)
+        whole = itch_handler.parse_file(path)
+        for chunk in (1, 7, 100, 1 << 20):
+            with self.subTest(chunk=chunk):
+                stream = itch_handler.stream(path, chunk_messages=chunk)
+                batches = list(stream)
+                self.assertTrue(batches)
+                for batch in batches:
+                    self.assertLessEqual(
+                        len(batch["add_orders"]["order_ref"]), chunk)
+                    self.assertLessEqual(
+                        len(batch["order_executed"]["order_ref"]), chunk)
+                self.assertTablesEqual(concatenate(batches), whole)
+                self.assertEqual(stream.packet_count, whole["packet_count"])
+                self.assertEqual(batches[-1]["packet_count"],
+                                 whole["packet_count"])
+                self.assertEqual(batches[-1]["session"], whole["session"])
+                self.assertEqual(batches[-1]["next_sequence"],
+                                 whole["next_sequence"])
+
+    def test_concurrent_next_calls_each_get_whole_batches(self):
+        feed, _ = random_feed(seed=4, packets=3000)
+        path = self.write(feed)
+        whole = itch_handler.parse_file(path)
+        stream = itch_handler.stream(path, chunk_messages=5)
+        batches = []
+
+        def drain():
+            for batch in stream:
+                batches.append(batch)  # list.append is atomic
+
+        workers = [threading.Thread(target=drain) for _ in range(4)]
+        for worker in workers:
+            worker.start()
+        for worker in workers:
+            worker.join()
+
+        # Batches interleave across threads, but no row is lost, doubled
+        # or torn
+        streamed = concatenate(batches)
+        for table in ("add_orders", "order_executed"):
+            self.assertEqual(sorted_rows(streamed, table),
+                             sorted_rows(whole, table), table)
+        self.assertEqual(stream.packet_count, whole["packet_count"])
+
+    def test_chunk_messages_must_be_positive(self):
+        path = self.write(random_feed(seed=5, packets=10)[0])
+        with self.assertRaises(ValueError):
+            itch_handler.stream(path, chunk_messages=0)
+
+
+def filtered(path: str, keep) -> dict:
+    """decode(path) tables keeping the rows where keep(table, locate,
+    timestamp) is true."""
+    tables = {}
+    decoded = decode(path)
+    for table in ("add_orders", "order_executed"):
+        columns = decoded[table]
+        rows = [i for i, (locate, ts) in enumerate(
+                    zip(columns["stock_locate"], columns["timestamp"]))
+                if keep(table, locate, ts)]
+        tables[table] = {name: [column[i] for i in rows]
+                         for name, column in columns.items()}
+    return tables
+
+
+class FilterTest(CaptureTestCase):
+    """parse_file() filters against the reference decoder, on a feed whose
+    Stock Directory messages arrive after some of their executions."""
+
+    THREADS = (1, 2, 3, 8)
+
+    def setUp(self):
+        super().setUp()
+        feed, self.symbols = random_feed(seed=7, packets=1500)
+        self.path = self.write(feed)
+
+    def assertFilter(self, keep, **filters):
+        expected = filtered(self.path, keep)
+        for threads in self.THREADS:
+            with self.subTest(threads=threads, **filters):
+                data = itch_handler.parse_file(self.path, threads=threads,
+                                               **filters)
+                self.assertTablesEqual(data, expected)
+
+    def test_symbols_keep_executions_sent_before_stock_directory(self):
+        # Executions on a locate before any message names its symbol are
+        # held pending until a later one (possibly in a later shard) does
+        wanted = {"SYM2", "SYM5", "SYM11"}
+        rows = message_rows(self.path)
+        first_named = {}
+        for i, (kind, locate, _, _, symbol) in enumerate(rows):
+            if symbol is not None:
+                first_named.setdefault(locate, i)
+        early = [i for i, (kind, locate, _, _, _) in enumerate(rows)
+                 if kind == "E" and self.symbols[locate] in wanted and
+                 i < first_named.get(locate, len(rows))]
+        self.assertTrue(early)
+        self.assertFilter(
+            lambda table, locate, ts: self.symbols[locate] in wanted,
+            symbols=sorted(wanted))
+
+    def test_empty_selection_keeps_nothing(self):
+        self.assertFilter(lambda table, locate, ts: False, symbols=[])
+        self.assertFilter(lambda table, locate, ts: False, stock_locates=[])
+
+    def test_stock_locates_and_symbols_select_either(self):
+        self.assertFilter(
+            lambda table, locate, ts: locate in (1, 3) or locate == 8,
+            stock_locates=[1, 3], symbols=["SYM8"])
+
+    def test_window_includes_start_and_excludes_end(self):
+        timestamps = sorted(set(
+            decode(self.path)["order_executed"]["timestamp"]))
+        start, end = timestamps[10], timestamps[-10]
+        self.assertFilter(lambda table, locate, ts: start <= ts < end,
+                          start_ns=start, end_ns=end)
+        data = itch_handler.parse_file(self.path, start_ns=start,
+                                       end_ns=end)
+        executed = data["order_executed"]["timestamp"]
+        self.assertEqual(executed[0], start)
+        self.assertLess(executed[-1], end)
+
+    def test_message_types_combine_with_symbols(self):
+        self.assertFilter(
+            lambda table, locate, ts: (table == "order_executed" and
+                                       self.symbols[locate] == "SYM4"),
+            message_types={"E"}, symbols=["SYM4"])
+
+    def test_invalid_filters_raise_value_error(self):
+        for filters in ({"symbols": [""]}, {"symbols": ["TOOLONGSYM"]},
+                        {"message_types": {"X"}},
+                        {"start_ns": 10, "end_ns": 5}):
+            with self.subTest(**filters):
+                with self.assertRaises(ValueError):
+                    itch_handler.parse_file(self.path, **filters)
+
+
+class ReplayBookTest(CaptureTestCase):
+    """replay_book() snapshots against a dict-of-orders reference book."""
+
+    DEPTH = 3
+    INTERVAL = 10_000
+
+    def setUp(self):
+        super().setUp()
+        self.path = self.write(book_feed(seed=8))
+        self.steps = book_steps(self.path, self.DEPTH)
+
+    def rows(self, snap):
+        columns = [snap[name].tolist() for name in
+                   ("bid_price", "bid_size", "ask_price", "ask_size")]
+        return [(ts, locate, tuple(tuple(c[i]) for c in columns))
+                for i, (ts, locate) in enumerate(
+                    zip(snap["timestamp"].tolist(),
+                        snap["stock_locate"].tolist()))]
+
+    def test_every_event_rows_match_reference(self):
+        snap = itch_handler.replay_book(self.path, depth=self.DEPTH)
+        expected = [step for step in self.steps if step[2] is not None]
+        self.assertGreater(len(expected), 1000)
+        self.assertEqual(self.rows(snap), expected)
+        self.assertEqual(snap["bid_price"].shape, (len(expected),
+                                                   self.DEPTH))
+
+    def test_interval_rows_hold_book_after_last_event(self):
+        snap = itch_handler.replay_book(self.path, depth=self.DEPTH,
+                                        interval_ns=self.INTERVAL)
+        expected = interval_rows(self.steps, self.INTERVAL)
+        self.assertLess(len(expected), len(self.steps))
+        self.assertEqual(self.rows(snap), expected)
+        # The last interval is flushed at the end of the replay
+        last_end = (self.steps[-1][0] // self.INTERVAL + 1) * self.INTERVAL
+        self.assertEqual(snap["timestamp"][-1], last_end)
+
+    def test_interval_forward_fill_equals_book_at_grid_times(self):
+        snap = itch_handler.replay_book(self.path, depth=self.DEPTH,
+                                        interval_ns=self.INTERVAL)
+        rows = self.rows(snap)
+        first = self.steps[0][0] // self.INTERVAL * self.INTERVAL
+        last = self.steps[-1][0] + 2 * self.INTERVAL
+        filled, truth = {}, {}
+        row = step = 0
+        for grid in range(first, last + 1, self.INTERVAL):
+            while row < len(rows) and rows[row][0] <= grid:
+                filled[rows[row][1]] = rows[row][2]
+                row += 1
+            while step < len(self.steps) and self.steps[step][0] < grid:
+                if self.steps[step][2] is not None:
+                    truth[self.steps[step][1]] = self.steps[step][2]
+                step += 1
+            self.assertEqual(filled, truth, grid)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,190 @@
+/**
+ * @file uring_reader_test.cpp
+ * @brief Unit tests for BlockFileReader and UringPcapReader.
+ */
+
+#include <gtest/gtest.h>
+#include <itch/pcap_reader.hpp>
+#include <itch/uring_reader.hpp>
+
+#include "test_files.hpp"
+
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace itch::test {
+
+// ============================================================================
+// Test Fixture - writes a temporary PCAP file
+// ============================================================================
+
+class UringReaderTest : public ::testing::Test {
+protected:
+  /// Write `bytes` to the test's temporary file and return its path
+  const char *write_file(const std::vector<unsigned char> &bytes) {
+    return file_.write(bytes);
+  }
+
+  /// Native-order PCAP with packets of 1..~6000 bytes (several straddle
+  /// every 4 KB block, and some are longer than a block)
+  static std::vector<unsigned char> make_pcap() {
+    PcapBuilder pcap;
+    unsigned char tag = 0;
+    for (uint32_t len = 1; len < 6000; len += 211) {
+      pcap.fill_packet(len, ++tag);
+    }
+    return pcap.bytes();
+  }
+
+  template <typename Reader>
+  static std::vector<std::pair<size_t, unsigned char>> collect(Reader &reader) {
+    std::vector<std::pair<size_t, unsigned char>> packets;
+    reader.for_each_packet([&](const char *data, size_t len) {
+      const auto tag = static_cast<unsigned char>(data[0]);
+      for (size_t i = 1; i < len; ++i) {
+        EXPECT_EQ(static_cast<unsigned char>(data[i]), tag);
+      }
+      packets.emplace_back(len, tag);
+    });
+    return packets;
+  }
+
+  TempFile file_{"itch_uring"};
+};
+
+// ============================================================================
+// BlockFileReader
+// ============================================================================
+
+TEST_F(UringReaderTest, Blocks_ArriveInOrderWithShortTail) {
+  std::vector<unsigned char> bytes(3 * 4096 + 100);
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<unsigned char>(i * 7);
+  }
+  const char *path = write_file(bytes);
+
+  for (const bool uring : {true, false}) {
+    BlockFileReader reader(path, {.block_bytes = 4096,
+                                  .queue_depth = 2,
+                                  .use_uring = uring});
+    ASSERT_TRUE(reader.is_open());
+    EXPECT_EQ(reader.block_bytes(), 4096u);
+    if (!uring) {
+      EXPECT_EQ(reader.backend(), ReadBackend::Pread);
+    }
+
+    std::vector<unsigned char> read;
+    std::vector<size_t> lengths;
+    EXPECT_TRUE(reader.for_each_block([&](const char *data, size_t len) {
+      read.insert(read.end(), data, data + len);
+      lengths.push_back(len);
+      return true;
+    }));
+    EXPECT_EQ(read, bytes);
+    EXPECT_EQ(lengths, (std::vector<size_t>{4096, 4096, 4096, 100}));
+  }
+}
+
+TEST_F(UringReaderTest, Blocks_StopEarlyDrainsReads) {
+  const char *path = write_file(std::vector<unsigned char>(16 * 4096, 1));
+  BlockFileReader reader(path, {.block_bytes = 4096, .queue_depth = 4});
+  int seen = 0;
+  EXPECT_TRUE(reader.for_each_block([&](const char *, size_t) {
+    return ++seen < 2;
+  }));
+  EXPECT_EQ(seen, 2);
+
+  // The reader is reusable after an early stop
+  seen = 0;
+  EXPECT_TRUE(reader.for_each_block([&](const char *, size_t) {
+    ++seen;
+    return true;
+  }));
+  EXPECT_EQ(seen, 16);
+}
+
+// ============================================================================
+// UringPcapReader
+// ============================================================================
+
+TEST_F(UringReaderTest, Pcap_BadFilesFailToOpen) {
+  EXPECT_FALSE(UringPcapReader("/nonexistent/itch.pcap").is_open());
+  const char *path = write_file(std::vector<unsigned char>(64, 0));
+  EXPECT_FALSE(UringPcapReader(path).is_open());
+}
+
+TEST_F(UringReaderTest, Pcap_ReportsLinkType) {
+  std::vector<unsigned char> bytes = make_pcap();
+  bytes[20] = 113; // network, native order (Linux cooked)
+  UringPcapReader reader(write_file(bytes));
+  ASSERT_TRUE(reader.is_open());
+  EXPECT_EQ(reader.link_type(), 113u);
+}
+
+TEST_F(UringReaderTest, Pcap_MatchesMmapReaderOnEveryBackend) {
+  const char *path = write_file(make_pcap());
+  PcapReader mapped(path);
+  ASSERT_TRUE(mapped.is_open());
+  const auto expected = collect(mapped);
+  ASSERT_FALSE(expected.empty());
+
+  for (const bool uring : {true, false}) {
+    for (const bool direct : {true, false}) {
+      UringPcapReader reader(path, {.block_bytes = 4096,
+                                    .queue_depth = 3,
+                                    .direct_io = direct,
+                                    .use_uring = uring});
+      ASSERT_TRUE(reader.is_open());
+      EXPECT_EQ(collect(reader), expected)
+          << "uring=" << uring << " direct=" << direct;
+    }
+  }
+}
+
+TEST_F(UringReaderTest, Pcap_TruncatedTailIsDropped) {
+  std::vector<unsigned char> bytes = make_pcap();
+  bytes.resize(bytes.size() - 10);
+  const char *path = write_file(bytes);
+  PcapReader mapped(path);
+  UringPcapReader reader(path, {.block_bytes = 4096});
+  const size_t expected = mapped.for_each_packet([](const char *, size_t) {});
+  EXPECT_EQ(reader.for_each_packet([](const char *, size_t) {}), expected);
+}
+
+TEST_F(UringReaderTest, Pcap_OversizedLengthStopsLikeMmapReader) {
+  // A corrupt incl_len far past end of file must not be buffered
+  std::vector<unsigned char> bytes = make_pcap();
+  PcapPacketHeader bogus{};
+  bogus.incl_len = 1U << 30;
+  const auto *raw = reinterpret_cast<const unsigned char *>(&bogus);
+  bytes.insert(bytes.end(), raw, raw + sizeof(bogus));
+  bytes.insert(bytes.end(), 8192, 0xEE);
+  const char *path = write_file(bytes);
+
+  PcapReader mapped(path);
+  const size_t expected = mapped.for_each_packet([](const char *, size_t) {});
+  for (const bool uring : {true, false}) {
+    UringPcapReader reader(path, {.block_bytes = 4096, .use_uring = uring});
+    EXPECT_EQ(reader.for_each_packet([](const char *, size_t) {}), expected);
+    EXPECT_FALSE(reader.read_failed());
+  }
+}
+
+TEST_F(UringReaderTest, Pcap_ReadErrorIsReported) {
+  const char *path = write_file(make_pcap());
+  UringPcapReader uring(path, {.block_bytes = 4096});
+  UringPcapReader pread(path, {.block_bytes = 4096, .use_uring = false});
+  ASSERT_TRUE(uring.is_open());
+  ASSERT_TRUE(pread.is_open());
+
+  // Shrunk after open: the second block comes back short, which is an
+  // error rather than end of file
+  ASSERT_EQ(::truncate(path, 5000), 0);
+  for (UringPcapReader *reader : {&uring, &pread}) {
+    (void)reader->for_each_packet([](const char *, size_t) {});
+    EXPECT_TRUE(reader->read_failed());
+  }
+}
+
+} // namespace itch::test